@@ -110,6 +110,7 @@ MFEM_DEBUG             = NO
 MFEM_USE_EXCEPTIONS    = NO
 MFEM_USE_GZSTREAM      = NO
 MFEM_USE_LIBUNWIND     = NO
+MFEM_USE_THREADS       = NO
 MFEM_USE_LAPACK        = NO
 MFEM_THREAD_SAFE       = NO
 MFEM_USE_OPENMP        = NO
@@ -185,6 +186,9 @@ OPENMP_LIB =
 # Used when MFEM_TIMER_TYPE = 2
 POSIX_CLOCKS_LIB = -lrt
 
+# Threads library, used when MFEM_USE_THREADS = YES
+PTHREAD_LIB = -lpthread
+
 # SUNDIALS library configuration
 SUNDIALS_DIR = @MFEM_DIR@/../sundials-5.0.0/instdir
 SUNDIALS_OPT = -I$(SUNDIALS_DIR)/include
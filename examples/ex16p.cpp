@@ -9,6 +9,7 @@
 //               mpirun -np 4 ex16p -s 2 -a 1.0 -k 0.0
 //               mpirun -np 8 ex16p -s 3 -a 0.5 -k 0.5 -o 4
 //               mpirun -np 4 ex16p -s 14 -dt 1.0e-4 -tf 4.0e-2 -vs 40
+//               mpirun -np 4 ex16p -s 31 -dt 0.05
 //               mpirun -np 16 ex16p -m ../data/fichera-q2.mesh
 //               mpirun -np 16 ex16p -m ../data/fichera-mixed.mesh
 //               mpirun -np 16 ex16p -m ../data/escher-p2.mesh
@@ -36,6 +37,29 @@
 using namespace std;
 using namespace mfem;
 
+/** Cache of the implicit systems T = M + dt K solved in
+    ConductionOperator::ImplicitSolve(). The systems are reused while dt
+    repeats, and the preconditioners also after K changes, until the number of
+    CG iterations grows. */
+class ConductionSystems : public ImplicitSolveCache
+{
+protected:
+   const HypreParMatrix &M, &K;
+
+   virtual Operator *NewSystem(double dt) { return Add(1.0, M, dt, K); }
+   virtual Solver *NewPreconditioner(const Operator &A, double dt)
+   {
+      HypreSmoother *prec = new HypreSmoother;
+      prec->SetOperator(A);
+      return prec;
+   }
+
+public:
+   ConductionSystems(MPI_Comm comm, CGSolver &solver, const HypreParMatrix &M_,
+                     const HypreParMatrix &K_)
+      : ImplicitSolveCache(comm, solver), M(M_), K(K_) { }
+};
+
 /** After spatial discretization, the conduction model can be written as:
  *
  *     du/dt = M^{-1}(-Ku)
@@ -57,14 +81,12 @@ protected:
 
    HypreParMatrix Mmat;
    HypreParMatrix Kmat;
-   HypreParMatrix *T; // T = M + dt K
-   double current_dt;
 
    CGSolver M_solver;    // Krylov solver for inverting the mass matrix M
    HypreSmoother M_prec; // Preconditioner for the mass matrix M
 
-   CGSolver T_solver;    // Implicit solver for T = M + dt K
-   HypreSmoother T_prec; // Preconditioner for the implicit solver
+   CGSolver T_solver;           // Implicit solver for T = M + dt K
+   ConductionSystems T_systems; // T and its preconditioner for each dt
 
    double alpha, kappa;
 
@@ -123,7 +145,8 @@ int main(int argc, char *argv[])
                   "Order (degree) of the finite elements.");
    args.AddOption(&ode_solver_type, "-s", "--ode-solver",
                   "ODE solver: 1 - Backward Euler, 2 - SDIRK2, 3 - SDIRK3,\n\t"
-                  "\t   11 - Forward Euler, 12 - RK2, 13 - RK3 SSP, 14 - RK4.");
+                  "\t   11 - Forward Euler, 12 - RK2, 13 - RK3 SSP, 14 - RK4,\n\t"
+                  "\t   31 - Exponential Euler.");
    args.AddOption(&t_final, "-tf", "--t-final",
                   "Final time; start time is 0.");
    args.AddOption(&dt, "-dt", "--time-step",
@@ -179,6 +202,16 @@ int main(int argc, char *argv[])
       case 22: ode_solver = new ImplicitMidpointSolver; break;
       case 23: ode_solver = new SDIRK23Solver; break;
       case 24: ode_solver = new SDIRK34Solver; break;
+      // Exponential methods: the operator is linear in each time step, since
+      // the conductivity is updated after the step, see SetParameters()
+      case 31:
+      {
+         ExponentialEulerSolver *exp_solver =
+            new ExponentialEulerSolver(MPI_COMM_WORLD);
+         exp_solver->SetLinearPart(ExponentialODESolver::LINEAR);
+         ode_solver = exp_solver;
+         break;
+      }
       default:
          cout << "Unknown ODE solver type: " << ode_solver_type << '\n';
          delete mesh;
@@ -343,8 +376,8 @@ int main(int argc, char *argv[])
 ConductionOperator::ConductionOperator(ParFiniteElementSpace &f, double al,
                                        double kap, const Vector &u)
    : TimeDependentOperator(f.GetTrueVSize(), 0.0), fespace(f), M(NULL), K(NULL),
-     T(NULL), current_dt(0.0),
-     M_solver(f.GetComm()), T_solver(f.GetComm()), z(height)
+     M_solver(f.GetComm()), T_solver(f.GetComm()),
+     T_systems(f.GetComm(), T_solver, Mmat, Kmat), z(height)
 {
    const double rel_tol = 1e-8;
 
@@ -370,7 +403,6 @@ ConductionOperator::ConductionOperator(ParFiniteElementSpace &f, double al,
    T_solver.SetAbsTol(0.0);
    T_solver.SetMaxIter(100);
    T_solver.SetPrintLevel(0);
-   T_solver.SetPreconditioner(T_prec);
 
    SetParameters(u);
 }
@@ -391,16 +423,9 @@ void ConductionOperator::ImplicitSolve(const double dt,
    // Solve the equation:
    //    du_dt = M^{-1}*[-K(u + dt*du_dt)]
    // for du_dt
-   if (!T)
-   {
-      T = Add(1.0, Mmat, dt, Kmat);
-      current_dt = dt;
-      T_solver.SetOperator(*T);
-   }
-   MFEM_VERIFY(dt == current_dt, ""); // SDIRK methods use the same dt
    Kmat.Mult(u, z);
    z.Neg();
-   T_solver.Mult(z, du_dt);
+   T_systems.Solve(dt, GetTime(), z, du_dt);
 }
 
 void ConductionOperator::SetParameters(const Vector &u)
@@ -420,13 +445,11 @@ void ConductionOperator::SetParameters(const Vector &u)
    K->AddDomainIntegrator(new DiffusionIntegrator(u_coeff));
    K->Assemble(0); // keep sparsity pattern of M and K the same
    K->FormSystemMatrix(ess_tdof_list, Kmat);
-   delete T;
-   T = NULL; // re-compute T on the next ImplicitSolve
+   T_systems.Update(); // re-compute T on the next ImplicitSolve
 }
 
 ConductionOperator::~ConductionOperator()
 {
-   delete T;
    delete M;
    delete K;
 }
@@ -995,6 +995,18 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::MultMulti(const MultiVector &X, MultiVector &Y) const
+{
+   if (ext)
+   {
+      ext->MultMulti(X, Y);
+   }
+   else
+   {
+      mat->MultMulti(X, Y);
+   }
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
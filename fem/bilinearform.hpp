@@ -229,6 +229,9 @@ public:
    /// Matrix vector multiplication.
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /// Matrix multiplication of several vectors, see Operator::MultMulti().
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const;
+
    void FullMult(const Vector &x, Vector &y) const
    { mat->Mult(x, y); mat_e->AddMult(x, y); }
 
@@ -147,6 +147,41 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void PABilinearFormExtension::MultMulti(const MultiVector &X,
+                                        MultiVector &Y) const
+{
+   if (DeviceCanUseCeed() || !elem_restrict_lex)
+   {
+      Operator::MultMulti(X, Y);
+      return;
+   }
+
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   const int nv = X.NumVectors();
+   const MemoryType mt = localX.GetMemory().GetMemoryType();
+   localXM.SetSize(localX.Size(), nv, mt);
+   localYM.SetSize(localY.Size(), nv, mt);
+   Vector x, y, lx, ly;
+   for (int v = 0; v < nv; v++)
+   {
+      X.GetVectorRef(v, x);
+      localXM.GetVectorRef(v, lx);
+      elem_restrict_lex->Mult(x, lx);
+   }
+   localYM = 0.0;
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultPAMulti(localXM, localYM);
+   }
+   for (int v = 0; v < nv; v++)
+   {
+      localYM.GetVectorRef(v, ly);
+      Y.GetVectorRef(v, y);
+      elem_restrict_lex->MultTranspose(ly, y);
+   }
+}
+
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
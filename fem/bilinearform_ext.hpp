@@ -102,6 +102,7 @@ class PABilinearFormExtension : public BilinearFormExtension
 protected:
    const FiniteElementSpace *trialFes, *testFes; // Not owned
    mutable Vector localX, localY;
+   mutable MultiVector localXM, localYM;
    const Operator *elem_restrict_lex; // Not owned
 
 public:
@@ -116,6 +117,10 @@ public:
                          int copy_interior = 0);
 
    void Mult(const Vector &x, Vector &y) const;
+   /** @brief Action on several vectors: the partially assembled data of each
+       element is read once for all vectors, for the integrators that support
+       it, see BilinearFormIntegrator::AddMultPAMulti(). */
+   void MultMulti(const MultiVector &X, MultiVector &Y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
 };
@@ -45,6 +45,18 @@ void BilinearFormIntegrator::AddMultPA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPAMulti(const MultiVector &x,
+                                            MultiVector &y) const
+{
+   Vector xv, yv;
+   for (int v = 0; v < x.NumVectors(); v++)
+   {
+      x.GetVectorRef(v, xv);
+      y.GetVectorRef(v, yv);
+      AddMultPA(xv, yv);
+   }
+}
+
 void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
 {
    mfem_error ("BilinearFormIntegrator::MultAssembledTranspose (...)\n"
@@ -479,12 +491,15 @@ void DiffusionIntegrator::AssembleElementMatrix
    elmat.SetSize(nd);
 
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
+   // The gradients at the points of the global rules are tabulated once
+   const DofToQuad *tables = IntRule ? NULL : el.GetShapeTables(*ir);
 
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
-      el.CalcDShape(ip, dshape);
+      if (tables) { tables->GetDShape(i, dshape); }
+      else { el.CalcDShape(ip, dshape); }
 
       Trans.SetIntPoint(&ip);
       w = Trans.Weight();
@@ -535,13 +550,17 @@ void DiffusionIntegrator::AssembleElementMatrix2(
    elmat.SetSize(te_nd, tr_nd);
 
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(trial_fe, test_fe);
+   const DofToQuad *tables = IntRule ? NULL : trial_fe.GetShapeTables(*ir);
+   const DofToQuad *te_tables = IntRule ? NULL : test_fe.GetShapeTables(*ir);
 
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
-      trial_fe.CalcDShape(ip, dshape);
-      test_fe.CalcDShape(ip, te_dshape);
+      if (tables) { tables->GetDShape(i, dshape); }
+      else { trial_fe.CalcDShape(ip, dshape); }
+      if (te_tables) { te_tables->GetDShape(i, te_dshape); }
+      else { test_fe.CalcDShape(ip, te_dshape); }
 
       Trans.SetIntPoint(&ip);
       CalcAdjugate(Trans.Jacobian(), invdfdx);
@@ -786,12 +805,15 @@ void MassIntegrator::AssembleElementMatrix
    shape.SetSize(nd);
 
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, Trans);
+   // The shape functions at the points of the global rules are tabulated once
+   const DofToQuad *tables = IntRule ? NULL : el.GetShapeTables(*ir);
 
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
-      el.CalcShape(ip, shape);
+      if (tables) { tables->GetShape(i, shape); }
+      else { el.CalcShape(ip, shape); }
 
       Trans.SetIntPoint (&ip);
       w = Trans.Weight() * ip.weight;
@@ -822,13 +844,17 @@ void MassIntegrator::AssembleElementMatrix2(
 
    const IntegrationRule *ir = IntRule ? IntRule :
                                &GetRule(trial_fe, test_fe, Trans);
+   const DofToQuad *tables = IntRule ? NULL : trial_fe.GetShapeTables(*ir);
+   const DofToQuad *te_tables = IntRule ? NULL : test_fe.GetShapeTables(*ir);
 
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
-      trial_fe.CalcShape(ip, shape);
-      test_fe.CalcShape(ip, te_shape);
+      if (tables) { tables->GetShape(i, shape); }
+      else { trial_fe.CalcShape(ip, shape); }
+      if (te_tables) { te_tables->GetShape(i, te_shape); }
+      else { test_fe.CalcShape(ip, te_shape); }
 
       Trans.SetIntPoint (&ip);
       w = Trans.Weight() * ip.weight;
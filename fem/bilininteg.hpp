@@ -62,6 +62,13 @@ public:
        called. */
    virtual void AddMultPA(const Vector &x, Vector &y) const;
 
+   /// Method for partially assembled action on several vectors.
+   /** Same as AddMultPA() for each vector of the E-vector MultiVectors @a x and
+       @a y. The default implementation calls AddMultPA() for each vector;
+       derived classes can override it to read the partially assembled data
+       only once for all vectors. */
+   virtual void AddMultPAMulti(const MultiVector &x, MultiVector &y) const;
+
    /// Method for partially assembled transposed action.
    /** Perform the transpose action of integrator on the input @a x and add the
        result to the output @a y. Both @a x and @a y are E-vectors, i.e. they
@@ -1716,6 +1723,85 @@ public:
                                          ElementTransformation &Trans);
 };
 
+/** @brief Basis evaluation for the partial assembly on triangles and
+    tetrahedra, with sum factorization in collapsed (Duffy) coordinates. */
+/** The element basis is written in the Bernstein basis of the same degree p,
+    whose functions are products of 1D Bernstein polynomials in the collapsed
+    coordinates of the simplex. At the tensor-product points of the collapsed
+    rule, see GetCollapsedRule(), the values and gradients of a function are
+    then computed with O(p^{dim+1}) operations per element, instead of the
+    O(p^{2 dim}) operations needed with the full basis matrices.
+
+    The O(p^{dim+1}) cost holds only for the Bernstein (BasisType::Positive)
+    elements H1Pos_TriangleElement and H1Pos_TetrahedronElement, whose change
+    of basis is a permutation of the dofs. Other bases spanning the polynomials
+    of degree p, e.g. the Lagrange H1_TriangleElement and H1_TetrahedronElement,
+    are supported with a dense ndof x ndof change of basis applied to each
+    element, i.e. O(p^{2 dim}) operations. The nodes of these elements have no
+    tensor structure in the collapsed coordinates, so this matrix does not
+    factorize. On tetrahedra the dense change of basis costs about as much as
+    the rest of the operator from p = 6, so use BasisType::Positive for high
+    order partial assembly on simplices. */
+class SimplexPAMaps
+{
+public:
+   int dim;    ///< Reference space dimension, 2 or 3
+   int order;  ///< Polynomial degree p of the element basis
+   int ndof;   ///< Number of element dofs
+   int nqpt1D; ///< Number of collapsed points in each direction
+
+   /// The collapsed rule; not owned, see GetCollapsedRule()
+   const IntegrationRule *IntRule;
+
+   /// The element; not owned
+   const FiniteElement *FE;
+
+   /** @brief 1D Bernstein polynomials B^k_a(t_q) = C(k,a) t_q^a (1-t_q)^{k-a}
+       with layout (nqpt1D, p+1, p+1), i.e. B1d[q + nqpt1D*(a + (p+1)*k)]. */
+   Array<double> B1d;
+
+   /** @brief Coefficients of the element basis in the Bernstein basis, with
+       layout (ndof, ndof). Empty when the change of basis is a permutation. */
+   Array<double> T;
+
+   /** @brief Index (a1 + (p+1)*(a2 + (p+1)*a3)) of each Bernstein function
+       (the rows of #T), or of each element dof when #T is empty. */
+   Array<int> bern_index;
+
+   /** @brief Set up the maps for the scalar element @a fe, with a collapsed
+       rule exact for polynomials of degree @a ir_order in the simplex. */
+   SimplexPAMaps(const FiniteElement &fe, int ir_order);
+
+   /// Return true if the element @a fe is supported by this class.
+   static bool Supports(const FiniteElement &fe);
+
+   /** @brief Return the collapsed rule with @a q1d Gauss-Legendre points in
+       each direction for the given simplex geometry. */
+   /** The points are ordered lexicographically in the collapsed coordinates
+       (t1,t2[,t3]), with x = t1, y = (1-t1) t2, z = (1-t1) (1-t2) t3. The
+       rules are created once and are never deleted, so that they can be used
+       as keys for cached data, e.g. Mesh::GetGeometricFactors(). */
+   static const IntegrationRule &GetCollapsedRule(Geometry::Type geom,
+                                                  int q1d);
+
+   /// y += B^T D B x, where D has layout (nq, NE), e.g. for the mass matrix.
+   void MassApply(const int NE, const Vector &D, const Vector &x,
+                  Vector &y) const;
+
+   /** @brief y += G^T D G x, where D has the symmetric layout (nq, 3, NE) in
+       2D or (nq, 6, NE) in 3D of the PA diffusion integrator. */
+   void DiffusionApply(const int NE, const Vector &D, const Vector &x,
+                       Vector &y) const;
+
+   /** @brief Add the diagonal of the MassApply() operator to @a diag. This
+       uses the full basis matrices of #FE at the points of #IntRule. */
+   void MassDiagonal(const int NE, const Vector &D, Vector &diag) const;
+
+   /** @brief Add the diagonal of the DiffusionApply() operator to @a diag.
+       This uses the full basis matrices of #FE at the points of #IntRule. */
+   void DiffusionDiagonal(const int NE, const Vector &D, Vector &diag) const;
+};
+
 /** Class for integrating the bilinear form a(u,v) := (Q grad u, grad v) where Q
     can be a scalar or a matrix coefficient. */
 class DiffusionIntegrator: public BilinearFormIntegrator
@@ -1735,6 +1821,7 @@ private:
    const FiniteElementSpace *fespace;
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
+   SimplexPAMaps *simplex_maps;   ///< Owned, used on simplices
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
 
@@ -1751,6 +1838,7 @@ public:
       MQ = NULL;
       maps = NULL;
       geom = NULL;
+      simplex_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1763,18 +1851,21 @@ public:
       MQ = NULL;
       maps = NULL;
       geom = NULL;
+      simplex_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
    }
 
    /// Construct a diffusion integrator with a matrix coefficient q
+   /** With partial assembly, @a q must be symmetric. */
    DiffusionIntegrator(MatrixCoefficient &q)
       : MQ(&q)
    {
       Q = NULL;
       maps = NULL;
       geom = NULL;
+      simplex_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1782,6 +1873,7 @@ public:
 
    virtual ~DiffusionIntegrator()
    {
+      delete simplex_maps;
 #ifdef MFEM_USE_CEED
       delete ceedDataPtr;
 #endif
@@ -1821,6 +1913,8 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultPAMulti(const MultiVector &x, MultiVector &y) const;
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 
@@ -1840,6 +1934,7 @@ protected:
    Vector pa_data;
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
+   SimplexPAMaps *simplex_maps;   ///< Owned, used on simplices
    int dim, ne, nq, dofs1D, quad1D;
 
 #ifdef MFEM_USE_CEED
@@ -1854,6 +1949,7 @@ public:
       Q = NULL;
       maps = NULL;
       geom = NULL;
+      simplex_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1865,6 +1961,7 @@ public:
    {
       maps = NULL;
       geom = NULL;
+      simplex_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1872,6 +1969,7 @@ public:
 
    virtual ~MassIntegrator()
    {
+      delete simplex_maps;
 #ifdef MFEM_USE_CEED
       delete ceedDataPtr;
 #endif
@@ -1894,6 +1992,8 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultPAMulti(const MultiVector &x, MultiVector &y) const;
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
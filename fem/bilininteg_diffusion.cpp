@@ -90,9 +90,11 @@ static void PADiffusionSetup2D(const int Q1D,
 {
    const int NQ = Q1D*Q1D;
    const bool const_c = c.Size() == 1;
+   const bool matrix_c = c.Size() == NQ*2*2*NE;
    auto W = w.Read();
    auto J = Reshape(j.Read(), NQ, 2, 2, NE);
    auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
+   auto K = Reshape(c.Read(), NQ, 2, 2, NE);
    auto D = Reshape(d.Write(), NQ, 3, NE);
 
    MFEM_FORALL(e, NE,
@@ -103,6 +105,23 @@ static void PADiffusionSetup2D(const int Q1D,
          const double J21 = J(q,1,0,e);
          const double J12 = J(q,0,1,e);
          const double J22 = J(q,1,1,e);
+         if (matrix_c)
+         {
+            const double w_detJ = W[q] / ((J11*J22)-(J21*J12));
+            // adj(J)
+            const double A11 =  J22, A12 = -J12;
+            const double A21 = -J21, A22 =  J11;
+            const double K11 = K(q,0,0,e), K12 = K(q,0,1,e);
+            const double K21 = K(q,1,0,e), K22 = K(q,1,1,e);
+            // adj(J) K
+            const double M11 = A11*K11 + A12*K21, M12 = A11*K12 + A12*K22;
+            const double M21 = A21*K11 + A22*K21, M22 = A21*K12 + A22*K22;
+            // detJ J^{-1} K J^{-T} = (1/detJ) adj(J) K adj(J)^T
+            D(q,0,e) = w_detJ * (M11*A11 + M12*A12); // 1,1
+            D(q,1,e) = w_detJ * (M11*A21 + M12*A22); // 1,2
+            D(q,2,e) = w_detJ * (M21*A21 + M22*A22); // 2,2
+            continue;
+         }
          const double coeff = const_c ? C(0,0) : C(q,e);
          const double c_detJ = W[q] * coeff / ((J11*J22)-(J21*J12));
          D(q,0,e) =  c_detJ * (J12*J12 + J22*J22); // 1,1
@@ -122,9 +141,11 @@ static void PADiffusionSetup3D(const int Q1D,
 {
    const int NQ = Q1D*Q1D*Q1D;
    const bool const_c = c.Size() == 1;
+   const bool matrix_c = c.Size() == NQ*3*3*NE;
    auto W = w.Read();
    auto J = Reshape(j.Read(), NQ, 3, 3, NE);
    auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
+   auto K = Reshape(c.Read(), NQ, 3, 3, NE);
    auto D = Reshape(d.Write(), NQ, 6, NE);
    MFEM_FORALL(e, NE,
    {
@@ -142,8 +163,6 @@ static void PADiffusionSetup3D(const int Q1D,
          const double detJ = J11 * (J22 * J33 - J32 * J23) -
          /* */               J21 * (J12 * J33 - J32 * J13) +
          /* */               J31 * (J12 * J23 - J22 * J13);
-         const double coeff = const_c ? C(0,0) : C(q,e);
-         const double c_detJ = W[q] * coeff / detJ;
          // adj(J)
          const double A11 = (J22 * J33) - (J23 * J32);
          const double A12 = (J32 * J13) - (J12 * J33);
@@ -154,6 +173,37 @@ static void PADiffusionSetup3D(const int Q1D,
          const double A31 = (J21 * J32) - (J31 * J22);
          const double A32 = (J31 * J12) - (J11 * J32);
          const double A33 = (J11 * J22) - (J12 * J21);
+         if (matrix_c)
+         {
+            const double w_detJ = W[q] / detJ;
+            const double A[3][3] = { {A11, A12, A13},
+               {A21, A22, A23},
+               {A31, A32, A33}
+            };
+            // adj(J) K
+            double M[3][3];
+            for (int i = 0; i < 3; i++)
+            {
+               for (int k = 0; k < 3; k++)
+               {
+                  M[i][k] = A[i][0]*K(q,0,k,e) + A[i][1]*K(q,1,k,e) +
+                            A[i][2]*K(q,2,k,e);
+               }
+            }
+            // detJ J^{-1} K J^{-T} = (1/detJ) adj(J) K adj(J)^T, stored with
+            // the same (lower triangular) layout as below
+            for (int i = 0, k = 0; i < 3; i++)
+            {
+               for (int l = i; l < 3; l++, k++)
+               {
+                  D(q,k,e) = w_detJ * (M[l][0]*A[i][0] + M[l][1]*A[i][1] +
+                                       M[l][2]*A[i][2]);
+               }
+            }
+            continue;
+         }
+         const double coeff = const_c ? C(0,0) : C(q,e);
+         const double c_detJ = W[q] * coeff / detJ;
          // detJ J^{-1} J^{-T} = (1/detJ) adj(J) adj(J)^T
          D(q,0,e) = c_detJ * (A11*A11 + A12*A12 + A13*A13); // 1,1
          D(q,1,e) = c_detJ * (A11*A21 + A12*A22 + A13*A23); // 2,1
@@ -175,10 +225,14 @@ static void PADiffusionSetup(const int dim,
                              Vector &D)
 {
    if (dim == 1) { MFEM_ABORT("dim==1 not supported in PADiffusionSetup"); }
+#ifdef MFEM_USE_OCCA
+   // The OCCA kernels only support scalar coefficients
+   const bool scalar_c = C.Size() == 1 || C.Size() == J.Size()/(dim*dim);
+#endif
    if (dim == 2)
    {
 #ifdef MFEM_USE_OCCA
-      if (DeviceCanUseOcca())
+      if (DeviceCanUseOcca() && scalar_c)
       {
          OccaPADiffusionSetup2D(D1D, Q1D, NE, W, J, C, D);
          return;
@@ -189,7 +243,7 @@ static void PADiffusionSetup(const int dim,
    if (dim == 3)
    {
 #ifdef MFEM_USE_OCCA
-      if (DeviceCanUseOcca())
+      if (DeviceCanUseOcca() && scalar_c)
       {
          OccaPADiffusionSetup3D(D1D, Q1D, NE, W, J, C, D);
          return;
@@ -199,6 +253,32 @@ static void PADiffusionSetup(const int dim,
    }
 }
 
+// Check the symmetry of the dim x dim matrices in the (NQ x dim x dim x NE)
+// array c, as computed by MatrixCoefficient::Project
+static bool IsSymmetricCoefficient(const int NQ, const int dim, const int NE,
+                                   const Vector &c)
+{
+   auto K = Reshape(c.HostRead(), NQ, dim, dim, NE);
+   for (int e = 0; e < NE; e++)
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         for (int i = 0; i < dim; i++)
+         {
+            for (int j = 0; j < i; j++)
+            {
+               const double kij = K(q,i,j,e), kji = K(q,j,i,e);
+               if (std::abs(kij - kji) > 1e-12*(std::abs(kij) + std::abs(kji)))
+               {
+                  return false;
+               }
+            }
+         }
+      }
+   }
+   return true;
+}
+
 void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
                                   const bool force)
 {
@@ -211,6 +291,7 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
 #ifdef MFEM_USE_CEED
    if (DeviceCanUseCeed() && !force)
    {
+      MFEM_VERIFY(MQ == NULL, "MatrixCoefficient is not supported with libCEED");
       if (ceedDataPtr) { delete ceedDataPtr; }
       CeedData* ptr = new CeedData();
       ceedDataPtr = ptr;
@@ -220,16 +301,33 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
 #endif
    const int dims = el.GetDim();
    const int symmDims = (dims * (dims + 1)) / 2; // 1x1: 1, 2x2: 3, 3x3: 6
+   delete simplex_maps;
+   simplex_maps = NULL;
+   if (SimplexPAMaps::Supports(el))
+   {
+      // Sum factorization in collapsed coordinates, see SimplexPAMaps
+      simplex_maps = new SimplexPAMaps(el, ir->GetOrder());
+      ir = simplex_maps->IntRule;
+   }
    const int nq = ir->GetNPoints();
    dim = mesh->Dimension();
    ne = fes.GetNE();
    geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
-   dofs1D = maps->ndof;
-   quad1D = maps->nqpt;
+   maps = simplex_maps ? NULL : &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = simplex_maps ? el.GetOrder() + 1 : maps->ndof;
+   quad1D = simplex_maps ? simplex_maps->nqpt1D : maps->nqpt;
    pa_data.SetSize(symmDims * nq * ne, Device::GetMemoryType());
    Vector coeff;
-   if (Q == nullptr)
+   if (MQ)
+   {
+      MFEM_VERIFY(MQ->GetHeight() == dim && MQ->GetWidth() == dim,
+                  "the MatrixCoefficient must be dim x dim");
+      MQ->Project(coeff, *mesh, *ir);
+      // Only the symmetric part of the operator is stored in pa_data
+      MFEM_VERIFY(IsSymmetricCoefficient(nq, dim, ne, coeff),
+                  "PA requires a symmetric MatrixCoefficient");
+   }
+   else if (Q == nullptr)
    {
       coeff.SetSize(1);
       coeff(0) = 1.0;
@@ -241,16 +339,7 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->Project(coeff, *mesh, *ir);
    }
    PADiffusionSetup(dim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J, coeff,
                     pa_data);
@@ -680,6 +769,11 @@ static void PADiffusionAssembleDiagonal(const int dim,
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (pa_data.Size()==0) { SetupPA(*fespace, true); }
+   if (simplex_maps)
+   {
+      simplex_maps->DiffusionDiagonal(ne, pa_data, diag);
+      return;
+   }
    PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne,
                                maps->B, maps->G, pa_data, diag);
 }
@@ -796,7 +890,8 @@ static void PADiffusionApply2D(const int NE,
                                const Vector &x_,
                                Vector &y_,
                                const int d1d = 0,
-                               const int q1d = 0)
+                               const int q1d = 0,
+                               const int NV = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -807,8 +902,8 @@ static void PADiffusionApply2D(const int NE,
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
    auto Gt = Reshape(gt_.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE, NV);
    MFEM_FORALL(e, NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
@@ -816,89 +911,91 @@ static void PADiffusionApply2D(const int NE,
       // the following variables are evaluated at compile time
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-
-      double grad[max_Q1D][max_Q1D][2];
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            grad[qy][qx][0] = 0.0;
-            grad[qy][qx][1] = 0.0;
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
+      for (int v = 0; v < NV; ++v)
       {
-         double gradX[max_Q1D][2];
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            gradX[qx][0] = 0.0;
-            gradX[qx][1] = 0.0;
-         }
-         for (int dx = 0; dx < D1D; ++dx)
+         double grad[max_Q1D][max_Q1D][2];
+         for (int qy = 0; qy < Q1D; ++qy)
          {
-            const double s = X(dx,dy,e);
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               gradX[qx][0] += s * B(qx,dx);
-               gradX[qx][1] += s * G(qx,dx);
+               grad[qy][qx][0] = 0.0;
+               grad[qy][qx][1] = 0.0;
             }
          }
-         for (int qy = 0; qy < Q1D; ++qy)
+         for (int dy = 0; dy < D1D; ++dy)
          {
-            const double wy  = B(qy,dy);
-            const double wDy = G(qy,dy);
+            double gradX[max_Q1D][2];
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               grad[qy][qx][0] += gradX[qx][1] * wy;
-               grad[qy][qx][1] += gradX[qx][0] * wDy;
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X(dx,dy,e,v);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qy][qx][0] += gradX[qx][1] * wy;
+                  grad[qy][qx][1] += gradX[qx][0] * wDy;
+               }
             }
          }
-      }
-      // Calculate Dxy, xDy in plane
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
+         // Calculate Dxy, xDy in plane
+         for (int qy = 0; qy < Q1D; ++qy)
          {
-            const int q = qx + qy * Q1D;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + qy * Q1D;
 
-            const double O11 = D(q,0,e);
-            const double O12 = D(q,1,e);
-            const double O22 = D(q,2,e);
+               const double O11 = D(q,0,e);
+               const double O12 = D(q,1,e);
+               const double O22 = D(q,2,e);
 
-            const double gradX = grad[qy][qx][0];
-            const double gradY = grad[qy][qx][1];
+               const double gradX = grad[qy][qx][0];
+               const double gradY = grad[qy][qx][1];
 
-            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
-            grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         double gradX[max_D1D][2];
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            gradX[dx][0] = 0;
-            gradX[dx][1] = 0;
+               grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+               grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+            }
          }
-         for (int qx = 0; qx < Q1D; ++qx)
+         for (int qy = 0; qy < Q1D; ++qy)
          {
-            const double gX = grad[qy][qx][0];
-            const double gY = grad[qy][qx][1];
+            double gradX[max_D1D][2];
             for (int dx = 0; dx < D1D; ++dx)
             {
-               const double wx  = Bt(dx,qx);
-               const double wDx = Gt(dx,qx);
-               gradX[dx][0] += gX * wDx;
-               gradX[dx][1] += gY * wx;
+               gradX[dx][0] = 0;
+               gradX[dx][1] = 0;
             }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            const double wy  = Bt(dy,qy);
-            const double wDy = Gt(dy,qy);
-            for (int dx = 0; dx < D1D; ++dx)
+            for (int qx = 0; qx < Q1D; ++qx)
             {
-               Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               const double gX = grad[qy][qx][0];
+               const double gY = grad[qy][qx][1];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,e,v) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               }
             }
          }
       }
@@ -916,7 +1013,8 @@ static void SmemPADiffusionApply2D(const int NE,
                                    const Vector &x_,
                                    Vector &y_,
                                    const int d1d = 0,
-                                   const int q1d = 0)
+                                   const int q1d = 0,
+                                   const int NV = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -928,8 +1026,8 @@ static void SmemPADiffusionApply2D(const int NE,
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto g = Reshape(g_.Read(), Q1D, D1D);
    auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE, NV);
    MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
    {
       const int tidz = MFEM_THREAD_ID(z);
@@ -951,114 +1049,118 @@ static void SmemPADiffusionApply2D(const int NE,
       double (*DQ1)[MD1] = (double (*)[MD1])(GD[1] + tidz);
       double (*QQ0)[MD1] = (double (*)[MD1])(GQ[0] + tidz);
       double (*QQ1)[MD1] = (double (*)[MD1])(GQ[1] + tidz);
-      MFEM_FOREACH_THREAD(dy,y,D1D)
+      for (int iv = 0; iv < NV; ++iv)
       {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
+         MFEM_FOREACH_THREAD(dy,y,D1D)
          {
-            X[dy][dx] = x(dx,dy,e);
+            MFEM_FOREACH_THREAD(dx,x,D1D)
+            {
+               X[dy][dx] = x(dx,dy,e,iv);
+            }
          }
-      }
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         if (tidz == 0)
          {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               B[q][dy] = b(q,dy);
-               G[q][dy] = g(q,dy);
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  B[q][dy] = b(q,dy);
+                  G[q][dy] = g(q,dy);
+               }
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dy,y,D1D)
          {
-            double u = 0.0;
-            double v = 0.0;
-            for (int dx = 0; dx < D1D; ++dx)
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
             {
-               const double coords = X[dy][dx];
-               u += B[qx][dx] * coords;
-               v += G[qx][dx] * coords;
+               double u = 0.0;
+               double v = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double coords = X[dy][dx];
+                  u += B[qx][dx] * coords;
+                  v += G[qx][dx] * coords;
+               }
+               DQ0[dy][qx] = u;
+               DQ1[dy][qx] = v;
             }
-            DQ0[dy][qx] = u;
-            DQ1[dy][qx] = v;
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
          {
-            double u = 0.0;
-            double v = 0.0;
-            for (int dy = 0; dy < D1D; ++dy)
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
             {
-               u += DQ1[dy][qx] * B[qy][dy];
-               v += DQ0[dy][qx] * G[qy][dy];
+               double u = 0.0;
+               double v = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  u += DQ1[dy][qx] * B[qy][dy];
+                  v += DQ0[dy][qx] * G[qy][dy];
+               }
+               QQ0[qy][qx] = u;
+               QQ1[qy][qx] = v;
             }
-            QQ0[qy][qx] = u;
-            QQ1[qy][qx] = v;
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
          {
-            const int q = (qx + ((qy) * Q1D));
-            const double O11 = D(q,0,e);
-            const double O12 = D(q,1,e);
-            const double O22 = D(q,2,e);
-            const double gX = QQ0[qy][qx];
-            const double gY = QQ1[qy][qx];
-            QQ0[qy][qx] = (O11 * gX) + (O12 * gY);
-            QQ1[qy][qx] = (O12 * gX) + (O22 * gY);
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            {
+               const int q = (qx + ((qy) * Q1D));
+               const double O11 = D(q,0,e);
+               const double O12 = D(q,1,e);
+               const double O22 = D(q,2,e);
+               const double gX = QQ0[qy][qx];
+               const double gY = QQ1[qy][qx];
+               QQ0[qy][qx] = (O11 * gX) + (O12 * gY);
+               QQ1[qy][qx] = (O12 * gX) + (O22 * gY);
+            }
          }
-      }
-      MFEM_SYNC_THREAD;
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_SYNC_THREAD;
+         if (tidz == 0)
          {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               Bt[dy][q] = b(q,dy);
-               Gt[dy][q] = g(q,dy);
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  Bt[dy][q] = b(q,dy);
+                  Gt[dy][q] = g(q,dy);
+               }
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
          {
-            double u = 0.0;
-            double v = 0.0;
-            for (int qx = 0; qx < Q1D; ++qx)
+            MFEM_FOREACH_THREAD(dx,x,D1D)
             {
-               u += Gt[dx][qx] * QQ0[qy][qx];
-               v += Bt[dx][qx] * QQ1[qy][qx];
+               double u = 0.0;
+               double v = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u += Gt[dx][qx] * QQ0[qy][qx];
+                  v += Bt[dx][qx] * QQ1[qy][qx];
+               }
+               DQ0[qy][dx] = u;
+               DQ1[qy][dx] = v;
             }
-            DQ0[qy][dx] = u;
-            DQ1[qy][dx] = v;
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dy,y,D1D)
          {
-            double u = 0.0;
-            double v = 0.0;
-            for (int qy = 0; qy < Q1D; ++qy)
+            MFEM_FOREACH_THREAD(dx,x,D1D)
             {
-               u += DQ0[qy][dx] * Bt[dy][qy];
-               v += DQ1[qy][dx] * Gt[dy][qy];
+               double u = 0.0;
+               double v = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  u += DQ0[qy][dx] * Bt[dy][qy];
+                  v += DQ1[qy][dx] * Gt[dy][qy];
+               }
+               Y(dx,dy,e,iv) += (u + v);
             }
-            Y(dx,dy,e) += (u + v);
          }
+         MFEM_SYNC_THREAD;
       }
    });
 }
@@ -1073,7 +1175,7 @@ static void PADiffusionApply3D(const int NE,
                                const Vector &d_,
                                const Vector &x_,
                                Vector &y_,
-                               int d1d = 0, int q1d = 0)
+                               int d1d = 0, int q1d = 0, const int NV = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1084,167 +1186,170 @@ static void PADiffusionApply3D(const int NE,
    auto Bt = Reshape(bt.Read(), D1D, Q1D);
    auto Gt = Reshape(gt.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE, NV);
    MFEM_FORALL(e, NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double grad[max_Q1D][max_Q1D][max_Q1D][3];
-      for (int qz = 0; qz < Q1D; ++qz)
+      for (int v = 0; v < NV; ++v)
       {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               grad[qz][qy][qx][0] = 0.0;
-               grad[qz][qy][qx][1] = 0.0;
-               grad[qz][qy][qx][2] = 0.0;
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         double gradXY[max_Q1D][max_Q1D][3];
-         for (int qy = 0; qy < Q1D; ++qy)
+         double grad[max_Q1D][max_Q1D][max_Q1D][3];
+         for (int qz = 0; qz < Q1D; ++qz)
          {
-            for (int qx = 0; qx < Q1D; ++qx)
+            for (int qy = 0; qy < Q1D; ++qy)
             {
-               gradXY[qy][qx][0] = 0.0;
-               gradXY[qy][qx][1] = 0.0;
-               gradXY[qy][qx][2] = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][0] = 0.0;
+                  grad[qz][qy][qx][1] = 0.0;
+                  grad[qz][qy][qx][2] = 0.0;
+               }
             }
          }
-         for (int dy = 0; dy < D1D; ++dy)
+         for (int dz = 0; dz < D1D; ++dz)
          {
-            double gradX[max_Q1D][2];
-            for (int qx = 0; qx < Q1D; ++qx)
+            double gradXY[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
             {
-               gradX[qx][0] = 0.0;
-               gradX[qx][1] = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
             }
-            for (int dx = 0; dx < D1D; ++dx)
+            for (int dy = 0; dy < D1D; ++dy)
             {
-               const double s = X(dx,dy,dz,e);
+               double gradX[max_Q1D][2];
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  gradX[qx][0] += s * B(qx,dx);
-                  gradX[qx][1] += s * G(qx,dx);
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = X(dx,dy,dz,e,v);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0] += s * B(qx,dx);
+                     gradX[qx][1] += s * G(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double wx  = gradX[qx][0];
+                     const double wDx = gradX[qx][1];
+                     gradXY[qy][qx][0] += wDx * wy;
+                     gradXY[qy][qx][1] += wx  * wDy;
+                     gradXY[qy][qx][2] += wx  * wy;
+                  }
                }
             }
-            for (int qy = 0; qy < Q1D; ++qy)
+            for (int qz = 0; qz < Q1D; ++qz)
             {
-               const double wy  = B(qy,dy);
-               const double wDy = G(qy,dy);
-               for (int qx = 0; qx < Q1D; ++qx)
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
                {
-                  const double wx  = gradX[qx][0];
-                  const double wDx = gradX[qx][1];
-                  gradXY[qy][qx][0] += wDx * wy;
-                  gradXY[qy][qx][1] += wx  * wDy;
-                  gradXY[qy][qx][2] += wx  * wy;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+                     grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+                     grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+                  }
                }
             }
          }
+         // Calculate Dxyz, xDyz, xyDz in plane
          for (int qz = 0; qz < Q1D; ++qz)
          {
-            const double wz  = B(qz,dz);
-            const double wDz = G(qz,dz);
             for (int qy = 0; qy < Q1D; ++qy)
             {
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
-                  grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
-                  grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+                  const int q = qx + (qy + qz * Q1D) * Q1D;
+                  const double O11 = D(q,0,e);
+                  const double O12 = D(q,1,e);
+                  const double O13 = D(q,2,e);
+                  const double O22 = D(q,3,e);
+                  const double O23 = D(q,4,e);
+                  const double O33 = D(q,5,e);
+                  const double gradX = grad[qz][qy][qx][0];
+                  const double gradY = grad[qz][qy][qx][1];
+                  const double gradZ = grad[qz][qy][qx][2];
+                  grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+                  grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
+                  grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
                }
             }
          }
-      }
-      // Calculate Dxyz, xDyz, xyDz in plane
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const int q = qx + (qy + qz * Q1D) * Q1D;
-               const double O11 = D(q,0,e);
-               const double O12 = D(q,1,e);
-               const double O13 = D(q,2,e);
-               const double O22 = D(q,3,e);
-               const double O23 = D(q,4,e);
-               const double O33 = D(q,5,e);
-               const double gradX = grad[qz][qy][qx][0];
-               const double gradY = grad[qz][qy][qx][1];
-               const double gradZ = grad[qz][qy][qx][2];
-               grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
-               grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
-               grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         double gradXY[max_D1D][max_D1D][3];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradXY[dy][dx][0] = 0;
-               gradXY[dy][dx][1] = 0;
-               gradXY[dy][dx][2] = 0;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
+         for (int qz = 0; qz < Q1D; ++qz)
          {
-            double gradX[max_D1D][3];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradX[dx][0] = 0;
-               gradX[dx][1] = 0;
-               gradX[dx][2] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
+            double gradXY[max_D1D][max_D1D][3];
+            for (int dy = 0; dy < D1D; ++dy)
             {
-               const double gX = grad[qz][qy][qx][0];
-               const double gY = grad[qz][qy][qx][1];
-               const double gZ = grad[qz][qy][qx][2];
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  const double wx  = Bt(dx,qx);
-                  const double wDx = Gt(dx,qx);
-                  gradX[dx][0] += gX * wDx;
-                  gradX[dx][1] += gY * wx;
-                  gradX[dx][2] += gZ * wx;
+                  gradXY[dy][dx][0] = 0;
+                  gradXY[dy][dx][1] = 0;
+                  gradXY[dy][dx][2] = 0;
                }
             }
-            for (int dy = 0; dy < D1D; ++dy)
+            for (int qy = 0; qy < Q1D; ++qy)
             {
-               const double wy  = Bt(dy,qy);
-               const double wDy = Gt(dy,qy);
+               double gradX[max_D1D][3];
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
-                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
-                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  gradX[dx][0] = 0;
+                  gradX[dx][1] = 0;
+                  gradX[dx][2] = 0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double gX = grad[qz][qy][qx][0];
+                  const double gY = grad[qz][qy][qx][1];
+                  const double gZ = grad[qz][qy][qx][2];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = Bt(dx,qx);
+                     const double wDx = Gt(dx,qx);
+                     gradX[dx][0] += gX * wDx;
+                     gradX[dx][1] += gY * wx;
+                     gradX[dx][2] += gZ * wx;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy  = Bt(dy,qy);
+                  const double wDy = Gt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  }
                }
             }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            const double wz  = Bt(dz,qz);
-            const double wDz = Gt(dz,qz);
-            for (int dy = 0; dy < D1D; ++dy)
+            for (int dz = 0; dz < D1D; ++dz)
             {
-               for (int dx = 0; dx < D1D; ++dx)
+               const double wz  = Bt(dz,qz);
+               const double wDz = Gt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
                {
-                  Y(dx,dy,dz,e) +=
-                     ((gradXY[dy][dx][0] * wz) +
-                      (gradXY[dy][dx][1] * wz) +
-                      (gradXY[dy][dx][2] * wDz));
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     Y(dx,dy,dz,e,v) +=
+                        ((gradXY[dy][dx][0] * wz) +
+                         (gradXY[dy][dx][1] * wz) +
+                         (gradXY[dy][dx][2] * wDz));
+                  }
                }
             }
          }
@@ -1263,7 +1368,8 @@ static void SmemPADiffusionApply3D(const int NE,
                                    const Vector &x_,
                                    Vector &y_,
                                    const int d1d = 0,
-                                   const int q1d = 0)
+                                   const int q1d = 0,
+                                   const int NV = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1274,8 +1380,8 @@ static void SmemPADiffusionApply3D(const int NE,
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto g = Reshape(g_.Read(), Q1D, D1D);
    auto d = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE, NV);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE, NV);
    MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
    {
       const int tidz = MFEM_THREAD_ID(z);
@@ -1306,189 +1412,193 @@ static void SmemPADiffusionApply3D(const int NE,
       double (*QDD0)[MD1][MD1] = (double (*)[MD1][MD1]) (sm0+0);
       double (*QDD1)[MD1][MD1] = (double (*)[MD1][MD1]) (sm0+1);
       double (*QDD2)[MD1][MD1] = (double (*)[MD1][MD1]) (sm0+2);
-      MFEM_FOREACH_THREAD(dz,z,D1D)
+      for (int iv = 0; iv < NV; ++iv)
       {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_FOREACH_THREAD(dz,z,D1D)
          {
-            MFEM_FOREACH_THREAD(dx,x,D1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               X[dz][dy][dx] = x(dx,dy,dz,e);
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  X[dz][dy][dx] = x(dx,dy,dz,e,iv);
+               }
             }
          }
-      }
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(d,y,D1D)
+         if (tidz == 0)
          {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
+            MFEM_FOREACH_THREAD(d,y,D1D)
             {
-               B[q][d] = b(q,d);
-               G[q][d] = g(q,d);
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  B[q][d] = b(q,d);
+                  G[q][d] = g(q,d);
+               }
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dz,z,D1D)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
          {
-            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               double u = 0.0;
-               double v = 0.0;
-               for (int dx = 0; dx < D1D; ++dx)
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
                {
-                  const double coords = X[dz][dy][dx];
-                  u += coords * B[qx][dx];
-                  v += coords * G[qx][dx];
+                  double u = 0.0;
+                  double v = 0.0;
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double coords = X[dz][dy][dx];
+                     u += coords * B[qx][dx];
+                     v += coords * G[qx][dx];
+                  }
+                  DDQ0[dz][dy][qx] = u;
+                  DDQ1[dz][dy][qx] = v;
                }
-               DDQ0[dz][dy][qx] = u;
-               DDQ1[dz][dy][qx] = v;
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dz,z,D1D)
-      {
-         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
          {
-            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
             {
-               double u = 0.0;
-               double v = 0.0;
-               double w = 0.0;
-               for (int dy = 0; dy < D1D; ++dy)
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
                {
-                  u += DDQ1[dz][dy][qx] * B[qy][dy];
-                  v += DDQ0[dz][dy][qx] * G[qy][dy];
-                  w += DDQ0[dz][dy][qx] * B[qy][dy];
+                  double u = 0.0;
+                  double v = 0.0;
+                  double w = 0.0;
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     u += DDQ1[dz][dy][qx] * B[qy][dy];
+                     v += DDQ0[dz][dy][qx] * G[qy][dy];
+                     w += DDQ0[dz][dy][qx] * B[qy][dy];
+                  }
+                  DQQ0[dz][qy][qx] = u;
+                  DQQ1[dz][qy][qx] = v;
+                  DQQ2[dz][qy][qx] = w;
                }
-               DQQ0[dz][qy][qx] = u;
-               DQQ1[dz][qy][qx] = v;
-               DQQ2[dz][qy][qx] = w;
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qz,z,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
          {
-            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
             {
-               double u = 0.0;
-               double v = 0.0;
-               double w = 0.0;
-               for (int dz = 0; dz < D1D; ++dz)
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
                {
-                  u += DQQ0[dz][qy][qx] * B[qz][dz];
-                  v += DQQ1[dz][qy][qx] * B[qz][dz];
-                  w += DQQ2[dz][qy][qx] * G[qz][dz];
+                  double u = 0.0;
+                  double v = 0.0;
+                  double w = 0.0;
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     u += DQQ0[dz][qy][qx] * B[qz][dz];
+                     v += DQQ1[dz][qy][qx] * B[qz][dz];
+                     w += DQQ2[dz][qy][qx] * G[qz][dz];
+                  }
+                  QQQ0[qz][qy][qx] = u;
+                  QQQ1[qz][qy][qx] = v;
+                  QQQ2[qz][qy][qx] = w;
                }
-               QQQ0[qz][qy][qx] = u;
-               QQQ1[qz][qy][qx] = v;
-               QQQ2[qz][qy][qx] = w;
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qz,z,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
          {
-            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
             {
-               const int q = qx + ((qy*Q1D) + (qz*Q1D*Q1D));
-               const double O11 = d(q,0,e);
-               const double O12 = d(q,1,e);
-               const double O13 = d(q,2,e);
-               const double O22 = d(q,3,e);
-               const double O23 = d(q,4,e);
-               const double O33 = d(q,5,e);
-               const double gX = QQQ0[qz][qy][qx];
-               const double gY = QQQ1[qz][qy][qx];
-               const double gZ = QQQ2[qz][qy][qx];
-               QQQ0[qz][qy][qx] = (O11*gX) + (O12*gY) + (O13*gZ);
-               QQQ1[qz][qy][qx] = (O12*gX) + (O22*gY) + (O23*gZ);
-               QQQ2[qz][qy][qx] = (O13*gX) + (O23*gY) + (O33*gZ);
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
+               {
+                  const int q = qx + ((qy*Q1D) + (qz*Q1D*Q1D));
+                  const double O11 = d(q,0,e);
+                  const double O12 = d(q,1,e);
+                  const double O13 = d(q,2,e);
+                  const double O22 = d(q,3,e);
+                  const double O23 = d(q,4,e);
+                  const double O33 = d(q,5,e);
+                  const double gX = QQQ0[qz][qy][qx];
+                  const double gY = QQQ1[qz][qy][qx];
+                  const double gZ = QQQ2[qz][qy][qx];
+                  QQQ0[qz][qy][qx] = (O11*gX) + (O12*gY) + (O13*gZ);
+                  QQQ1[qz][qy][qx] = (O12*gX) + (O22*gY) + (O23*gZ);
+                  QQQ2[qz][qy][qx] = (O13*gX) + (O23*gY) + (O33*gZ);
+               }
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(d,y,D1D)
+         MFEM_SYNC_THREAD;
+         if (tidz == 0)
          {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
+            MFEM_FOREACH_THREAD(d,y,D1D)
             {
-               Bt[d][q] = b(q,d);
-               Gt[d][q] = g(q,d);
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  Bt[d][q] = b(q,d);
+                  Gt[d][q] = g(q,d);
+               }
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qz,z,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
          {
-            MFEM_FOREACH_THREAD(dx,x,D1D)
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
             {
-               double u = 0.0;
-               double v = 0.0;
-               double w = 0.0;
-               for (int qx = 0; qx < Q1D; ++qx)
+               MFEM_FOREACH_THREAD(dx,x,D1D)
                {
-                  u += QQQ0[qz][qy][qx] * Gt[dx][qx];
-                  v += QQQ1[qz][qy][qx] * Bt[dx][qx];
-                  w += QQQ2[qz][qy][qx] * Bt[dx][qx];
+                  double u = 0.0;
+                  double v = 0.0;
+                  double w = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     u += QQQ0[qz][qy][qx] * Gt[dx][qx];
+                     v += QQQ1[qz][qy][qx] * Bt[dx][qx];
+                     w += QQQ2[qz][qy][qx] * Bt[dx][qx];
+                  }
+                  QQD0[qz][qy][dx] = u;
+                  QQD1[qz][qy][dx] = v;
+                  QQD2[qz][qy][dx] = w;
                }
-               QQD0[qz][qy][dx] = u;
-               QQD1[qz][qy][dx] = v;
-               QQD2[qz][qy][dx] = w;
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qz,z,Q1D)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
          {
-            MFEM_FOREACH_THREAD(dx,x,D1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               double u = 0.0;
-               double v = 0.0;
-               double w = 0.0;
-               for (int qy = 0; qy < Q1D; ++qy)
+               MFEM_FOREACH_THREAD(dx,x,D1D)
                {
-                  u += QQD0[qz][qy][dx] * Bt[dy][qy];
-                  v += QQD1[qz][qy][dx] * Gt[dy][qy];
-                  w += QQD2[qz][qy][dx] * Bt[dy][qy];
+                  double u = 0.0;
+                  double v = 0.0;
+                  double w = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     u += QQD0[qz][qy][dx] * Bt[dy][qy];
+                     v += QQD1[qz][qy][dx] * Gt[dy][qy];
+                     w += QQD2[qz][qy][dx] * Bt[dy][qy];
+                  }
+                  QDD0[qz][dy][dx] = u;
+                  QDD1[qz][dy][dx] = v;
+                  QDD2[qz][dy][dx] = w;
                }
-               QDD0[qz][dy][dx] = u;
-               QDD1[qz][dy][dx] = v;
-               QDD2[qz][dy][dx] = w;
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dz,z,D1D)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
          {
-            MFEM_FOREACH_THREAD(dx,x,D1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               double u = 0.0;
-               double v = 0.0;
-               double w = 0.0;
-               for (int qz = 0; qz < Q1D; ++qz)
+               MFEM_FOREACH_THREAD(dx,x,D1D)
                {
-                  u += QDD0[qz][dy][dx] * Bt[dz][qz];
-                  v += QDD1[qz][dy][dx] * Bt[dz][qz];
-                  w += QDD2[qz][dy][dx] * Gt[dz][qz];
+                  double u = 0.0;
+                  double v = 0.0;
+                  double w = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     u += QDD0[qz][dy][dx] * Bt[dz][qz];
+                     v += QDD1[qz][dy][dx] * Bt[dz][qz];
+                     w += QDD2[qz][dy][dx] * Gt[dz][qz];
+                  }
+                  y(dx,dy,dz,e,iv) += (u + v + w);
                }
-               y(dx,dy,dz,e) += (u + v + w);
             }
          }
+         MFEM_SYNC_THREAD;
       }
    });
 }
@@ -1503,7 +1613,8 @@ static void PADiffusionApply(const int dim,
                              const Array<double> &Gt,
                              const Vector &D,
                              const Vector &X,
-                             Vector &Y)
+                             Vector &Y,
+                             const int NV = 1)
 {
 #ifdef MFEM_USE_OCCA
    if (DeviceCanUseOcca())
@@ -1525,29 +1636,44 @@ static void PADiffusionApply(const int dim,
    {
       switch ((D1D << 4 ) | Q1D)
       {
-         case 0x22: return SmemPADiffusionApply2D<2,2,16>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x33: return SmemPADiffusionApply2D<3,3,16>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x44: return SmemPADiffusionApply2D<4,4,8>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x55: return SmemPADiffusionApply2D<5,5,8>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x66: return SmemPADiffusionApply2D<6,6,4>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,B,G,Bt,Gt,D,X,Y);
-         default:   return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x22:
+            return SmemPADiffusionApply2D<2,2,16>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x33:
+            return SmemPADiffusionApply2D<3,3,16>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x44:
+            return SmemPADiffusionApply2D<4,4,8>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x55:
+            return SmemPADiffusionApply2D<5,5,8>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x66:
+            return SmemPADiffusionApply2D<6,6,4>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x77:
+            return SmemPADiffusionApply2D<7,7,4>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x88:
+            return SmemPADiffusionApply2D<8,8,2>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x99:
+            return SmemPADiffusionApply2D<9,9,2>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         default:   return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D,NV);
       }
    }
    else if (dim == 3)
    {
       switch ((D1D << 4 ) | Q1D)
       {
-         case 0x23: return SmemPADiffusionApply3D<2,3>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x34: return SmemPADiffusionApply3D<3,4>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x45: return SmemPADiffusionApply3D<4,5>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x56: return SmemPADiffusionApply3D<5,6>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x67: return SmemPADiffusionApply3D<6,7>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x78: return SmemPADiffusionApply3D<7,8>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x89: return SmemPADiffusionApply3D<8,9>(NE,B,G,Bt,Gt,D,X,Y);
-         default:   return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x23:
+            return SmemPADiffusionApply3D<2,3>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x34:
+            return SmemPADiffusionApply3D<3,4>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x45:
+            return SmemPADiffusionApply3D<4,5>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x56:
+            return SmemPADiffusionApply3D<5,6>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x67:
+            return SmemPADiffusionApply3D<6,7>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x78:
+            return SmemPADiffusionApply3D<7,8>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x89:
+            return SmemPADiffusionApply3D<8,9>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         default:   return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D,NV);
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -1585,6 +1711,11 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
    else
 #endif
+   if (simplex_maps)
+   {
+      simplex_maps->DiffusionApply(ne, pa_data, x, y);
+   }
+   else
    {
       PADiffusionApply(dim, dofs1D, quad1D, ne,
                        maps->B, maps->G, maps->Bt, maps->Gt,
@@ -1592,4 +1723,24 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+void DiffusionIntegrator::AddMultPAMulti(const MultiVector &x,
+                                         MultiVector &y) const
+{
+   bool fallback = DeviceCanUseCeed() || simplex_maps ||
+                   (dim != 2 && dim != 3);
+#ifdef MFEM_USE_OCCA
+   fallback = fallback || DeviceCanUseOcca();
+#endif
+   if (fallback)
+   {
+      BilinearFormIntegrator::AddMultPAMulti(x, y);
+      return;
+   }
+   // The kernels loop over the vectors inside each element, so that the
+   // quadrature data is read once for all vectors
+   PADiffusionApply(dim, dofs1D, quad1D, ne,
+                    maps->B, maps->G, maps->Bt, maps->Gt,
+                    pa_data, x, y, x.NumVectors());
+}
+
 } // namespace mfem
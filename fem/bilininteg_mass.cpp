@@ -44,12 +44,20 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
 #endif
    dim = mesh->Dimension();
    ne = fes.GetMesh()->GetNE();
+   delete simplex_maps;
+   simplex_maps = NULL;
+   if (SimplexPAMaps::Supports(el))
+   {
+      // Sum factorization in collapsed coordinates, see SimplexPAMaps
+      simplex_maps = new SimplexPAMaps(el, ir->GetOrder());
+      ir = simplex_maps->IntRule;
+   }
    nq = ir->GetNPoints();
    geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
                                     GeometricFactors::JACOBIANS);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
-   dofs1D = maps->ndof;
-   quad1D = maps->nqpt;
+   maps = simplex_maps ? NULL : &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = simplex_maps ? el.GetOrder() + 1 : maps->ndof;
+   quad1D = simplex_maps ? simplex_maps->nqpt1D : maps->nqpt;
    pa_data.SetSize(ne*nq, Device::GetMemoryType());
    Vector coeff;
    if (Q == nullptr)
@@ -64,16 +72,7 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->Project(coeff, *mesh, *ir);
    }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
@@ -441,6 +440,11 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (pa_data.Size()==0) { SetupPA(*fespace, true); }
+   if (simplex_maps)
+   {
+      simplex_maps->MassDiagonal(ne, pa_data, diag);
+      return;
+   }
    PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
 }
 
@@ -545,7 +549,8 @@ static void PAMassApply2D(const int NE,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
-                          const int q1d = 0)
+                          const int q1d = 0,
+                          const int NV = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -554,8 +559,8 @@ static void PAMassApply2D(const int NE,
    auto B = Reshape(b_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE, NV);
    MFEM_FORALL(e, NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
@@ -563,66 +568,69 @@ static void PAMassApply2D(const int NE,
       // the following variables are evaluated at compile time
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xy[max_Q1D][max_Q1D];
-      for (int qy = 0; qy < Q1D; ++qy)
+      for (int v = 0; v < NV; ++v)
       {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            sol_xy[qy][qx] = 0.0;
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         double sol_x[max_Q1D];
+         double sol_xy[max_Q1D][max_Q1D];
          for (int qy = 0; qy < Q1D; ++qy)
          {
-            sol_x[qy] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] = 0.0;
+            }
          }
-         for (int dx = 0; dx < D1D; ++dx)
+         for (int dy = 0; dy < D1D; ++dy)
          {
-            const double s = X(dx,dy,e);
-            for (int qx = 0; qx < Q1D; ++qx)
+            double sol_x[max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               sol_x[qy] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
             {
-               sol_x[qx] += B(qx,dx)* s;
+               const double s = X(dx,dy,e,v);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] += B(qx,dx)* s;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double d2q = B(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] += d2q * sol_x[qx];
+               }
             }
          }
          for (int qy = 0; qy < Q1D; ++qy)
          {
-            const double d2q = B(qy,dy);
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               sol_xy[qy][qx] += d2q * sol_x[qx];
+               sol_xy[qy][qx] *= D(qx,qy,e);
             }
          }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            sol_xy[qy][qx] *= D(qx,qy,e);
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         double sol_x[max_D1D];
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            sol_x[dx] = 0.0;
-         }
-         for (int qx = 0; qx < Q1D; ++qx)
+         for (int qy = 0; qy < Q1D; ++qy)
          {
-            const double s = sol_xy[qy][qx];
+            double sol_x[max_D1D];
             for (int dx = 0; dx < D1D; ++dx)
             {
-               sol_x[dx] += Bt(dx,qx) * s;
+               sol_x[dx] = 0.0;
             }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            const double q2d = Bt(dy,qy);
-            for (int dx = 0; dx < D1D; ++dx)
+            for (int qx = 0; qx < Q1D; ++qx)
             {
-               Y(dx,dy,e) += q2d * sol_x[dx];
+               const double s = sol_xy[qy][qx];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] += Bt(dx,qx) * s;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double q2d = Bt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,e,v) += q2d * sol_x[dx];
+               }
             }
          }
       }
@@ -637,7 +645,8 @@ static void SmemPAMassApply2D(const int NE,
                               const Vector &x_,
                               Vector &y_,
                               const int d1d = 0,
-                              const int q1d = 0)
+                              const int q1d = 0,
+                              const int NV = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -648,8 +657,8 @@ static void SmemPAMassApply2D(const int NE,
    MFEM_VERIFY(Q1D <= MQ1, "");
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE, NV);
    MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
    {
       const int tidz = MFEM_THREAD_ID(z);
@@ -668,85 +677,89 @@ static void SmemPAMassApply2D(const int NE,
       double (*DQ)[MQ1] = (double (*)[MQ1]) (sm1 + tidz);
       double (*QQ)[MQ1] = (double (*)[MQ1]) (sm0 + tidz);
       double (*QD)[MD1] = (double (*)[MD1]) (sm1 + tidz);
-      MFEM_FOREACH_THREAD(dy,y,D1D)
+      for (int iv = 0; iv < NV; ++iv)
       {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
+         MFEM_FOREACH_THREAD(dy,y,D1D)
          {
-            X[dy][dx] = x(dx,dy,e);
+            MFEM_FOREACH_THREAD(dx,x,D1D)
+            {
+               X[dy][dx] = x(dx,dy,e,iv);
+            }
          }
-      }
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         if (tidz == 0)
          {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               B[q][dy] = b(q,dy);
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  B[q][dy] = b(q,dy);
+               }
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dy,y,D1D)
          {
-            double dq = 0.0;
-            for (int dx = 0; dx < D1D; ++dx)
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
             {
-               dq += X[dy][dx] * B[qx][dx];
+               double dq = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  dq += X[dy][dx] * B[qx][dx];
+               }
+               DQ[dy][qx] = dq;
             }
-            DQ[dy][qx] = dq;
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
          {
-            double qq = 0.0;
-            for (int dy = 0; dy < D1D; ++dy)
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
             {
-               qq += DQ[dy][qx] * B[qy][dy];
+               double qq = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  qq += DQ[dy][qx] * B[qy][dy];
+               }
+               QQ[qy][qx] = qq * D(qx, qy, e);
             }
-            QQ[qy][qx] = qq * D(qx, qy, e);
          }
-      }
-      MFEM_SYNC_THREAD;
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_SYNC_THREAD;
+         if (tidz == 0)
          {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               Bt[dy][q] = b(q,dy);
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  Bt[dy][q] = b(q,dy);
+               }
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
          {
-            double dq = 0.0;
-            for (int qx = 0; qx < Q1D; ++qx)
+            MFEM_FOREACH_THREAD(dx,x,D1D)
             {
-               dq += QQ[qy][qx] * Bt[dx][qx];
+               double dq = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  dq += QQ[qy][qx] * Bt[dx][qx];
+               }
+               QD[qy][dx] = dq;
             }
-            QD[qy][dx] = dq;
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dy,y,D1D)
          {
-            double dd = 0.0;
-            for (int qy = 0; qy < Q1D; ++qy)
+            MFEM_FOREACH_THREAD(dx,x,D1D)
             {
-               dd += (QD[qy][dx] * Bt[dy][qy]);
+               double dd = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  dd += (QD[qy][dx] * Bt[dy][qy]);
+               }
+               Y(dx, dy,e,iv) += dd;
             }
-            Y(dx, dy, e) += dd;
          }
+         MFEM_SYNC_THREAD;
       }
    });
 }
@@ -759,7 +772,8 @@ static void PAMassApply3D(const int NE,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
-                          const int q1d = 0)
+                          const int q1d = 0,
+                          const int NV = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -768,123 +782,126 @@ static void PAMassApply3D(const int NE,
    auto B = Reshape(b_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE, NV);
    MFEM_FORALL(e, NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
-      for (int qz = 0; qz < Q1D; ++qz)
+      for (int v = 0; v < NV; ++v)
       {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xyz[qz][qy][qx] = 0.0;
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         double sol_xy[max_Q1D][max_Q1D];
-         for (int qy = 0; qy < Q1D; ++qy)
+         double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
+         for (int qz = 0; qz < Q1D; ++qz)
          {
-            for (int qx = 0; qx < Q1D; ++qx)
+            for (int qy = 0; qy < Q1D; ++qy)
             {
-               sol_xy[qy][qx] = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[qz][qy][qx] = 0.0;
+               }
             }
          }
-         for (int dy = 0; dy < D1D; ++dy)
+         for (int dz = 0; dz < D1D; ++dz)
          {
-            double sol_x[max_Q1D];
-            for (int qx = 0; qx < Q1D; ++qx)
+            double sol_xy[max_Q1D][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
             {
-               sol_x[qx] = 0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] = 0.0;
+               }
             }
-            for (int dx = 0; dx < D1D; ++dx)
+            for (int dy = 0; dy < D1D; ++dy)
             {
-               const double s = X(dx,dy,dz,e);
+               double sol_x[max_Q1D];
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  sol_x[qx] += B(qx,dx) * s;
+                  sol_x[qx] = 0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = X(dx,dy,dz,e,v);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_x[qx] += B(qx,dx) * s;
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy = B(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xy[qy][qx] += wy * sol_x[qx];
+                  }
                }
             }
-            for (int qy = 0; qy < Q1D; ++qy)
+            for (int qz = 0; qz < Q1D; ++qz)
             {
-               const double wy = B(qy,dy);
-               for (int qx = 0; qx < Q1D; ++qx)
+               const double wz = B(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
                {
-                  sol_xy[qy][qx] += wy * sol_x[qx];
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
+                  }
                }
             }
          }
          for (int qz = 0; qz < Q1D; ++qz)
          {
-            const double wz = B(qz,dz);
             for (int qy = 0; qy < Q1D; ++qy)
             {
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
+                  sol_xyz[qz][qy][qx] *= D(qx,qy,qz,e);
                }
             }
          }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xyz[qz][qy][qx] *= D(qx,qy,qz,e);
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         double sol_xy[max_D1D][max_D1D];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_xy[dy][dx] = 0;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
+         for (int qz = 0; qz < Q1D; ++qz)
          {
-            double sol_x[max_D1D];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_x[dx] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
+            double sol_xy[max_D1D][max_D1D];
+            for (int dy = 0; dy < D1D; ++dy)
             {
-               const double s = sol_xyz[qz][qy][qx];
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  sol_x[dx] += Bt(dx,qx) * s;
+                  sol_xy[dy][dx] = 0;
                }
             }
-            for (int dy = 0; dy < D1D; ++dy)
+            for (int qy = 0; qy < Q1D; ++qy)
             {
-               const double wy = Bt(dy,qy);
+               double sol_x[max_D1D];
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  sol_xy[dy][dx] += wy * sol_x[dx];
+                  sol_x[dx] = 0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double s = sol_xyz[qz][qy][qx];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_x[dx] += Bt(dx,qx) * s;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy = Bt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xy[dy][dx] += wy * sol_x[dx];
+                  }
                }
             }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            const double wz = Bt(dz,qz);
-            for (int dy = 0; dy < D1D; ++dy)
+            for (int dz = 0; dz < D1D; ++dz)
             {
-               for (int dx = 0; dx < D1D; ++dx)
+               const double wz = Bt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
                {
-                  Y(dx,dy,dz,e) += wz * sol_xy[dy][dx];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     Y(dx,dy,dz,e,v) += wz * sol_xy[dy][dx];
+                  }
                }
             }
          }
@@ -900,7 +917,8 @@ static void SmemPAMassApply3D(const int NE,
                               const Vector &x_,
                               Vector &y_,
                               const int d1d = 0,
-                              const int q1d = 0)
+                              const int q1d = 0,
+                              const int NV = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -910,8 +928,8 @@ static void SmemPAMassApply3D(const int NE,
    MFEM_VERIFY(Q1D <= M1Q, "");
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE, NV);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE, NV);
    MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
    {
       const int tidz = MFEM_THREAD_ID(z);
@@ -931,132 +949,136 @@ static void SmemPAMassApply3D(const int NE,
       double (*QQQ)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) sm1;
       double (*QQD)[MQ1][MD1] = (double (*)[MQ1][MD1]) sm0;
       double (*QDD)[MD1][MD1] = (double (*)[MD1][MD1]) sm1;
-      MFEM_FOREACH_THREAD(dz,z,D1D)
+      for (int iv = 0; iv < NV; ++iv)
       {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_FOREACH_THREAD(dz,z,D1D)
          {
-            MFEM_FOREACH_THREAD(dx,x,D1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               X[dz][dy][dx] = x(dx,dy,dz,e);
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  X[dz][dy][dx] = x(dx,dy,dz,e,iv);
+               }
             }
          }
-      }
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(d,y,D1D)
+         if (tidz == 0)
          {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
+            MFEM_FOREACH_THREAD(d,y,D1D)
             {
-               B[q][d] = b(q,d);
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  B[q][d] = b(q,d);
+               }
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dz,z,D1D)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
          {
-            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               double u = 0.0;
-               for (int dx = 0; dx < D1D; ++dx)
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
                {
-                  u += X[dz][dy][dx] * B[qx][dx];
+                  double u = 0.0;
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     u += X[dz][dy][dx] * B[qx][dx];
+                  }
+                  DDQ[dz][dy][qx] = u;
                }
-               DDQ[dz][dy][qx] = u;
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dz,z,D1D)
-      {
-         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
          {
-            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
             {
-               double u = 0.0;
-               for (int dy = 0; dy < D1D; ++dy)
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
                {
-                  u += DDQ[dz][dy][qx] * B[qy][dy];
+                  double u = 0.0;
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     u += DDQ[dz][dy][qx] * B[qy][dy];
+                  }
+                  DQQ[dz][qy][qx] = u;
                }
-               DQQ[dz][qy][qx] = u;
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qz,z,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
          {
-            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
             {
-               double u = 0.0;
-               for (int dz = 0; dz < D1D; ++dz)
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
                {
-                  u += DQQ[dz][qy][qx] * B[qz][dz];
+                  double u = 0.0;
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     u += DQQ[dz][qy][qx] * B[qz][dz];
+                  }
+                  QQQ[qz][qy][qx] = u * d(qx,qy,qz,e);
                }
-               QQQ[qz][qy][qx] = u * d(qx,qy,qz,e);
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(d,y,D1D)
+         MFEM_SYNC_THREAD;
+         if (tidz == 0)
          {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
+            MFEM_FOREACH_THREAD(d,y,D1D)
             {
-               Bt[d][q] = b(q,d);
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  Bt[d][q] = b(q,d);
+               }
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qz,z,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
          {
-            MFEM_FOREACH_THREAD(dx,x,D1D)
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
             {
-               double u = 0.0;
-               for (int qx = 0; qx < Q1D; ++qx)
+               MFEM_FOREACH_THREAD(dx,x,D1D)
                {
-                  u += QQQ[qz][qy][qx] * Bt[dx][qx];
+                  double u = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     u += QQQ[qz][qy][qx] * Bt[dx][qx];
+                  }
+                  QQD[qz][qy][dx] = u;
                }
-               QQD[qz][qy][dx] = u;
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qz,z,Q1D)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
          {
-            MFEM_FOREACH_THREAD(dx,x,D1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               double u = 0.0;
-               for (int qy = 0; qy < Q1D; ++qy)
+               MFEM_FOREACH_THREAD(dx,x,D1D)
                {
-                  u += QQD[qz][qy][dx] * Bt[dy][qy];
+                  double u = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     u += QQD[qz][qy][dx] * Bt[dy][qy];
+                  }
+                  QDD[qz][dy][dx] = u;
                }
-               QDD[qz][dy][dx] = u;
             }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dz,z,D1D)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
          {
-            MFEM_FOREACH_THREAD(dx,x,D1D)
+            MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               double u = 0.0;
-               for (int qz = 0; qz < Q1D; ++qz)
+               MFEM_FOREACH_THREAD(dx,x,D1D)
                {
-                  u += QDD[qz][dy][dx] * Bt[dz][qz];
+                  double u = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     u += QDD[qz][dy][dx] * Bt[dz][qz];
+                  }
+                  y(dx,dy,dz,e,iv) += u;
                }
-               y(dx,dy,dz,e) += u;
             }
          }
+         MFEM_SYNC_THREAD;
       }
    });
 }
@@ -1069,7 +1091,8 @@ static void PAMassApply(const int dim,
                         const Array<double> &Bt,
                         const Vector &D,
                         const Vector &X,
-                        Vector &Y)
+                        Vector &Y,
+                        const int NV = 1)
 {
 #ifdef MFEM_USE_OCCA
    if (DeviceCanUseOcca())
@@ -1089,29 +1112,29 @@ static void PAMassApply(const int dim,
    {
       switch ((D1D << 4) | Q1D)
       {
-         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y);
-         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y);
-         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y);
-         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y);
-         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y);
-         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
-         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
-         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y,0,0,NV);
+         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D,NV);
       }
    }
    else if (dim == 3)
    {
       switch ((D1D << 4) | Q1D)
       {
-         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y);
-         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y);
-         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y);
-         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y);
-         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
-         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y,0,0,NV);
+         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D,NV);
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -1148,9 +1171,33 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
    else
 #endif
+   if (simplex_maps)
+   {
+      simplex_maps->MassApply(ne, pa_data, x, y);
+   }
+   else
    {
       PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
    }
 }
 
+void MassIntegrator::AddMultPAMulti(const MultiVector &x,
+                                    MultiVector &y) const
+{
+   bool fallback = DeviceCanUseCeed() || simplex_maps ||
+                   (dim != 2 && dim != 3);
+#ifdef MFEM_USE_OCCA
+   fallback = fallback || DeviceCanUseOcca();
+#endif
+   if (fallback)
+   {
+      BilinearFormIntegrator::AddMultPAMulti(x, y);
+      return;
+   }
+   // The kernels loop over the vectors inside each element, so that the
+   // quadrature data is read once for all vectors
+   PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y,
+               x.NumVectors());
+}
+
 } // namespace mfem
@@ -0,0 +1,689 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include <mutex>
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA on simplices, with sum factorization in collapsed coordinates
+
+// Maximum number of 1D Bernstein polynomials (p+1) and of collapsed points in
+// each direction supported by the kernels below. The collapsed rules must also
+// fit in the QuadratureInterpolator used by Mesh::GetGeometricFactors(), i.e.
+// have at most 100 points in 2D and 1000 points in 3D.
+static constexpr int MAX_SIMPLEX_D1D = 9;
+static constexpr int MAX_SIMPLEX_Q1D = 10;
+
+static double Binomial(const int n, const int k)
+{
+   double r = 1.0;
+   for (int i = 1; i <= k; i++) { r = (r*(n - k + i))/i; }
+   return r;
+}
+
+bool SimplexPAMaps::Supports(const FiniteElement &fe)
+{
+   return ((fe.GetGeomType() == Geometry::TRIANGLE ||
+            fe.GetGeomType() == Geometry::TETRAHEDRON) &&
+           fe.GetRangeType() == FiniteElement::SCALAR &&
+           fe.GetMapType() == FiniteElement::VALUE);
+}
+
+const IntegrationRule &SimplexPAMaps::GetCollapsedRule(Geometry::Type geom,
+                                                       int q1d)
+{
+   MFEM_VERIFY(geom == Geometry::TRIANGLE || geom == Geometry::TETRAHEDRON,
+               "invalid geometry: " << geom);
+   struct RuleTable
+   {
+      Array<IntegrationRule *> rules[2];
+      ~RuleTable()
+      {
+         for (int g = 0; g < 2; g++)
+         {
+            for (int i = 0; i < rules[g].Size(); i++) { delete rules[g][i]; }
+         }
+      }
+   };
+   static RuleTable table;
+   static std::mutex mtx;
+
+   std::lock_guard<std::mutex> lock(mtx);
+   const int dim = (geom == Geometry::TRIANGLE) ? 2 : 3;
+   Array<IntegrationRule *> &rules = table.rules[dim-2];
+   if (rules.Size() <= q1d) { rules.SetSize(q1d + 1, NULL); }
+   if (rules[q1d]) { return *rules[q1d]; }
+
+   IntegrationRule ir1d;
+   QuadratureFunctions1D quad_func;
+   quad_func.GaussLegendre(q1d, &ir1d);
+   const int nz = (dim == 3) ? q1d : 1;
+   IntegrationRule *ir = new IntegrationRule(q1d*q1d*nz);
+   for (int k = 0; k < nz; k++)
+   {
+      const IntegrationPoint &ip3 = ir1d.IntPoint(k);
+      const double t3 = (dim == 3) ? ip3.x : 0.0;
+      const double w3 = (dim == 3) ? ip3.weight : 1.0;
+      for (int j = 0; j < q1d; j++)
+      {
+         const double t2 = ir1d.IntPoint(j).x, w2 = ir1d.IntPoint(j).weight;
+         for (int i = 0; i < q1d; i++)
+         {
+            const double t1 = ir1d.IntPoint(i).x, w1 = ir1d.IntPoint(i).weight;
+            IntegrationPoint &ip = ir->IntPoint(i + q1d*(j + q1d*k));
+            // Jacobian of the collapsed map: (1-t1)^{dim-1} (1-t2)^{dim-2}
+            const double w = (dim == 3) ?
+                             w1*w2*w3*(1.0 - t1)*(1.0 - t1)*(1.0 - t2) :
+                             w1*w2*(1.0 - t1);
+            ip.Set(t1, (1.0 - t1)*t2, (1.0 - t1)*(1.0 - t2)*t3, w);
+         }
+      }
+   }
+   ir->SetOrder(2*q1d - dim);
+   ir->GetWeights(); // create the weights before the rule is shared
+   rules[q1d] = ir;
+   return *ir;
+}
+
+SimplexPAMaps::SimplexPAMaps(const FiniteElement &fe, int ir_order)
+{
+   MFEM_VERIFY(Supports(fe), "the element is not supported");
+   FE = &fe;
+   dim = fe.GetDim();
+   order = fe.GetOrder();
+   ndof = fe.GetDof();
+   const int p = order, D = p + 1;
+   const int nbern = (dim == 2) ? (D*(D + 1))/2 : (D*(D + 1)*(D + 2))/6;
+   MFEM_VERIFY(ndof == nbern, "the element basis must span the polynomials "
+               "of degree " << p);
+   // Gauss-Legendre with q points is exact for degree 2q-1, and the Jacobian
+   // of the collapsed map adds dim-1 to the degree in t1.
+   nqpt1D = (ir_order + dim)/2 + 1;
+   MFEM_VERIFY(D <= MAX_SIMPLEX_D1D && nqpt1D <= MAX_SIMPLEX_Q1D,
+               "the order is too high: p = " << p << ", q1d = " << nqpt1D);
+   IntRule = &GetCollapsedRule(fe.GetGeomType(), nqpt1D);
+
+   const int Q = nqpt1D;
+   IntegrationRule ir1d;
+   QuadratureFunctions1D quad_func;
+   quad_func.GaussLegendre(Q, &ir1d);
+   B1d.SetSize(Q*D*D);
+   B1d = 0.0;
+   for (int k = 0; k <= p; k++)
+   {
+      for (int a = 0; a <= k; a++)
+      {
+         const double c = Binomial(k, a);
+         for (int q = 0; q < Q; q++)
+         {
+            const double t = ir1d.IntPoint(q).x;
+            B1d[q + Q*(a + D*k)] = c*pow(t, a)*pow(1.0 - t, k - a);
+         }
+      }
+   }
+
+   // Express the element basis in the Bernstein basis, using the values of
+   // both at the (shifted, unisolvent) lattice points (a + 1)/(p + dim + 1).
+   Array<int> slots(nbern);
+   DenseMatrix V(nbern), S(nbern, ndof);
+   Vector shape(ndof);
+   const int nz = (dim == 3) ? D : 1;
+   for (int a3 = 0, j = 0; a3 < nz; a3++)
+   {
+      for (int a2 = 0; a2 + a3 <= p; a2++)
+      {
+         for (int a1 = 0; a1 + a2 + a3 <= p; a1++, j++)
+         {
+            slots[j] = a1 + D*(a2 + D*a3);
+            const double h = 1.0/(p + dim + 1);
+            IntegrationPoint ip;
+            ip.Set3((a1 + 1)*h, (a2 + 1)*h, (dim == 3) ? (a3 + 1)*h : 0.0);
+            fe.CalcShape(ip, shape);
+            for (int i = 0; i < ndof; i++) { S(j,i) = shape(i); }
+            const double l[4] = { 1.0 - ip.x - ip.y - ip.z, ip.x, ip.y, ip.z };
+            for (int b3 = 0, b = 0; b3 < nz; b3++)
+            {
+               for (int b2 = 0; b2 + b3 <= p; b2++)
+               {
+                  for (int b1 = 0; b1 + b2 + b3 <= p; b1++, b++)
+                  {
+                     const int b0 = p - b1 - b2 - b3;
+                     V(j,b) = Binomial(p, b1)*Binomial(p - b1, b2)*
+                              Binomial(p - b1 - b2, b3)*
+                              pow(l[0], b0)*pow(l[1], b1)*pow(l[2], b2)*
+                              (dim == 3 ? pow(l[3], b3) : 1.0);
+                  }
+               }
+            }
+         }
+      }
+   }
+   DenseMatrix Tm(nbern, ndof), R(nbern, ndof);
+   {
+      DenseMatrixInverse V_inv(V);
+      V_inv.Mult(S, Tm);
+   }
+   mfem::Mult(V, Tm, R);
+   R -= S;
+   MFEM_VERIFY(R.MaxMaxNorm() < 1e-10*S.MaxMaxNorm(), "the element basis must "
+               "span the polynomials of degree " << p);
+
+   // Check if the change of basis is a permutation
+   bern_index.SetSize(ndof);
+   bool perm = true;
+   for (int i = 0; perm && i < ndof; i++)
+   {
+      int nnz = 0;
+      for (int b = 0; b < nbern; b++)
+      {
+         if (std::abs(Tm(b,i)) > 1e-10)
+         {
+            nnz++;
+            bern_index[i] = slots[b];
+            perm = perm && std::abs(Tm(b,i) - 1.0) < 1e-10;
+         }
+      }
+      perm = perm && (nnz == 1);
+   }
+   if (!perm)
+   {
+      bern_index = slots;
+      T.SetSize(nbern*ndof);
+      for (int i = 0; i < nbern*ndof; i++) { T[i] = Tm.Data()[i]; }
+   }
+}
+
+#define B1(q,a,k) B[(q) + Q*((a) + D*(k))]
+
+// Values at the collapsed points of the polynomial of degree m with Bernstein
+// coefficients c (dense layout D x D).
+template <int MD, int MQ>
+MFEM_HOST_DEVICE static inline
+void CollapsedEval2D(const int m, const int D, const int Q, const double *B,
+                     const double *c, double *u)
+{
+   double A[MD][MQ];
+   for (int a1 = 0; a1 <= m; a1++)
+   {
+      const int k = m - a1;
+      for (int q2 = 0; q2 < Q; q2++)
+      {
+         double s = 0.0;
+         for (int a2 = 0; a2 <= k; a2++) { s += B1(q2,a2,k)*c[a1 + D*a2]; }
+         A[a1][q2] = s;
+      }
+   }
+   for (int q2 = 0; q2 < Q; q2++)
+   {
+      for (int q1 = 0; q1 < Q; q1++)
+      {
+         double s = 0.0;
+         for (int a1 = 0; a1 <= m; a1++) { s += B1(q1,a1,m)*A[a1][q2]; }
+         u[q1 + Q*q2] = s;
+      }
+   }
+}
+
+// Transpose of CollapsedEval2D: set the coefficients c with |a| <= m.
+template <int MD, int MQ>
+MFEM_HOST_DEVICE static inline
+void CollapsedEvalT2D(const int m, const int D, const int Q, const double *B,
+                      const double *u, double *c)
+{
+   double A[MD][MQ];
+   for (int a1 = 0; a1 <= m; a1++)
+   {
+      for (int q2 = 0; q2 < Q; q2++)
+      {
+         double s = 0.0;
+         for (int q1 = 0; q1 < Q; q1++) { s += B1(q1,a1,m)*u[q1 + Q*q2]; }
+         A[a1][q2] = s;
+      }
+   }
+   for (int a1 = 0; a1 <= m; a1++)
+   {
+      const int k = m - a1;
+      for (int a2 = 0; a2 <= k; a2++)
+      {
+         double s = 0.0;
+         for (int q2 = 0; q2 < Q; q2++) { s += B1(q2,a2,k)*A[a1][q2]; }
+         c[a1 + D*a2] = s;
+      }
+   }
+}
+
+// Values at the collapsed points of the polynomial of degree m with Bernstein
+// coefficients c (dense layout D x D x D).
+template <int MD, int MQ>
+MFEM_HOST_DEVICE static inline
+void CollapsedEval3D(const int m, const int D, const int Q, const double *B,
+                     const double *c, double *u)
+{
+   double A[MD][MD][MQ];
+   double AA[MD][MQ][MQ];
+   for (int a1 = 0; a1 <= m; a1++)
+   {
+      for (int a2 = 0; a1 + a2 <= m; a2++)
+      {
+         const int k = m - a1 - a2;
+         for (int q3 = 0; q3 < Q; q3++)
+         {
+            double s = 0.0;
+            for (int a3 = 0; a3 <= k; a3++)
+            {
+               s += B1(q3,a3,k)*c[a1 + D*(a2 + D*a3)];
+            }
+            A[a1][a2][q3] = s;
+         }
+      }
+   }
+   for (int a1 = 0; a1 <= m; a1++)
+   {
+      const int k = m - a1;
+      for (int q3 = 0; q3 < Q; q3++)
+      {
+         for (int q2 = 0; q2 < Q; q2++)
+         {
+            double s = 0.0;
+            for (int a2 = 0; a2 <= k; a2++) { s += B1(q2,a2,k)*A[a1][a2][q3]; }
+            AA[a1][q2][q3] = s;
+         }
+      }
+   }
+   for (int q3 = 0; q3 < Q; q3++)
+   {
+      for (int q2 = 0; q2 < Q; q2++)
+      {
+         for (int q1 = 0; q1 < Q; q1++)
+         {
+            double s = 0.0;
+            for (int a1 = 0; a1 <= m; a1++) { s += B1(q1,a1,m)*AA[a1][q2][q3]; }
+            u[q1 + Q*(q2 + Q*q3)] = s;
+         }
+      }
+   }
+}
+
+// Transpose of CollapsedEval3D: set the coefficients c with |a| <= m.
+template <int MD, int MQ>
+MFEM_HOST_DEVICE static inline
+void CollapsedEvalT3D(const int m, const int D, const int Q, const double *B,
+                      const double *u, double *c)
+{
+   double A[MD][MD][MQ];
+   double AA[MD][MQ][MQ];
+   for (int a1 = 0; a1 <= m; a1++)
+   {
+      for (int q3 = 0; q3 < Q; q3++)
+      {
+         for (int q2 = 0; q2 < Q; q2++)
+         {
+            double s = 0.0;
+            for (int q1 = 0; q1 < Q; q1++)
+            {
+               s += B1(q1,a1,m)*u[q1 + Q*(q2 + Q*q3)];
+            }
+            AA[a1][q2][q3] = s;
+         }
+      }
+   }
+   for (int a1 = 0; a1 <= m; a1++)
+   {
+      const int k = m - a1;
+      for (int a2 = 0; a2 <= k; a2++)
+      {
+         for (int q3 = 0; q3 < Q; q3++)
+         {
+            double s = 0.0;
+            for (int q2 = 0; q2 < Q; q2++) { s += B1(q2,a2,k)*AA[a1][q2][q3]; }
+            A[a1][a2][q3] = s;
+         }
+      }
+   }
+   for (int a1 = 0; a1 <= m; a1++)
+   {
+      for (int a2 = 0; a1 + a2 <= m; a2++)
+      {
+         const int k = m - a1 - a2;
+         for (int a3 = 0; a3 <= k; a3++)
+         {
+            double s = 0.0;
+            for (int q3 = 0; q3 < Q; q3++) { s += B1(q3,a3,k)*A[a1][a2][q3]; }
+            c[a1 + D*(a2 + D*a3)] = s;
+         }
+      }
+   }
+}
+
+#undef B1
+
+template <int DIM, int MD, int MQ>
+MFEM_HOST_DEVICE static inline
+void CollapsedEval(const int m, const int D, const int Q, const double *B,
+                   const double *c, double *u)
+{
+   if (DIM == 2) { CollapsedEval2D<MD,MQ>(m, D, Q, B, c, u); }
+   else { CollapsedEval3D<MD,MQ>(m, D, Q, B, c, u); }
+}
+
+template <int DIM, int MD, int MQ>
+MFEM_HOST_DEVICE static inline
+void CollapsedEvalT(const int m, const int D, const int Q, const double *B,
+                    const double *u, double *c)
+{
+   if (DIM == 2) { CollapsedEvalT2D<MD,MQ>(m, D, Q, B, u, c); }
+   else { CollapsedEvalT3D<MD,MQ>(m, D, Q, B, u, c); }
+}
+
+// Bernstein coefficients c (dense layout D^dim) of the element dofs x_e, using
+// either the change of basis matrix T (if use_T) or the permutation idx.
+MFEM_HOST_DEVICE static inline
+void ToBernstein(const int ND, const int DD, const bool use_T,
+                 const double *T, const int *idx, const double *x_e,
+                 double *c)
+{
+   for (int j = 0; j < DD; j++) { c[j] = 0.0; }
+   for (int b = 0; b < ND; b++)
+   {
+      if (!use_T) { c[idx[b]] = x_e[b]; continue; }
+      double s = 0.0;
+      for (int i = 0; i < ND; i++) { s += T[b + ND*i]*x_e[i]; }
+      c[idx[b]] = s;
+   }
+}
+
+// Transpose of ToBernstein, adding the result to y_e.
+MFEM_HOST_DEVICE static inline
+void FromBernstein(const int ND, const bool use_T, const double *T,
+                   const int *idx, const double *c, double *y_e)
+{
+   for (int i = 0; i < ND; i++)
+   {
+      if (!use_T) { y_e[i] += c[idx[i]]; continue; }
+      double s = 0.0;
+      for (int b = 0; b < ND; b++) { s += T[b + ND*i]*c[idx[b]]; }
+      y_e[i] += s;
+   }
+}
+
+// Mass operator on one element. The local arrays are sized with the
+// compile-time bounds MD >= D and MQ >= Q for the dimension DIM.
+template <int DIM, int MD, int MQ>
+MFEM_HOST_DEVICE static inline
+void SimplexMassElement(const int P, const int ND, const int NQ, const int Q,
+                        const bool use_T, const double *B, const double *T,
+                        const int *idx, const double *d_e, const double *x_e,
+                        double *y_e)
+{
+   constexpr int MDD = (DIM == 2) ? MD*MD : MD*MD*MD;
+   constexpr int MQQ = (DIM == 2) ? MQ*MQ : MQ*MQ*MQ;
+   const int D = P + 1;
+   const int DD = (DIM == 2) ? D*D : D*D*D;
+   double c[MDD], u[MQQ];
+   ToBernstein(ND, DD, use_T, T, idx, x_e, c);
+   CollapsedEval<DIM,MD,MQ>(P, D, Q, B, c, u);
+   for (int q = 0; q < NQ; q++) { u[q] *= d_e[q]; }
+   CollapsedEvalT<DIM,MD,MQ>(P, D, Q, B, u, c);
+   FromBernstein(ND, use_T, T, idx, c, y_e);
+}
+
+// Diffusion operator on one element, see SimplexMassElement. The data d_e has
+// the layout (NQ, DIM*(DIM+1)/2).
+template <int DIM, int MD, int MQ>
+MFEM_HOST_DEVICE static inline
+void SimplexDiffusionElement(const int P, const int ND, const int NQ,
+                             const int Q, const bool use_T, const double *B,
+                             const double *T, const int *idx,
+                             const double *d_e, const double *x_e,
+                             double *y_e)
+{
+   constexpr int MDD = (DIM == 2) ? MD*MD : MD*MD*MD;
+   constexpr int MQQ = (DIM == 2) ? MQ*MQ : MQ*MQ*MQ;
+   const int D = P + 1;
+   const int DD = (DIM == 2) ? D*D : D*D*D;
+   double c[MDD], g[MDD];
+   double u[DIM][MQQ];
+   const int stride[3] = { 1, D, D*D };
+   const int nz = (DIM == 3) ? P : 1;
+   ToBernstein(ND, DD, use_T, T, idx, x_e, c);
+   // The reference derivative d/dx_k of the polynomial of degree p with
+   // coefficients c has the coefficients p (c[b + e_k] - c[b]), |b| < p.
+   for (int k = 0; k < DIM; k++)
+   {
+      for (int b3 = 0; b3 < nz; b3++)
+      {
+         for (int b2 = 0; b2 + b3 < P; b2++)
+         {
+            for (int b1 = 0; b1 + b2 + b3 < P; b1++)
+            {
+               const int j = b1 + D*(b2 + D*b3);
+               g[j] = P*(c[j + stride[k]] - c[j]);
+            }
+         }
+      }
+      CollapsedEval<DIM,MD,MQ>(P - 1, D, Q, B, g, u[k]);
+   }
+#define D_(q,s) d_e[(q) + NQ*(s)]
+   for (int q = 0; q < NQ; q++)
+   {
+      if (DIM == 2)
+      {
+         const double u0 = u[0][q], u1 = u[1][q];
+         u[0][q] = D_(q,0)*u0 + D_(q,1)*u1;
+         u[1][q] = D_(q,1)*u0 + D_(q,2)*u1;
+      }
+      else
+      {
+         const double u0 = u[0][q], u1 = u[1][q], u2 = u[DIM-1][q];
+         u[0][q] = D_(q,0)*u0 + D_(q,1)*u1 + D_(q,2)*u2;
+         u[1][q] = D_(q,1)*u0 + D_(q,3)*u1 + D_(q,4)*u2;
+         u[DIM-1][q] = D_(q,2)*u0 + D_(q,4)*u1 + D_(q,5)*u2;
+      }
+   }
+#undef D_
+   for (int j = 0; j < DD; j++) { c[j] = 0.0; }
+   for (int k = 0; k < DIM; k++)
+   {
+      CollapsedEvalT<DIM,MD,MQ>(P - 1, D, Q, B, u[k], g);
+      for (int b3 = 0; b3 < nz; b3++)
+      {
+         for (int b2 = 0; b2 + b3 < P; b2++)
+         {
+            for (int b1 = 0; b1 + b2 + b3 < P; b1++)
+            {
+               const int j = b1 + D*(b2 + D*b3);
+               c[j + stride[k]] += P*g[j];
+               c[j] -= P*g[j];
+            }
+         }
+      }
+   }
+   FromBernstein(ND, use_T, T, idx, c, y_e);
+}
+
+template <int DIM, int MD, int MQ>
+static void SimplexMassApply(const SimplexPAMaps &maps, const int NE,
+                             const Vector &d, const Vector &x, Vector &y)
+{
+   const int P = maps.order, ND = maps.ndof, Q = maps.nqpt1D;
+   const int NQ = maps.IntRule->GetNPoints();
+   MFEM_VERIFY(P + 1 <= MD && Q <= MQ, "");
+   const bool use_T = maps.T.Size() > 0;
+   auto B = maps.B1d.Read();
+   auto Tr = use_T ? maps.T.Read() : nullptr;
+   auto idx = maps.bern_index.Read();
+   auto D_ = Reshape(d.Read(), NQ, NE);
+   auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      SimplexMassElement<DIM,MD,MQ>(P, ND, NQ, Q, use_T, B, Tr, idx,
+                                    &D_(0,e), &X(0,e), &Y(0,e));
+   });
+}
+
+template <int DIM, int MD, int MQ>
+static void SimplexDiffusionApply(const SimplexPAMaps &maps, const int NE,
+                                  const Vector &d, const Vector &x, Vector &y)
+{
+   const int P = maps.order, ND = maps.ndof, Q = maps.nqpt1D;
+   const int NQ = maps.IntRule->GetNPoints();
+   const int NS = (DIM*(DIM + 1))/2;
+   MFEM_VERIFY(P + 1 <= MD && Q <= MQ, "");
+   const bool use_T = maps.T.Size() > 0;
+   auto B = maps.B1d.Read();
+   auto Tr = use_T ? maps.T.Read() : nullptr;
+   auto idx = maps.bern_index.Read();
+   auto D_ = Reshape(d.Read(), NQ, NS, NE);
+   auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      SimplexDiffusionElement<DIM,MD,MQ>(P, ND, NQ, Q, use_T, B, Tr, idx,
+                                         &D_(0,0,e), &X(0,e), &Y(0,e));
+   });
+}
+
+void SimplexPAMaps::MassApply(const int NE, const Vector &d, const Vector &x,
+                              Vector &y) const
+{
+   // Specialized kernels for the default rules on straight elements, with
+   // q1d = p + 2 (q1d = p + 3 for p = 5, 6 in 3D), and p <= 6; the generic
+   // kernels use the maximal sizes
+   const int id = ((order + 1) << 4) | nqpt1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x23: return SimplexMassApply<2,2,3>(*this, NE, d, x, y);
+         case 0x34: return SimplexMassApply<2,3,4>(*this, NE, d, x, y);
+         case 0x45: return SimplexMassApply<2,4,5>(*this, NE, d, x, y);
+         case 0x56: return SimplexMassApply<2,5,6>(*this, NE, d, x, y);
+         case 0x67: return SimplexMassApply<2,6,7>(*this, NE, d, x, y);
+         case 0x78: return SimplexMassApply<2,7,8>(*this, NE, d, x, y);
+         default:
+            return SimplexMassApply<2,MAX_SIMPLEX_D1D,MAX_SIMPLEX_Q1D>(
+                      *this, NE, d, x, y);
+      }
+   }
+   switch (id)
+   {
+      case 0x23: return SimplexMassApply<3,2,3>(*this, NE, d, x, y);
+      case 0x34: return SimplexMassApply<3,3,4>(*this, NE, d, x, y);
+      case 0x45: return SimplexMassApply<3,4,5>(*this, NE, d, x, y);
+      case 0x56: return SimplexMassApply<3,5,6>(*this, NE, d, x, y);
+      case 0x68: return SimplexMassApply<3,6,8>(*this, NE, d, x, y);
+      case 0x79: return SimplexMassApply<3,7,9>(*this, NE, d, x, y);
+      default:
+         return SimplexMassApply<3,MAX_SIMPLEX_D1D,MAX_SIMPLEX_Q1D>(
+                   *this, NE, d, x, y);
+   }
+}
+
+void SimplexPAMaps::DiffusionApply(const int NE, const Vector &d,
+                                   const Vector &x, Vector &y) const
+{
+   if (order == 0) { return; }
+   // Specialized kernels for the default rules on straight elements, with
+   // q1d = p + 1 (q1d = p + 2 for p = 1, 6 in 3D), and p <= 6; the generic
+   // kernels use the maximal sizes
+   const int id = ((order + 1) << 4) | nqpt1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: return SimplexDiffusionApply<2,2,2>(*this, NE, d, x, y);
+         case 0x33: return SimplexDiffusionApply<2,3,3>(*this, NE, d, x, y);
+         case 0x44: return SimplexDiffusionApply<2,4,4>(*this, NE, d, x, y);
+         case 0x55: return SimplexDiffusionApply<2,5,5>(*this, NE, d, x, y);
+         case 0x66: return SimplexDiffusionApply<2,6,6>(*this, NE, d, x, y);
+         case 0x77: return SimplexDiffusionApply<2,7,7>(*this, NE, d, x, y);
+         default:
+            return SimplexDiffusionApply<2,MAX_SIMPLEX_D1D,MAX_SIMPLEX_Q1D>(
+                      *this, NE, d, x, y);
+      }
+   }
+   switch (id)
+   {
+      case 0x22: return SimplexDiffusionApply<3,2,2>(*this, NE, d, x, y);
+      case 0x23: return SimplexDiffusionApply<3,2,3>(*this, NE, d, x, y);
+      case 0x33: return SimplexDiffusionApply<3,3,3>(*this, NE, d, x, y);
+      case 0x44: return SimplexDiffusionApply<3,4,4>(*this, NE, d, x, y);
+      case 0x55: return SimplexDiffusionApply<3,5,5>(*this, NE, d, x, y);
+      case 0x66: return SimplexDiffusionApply<3,6,6>(*this, NE, d, x, y);
+      case 0x78: return SimplexDiffusionApply<3,7,8>(*this, NE, d, x, y);
+      default:
+         return SimplexDiffusionApply<3,MAX_SIMPLEX_D1D,MAX_SIMPLEX_Q1D>(
+                   *this, NE, d, x, y);
+   }
+}
+
+void SimplexPAMaps::MassDiagonal(const int NE, const Vector &d,
+                                 Vector &diag) const
+{
+   const DofToQuad &maps = FE->GetDofToQuad(*IntRule, DofToQuad::FULL);
+   const int ND = ndof;
+   const int NQ = IntRule->GetNPoints();
+   auto B = Reshape(maps.B.Read(), NQ, ND);
+   auto D_ = Reshape(d.Read(), NQ, NE);
+   auto Y = Reshape(diag.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; i++)
+      {
+         double s = 0.0;
+         for (int q = 0; q < NQ; q++) { s += B(q,i)*B(q,i)*D_(q,e); }
+         Y(i,e) += s;
+      }
+   });
+}
+
+void SimplexPAMaps::DiffusionDiagonal(const int NE, const Vector &d,
+                                      Vector &diag) const
+{
+   const DofToQuad &maps = FE->GetDofToQuad(*IntRule, DofToQuad::FULL);
+   const int DIM = dim, ND = ndof;
+   const int NQ = IntRule->GetNPoints();
+   const int NS = (dim*(dim + 1))/2;
+   auto G = Reshape(maps.G.Read(), NQ, DIM, ND);
+   auto D_ = Reshape(d.Read(), NQ, NS, NE);
+   auto Y = Reshape(diag.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; i++)
+      {
+         double s = 0.0;
+         for (int q = 0; q < NQ; q++)
+         {
+            if (DIM == 2)
+            {
+               const double g0 = G(q,0,i), g1 = G(q,1,i);
+               s += D_(q,0,e)*g0*g0 + 2.0*D_(q,1,e)*g0*g1 + D_(q,2,e)*g1*g1;
+            }
+            else
+            {
+               const double g0 = G(q,0,i), g1 = G(q,1,i), g2 = G(q,2,i);
+               s += D_(q,0,e)*g0*g0 + D_(q,3,e)*g1*g1 + D_(q,5,e)*g2*g2 +
+                    2.0*(D_(q,1,e)*g0*g1 + D_(q,2,e)*g0*g2 +
+                         D_(q,4,e)*g1*g2);
+            }
+         }
+         Y(i,e) += s;
+      }
+   });
+}
+
+} // namespace mfem
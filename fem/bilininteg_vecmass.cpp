@@ -38,26 +38,55 @@ void VectorMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
-   pa_data.SetSize(ne*nq, Device::GetMemoryType());
-   double coeff = 1.0;
-   if (Q)
-   {
-      ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q);
-      MFEM_VERIFY(cQ != NULL, "Only ConstantCoefficient is supported.");
-      coeff = cQ->constant;
-   }
    if (!(dim == 2 || dim == 3))
    {
       MFEM_ABORT("Dimension not supported.");
    }
+   // The quadrature data uses the layout (NQ x NC x NE) where NC = 1 for a
+   // scalar coefficient, NC = dim for a diagonal (vector) coefficient and
+   // NC = dim*dim for a matrix coefficient (column-major).
+   int nc = 1;
+   Vector coeff;
+   if (MQ)
+   {
+      MFEM_VERIFY(MQ->GetHeight() == dim && MQ->GetWidth() == dim,
+                  "the MatrixCoefficient must be dim x dim");
+      MQ->Project(coeff, *mesh, *ir);
+      nc = dim*dim;
+   }
+   else if (VQ)
+   {
+      MFEM_VERIFY(VQ->GetVDim() == dim, "the VectorCoefficient must have "
+                  "dimension dim");
+      VQ->Project(coeff, *mesh, *ir);
+      nc = dim;
+   }
+   else if (Q == NULL)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
+   {
+      Q->Project(coeff, *mesh, *ir);
+   }
+   pa_data.SetSize(ne*nq*nc, Device::GetMemoryType());
+   const bool const_c = coeff.Size() == 1;
+   const int NE = ne;
+   const int NQ = nq;
+   const int NC = nc;
+   auto W = ir->GetWeights().Read();
+   auto C = const_c ? Reshape(coeff.Read(), 1, 1, 1) :
+            Reshape(coeff.Read(), NQ, NC, NE);
+   auto v = Reshape(pa_data.Write(), NQ, NC, NE);
    if (dim == 2)
    {
-      const double constant = coeff;
-      const int NE = ne;
-      const int NQ = nq;
-      auto w = ir->GetWeights().Read();
       auto J = Reshape(geom->J.Read(), NQ,2,2,NE);
-      auto v = Reshape(pa_data.Write(), NQ, NE);
       MFEM_FORALL(e, NE,
       {
          for (int q = 0; q < NQ; ++q)
@@ -67,18 +96,17 @@ void VectorMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
             const double J21 = J(q,0,1,e);
             const double J22 = J(q,1,1,e);
             const double detJ = (J11*J22)-(J21*J12);
-            v(q,e) =  w[q] * constant * detJ;
+            for (int c = 0; c < NC; ++c)
+            {
+               const double coeff = const_c ? C(0,0,0) : C(q,c,e);
+               v(q,c,e) =  W[q] * coeff * detJ;
+            }
          }
       });
    }
    if (dim == 3)
    {
-      const double constant = coeff;
-      const int NE = ne;
-      const int NQ = nq;
-      auto W = ir->GetWeights().Read();
       auto J = Reshape(geom->J.Read(), NQ,3,3,NE);
-      auto v = Reshape(pa_data.Write(), NQ,NE);
       MFEM_FORALL(e, NE,
       {
          for (int q = 0; q < NQ; ++q)
@@ -89,7 +117,11 @@ void VectorMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
             const double detJ = J11 * (J22 * J33 - J32 * J23) -
             /* */               J21 * (J12 * J33 - J32 * J13) +
             /* */               J31 * (J12 * J23 - J22 * J13);
-            v(q,e) = W[q] * constant * detJ;
+            for (int c = 0; c < NC; ++c)
+            {
+               const double coeff = const_c ? C(0,0,0) : C(q,c,e);
+               v(q,c,e) = W[q] * coeff * detJ;
+            }
          }
       });
    }
@@ -103,6 +135,7 @@ static void PAVectorMassApply2D(const int NE,
                                 const Vector &_op,
                                 const Vector &_x,
                                 Vector &_y,
+                                const int nc,
                                 const int d1d = 0,
                                 const int q1d = 0)
 {
@@ -113,7 +146,7 @@ static void PAVectorMassApply2D(const int NE,
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(_B.Read(), Q1D, D1D);
    auto Bt = Reshape(_Bt.Read(), D1D, Q1D);
-   auto op = Reshape(_op.Read(), Q1D, Q1D, NE);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, nc, NE);
    auto x = Reshape(_x.Read(), D1D, D1D, VDIM, NE);
    auto y = Reshape(_y.ReadWrite(), D1D, D1D, VDIM, NE);
    MFEM_FORALL(e, NE,
@@ -126,6 +159,8 @@ static void PAVectorMassApply2D(const int NE,
       double sol_xy[max_Q1D][max_Q1D];
       for (int c = 0; c < VDIM; ++c)
       {
+         // scalar (nc == 1) or diagonal (nc == VDIM) coefficient
+         const int oc = (nc == 1) ? 0 : c;
          for (int qy = 0; qy < Q1D; ++qy)
          {
             for (int qx = 0; qx < Q1D; ++qx)
@@ -161,7 +196,7 @@ static void PAVectorMassApply2D(const int NE,
          {
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               sol_xy[qy][qx] *= op(qx,qy,e);
+               sol_xy[qy][qx] *= op(qx,qy,oc,e);
             }
          }
          for (int qy = 0; qy < Q1D; ++qy)
@@ -200,6 +235,7 @@ static void PAVectorMassApply3D(const int NE,
                                 const Vector &_op,
                                 const Vector &_x,
                                 Vector &_y,
+                                const int nc,
                                 const int d1d = 0,
                                 const int q1d = 0)
 {
@@ -210,7 +246,7 @@ static void PAVectorMassApply3D(const int NE,
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(_B.Read(), Q1D, D1D);
    auto Bt = Reshape(_Bt.Read(), D1D, Q1D);
-   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, NE);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, nc, NE);
    auto x = Reshape(_x.Read(), D1D, D1D, D1D, VDIM, NE);
    auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, VDIM, NE);
    MFEM_FORALL(e, NE,
@@ -222,6 +258,8 @@ static void PAVectorMassApply3D(const int NE,
       double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
       for (int c = 0; c < VDIM; ++ c)
       {
+         // scalar (nc == 1) or diagonal (nc == VDIM) coefficient
+         const int oc = (nc == 1) ? 0 : c;
          for (int qz = 0; qz < Q1D; ++qz)
          {
             for (int qy = 0; qy < Q1D; ++qy)
@@ -284,7 +322,7 @@ static void PAVectorMassApply3D(const int NE,
             {
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  sol_xyz[qz][qy][qx] *= op(qx,qy,qz,e);
+                  sol_xyz[qz][qy][qx] *= op(qx,qy,qz,oc,e);
                }
             }
          }
@@ -338,6 +376,248 @@ static void PAVectorMassApply3D(const int NE,
    });
 }
 
+// PA Vector Mass Apply 2D kernel for a full (VDIM x VDIM) matrix coefficient
+template<const int T_D1D = 0,
+         const int T_Q1D = 0>
+static void PAVectorMassMatrixApply2D(const int NE,
+                                      const Array<double> &_B,
+                                      const Array<double> &_Bt,
+                                      const Vector &_op,
+                                      const Vector &_x,
+                                      Vector &_y,
+                                      const int d1d = 0,
+                                      const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   constexpr int VDIM = 2;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(_B.Read(), Q1D, D1D);
+   auto Bt = Reshape(_Bt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, VDIM, VDIM, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, VDIM, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // interpolate all components to the quadrature points
+      double sol_xy[VDIM][max_Q1D][max_Q1D];
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[c][qy][qx] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double sol_x[max_Q1D];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_x[qx] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = x(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] += B(qx,dx) * s;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double d2q = B(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[c][qy][qx] += d2q * sol_x[qx];
+               }
+            }
+         }
+      }
+      // apply the matrix coefficient and integrate each component
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double sol_x[max_D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double s = op(qx,qy,c,0,e) * sol_xy[0][qy][qx] +
+                                op(qx,qy,c,1,e) * sol_xy[1][qy][qx];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] += Bt(dx,qx) * s;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double q2d = Bt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y(dx,dy,c,e) += q2d * sol_x[dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Vector Mass Apply 3D kernel for a full (VDIM x VDIM) matrix coefficient
+template<const int T_D1D = 0,
+         const int T_Q1D = 0>
+static void PAVectorMassMatrixApply3D(const int NE,
+                                      const Array<double> &_B,
+                                      const Array<double> &_Bt,
+                                      const Vector &_op,
+                                      const Vector &_x,
+                                      Vector &_y,
+                                      const int d1d = 0,
+                                      const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   constexpr int VDIM = 3;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(_B.Read(), Q1D, D1D);
+   auto Bt = Reshape(_Bt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, VDIM, VDIM, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, D1D, VDIM, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // interpolate all components to the quadrature points
+      double sol_xyz[VDIM][max_Q1D][max_Q1D][max_Q1D];
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[c][qz][qy][qx] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double sol_xy[max_Q1D][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double sol_x[max_Q1D];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] = 0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = x(dx,dy,dz,c,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_x[qx] += B(qx,dx) * s;
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy = B(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xy[qy][qx] += wy * sol_x[qx];
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz = B(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xyz[c][qz][qy][qx] += wz * sol_xy[qy][qx];
+                  }
+               }
+            }
+         }
+      }
+      // apply the matrix coefficient and integrate each component
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double sol_xy[max_D1D][max_D1D];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] = 0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double sol_x[max_D1D];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] = 0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double s =
+                     op(qx,qy,qz,c,0,e) * sol_xyz[0][qz][qy][qx] +
+                     op(qx,qy,qz,c,1,e) * sol_xyz[1][qz][qy][qx] +
+                     op(qx,qy,qz,c,2,e) * sol_xyz[2][qz][qy][qx];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_x[dx] += Bt(dx,qx) * s;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy = Bt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xy[dy][dx] += wy * sol_x[dx];
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz = Bt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     y(dx,dy,dz,c,e) += wz * sol_xy[dy][dx];
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
 static void PAVectorMassApply(const int dim,
                               const int D1D,
                               const int Q1D,
@@ -348,13 +628,24 @@ static void PAVectorMassApply(const int dim,
                               const Vector &x,
                               Vector &y)
 {
+   if (NE == 0) { return; }
+   // number of coefficient components per quadrature point, see AssemblePA
+   const int nc = op.Size() / (NE*(dim == 2 ? Q1D*Q1D : Q1D*Q1D*Q1D));
    if (dim == 2)
    {
-      return PAVectorMassApply2D(NE, B, Bt, op, x, y, D1D, Q1D);
+      if (nc == 2*2)
+      {
+         return PAVectorMassMatrixApply2D(NE, B, Bt, op, x, y, D1D, Q1D);
+      }
+      return PAVectorMassApply2D(NE, B, Bt, op, x, y, nc, D1D, Q1D);
    }
    if (dim == 3)
    {
-      return PAVectorMassApply3D(NE, B, Bt, op, x, y, D1D, Q1D);
+      if (nc == 3*3)
+      {
+         return PAVectorMassMatrixApply3D(NE, B, Bt, op, x, y, D1D, Q1D);
+      }
+      return PAVectorMassApply3D(NE, B, Bt, op, x, y, nc, D1D, Q1D);
    }
    MFEM_ABORT("Unknown kernel.");
 }
@@ -12,6 +12,7 @@
 // Implementation of Coefficient class
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 #include <cmath>
 #include <limits>
@@ -21,6 +22,58 @@ namespace mfem
 
 using namespace std;
 
+void Coefficient::Project(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir)
+{
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   qcoeff.SetSize(nq*ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, ne);
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         C(q,e) = Eval(T, ip);
+      }
+   }
+}
+
+void Coefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "invalid QuadratureFunction vdim");
+   QuadratureSpace &qspace = *qf.GetSpace();
+   Mesh &mesh = *qspace.GetMesh();
+   const int ne = mesh.GetNE();
+   if (ne == 0) { return; }
+   if (mesh.GetNumGeometries(mesh.Dimension()) == 1)
+   {
+      Project(qf, mesh, qspace.GetElementIntRule(0));
+      return;
+   }
+   double *C = qf.HostWrite();
+   for (int e = 0, offset = 0; e < ne; e++)
+   {
+      const IntegrationRule &ir = qspace.GetElementIntRule(e);
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         C[offset++] = Eval(T, ip);
+      }
+   }
+}
+
+void ConstantCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                  const IntegrationRule &ir)
+{
+   qcoeff.SetSize(ir.GetNPoints()*mesh.GetNE());
+   qcoeff = constant;
+}
+
 double PWConstCoefficient::Eval(ElementTransformation & T,
                                 const IntegrationPoint & ip)
 {
@@ -46,12 +99,86 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                  const IntegrationRule &ir)
+{
+   const int ne = mesh.GetNE();
+   const int dim = mesh.Dimension();
+   const int sdim = mesh.SpaceDimension();
+   // The coordinates are computed from the current nodes, not with the
+   // GeometricFactors cached in the mesh, which are not updated when the mesh
+   // moves. The QuadratureInterpolator requires dim == sdim >= 2.
+   Vector q_coords;
+   if (ne == 0 || dim < 2 || sdim != dim ||
+       mesh.GetNumGeometries(dim) != 1 ||
+       !ComputeQuadratureCoordinates(mesh, ir, q_coords))
+   {
+      Coefficient::Project(qcoeff, mesh, ir);
+      return;
+   }
+   const int nq = ir.GetNPoints();
+   qcoeff.SetSize(nq*ne);
+   auto X = Reshape(q_coords.HostRead(), nq, sdim, ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, ne);
+   const double t = GetTime();
+   double x[3];
+   Vector transip(x, sdim);
+   for (int e = 0; e < ne; e++)
+   {
+      for (int q = 0; q < nq; q++)
+      {
+         for (int d = 0; d < sdim; d++) { x[d] = X(q,d,e); }
+         C(q,e) = Function ? (*Function)(transip) : (*TDFunction)(transip, t);
+      }
+   }
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
    return GridF -> GetValue (T.ElementNo, ip, Component);
 }
 
+void GridFunctionCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                      const IntegrationRule &ir)
+{
+   const FiniteElementSpace &fes = *GridF->FESpace();
+   const int ne = mesh.GetNE();
+   const int dim = mesh.Dimension();
+   const int vdim = fes.GetVDim();
+   if (ne == 0 || fes.GetMesh() != &mesh || fes.GetNURBSext() ||
+       (dim != 2 && dim != 3) || (vdim != 1 && vdim != dim) ||
+       mesh.GetNumGeometries(dim) != 1 ||
+       !dynamic_cast<const ScalarFiniteElement*>(fes.GetFE(0)) ||
+       fes.GetFE(0)->GetMapType() != FiniteElement::VALUE ||
+       !fes.GetQuadratureInterpolator(ir)->CanEvaluate(ir))
+   {
+      Coefficient::Project(qcoeff, mesh, ir);
+      return;
+   }
+   const int nq = ir.GetNPoints();
+   const Operator *elem_restr =
+      fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector e_vec(elem_restr->Height());
+   elem_restr->Mult(*GridF, e_vec);
+
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   Vector q_der, q_det;
+   qcoeff.SetSize(nq*ne);
+   if (vdim == 1)
+   {
+      qi->Mult(e_vec, QuadratureInterpolator::VALUES, qcoeff, q_der, q_det);
+      return;
+   }
+   Vector q_val(nq*vdim*ne);
+   qi->Mult(e_vec, QuadratureInterpolator::VALUES, q_val, q_der, q_det);
+   const int NQ = nq;
+   const int comp = Component - 1;
+   auto V = Reshape(q_val.Read(), nq, vdim, ne);
+   auto C = Reshape(qcoeff.Write(), nq, ne);
+   MFEM_FORALL(i, nq*ne, C(i % NQ, i / NQ) = V(i % NQ, comp, i / NQ););
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
@@ -101,6 +228,27 @@ void VectorCoefficient::Eval(DenseMatrix &M, ElementTransformation &T,
    }
 }
 
+void VectorCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                const IntegrationRule &ir)
+{
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   qcoeff.SetSize(nq*vdim*ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, vdim, ne);
+   Vector V(vdim);
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         Eval(V, T, ip);
+         for (int i = 0; i < vdim; i++) { C(q,i,e) = V(i); }
+      }
+   }
+}
+
 void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
                                      const IntegrationPoint &ip)
 {
@@ -285,6 +433,30 @@ void VectorRestrictedCoefficient::Eval(
    }
 }
 
+void MatrixCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                const IntegrationRule &ir)
+{
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   qcoeff.SetSize(nq*height*width*ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, height, width, ne);
+   DenseMatrix K(height, width);
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         Eval(K, T, ip);
+         for (int j = 0; j < width; j++)
+         {
+            for (int i = 0; i < height; i++) { C(q,i,j,e) = K(i,j); }
+         }
+      }
+   }
+}
+
 void MatrixFunctionCoefficient::Eval(DenseMatrix &K, ElementTransformation &T,
                                      const IntegrationPoint &ip)
 {
@@ -21,6 +21,7 @@ namespace mfem
 {
 
 class Mesh;
+class QuadratureFunction;
 
 #ifdef MFEM_USE_MPI
 class ParMesh;
@@ -59,6 +60,22 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at all points of the IntegrationRule
+       @a ir in all elements of @a mesh. */
+   /** The result is stored in @a qcoeff which is resized to NQ x NE
+       (column-major), where NQ is the number of points in @a ir and NE is the
+       number of elements in @a mesh. All elements of @a mesh must have the
+       geometry of @a ir.
+
+       The default implementation calls Eval() at every point; derived classes
+       can override it with a batched (and possibly device) evaluation. */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
+   /// Evaluate the coefficient at all points of the QuadratureFunction @a qf.
+   /** The vector dimension of @a qf must be 1. When all mesh elements have the
+       same geometry, the batched Project() method above is used. */
+   void Project(QuadratureFunction &qf);
+
    virtual ~Coefficient() { }
 };
 
@@ -76,6 +93,10 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   using Coefficient::Project;
+   /// Set all entries of @a qcoeff to the constant value.
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 /// class for piecewise constant coefficient
@@ -156,6 +177,17 @@ public:
    /// Evaluate coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   using Coefficient::Project;
+   /** @brief Batched evaluation at the physical coordinates of the quadrature
+       points, computed with ComputeQuadratureCoordinates(). */
+   /** The coordinates are interpolated from the current nodes of @a mesh, or
+       from its vertices if it has no nodes, and are not cached, so the result
+       is also correct after the mesh moves. 1D meshes, surface meshes and
+       meshes with several element geometries, which the
+       QuadratureInterpolator does not support, use the point-wise
+       Coefficient::Project(). */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 class GridFunction;
@@ -179,6 +211,14 @@ public:
 
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   using Coefficient::Project;
+   /** @brief Batched evaluation using the element restriction and the
+       QuadratureInterpolator of the FiniteElementSpace of the GridFunction. */
+   /** Spaces that are not supported by the QuadratureInterpolator (e.g. 1D,
+       NURBS or vector finite elements), as well as GridFunctions defined on a
+       different mesh, fall back to the point-wise Coefficient::Project(). */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 class TransformedCoefficient : public Coefficient
@@ -315,6 +355,14 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Evaluate the vector coefficient at all points of the
+       IntegrationRule @a ir in all elements of @a mesh. */
+   /** The result is stored in @a qcoeff which is resized to NQ x VDIM x NE
+       (column-major), where NQ is the number of points in @a ir and NE is the
+       number of elements in @a mesh. The default implementation calls Eval()
+       at every point. */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~VectorCoefficient() { }
 };
 
@@ -569,6 +617,14 @@ public:
    virtual void Eval(DenseMatrix &K, ElementTransformation &T,
                      const IntegrationPoint &ip) = 0;
 
+   /** @brief Evaluate the matrix coefficient at all points of the
+       IntegrationRule @a ir in all elements of @a mesh. */
+   /** The result is stored in @a qcoeff which is resized to NQ x HEIGHT x
+       WIDTH x NE (column-major), where NQ is the number of points in @a ir and
+       NE is the number of elements in @a mesh. The default implementation
+       calls Eval() at every point. */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~MatrixCoefficient() { }
 };
 
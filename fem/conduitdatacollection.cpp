@@ -66,6 +66,13 @@ ConduitDataCollection::~ConduitDataCollection()
    // empty
 }
 
+//---------------------------------------------------------------------------//
+void ConduitDataCollection::SetAsyncSave(bool async, int max_in_flight)
+{
+   MFEM_VERIFY(!async, "asynchronous saving is not supported by "
+               "ConduitDataCollection");
+}
+
 //---------------------------------------------------------------------------//
 void ConduitDataCollection::Save()
 {
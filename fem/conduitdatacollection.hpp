@@ -130,6 +130,9 @@ public:
    /// Save the collection and a Conduit blueprint root file
    virtual void Save();
 
+   /// Asynchronous saving is not supported, aborts when @a async is true.
+   virtual void SetAsyncSave(bool async, int max_in_flight = 2);
+
    /// Load the collection based blueprint data
    virtual void Load(int cycle = 0);
 
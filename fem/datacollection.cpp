@@ -16,6 +16,12 @@
 
 #include <cerrno>      // errno
 #include <sstream>
+#include <deque>
+#ifdef MFEM_USE_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
 
 #ifndef _WIN32
 #include <sys/stat.h>  // mkdir
@@ -67,6 +73,166 @@ int DataCollection::create_directory(const std::string &dir_name,
    return err;
 }
 
+// class DataCollection::AsyncSaveJob implementation
+
+class DataCollection::AsyncSaveJob
+{
+protected:
+   struct File
+   {
+      std::string name;
+      bool compress;
+      std::string header; // formatted text written before the data, if any
+      Vector data;        // host staging buffer, printed with 'width' entries
+      int width;          // per line after the header
+   };
+   std::vector<File> files;
+   int precision;
+
+public:
+   AsyncSaveJob(int prec) : precision(prec) { }
+
+   /// Add a file with the given @a header and no data.
+   File &AddFile(const std::string &name, bool compress,
+                 const std::string &header)
+   {
+      files.push_back(File());
+      File &f = files.back();
+      f.name = name;
+      f.compress = compress;
+      f.header = header;
+      f.width = 1;
+      return f;
+   }
+
+   /// Add a file with the given @a header followed by a copy of @a vec.
+   File &AddFile(const std::string &name, bool compress,
+                 const std::string &header, const Vector &vec, int width)
+   {
+      File &f = AddFile(name, compress, header);
+      f.data.SetSize(vec.Size());
+      if (vec.Size())
+      {
+         // HostRead() performs any needed device-to-host copy
+         std::memcpy(f.data.GetData(), vec.HostRead(),
+                     vec.Size()*sizeof(double));
+      }
+      f.width = width;
+      return f;
+   }
+
+   /// Format, compress and write all files, called on the I/O thread.
+   /** Returns the number of files that could not be written. */
+   int Write() const
+   {
+      int num_errors = 0;
+      for (size_t i = 0; i < files.size(); i++)
+      {
+         const File &f = files[i];
+         ofgzstream file(f.name.c_str(), f.compress ? "zwb6" : "w");
+         file.precision(precision);
+         file << f.header;
+         f.data.Print(file, f.width);
+         file.flush();
+         if (!file)
+         {
+            MFEM_WARNING("Error writing file: " << f.name);
+            num_errors++;
+         }
+      }
+      return num_errors;
+   }
+};
+
+
+// class DataCollection::AsyncSaveWriter implementation
+
+#ifdef MFEM_USE_THREADS
+class DataCollection::AsyncSaveWriter
+{
+protected:
+   std::thread thread;
+   std::mutex mtx;
+   std::condition_variable cond;
+   std::deque<AsyncSaveJob*> queue; // the front job is being written
+   int max_in_flight;
+   int num_errors;
+   bool stop;
+
+   void Run()
+   {
+      std::unique_lock<std::mutex> lock(mtx);
+      while (true)
+      {
+         cond.wait(lock, [this] { return stop || !queue.empty(); });
+         if (queue.empty()) { break; } // stop requested, nothing pending
+
+         AsyncSaveJob *job = queue.front();
+         lock.unlock();
+         int err = job->Write();
+         delete job;
+         lock.lock();
+
+         num_errors += err;
+         queue.pop_front();
+         cond.notify_all();
+      }
+   }
+
+public:
+   AsyncSaveWriter(int max_in_flight_)
+      : max_in_flight(max_in_flight_), num_errors(0), stop(false)
+   {
+      thread = std::thread(&AsyncSaveWriter::Run, this);
+   }
+
+   void SetMaxInFlight(int max_in_flight_)
+   {
+      std::lock_guard<std::mutex> lock(mtx);
+      max_in_flight = max_in_flight_;
+      cond.notify_all();
+   }
+
+   void Post(AsyncSaveJob *job)
+   {
+      std::unique_lock<std::mutex> lock(mtx);
+      cond.wait(lock, [this] { return (int) queue.size() < max_in_flight; });
+      queue.push_back(job);
+      cond.notify_all();
+   }
+
+   /// Wait for all posted jobs; return and reset the number of write errors.
+   int Wait()
+   {
+      std::unique_lock<std::mutex> lock(mtx);
+      cond.wait(lock, [this] { return queue.empty(); });
+      int err = num_errors;
+      num_errors = 0;
+      return err;
+   }
+
+   ~AsyncSaveWriter()
+   {
+      {
+         std::lock_guard<std::mutex> lock(mtx);
+         stop = true;
+         cond.notify_all();
+      }
+      thread.join(); // pending jobs are written before the thread exits
+   }
+};
+#else
+// Without threads SetAsyncSave() aborts, so no writer is ever created.
+class DataCollection::AsyncSaveWriter
+{
+public:
+   void SetMaxInFlight(int max_in_flight_) { }
+   void Post(AsyncSaveJob *job) { delete job; }
+   int Wait() { return 0; }
+};
+#endif
+
+
 // class DataCollection implementation
 
 DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
@@ -109,6 +275,7 @@ DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
    format = SERIAL_FORMAT; // use serial mesh format
    compression = false;
    error = NO_ERROR;
+   async_writer = NULL;
 }
 
 void DataCollection::SetMesh(Mesh *new_mesh)
@@ -185,6 +352,114 @@ void DataCollection::SetPrefixPath(const std::string& prefix)
    }
 }
 
+void DataCollection::SetAsyncSave(bool async, int max_in_flight)
+{
+   if (async)
+   {
+#ifdef MFEM_USE_THREADS
+      MFEM_VERIFY(max_in_flight > 0,
+                  "invalid max_in_flight = " << max_in_flight);
+      if (async_writer) { async_writer->SetMaxInFlight(max_in_flight); }
+      else { async_writer = new AsyncSaveWriter(max_in_flight); }
+#else
+      MFEM_ABORT("asynchronous saving requires MFEM_USE_THREADS");
+#endif
+   }
+   else if (async_writer)
+   {
+      WaitSave();
+      delete async_writer;
+      async_writer = NULL;
+   }
+}
+
+void DataCollection::WaitSave()
+{
+   if (async_writer && async_writer->Wait())
+   {
+      error = WRITE_ERROR;
+   }
+}
+
+DataCollection::AsyncSaveJob *DataCollection::NewAsyncSaveJob()
+{
+   std::string dir_name = prefix_path + name;
+   if (cycle != -1)
+   {
+      dir_name += "_" + to_padded_string(cycle, pad_digits_cycle);
+   }
+   if (create_directory(dir_name, mesh, myid))
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error creating directory: " << dir_name);
+      return NULL;
+   }
+
+   AsyncSaveJob *job = new AsyncSaveJob(precision);
+
+   // The mesh is formatted here since its topology may change as soon as
+   // Save() returns; compression and file output are left to the I/O thread.
+   std::ostringstream mesh_str;
+   mesh_str.precision(precision);
+#ifdef MFEM_USE_MPI
+   const ParMesh *pmesh = dynamic_cast<const ParMesh*>(mesh);
+   if (pmesh && format == PARALLEL_FORMAT)
+   {
+      pmesh->ParPrint(mesh_str);
+   }
+   else
+#endif
+   {
+      mesh->Print(mesh_str);
+   }
+   job->AddFile(GetMeshFileName(), compression, mesh_str.str());
+
+   for (FieldMapIterator it = field_map.begin(); it != field_map.end(); ++it)
+   {
+      const GridFunction &gf = *it->second;
+      const FiniteElementSpace *fes = gf.FESpace();
+      std::ostringstream header;
+      fes->Save(header);
+      header << '\n';
+      const int width =
+         (fes->GetOrdering() == Ordering::byNODES) ? 1 : fes->GetVDim();
+      Vector &data =
+         job->AddFile(GetFieldFileName(it->first), compression, header.str(),
+                      gf, width).data;
+#ifdef MFEM_USE_MPI
+      // Flip the signs of the dofs as in ParGridFunction::Save()
+      ParFiniteElementSpace *pfes =
+         dynamic_cast<ParFiniteElementSpace*>(it->second->FESpace());
+      for (int i = 0; pfes && i < data.Size(); i++)
+      {
+         if (pfes->GetDofSign(i) < 0) { data(i) = -data(i); }
+      }
+#else
+      MFEM_CONTRACT_VAR(data);
+#endif
+   }
+
+   for (QFieldMapIterator it = q_field_map.begin(); it != q_field_map.end();
+        ++it)
+   {
+      const QuadratureFunction &qf = *it->second;
+      std::ostringstream header;
+      qf.GetSpace()->Save(header);
+      header << "VDim: " << qf.GetVDim() << '\n'
+             << '\n';
+      job->AddFile(GetFieldFileName(it->first), compression, header.str(),
+                   qf, qf.GetVDim());
+   }
+
+   return job;
+}
+
+void DataCollection::PostAsyncSaveJob(AsyncSaveJob *job)
+{
+   MFEM_ASSERT(async_writer, "asynchronous saving is not enabled");
+   if (job) { async_writer->Post(job); }
+}
+
 void DataCollection::Load(int cycle)
 {
    MFEM_ABORT("this method is not implemented");
@@ -192,6 +467,12 @@ void DataCollection::Load(int cycle)
 
 void DataCollection::Save()
 {
+   if (async_writer)
+   {
+      PostAsyncSaveJob(NewAsyncSaveJob());
+      return;
+   }
+
    SaveMesh();
 
    if (error) { return; }
@@ -338,6 +619,7 @@ void DataCollection::DeleteAll()
 
 DataCollection::~DataCollection()
 {
+   delete async_writer; // writes any pending saves
    DeleteData();
 }
 
@@ -453,17 +735,33 @@ void VisItDataCollection::DeleteAll()
 
 void VisItDataCollection::Save()
 {
+   if (async_writer)
+   {
+      AsyncSaveJob *job = NewAsyncSaveJob();
+      if (job && myid == 0)
+      {
+         // written last, after the mesh and field files
+         job->AddFile(GetVisItRootFileName(), false, GetVisItRootString());
+      }
+      PostAsyncSaveJob(job);
+      return;
+   }
+
    DataCollection::Save();
    SaveRootFile();
 }
 
+std::string VisItDataCollection::GetVisItRootFileName() const
+{
+   return prefix_path + name + "_" +
+          to_padded_string(cycle, pad_digits_cycle) + ".mfem_root";
+}
+
 void VisItDataCollection::SaveRootFile()
 {
    if (myid != 0) { return; }
 
-   std::string root_name = prefix_path + name + "_" +
-                           to_padded_string(cycle, pad_digits_cycle) +
-                           ".mfem_root";
+   std::string root_name = GetVisItRootFileName();
    std::ofstream root_file(root_name.c_str());
    root_file << GetVisItRootString();
    if (!root_file)
@@ -825,6 +1123,12 @@ std::string ParaViewDataCollection::GenerateVTUFileName(int crank)
    return out;
 }
 
+void ParaViewDataCollection::SetAsyncSave(bool async, int max_in_flight)
+{
+   MFEM_VERIFY(!async, "asynchronous saving is not supported by "
+               "ParaViewDataCollection");
+}
+
 void ParaViewDataCollection::Save()
 {
    // add a new collection to the PDV file
@@ -214,6 +214,22 @@ protected:
    /// Error state
    int error;
 
+   /// Snapshot of the collection data, written by the asynchronous I/O thread
+   class AsyncSaveJob;
+   /// Background I/O thread and queue of pending AsyncSaveJob%s
+   class AsyncSaveWriter;
+
+   /// Non-NULL when asynchronous saving is enabled, see SetAsyncSave()
+   AsyncSaveWriter *async_writer;
+
+   /** @brief Snapshot the mesh and all fields into a new AsyncSaveJob, creating
+       the collection directory. Returns NULL if the directory cannot be
+       created. */
+   AsyncSaveJob *NewAsyncSaveJob();
+   /** @brief Hand @a job over to the I/O thread, blocking while the maximum
+       number of in-flight saves is reached. */
+   void PostAsyncSaveJob(AsyncSaveJob *job);
+
    /// Delete data owned by the DataCollection keeping field information
    void DeleteData();
    /// Delete data owned by the DataCollection including field information
@@ -357,6 +373,29 @@ public:
    /// Get the path where the DataCollection will be saved.
    const std::string &GetPrefixPath() const { return prefix_path; }
 
+   /// Enable or disable asynchronous saving in Save().
+   /** When enabled, Save() copies the mesh and the field data (including any
+       device-to-host transfers) into host staging buffers and returns, while a
+       background thread formats, compresses and writes the files. At most
+       @a max_in_flight saves can be pending; further calls to Save() block
+       until an earlier save completes. Disabling waits for all pending saves.
+
+       @note The staging buffers are independent of the registered fields, so
+       these can be modified (or the mesh refined) right after Save() returns.
+       Write errors from the background thread are reported by Error() after
+       WaitSave().
+
+       Asynchronous saving requires MFEM_USE_THREADS. It is supported by
+       DataCollection and VisItDataCollection; the other collections abort
+       when @a async is true. */
+   virtual void SetAsyncSave(bool async, int max_in_flight = 2);
+
+   /// Return true if asynchronous saving is enabled, see SetAsyncSave().
+   bool GetAsyncSave() const { return async_writer != NULL; }
+
+   /// Block until all pending asynchronous saves have been written to disk.
+   void WaitSave();
+
    /// Save the collection to disk.
    /** By default, everything is saved in the "prefix_path" directory with
        subdirectory name "collection_name" or "collection_name_cycle" for
@@ -410,6 +449,8 @@ protected:
 
    /// Prepare the VisIt root file in JSON format for the current collection
    std::string GetVisItRootString();
+   /// Name of the VisIt root file for the current cycle
+   std::string GetVisItRootFileName() const;
    /// Read in a VisIt root file in JSON format
    void ParseVisItRootString(const std::string& json);
 
@@ -530,6 +571,9 @@ public:
    /// cycle value
    virtual void Save() override;
 
+   /// Asynchronous saving is not supported, aborts when @a async is true.
+   virtual void SetAsyncSave(bool async, int max_in_flight = 2) override;
+
    /// Load the collection - not implemented in the ParaView writer
    virtual void Load(int cycle_ = 0) override;
 
@@ -32,6 +32,7 @@ FiniteElement::FiniteElement(int D, Geometry::Type G, int Do, int O, int F)
    DerivRangeType = SCALAR;
    DerivMapType = VALUE;
    for (int i = 0; i < Geometry::MaxDim; i++) { Orders[i] = -1; }
+   dof2quad_list = NULL;
 #ifndef MFEM_THREAD_SAFE
    vshape.SetSize(Dof, Dim);
 #endif
@@ -203,19 +204,67 @@ void FiniteElement::CalcPhysDShape(ElementTransformation &Trans,
    Mult(vshape, Trans.InverseJacobian(), dshape);
 }
 
+void DofToQuad::GetShape(int q, Vector &shape) const
+{
+   MFEM_ASSERT(mode == FULL && shape.Size() == ndof, "");
+   const double *Bt_q = Bt.GetData() + ndof*q;
+   for (int j = 0; j < ndof; j++) { shape(j) = Bt_q[j]; }
+}
+
+void DofToQuad::GetDShape(int q, DenseMatrix &dshape) const
+{
+   const int dim = dshape.Width();
+   MFEM_ASSERT(mode == FULL && dshape.Height() == ndof &&
+               Gt.Size() == ndof*nqpt*dim, "");
+   for (int d = 0; d < dim; d++)
+   {
+      const double *Gt_qd = Gt.GetData() + ndof*(q + nqpt*d);
+      for (int j = 0; j < ndof; j++) { dshape(j,d) = Gt_qd[j]; }
+   }
+}
+
 const DofToQuad &FiniteElement::GetDofToQuad(const IntegrationRule &,
                                              DofToQuad::Mode) const
 {
    mfem_error("FiniteElement::GetDofToQuad(...) is not implemented for "
               "this element!");
-   return *dof2quad_array[0]; // suppress a warning
+   return *dof2quad_list.load()->d2q; // suppress a warning
+}
+
+std::mutex FiniteElement::dof2quad_mutex;
+
+const DofToQuad *FiniteElement::FindDofToQuad(const IntegrationRule &ir,
+                                              DofToQuad::Mode mode) const
+{
+   for (const DofToQuadNode *node =
+           dof2quad_list.load(std::memory_order_acquire);
+        node; node = node->next)
+   {
+      if (node->d2q->IntRule == &ir && node->d2q->mode == mode)
+      {
+         return node->d2q;
+      }
+   }
+   return NULL;
+}
+
+void FiniteElement::AddDofToQuad(DofToQuad *d2q) const
+{
+   DofToQuadNode *node = new DofToQuadNode;
+   node->d2q = d2q;
+   node->next = dof2quad_list.load(std::memory_order_relaxed);
+   dof2quad_list.store(node, std::memory_order_release);
 }
 
 FiniteElement::~FiniteElement()
 {
-   for (int i = 0; i < dof2quad_array.Size(); i++)
+   DofToQuadNode *node = dof2quad_list.load();
+   while (node)
    {
-      delete dof2quad_array[i];
+      DofToQuadNode *next = node->next;
+      delete node->d2q;
+      delete node;
+      node = next;
    }
 }
 
@@ -299,11 +348,11 @@ const DofToQuad &ScalarFiniteElement::GetDofToQuad(const IntegrationRule &ir,
 {
    MFEM_VERIFY(mode == DofToQuad::FULL, "invalid mode requested");
 
-   for (int i = 0; i < dof2quad_array.Size(); i++)
-   {
-      const DofToQuad &d2q = *dof2quad_array[i];
-      if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
-   }
+   const DofToQuad *found = FindDofToQuad(ir, mode);
+   if (found) { return *found; }
+   std::lock_guard<std::mutex> lock(dof2quad_mutex);
+   found = FindDofToQuad(ir, mode);
+   if (found) { return *found; }
 
    DofToQuad *d2q = new DofToQuad;
    const int nqpt = ir.GetNPoints();
@@ -337,7 +386,7 @@ const DofToQuad &ScalarFiniteElement::GetDofToQuad(const IntegrationRule &ir,
          }
       }
    }
-   dof2quad_array.Append(d2q);
+   AddDofToQuad(d2q);
    return *d2q;
 }
 
@@ -348,11 +397,11 @@ const DofToQuad &ScalarFiniteElement::GetTensorDofToQuad(
 {
    MFEM_VERIFY(mode == DofToQuad::TENSOR, "invalid mode requested");
 
-   for (int i = 0; i < dof2quad_array.Size(); i++)
-   {
-      const DofToQuad &d2q = *dof2quad_array[i];
-      if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
-   }
+   const DofToQuad *found = FindDofToQuad(ir, mode);
+   if (found) { return *found; }
+   std::lock_guard<std::mutex> lock(dof2quad_mutex);
+   found = FindDofToQuad(ir, mode);
+   if (found) { return *found; }
 
    DofToQuad *d2q = new DofToQuad;
    const Poly_1D::Basis &basis_1d = tb.GetBasis1D();
@@ -379,7 +428,7 @@ const DofToQuad &ScalarFiniteElement::GetTensorDofToQuad(
          d2q->G[i+nqpt*j] = d2q->Gt[j+ndof*i] = grad(j);
       }
    }
-   dof2quad_array.Append(d2q);
+   AddDofToQuad(d2q);
    return *d2q;
 }
 
@@ -6645,16 +6694,24 @@ void Poly_1D::Basis::Eval(const double y, Vector &u, Vector &d) const
 
 const int *Poly_1D::Binom(const int p)
 {
-   if (binom.NumCols() <= p)
+   // The table is never reallocated, so the rows returned to other threads
+   // remain valid while new rows are added under the lock.
+   if (binom_size.load(std::memory_order_acquire) <= p)
    {
-      binom.SetSize(p + 1, p + 1);
-      for (int i = 0; i <= p; i++)
+      MFEM_VERIFY(p <= MaxBinomOrder, "order " << p << " is too large");
+      std::lock_guard<std::mutex> lock(binom_mutex);
+      if (binom.NumRows() == 0)
+      {
+         binom.SetSize(MaxBinomOrder + 1, MaxBinomOrder + 1);
+      }
+      for (int i = binom_size.load(std::memory_order_relaxed); i <= p; i++)
       {
          binom(i,0) = binom(i,i) = 1;
          for (int j = 1; j < i; j++)
          {
             binom(i,j) = binom(i-1,j) + binom(i-1,j-1);
          }
+         binom_size.store(i + 1, std::memory_order_release);
       }
    }
    return binom[p];
@@ -6892,6 +6949,7 @@ const double *Poly_1D::GetPoints(const int p, const int btype)
 
    if (qtype == Quadrature1D::Invalid) { return NULL; }
 
+   std::lock_guard<std::recursive_mutex> lock(containers_mutex);
    if (points_container.find(btype) == points_container.end())
    {
       points_container[btype] = new Array<double*>;
@@ -6913,6 +6971,7 @@ Poly_1D::Basis &Poly_1D::GetBasis(const int p, const int btype)
 {
    BasisType::Check(btype);
 
+   std::lock_guard<std::recursive_mutex> lock(containers_mutex);
    if ( bases_container.find(btype) == bases_container.end() )
    {
       // we haven't been asked for basis or points of this type yet
@@ -6957,6 +7016,8 @@ Poly_1D::~Poly_1D()
 }
 
 Array2D<int> Poly_1D::binom;
+std::atomic<int> Poly_1D::binom_size(0);
+std::mutex Poly_1D::binom_mutex;
 Poly_1D poly1d;
 
 
@@ -19,6 +19,8 @@
 #include "geom.hpp"
 
 #include <map>
+#include <atomic>
+#include <mutex>
 
 namespace mfem
 {
@@ -200,6 +202,17 @@ public:
        - #ndof x #nqpt, for H(div) vector elements (TODO), or
        - #ndof x #nqpt x cdim, for H(curl) vector elements (TODO). */
    Array<double> Gt;
+
+   /** @brief Copy the values of the basis functions at quadrature point @a q
+       into @a shape; FULL #mode and scalar elements only. */
+   /** The size (#ndof) of @a shape must be set in advance. */
+   void GetShape(int q, Vector &shape) const;
+
+   /** @brief Copy the reference gradients of the basis functions at
+       quadrature point @a q into @a dshape; FULL #mode and scalar elements
+       only. */
+   /** The size (#ndof x dim) of @a dshape must be set in advance. */
+   void GetDShape(int q, DenseMatrix &dshape) const;
 };
 
 
@@ -241,10 +254,30 @@ protected:
 #ifndef MFEM_THREAD_SAFE
    mutable DenseMatrix vshape; // Dof x Dim
 #endif
-   /// Container for all DofToQuad objects created by the FiniteElement.
+   /// Node of the list of DofToQuad objects created by the FiniteElement.
+   struct DofToQuadNode
+   {
+      DofToQuad *d2q;
+      DofToQuadNode *next;
+   };
+
+   /// List of all DofToQuad objects created by the FiniteElement.
    /** Multiple DofToQuad objects may be needed when different quadrature rules
-       or different DofToQuad::Mode are used. */
-   mutable Array<DofToQuad*> dof2quad_array;
+       or different DofToQuad::Mode are used. The list is searched without
+       locking by FindDofToQuad() and new objects are only added by
+       AddDofToQuad(), so that GetDofToQuad() is thread-safe. */
+   mutable std::atomic<DofToQuadNode*> dof2quad_list;
+
+   /// Mutex that must be locked while new DofToQuad objects are computed.
+   static std::mutex dof2quad_mutex;
+
+   /** @brief Return the DofToQuad object for the given rule and mode, or NULL
+       if it has not been created yet. */
+   const DofToQuad *FindDofToQuad(const IntegrationRule &ir,
+                                  DofToQuad::Mode mode) const;
+
+   /// Add a new DofToQuad object; #dof2quad_mutex must be locked.
+   void AddDofToQuad(DofToQuad *d2q) const;
 
 public:
    /// Enumeration for RangeType and DerivRangeType
@@ -516,6 +549,16 @@ public:
    virtual const DofToQuad &GetDofToQuad(const IntegrationRule &ir,
                                          DofToQuad::Mode mode) const;
 
+   /** @brief Return the values and reference gradients of the basis functions
+       at the points of @a ir, tabulated once and shared by all elements, or
+       NULL if the basis of this element can not be tabulated. */
+   /** The tables are the DofToQuad object in FULL mode, see GetDofToQuad(),
+       and are read with DofToQuad::GetShape() and DofToQuad::GetDShape(). The
+       rule @a ir must outlive this FiniteElement, e.g. a rule from IntRules.
+       The default implementation returns NULL. */
+   virtual const DofToQuad *GetShapeTables(const IntegrationRule &ir) const
+   { return NULL; }
+
    virtual ~FiniteElement();
 
    static bool IsClosedType(int b_type)
@@ -600,6 +643,9 @@ public:
 
    virtual const DofToQuad &GetDofToQuad(const IntegrationRule &ir,
                                          DofToQuad::Mode mode) const;
+
+   virtual const DofToQuad *GetShapeTables(const IntegrationRule &ir) const
+   { return &ScalarFiniteElement::GetDofToQuad(ir, DofToQuad::FULL); }
 };
 
 class NodalFiniteElement : public ScalarFiniteElement
@@ -1695,8 +1741,14 @@ private:
 
    PointsMap points_container;
    BasisMap  bases_container;
+   /// Protects the containers; recursive since GetBasis() calls GetPoints().
+   std::recursive_mutex containers_mutex;
 
+   /** Binomial coefficients, allocated once for all orders up to
+       MaxBinomOrder and filled on demand up to the order binom_size-1. */
    static Array2D<int> binom;
+   static std::atomic<int> binom_size;
+   static std::mutex binom_mutex;
 
    static void CalcMono(const int p, const double x, double *u);
    static void CalcMono(const int p, const double x, double *u, double *d);
@@ -1714,8 +1766,12 @@ private:
 public:
    Poly_1D() { }
 
+   /// The largest order for which all binomial coefficients fit in an int.
+   static const int MaxBinomOrder = 33;
+
    /** @brief Get a pointer to an array containing the binomial coefficients "p
-       choose k" for k=0,...,p for the given p. */
+       choose k" for k=0,...,p for the given p, 0 <= p <= MaxBinomOrder. This
+       method is thread-safe and the returned pointer stays valid. */
    static const int *Binom(const int p);
 
    /** @brief Get the coordinates of the points of the given BasisType,
@@ -2872,6 +2928,10 @@ public:
    Vector              &Weights    ()         const { return weights; }
    /// Update the NURBSFiniteElement according to the currently set knot vectors
    virtual void         SetOrder   ()         const { }
+
+   /// The basis depends on the current patch and element: no shared tables.
+   virtual const DofToQuad *GetShapeTables(const IntegrationRule &ir) const
+   { return NULL; }
 };
 
 class NURBS1DFiniteElement : public NURBSFiniteElement
@@ -669,7 +669,7 @@ void FiniteElementSpace::BuildConformingInterpolation() const
             GetEntityDofs(entity, slave.index, slave_dofs, master.Geom());
             if (!slave_dofs.Size()) { continue; }
 
-            slave.OrientedPointMatrix(T.GetPointMat());
+            list.OrientedPointMatrix(slave, T.GetPointMat());
             T.FinalizeTransformation();
             fe->GetLocalInterpolation(T, I);
 
@@ -2769,9 +2769,13 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    // Assuming all finite elements are the same.
    height = vdim*ne*dof;
    width = fes.GetVSize();
-   const bool dof_reorder = (e_ordering == ElementDofOrdering::LEXICOGRAPHIC);
+   // The lexicographic ordering of non-tensor elements, e.g. simplices, is
+   // their native ordering.
+   const bool dof_reorder = (e_ordering == ElementDofOrdering::LEXICOGRAPHIC) &&
+                            ne > 0 && dynamic_cast<const TensorBasisElement*>(
+                               fes.GetFE(0));
    const int *dof_map = NULL;
-   if (dof_reorder && ne > 0)
+   if (dof_reorder)
    {
       for (int e = 0; e < ne; ++e)
       {
@@ -2888,7 +2892,7 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
    fespace = &fes;
    qspace = NULL;
    IntRule = &ir;
-   use_tensor_products = true; // not implemented yet (not used)
+   use_tensor_products = true;
 
    if (fespace->GetNE() == 0) { return; }
    const FiniteElement *fe = fespace->GetFE(0);
@@ -2902,7 +2906,7 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
    fespace = &fes;
    qspace = &qs;
    IntRule = NULL;
-   use_tensor_products = true; // not implemented yet (not used)
+   use_tensor_products = true;
 
    if (fespace->GetNE() == 0) { return; }
    const FiniteElement *fe = fespace->GetFE(0);
@@ -3091,6 +3095,255 @@ void QuadratureInterpolator::Eval3D(
    });
 }
 
+template<const int T_D1D, const int T_Q1D>
+void QuadratureInterpolator::TensorEval2D(
+   const int NE,
+   const int vdim,
+   const DofToQuad &maps,
+   const Array<int> &dof_map,
+   const Vector &e_vec,
+   Vector &q_val,
+   Vector &q_der,
+   const int eval_flags)
+{
+   const int d1d = maps.ndof;
+   const int q1d = maps.nqpt;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = vdim;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_map = dof_map.Size() > 0;
+   auto M = dof_map.Read();
+   auto B = Reshape(maps.B.Read(), Q1D, D1D);
+   auto G = Reshape(maps.G.Read(), Q1D, D1D);
+   auto E = Reshape(e_vec.Read(), D1D*D1D, VDIM, NE);
+   auto val = Reshape(q_val.Write(), Q1D, Q1D, VDIM, NE);
+   auto der = Reshape(q_der.Write(), Q1D, Q1D, VDIM, 2, NE);
+   const bool use_val = eval_flags & VALUES;
+   const bool use_der = eval_flags & DERIVATIVES;
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      for (int c = 0; c < VDIM; ++c)
+      {
+         double sol_xy[max_Q1D][max_Q1D];
+         double grad_xy[max_Q1D][max_Q1D][2];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] = 0.0;
+               grad_xy[qy][qx][0] = 0.0;
+               grad_xy[qy][qx][1] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double sol_x[max_Q1D], grad_x[max_Q1D];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_x[qx] = 0.0;
+               grad_x[qx] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const int d = dx + D1D*dy;
+               const double s = E(use_map ? M[d] : d, c, e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] += B(qx,dx) * s;
+                  grad_x[qx] += G(qx,dx) * s;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy = B(qy,dy);
+               const double wgy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] += wy * sol_x[qx];
+                  grad_xy[qy][qx][0] += wy * grad_x[qx];
+                  grad_xy[qy][qx][1] += wgy * sol_x[qx];
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               if (use_val) { val(qx,qy,c,e) = sol_xy[qy][qx]; }
+               if (use_der)
+               {
+                  der(qx,qy,c,0,e) = grad_xy[qy][qx][0];
+                  der(qx,qy,c,1,e) = grad_xy[qy][qx][1];
+               }
+            }
+         }
+      }
+   });
+}
+
+template<const int T_D1D, const int T_Q1D>
+void QuadratureInterpolator::TensorEval3D(
+   const int NE,
+   const int vdim,
+   const DofToQuad &maps,
+   const Array<int> &dof_map,
+   const Vector &e_vec,
+   Vector &q_val,
+   Vector &q_der,
+   const int eval_flags)
+{
+   const int d1d = maps.ndof;
+   const int q1d = maps.nqpt;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = vdim;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_map = dof_map.Size() > 0;
+   auto M = dof_map.Read();
+   auto B = Reshape(maps.B.Read(), Q1D, D1D);
+   auto G = Reshape(maps.G.Read(), Q1D, D1D);
+   auto E = Reshape(e_vec.Read(), D1D*D1D*D1D, VDIM, NE);
+   auto val = Reshape(q_val.Write(), Q1D, Q1D, Q1D, VDIM, NE);
+   auto der = Reshape(q_der.Write(), Q1D, Q1D, Q1D, VDIM, 3, NE);
+   const bool use_val = eval_flags & VALUES;
+   const bool use_der = eval_flags & DERIVATIVES;
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      for (int c = 0; c < VDIM; ++c)
+      {
+         double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
+         double grad_xyz[max_Q1D][max_Q1D][max_Q1D][3];
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[qz][qy][qx] = 0.0;
+                  grad_xyz[qz][qy][qx][0] = 0.0;
+                  grad_xyz[qz][qy][qx][1] = 0.0;
+                  grad_xyz[qz][qy][qx][2] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double sol_xy[max_Q1D][max_Q1D];
+            double grad_xy[max_Q1D][max_Q1D][2];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] = 0.0;
+                  grad_xy[qy][qx][0] = 0.0;
+                  grad_xy[qy][qx][1] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double sol_x[max_Q1D], grad_x[max_Q1D];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] = 0.0;
+                  grad_x[qx] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const int d = dx + D1D*(dy + D1D*dz);
+                  const double s = E(use_map ? M[d] : d, c, e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_x[qx] += B(qx,dx) * s;
+                     grad_x[qx] += G(qx,dx) * s;
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy = B(qy,dy);
+                  const double wgy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xy[qy][qx] += wy * sol_x[qx];
+                     grad_xy[qy][qx][0] += wy * grad_x[qx];
+                     grad_xy[qy][qx][1] += wgy * sol_x[qx];
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz = B(qz,dz);
+               const double wgz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
+                     grad_xyz[qz][qy][qx][0] += wz * grad_xy[qy][qx][0];
+                     grad_xyz[qz][qy][qx][1] += wz * grad_xy[qy][qx][1];
+                     grad_xyz[qz][qy][qx][2] += wgz * sol_xy[qy][qx];
+                  }
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  if (use_val) { val(qx,qy,qz,c,e) = sol_xyz[qz][qy][qx]; }
+                  if (use_der)
+                  {
+                     for (int d = 0; d < 3; d++)
+                     {
+                        der(qx,qy,qz,c,d,e) = grad_xyz[qz][qy][qx][d];
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// Compute the determinants of the (dim x dim) derivative matrices at all
+// quadrature points, using the layout of QuadratureInterpolator::Mult.
+static void QuadratureDeterminants(const int dim, const int NQ, const int NE,
+                                   const Vector &q_der, Vector &q_det)
+{
+   auto D = Reshape(q_der.Read(), NQ, dim*dim, NE);
+   auto det = Reshape(q_det.Write(), NQ, NE);
+   if (dim == 2)
+   {
+      MFEM_FORALL(i, NQ*NE,
+      {
+         const int q = i % NQ, e = i / NQ;
+         det(q,e) = D(q,0,e)*D(q,3,e) - D(q,1,e)*D(q,2,e);
+      });
+   }
+   else
+   {
+      MFEM_FORALL(i, NQ*NE,
+      {
+         const int q = i % NQ, e = i / NQ;
+         det(q,e) = D(q,0,e) * (D(q,4,e) * D(q,8,e) - D(q,5,e) * D(q,7,e)) +
+                    D(q,3,e) * (D(q,2,e) * D(q,7,e) - D(q,1,e) * D(q,8,e)) +
+                    D(q,6,e) * (D(q,1,e) * D(q,5,e) - D(q,2,e) * D(q,4,e));
+      });
+   }
+}
+
 void QuadratureInterpolator::Mult(
    const Vector &e_vec, unsigned eval_flags,
    Vector &q_val, Vector &q_der, Vector &q_det) const
@@ -3102,6 +3355,70 @@ void QuadratureInterpolator::Mult(
    const FiniteElement *fe = fespace->GetFE(0);
    const IntegrationRule *ir =
       IntRule ? IntRule : &qspace->GetElementIntRule(0);
+   if (CanUseTensorProducts(*ir))
+   {
+      const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::TENSOR);
+      const Array<int> &dof_map =
+         dynamic_cast<const TensorBasisElement*>(fe)->GetDofMap();
+      const int d1d = maps.ndof;
+      const int q1d = maps.nqpt;
+      const int nq = ir->GetNPoints();
+      MFEM_VERIFY(vdim == dim || !(eval_flags & DETERMINANTS), "");
+      // The determinants are computed from the derivatives in a second pass
+      Vector tmp_der;
+      Vector &der = (eval_flags & DERIVATIVES) ? q_der : tmp_der;
+      unsigned flags = eval_flags & VALUES;
+      if (eval_flags & (DERIVATIVES | DETERMINANTS))
+      {
+         flags |= DERIVATIVES;
+         if (!(eval_flags & DERIVATIVES)) { tmp_der.SetSize(nq*vdim*dim*ne); }
+      }
+      void (*eval_func)(
+         const int NE,
+         const int vdim,
+         const DofToQuad &maps,
+         const Array<int> &dof_map,
+         const Vector &e_vec,
+         Vector &q_val,
+         Vector &q_der,
+         const int eval_flags) = NULL;
+      if (dim == 2)
+      {
+         switch ((d1d << 4) | q1d)
+         {
+            case 0x22: eval_func = &TensorEval2D<2,2>; break;
+            case 0x23: eval_func = &TensorEval2D<2,3>; break;
+            case 0x33: eval_func = &TensorEval2D<3,3>; break;
+            case 0x34: eval_func = &TensorEval2D<3,4>; break;
+            case 0x44: eval_func = &TensorEval2D<4,4>; break;
+            case 0x45: eval_func = &TensorEval2D<4,5>; break;
+            case 0x55: eval_func = &TensorEval2D<5,5>; break;
+            case 0x56: eval_func = &TensorEval2D<5,6>; break;
+            default:   eval_func = &TensorEval2D<>; break;
+         }
+      }
+      else
+      {
+         switch ((d1d << 4) | q1d)
+         {
+            case 0x22: eval_func = &TensorEval3D<2,2>; break;
+            case 0x23: eval_func = &TensorEval3D<2,3>; break;
+            case 0x33: eval_func = &TensorEval3D<3,3>; break;
+            case 0x34: eval_func = &TensorEval3D<3,4>; break;
+            case 0x44: eval_func = &TensorEval3D<4,4>; break;
+            case 0x45: eval_func = &TensorEval3D<4,5>; break;
+            case 0x55: eval_func = &TensorEval3D<5,5>; break;
+            case 0x56: eval_func = &TensorEval3D<5,6>; break;
+            default:   eval_func = &TensorEval3D<>; break;
+         }
+      }
+      eval_func(ne, vdim, maps, dof_map, e_vec, q_val, der, flags);
+      if (eval_flags & DETERMINANTS)
+      {
+         QuadratureDeterminants(dim, nq, ne, der, q_det);
+      }
+      return;
+   }
    const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::FULL);
    const int nd = maps.ndof;
    const int nq = maps.nqpt;
@@ -3232,11 +3549,459 @@ void QuadratureInterpolator::Mult(
    }
 }
 
+bool QuadratureInterpolator::CanUseTensorProducts(
+   const IntegrationRule &ir) const
+{
+   if (!use_tensor_products) { return false; }
+   const int dim = fespace->GetMesh()->Dimension();
+   const FiniteElement *fe = fespace->GetFE(0);
+   if ((dim != 2 && dim != 3) ||
+       !dynamic_cast<const TensorBasisElement*>(fe) ||
+       fespace->GetMesh()->GetNumGeometries(dim) != 1)
+   {
+      return false;
+   }
+   // Check that 'ir' is a tensor-product rule with the x-coordinate varying
+   // fastest, as assumed by the DofToQuad::TENSOR maps.
+   const int nq = ir.GetNPoints();
+   const int q1d = (int)floor(pow(nq, 1.0/dim) + 0.5);
+   if (q1d > MAX_Q1D || (dim == 2 ? q1d*q1d : q1d*q1d*q1d) != nq)
+   {
+      return false;
+   }
+   for (int q = 0; q < nq; q++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(q);
+      if (ip.x != ir.IntPoint(q % q1d).x ||
+          ip.y != ir.IntPoint(q1d*((q / q1d) % q1d)).y ||
+          (dim == 3 && ip.z != ir.IntPoint(q1d*q1d*(q / (q1d*q1d))).z))
+      {
+         return false;
+      }
+   }
+   return fe->GetOrder() + 1 <= MAX_D1D;
+}
+
+bool QuadratureInterpolator::CanEvaluate(const IntegrationRule &ir) const
+{
+   const int dim = fespace->GetMesh()->Dimension();
+   const int vdim = fespace->GetVDim();
+   if ((dim != 2 && dim != 3) || (vdim != 1 && vdim != dim)) { return false; }
+   if (fespace->GetNE() == 0 || CanUseTensorProducts(ir)) { return true; }
+   const int nd = fespace->GetFE(0)->GetDof();
+   const int nq = ir.GetNPoints();
+   return (dim == 2) ? (nd <= MAX_ND2D && nq <= MAX_NQ2D) :
+          (nd <= MAX_ND3D && nq <= MAX_NQ3D);
+}
+
+template<const int T_VDIM, const int T_ND, const int T_NQ>
+void QuadratureInterpolator::EvalTranspose2D(
+   const int NE,
+   const int vdim,
+   const DofToQuad &maps,
+   const Vector &q_val,
+   const Vector &q_der,
+   Vector &e_vec,
+   const int eval_flags)
+{
+   const int nd = maps.ndof;
+   const int nq = maps.nqpt;
+   const int ND = T_ND ? T_ND : nd;
+   const int NQ = T_NQ ? T_NQ : nq;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+   MFEM_VERIFY(VDIM <= MAX_VDIM2D, "");
+   auto Bt = Reshape(maps.Bt.Read(), ND, NQ);
+   auto Gt = Reshape(maps.Gt.Read(), ND, NQ, 2);
+   auto val = Reshape(q_val.Read(), NQ, VDIM, NE);
+   auto der = Reshape(q_der.Read(), NQ, VDIM, 2, NE);
+   auto E = Reshape(e_vec.Write(), ND, VDIM, NE);
+   const bool use_val = eval_flags & VALUES;
+   const bool use_der = eval_flags & DERIVATIVES;
+   MFEM_FORALL(e, NE,
+   {
+      const int ND = T_ND ? T_ND : nd;
+      const int NQ = T_NQ ? T_NQ : nq;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      for (int d = 0; d < ND; ++d)
+      {
+         // use MAX_VDIM2D to avoid "subscript out of range" warnings
+         double ed[MAX_VDIM2D];
+         for (int c = 0; c < VDIM; c++) { ed[c] = 0.0; }
+         for (int q = 0; q < NQ; ++q)
+         {
+            if (use_val)
+            {
+               const double b = Bt(d,q);
+               for (int c = 0; c < VDIM; c++) { ed[c] += b*val(q,c,e); }
+            }
+            if (use_der)
+            {
+               const double wx = Gt(d,q,0);
+               const double wy = Gt(d,q,1);
+               for (int c = 0; c < VDIM; c++)
+               {
+                  ed[c] += wx*der(q,c,0,e) + wy*der(q,c,1,e);
+               }
+            }
+         }
+         for (int c = 0; c < VDIM; c++) { E(d,c,e) = ed[c]; }
+      }
+   });
+}
+
+template<const int T_VDIM, const int T_ND, const int T_NQ>
+void QuadratureInterpolator::EvalTranspose3D(
+   const int NE,
+   const int vdim,
+   const DofToQuad &maps,
+   const Vector &q_val,
+   const Vector &q_der,
+   Vector &e_vec,
+   const int eval_flags)
+{
+   const int nd = maps.ndof;
+   const int nq = maps.nqpt;
+   const int ND = T_ND ? T_ND : nd;
+   const int NQ = T_NQ ? T_NQ : nq;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+   MFEM_VERIFY(VDIM <= MAX_VDIM3D, "");
+   auto Bt = Reshape(maps.Bt.Read(), ND, NQ);
+   auto Gt = Reshape(maps.Gt.Read(), ND, NQ, 3);
+   auto val = Reshape(q_val.Read(), NQ, VDIM, NE);
+   auto der = Reshape(q_der.Read(), NQ, VDIM, 3, NE);
+   auto E = Reshape(e_vec.Write(), ND, VDIM, NE);
+   const bool use_val = eval_flags & VALUES;
+   const bool use_der = eval_flags & DERIVATIVES;
+   MFEM_FORALL(e, NE,
+   {
+      const int ND = T_ND ? T_ND : nd;
+      const int NQ = T_NQ ? T_NQ : nq;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      for (int d = 0; d < ND; ++d)
+      {
+         // use MAX_VDIM3D to avoid "subscript out of range" warnings
+         double ed[MAX_VDIM3D];
+         for (int c = 0; c < VDIM; c++) { ed[c] = 0.0; }
+         for (int q = 0; q < NQ; ++q)
+         {
+            if (use_val)
+            {
+               const double b = Bt(d,q);
+               for (int c = 0; c < VDIM; c++) { ed[c] += b*val(q,c,e); }
+            }
+            if (use_der)
+            {
+               const double wx = Gt(d,q,0);
+               const double wy = Gt(d,q,1);
+               const double wz = Gt(d,q,2);
+               for (int c = 0; c < VDIM; c++)
+               {
+                  ed[c] += wx*der(q,c,0,e) + wy*der(q,c,1,e) +
+                           wz*der(q,c,2,e);
+               }
+            }
+         }
+         for (int c = 0; c < VDIM; c++) { E(d,c,e) = ed[c]; }
+      }
+   });
+}
+
+template<const int T_D1D, const int T_Q1D>
+void QuadratureInterpolator::TensorEvalTranspose2D(
+   const int NE,
+   const int vdim,
+   const DofToQuad &maps,
+   const Array<int> &dof_map,
+   const Vector &q_val,
+   const Vector &q_der,
+   Vector &e_vec,
+   const int eval_flags)
+{
+   const int d1d = maps.ndof;
+   const int q1d = maps.nqpt;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = vdim;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_map = dof_map.Size() > 0;
+   auto M = dof_map.Read();
+   auto Bt = Reshape(maps.Bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(maps.Gt.Read(), D1D, Q1D);
+   auto val = Reshape(q_val.Read(), Q1D, Q1D, VDIM, NE);
+   auto der = Reshape(q_der.Read(), Q1D, Q1D, VDIM, 2, NE);
+   auto E = Reshape(e_vec.Write(), D1D*D1D, VDIM, NE);
+   const bool use_val = eval_flags & VALUES;
+   const bool use_der = eval_flags & DERIVATIVES;
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      for (int c = 0; c < VDIM; ++c)
+      {
+         double sol_xy[max_D1D][max_D1D];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_xy[dy][dx] = 0.0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            // x-contractions of (val + d/dx) and of d/dy
+            double sol_x[max_D1D], sol_gy[max_D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] = 0.0;
+               sol_gy[dx] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double v = use_val ? val(qx,qy,c,e) : 0.0;
+               const double gx = use_der ? der(qx,qy,c,0,e) : 0.0;
+               const double gy = use_der ? der(qx,qy,c,1,e) : 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] += Bt(dx,qx)*v + Gt(dx,qx)*gx;
+                  sol_gy[dx] += Bt(dx,qx)*gy;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy = Bt(dy,qy);
+               const double wgy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] += wy*sol_x[dx] + wgy*sol_gy[dx];
+               }
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const int d = dx + D1D*dy;
+               E(use_map ? M[d] : d, c, e) = sol_xy[dy][dx];
+            }
+         }
+      }
+   });
+}
+
+template<const int T_D1D, const int T_Q1D>
+void QuadratureInterpolator::TensorEvalTranspose3D(
+   const int NE,
+   const int vdim,
+   const DofToQuad &maps,
+   const Array<int> &dof_map,
+   const Vector &q_val,
+   const Vector &q_der,
+   Vector &e_vec,
+   const int eval_flags)
+{
+   const int d1d = maps.ndof;
+   const int q1d = maps.nqpt;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = vdim;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_map = dof_map.Size() > 0;
+   auto M = dof_map.Read();
+   auto Bt = Reshape(maps.Bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(maps.Gt.Read(), D1D, Q1D);
+   auto val = Reshape(q_val.Read(), Q1D, Q1D, Q1D, VDIM, NE);
+   auto der = Reshape(q_der.Read(), Q1D, Q1D, Q1D, VDIM, 3, NE);
+   auto E = Reshape(e_vec.Write(), D1D*D1D*D1D, VDIM, NE);
+   const bool use_val = eval_flags & VALUES;
+   const bool use_der = eval_flags & DERIVATIVES;
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      for (int c = 0; c < VDIM; ++c)
+      {
+         double sol_xyz[max_D1D][max_D1D][max_D1D];
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xyz[dz][dy][dx] = 0.0;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            // xy-contractions of (val + d/dx + d/dy) and of d/dz
+            double sol_xy[max_D1D][max_D1D], sol_gz[max_D1D][max_D1D];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] = 0.0;
+                  sol_gz[dy][dx] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               // x-contractions of (val + d/dx), d/dy and d/dz
+               double sol_x[max_D1D], sol_gy[max_D1D], sol_z[max_D1D];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] = 0.0;
+                  sol_gy[dx] = 0.0;
+                  sol_z[dx] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double v = use_val ? val(qx,qy,qz,c,e) : 0.0;
+                  const double gx = use_der ? der(qx,qy,qz,c,0,e) : 0.0;
+                  const double gy = use_der ? der(qx,qy,qz,c,1,e) : 0.0;
+                  const double gz = use_der ? der(qx,qy,qz,c,2,e) : 0.0;
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double bx = Bt(dx,qx);
+                     sol_x[dx] += bx*v + Gt(dx,qx)*gx;
+                     sol_gy[dx] += bx*gy;
+                     sol_z[dx] += bx*gz;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy = Bt(dy,qy);
+                  const double wgy = Gt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xy[dy][dx] += wy*sol_x[dx] + wgy*sol_gy[dx];
+                     sol_gz[dy][dx] += wy*sol_z[dx];
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz = Bt(dz,qz);
+               const double wgz = Gt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xyz[dz][dy][dx] += wz*sol_xy[dy][dx] +
+                                            wgz*sol_gz[dy][dx];
+                  }
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const int d = dx + D1D*(dy + D1D*dz);
+                  E(use_map ? M[d] : d, c, e) = sol_xyz[dz][dy][dx];
+               }
+            }
+         }
+      }
+   });
+}
+
 void QuadratureInterpolator::MultTranspose(
    unsigned eval_flags, const Vector &q_val, const Vector &q_der,
    Vector &e_vec) const
 {
-   MFEM_ABORT("this method is not implemented yet");
+   MFEM_VERIFY(!(eval_flags & DETERMINANTS),
+               "DETERMINANTS are not supported in MultTranspose");
+   const int ne = fespace->GetNE();
+   if (ne == 0) { return; }
+   const int vdim = fespace->GetVDim();
+   const int dim = fespace->GetMesh()->Dimension();
+   const FiniteElement *fe = fespace->GetFE(0);
+   const IntegrationRule *ir =
+      IntRule ? IntRule : &qspace->GetElementIntRule(0);
+
+   if (CanUseTensorProducts(*ir))
+   {
+      const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::TENSOR);
+      const Array<int> &dof_map =
+         dynamic_cast<const TensorBasisElement*>(fe)->GetDofMap();
+      const int d1d = maps.ndof;
+      const int q1d = maps.nqpt;
+      void (*eval_func)(
+         const int NE,
+         const int vdim,
+         const DofToQuad &maps,
+         const Array<int> &dof_map,
+         const Vector &q_val,
+         const Vector &q_der,
+         Vector &e_vec,
+         const int eval_flags) = NULL;
+      if (dim == 2)
+      {
+         switch ((d1d << 4) | q1d)
+         {
+            case 0x22: eval_func = &TensorEvalTranspose2D<2,2>; break;
+            case 0x23: eval_func = &TensorEvalTranspose2D<2,3>; break;
+            case 0x33: eval_func = &TensorEvalTranspose2D<3,3>; break;
+            case 0x34: eval_func = &TensorEvalTranspose2D<3,4>; break;
+            case 0x44: eval_func = &TensorEvalTranspose2D<4,4>; break;
+            case 0x45: eval_func = &TensorEvalTranspose2D<4,5>; break;
+            case 0x55: eval_func = &TensorEvalTranspose2D<5,5>; break;
+            case 0x56: eval_func = &TensorEvalTranspose2D<5,6>; break;
+            default:   eval_func = &TensorEvalTranspose2D<>; break;
+         }
+      }
+      else
+      {
+         switch ((d1d << 4) | q1d)
+         {
+            case 0x22: eval_func = &TensorEvalTranspose3D<2,2>; break;
+            case 0x23: eval_func = &TensorEvalTranspose3D<2,3>; break;
+            case 0x33: eval_func = &TensorEvalTranspose3D<3,3>; break;
+            case 0x34: eval_func = &TensorEvalTranspose3D<3,4>; break;
+            case 0x44: eval_func = &TensorEvalTranspose3D<4,4>; break;
+            case 0x45: eval_func = &TensorEvalTranspose3D<4,5>; break;
+            case 0x55: eval_func = &TensorEvalTranspose3D<5,5>; break;
+            case 0x56: eval_func = &TensorEvalTranspose3D<5,6>; break;
+            default:   eval_func = &TensorEvalTranspose3D<>; break;
+         }
+      }
+      eval_func(ne, vdim, maps, dof_map, q_val, q_der, e_vec, eval_flags);
+      return;
+   }
+
+   const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::FULL);
+   void (*eval_func)(
+      const int NE,
+      const int vdim,
+      const DofToQuad &maps,
+      const Vector &q_val,
+      const Vector &q_der,
+      Vector &e_vec,
+      const int eval_flags) = NULL;
+   if (dim == 2 && vdim <= MAX_VDIM2D)
+   {
+      eval_func = (vdim == 1) ? &EvalTranspose2D<1> : &EvalTranspose2D<2>;
+   }
+   else if (dim == 3 && vdim <= MAX_VDIM3D)
+   {
+      eval_func = (vdim == 1) ? &EvalTranspose3D<1> : &EvalTranspose3D<>;
+   }
+   if (eval_func)
+   {
+      eval_func(ne, vdim, maps, q_val, q_der, e_vec, eval_flags);
+   }
+   else
+   {
+      MFEM_ABORT("case not supported yet");
+   }
 }
 
 } // namespace mfem
@@ -662,6 +662,9 @@ public:
    /// Return the total number of quadrature points.
    int GetSize() const { return size; }
 
+   /// Returns the mesh
+   inline Mesh *GetMesh() const { return mesh; }
+
    /// Get the IntegrationRule associated with mesh element @a idx.
    const IntegrationRule &GetElementIntRule(int idx) const
    { return *int_rule[mesh->GetElementBaseGeometry(idx)]; }
@@ -947,6 +950,11 @@ protected:
    static const int MAX_ND3D = 1000;
    static const int MAX_VDIM3D = 3;
 
+   /** @brief Check if the sum-factorized kernels can be used, i.e. if tensor
+       products are enabled, the elements are tensor-product elements and
+       @a ir is a tensor-product rule. */
+   bool CanUseTensorProducts(const IntegrationRule &ir) const;
+
 public:
    enum EvalFlags
    {
@@ -966,11 +974,18 @@ public:
 
    /** @brief Disable the use of tensor product evaluations, for tensor-product
        elements, e.g. quads and hexes. */
-   /** Currently, tensor product evaluations are not implemented and this method
-       has no effect. */
+   /** Tensor product evaluations are used by Mult() and MultTranspose() when
+       the elements are tensor-product elements and the IntegrationRule is a
+       tensor-product rule, see CanUseTensorProducts(). */
    void DisableTensorProducts(bool disable = true) const
    { use_tensor_products = !disable; }
 
+   /** @brief Check if Mult() supports the space of the interpolator with the
+       given IntegrationRule, i.e. if the dimension, the vector dimension and
+       the number of dofs and quadrature points are within the limits of the
+       evaluation kernels. */
+   bool CanEvaluate(const IntegrationRule &ir) const;
+
    /// Interpolate the E-vector @a e_vec to quadrature points.
    /** The @a eval_flags are a bitwise mask of constants from the EvalFlags
        enumeration. When the VALUES flag is set, the values at quadrature points
@@ -979,11 +994,23 @@ public:
        When the DETERMINANTS flags is set, it is assumed that the derivatives
        form a matrix at each quadrature point (i.e. the associated
        FiniteElementSpace is a vector space) and their determinants are computed
-       and stored in @a q_det. */
+       and stored in @a q_det.
+
+       On tensor-product elements (quads and hexes) with a tensor-product
+       IntegrationRule, sum-factorized kernels are used, unless disabled with
+       DisableTensorProducts(). */
    void Mult(const Vector &e_vec, unsigned eval_flags,
              Vector &q_val, Vector &q_der, Vector &q_det) const;
 
-   /// Perform the transpose operation of Mult(). (TODO)
+   /// Perform the transpose operation of Mult().
+   /** The @a eval_flags can be VALUES and/or DERIVATIVES (DETERMINANTS is not
+       supported). The E-vector @a e_vec is set to the sum of the transposed
+       interpolation of @a q_val and of @a q_der, which use the same layouts as
+       in Mult(). The size of @a e_vec must be set by the caller.
+
+       On tensor-product elements (quads and hexes) with a tensor-product
+       IntegrationRule, sum-factorized kernels are used, unless disabled with
+       DisableTensorProducts(). */
    void MultTranspose(unsigned eval_flags, const Vector &q_val,
                       const Vector &q_der, Vector &e_vec) const;
 
@@ -1010,6 +1037,80 @@ public:
                       Vector &q_der,
                       Vector &q_det,
                       const int eval_flags);
+
+   /** @brief Sum-factorized compute kernel for VALUES and DERIVATIVES on 2D
+       tensor-product elements. */
+   /** The DofToQuad @a maps must use the TENSOR mode. The E-vector uses the
+       native element dof ordering, which is mapped to the lexicographic one
+       with @a dof_map; an empty @a dof_map denotes the identity. */
+   template<const int T_D1D = 0, const int T_Q1D = 0>
+   static void TensorEval2D(const int NE,
+                            const int vdim,
+                            const DofToQuad &maps,
+                            const Array<int> &dof_map,
+                            const Vector &e_vec,
+                            Vector &q_val,
+                            Vector &q_der,
+                            const int eval_flags);
+
+   /** @brief Sum-factorized compute kernel for VALUES and DERIVATIVES on 3D
+       tensor-product elements, see TensorEval2D(). */
+   template<const int T_D1D = 0, const int T_Q1D = 0>
+   static void TensorEval3D(const int NE,
+                            const int vdim,
+                            const DofToQuad &maps,
+                            const Array<int> &dof_map,
+                            const Vector &e_vec,
+                            Vector &q_val,
+                            Vector &q_der,
+                            const int eval_flags);
+
+   /// Template compute kernel for the transpose operation in 2D.
+   template<const int T_VDIM = 0, const int T_ND = 0, const int T_NQ = 0>
+   static void EvalTranspose2D(const int NE,
+                               const int vdim,
+                               const DofToQuad &maps,
+                               const Vector &q_val,
+                               const Vector &q_der,
+                               Vector &e_vec,
+                               const int eval_flags);
+
+   /// Template compute kernel for the transpose operation in 3D.
+   template<const int T_VDIM = 0, const int T_ND = 0, const int T_NQ = 0>
+   static void EvalTranspose3D(const int NE,
+                               const int vdim,
+                               const DofToQuad &maps,
+                               const Vector &q_val,
+                               const Vector &q_der,
+                               Vector &e_vec,
+                               const int eval_flags);
+
+   /** @brief Sum-factorized compute kernel for the transpose operation on
+       2D tensor-product elements. */
+   /** The DofToQuad @a maps must use the TENSOR mode. The E-vector uses the
+       native element dof ordering, which is mapped to the lexicographic one
+       with @a dof_map; an empty @a dof_map denotes the identity. */
+   template<const int T_D1D = 0, const int T_Q1D = 0>
+   static void TensorEvalTranspose2D(const int NE,
+                                     const int vdim,
+                                     const DofToQuad &maps,
+                                     const Array<int> &dof_map,
+                                     const Vector &q_val,
+                                     const Vector &q_der,
+                                     Vector &e_vec,
+                                     const int eval_flags);
+
+   /** @brief Sum-factorized compute kernel for the transpose operation on
+       3D tensor-product elements, see TensorEvalTranspose2D(). */
+   template<const int T_D1D = 0, const int T_Q1D = 0>
+   static void TensorEvalTranspose3D(const int NE,
+                                     const int vdim,
+                                     const DofToQuad &maps,
+                                     const Array<int> &dof_map,
+                                     const Vector &q_val,
+                                     const Vector &q_der,
+                                     Vector &e_vec,
+                                     const int eval_flags);
 };
 
 }
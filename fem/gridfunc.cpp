@@ -14,6 +14,7 @@
 #include "gridfunc.hpp"
 #include "../mesh/nurbs.hpp"
 #include "../general/text.hpp"
+#include "../general/forall.hpp"
 
 #include <limits>
 #include <cstring>
@@ -1890,10 +1891,203 @@ void GridFunction::ProjectBdrCoefficientTangent(
 #endif
 }
 
+// Compute the coordinates, with layout (NQ,DIM,NE), or the Jacobian
+// determinants, with layout (NQ,NE), of the mesh transformation by
+// interpolating the given nodal coordinates; @a flags is
+// QuadratureInterpolator::VALUES or DETERMINANTS. Returns false if the nodal
+// space is not supported by the QuadratureInterpolator.
+static bool QuadratureGeometry(const GridFunction &nodes,
+                               const IntegrationRule &ir, int flags,
+                               Vector &q_geom)
+{
+   const FiniteElementSpace &nfes = *nodes.FESpace();
+   const QuadratureInterpolator *qi = nfes.GetQuadratureInterpolator(ir);
+   if (!qi->CanEvaluate(ir)) { return false; }
+   const int dim = nfes.GetMesh()->Dimension();
+   const int nq = ir.GetNPoints();
+   const int ne = nfes.GetNE();
+   const Operator *elem_restr =
+      nfes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector e_vec(elem_restr->Height());
+   elem_restr->Mult(nodes, e_vec);
+   Vector q_unused;
+   if (flags == QuadratureInterpolator::VALUES)
+   {
+      q_geom.SetSize(nq*dim*ne);
+      qi->Mult(e_vec, flags, q_geom, q_unused, q_unused);
+   }
+   else
+   {
+      Vector q_der(nq*dim*dim*ne);
+      q_geom.SetSize(nq*ne);
+      qi->Mult(e_vec, flags, q_unused, q_der, q_geom);
+   }
+   return true;
+}
+
+static bool ComputeQuadratureGeometry(Mesh &mesh, const IntegrationRule &ir,
+                                      int flags, Vector &q_geom)
+{
+   if (mesh.GetNodes())
+   {
+      return QuadratureGeometry(*mesh.GetNodes(), ir, flags, q_geom);
+   }
+   // Interpolate the vertex coordinates in a temporary linear space, so that
+   // we do not add nodes to the mesh
+   const int dim = mesh.Dimension();
+   H1_FECollection lin_fec(1, dim);
+   FiniteElementSpace lin_fes(&mesh, &lin_fec, dim, Ordering::byVDIM);
+   GridFunction lin_nodes(&lin_fes);
+   mesh.GetNodes(lin_nodes);
+   return QuadratureGeometry(lin_nodes, ir, flags, q_geom);
+}
+
+bool ComputeQuadratureDeterminants(Mesh &mesh, const IntegrationRule &ir,
+                                   Vector &detJ)
+{
+   return ComputeQuadratureGeometry(mesh, ir,
+                                    QuadratureInterpolator::DETERMINANTS,
+                                    detJ);
+}
+
+bool ComputeQuadratureCoordinates(Mesh &mesh, const IntegrationRule &ir,
+                                  Vector &X)
+{
+   return ComputeQuadratureGeometry(mesh, ir, QuadratureInterpolator::VALUES,
+                                    X);
+}
+
+// Batched version of the Lp error computation: the GridFunction is evaluated
+// with the ElementRestriction and the QuadratureInterpolator, and the
+// coefficients with their bulk Project methods. The exact solution is given
+// either by the scalar coefficients exsol[0..vdim-1], or by vexsol. Returns
+// false if the space or the mesh are not supported, in which case the caller
+// uses the element-by-element loop.
+static bool ComputeLpErrorBatched(const GridFunction &u, const double p,
+                                  Coefficient *exsol[],
+                                  VectorCoefficient *vexsol,
+                                  Coefficient *weight,
+                                  VectorCoefficient *v_weight,
+                                  const IntegrationRule *irs[],
+                                  double &error)
+{
+   const FiniteElementSpace &fes = *u.FESpace();
+   Mesh &mesh = *fes.GetMesh();
+   const int ne = mesh.GetNE();
+   const int dim = mesh.Dimension();
+   const int vdim = fes.GetVDim();
+   if (ne == 0 || mesh.NURBSext || (dim != 2 && dim != 3) ||
+       mesh.SpaceDimension() != dim || (vdim != 1 && vdim != dim) ||
+       (vexsol && vexsol->GetVDim() != vdim) ||
+       (v_weight && v_weight->GetVDim() != vdim) ||
+       mesh.GetNumGeometries(dim) != 1 ||
+       !dynamic_cast<const ScalarFiniteElement*>(fes.GetFE(0)) ||
+       fes.GetFE(0)->GetMapType() != FiniteElement::VALUE)
+   {
+      return false;
+   }
+   const FiniteElement &fe = *fes.GetFE(0);
+   const IntegrationRule &ir = irs ? *irs[fe.GetGeomType()] :
+                               IntRules.Get(fe.GetGeomType(),
+                                            2*fe.GetOrder() + 1);
+   const int nq = ir.GetNPoints();
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   if (!qi->CanEvaluate(ir)) { return false; }
+
+   Vector detJ;
+   if (!ComputeQuadratureDeterminants(mesh, ir, detJ)) { return false; }
+
+   const Operator *elem_restr =
+      fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector e_vec(elem_restr->Height());
+   elem_restr->Mult(u, e_vec);
+   Vector u_q(nq*vdim*ne), q_der, q_det;
+   qi->Mult(e_vec, QuadratureInterpolator::VALUES, u_q, q_der, q_det);
+
+   Vector ex_q;
+   if (vexsol)
+   {
+      vexsol->Project(ex_q, mesh, ir);
+   }
+   else
+   {
+      ex_q.SetSize(nq*vdim*ne);
+      Vector c_q;
+      const int NQ = nq;
+      for (int c = 0; c < vdim; c++)
+      {
+         exsol[c]->Project(c_q, mesh, ir);
+         const int C = c;
+         auto src = Reshape(c_q.Read(), nq, ne);
+         auto dst = Reshape(ex_q.Write(), nq, vdim, ne);
+         MFEM_FORALL(i, nq*ne, dst(i % NQ, C, i / NQ) = src(i % NQ, i / NQ););
+      }
+   }
+   Vector w_q, vw_q;
+   if (weight) { weight->Project(w_q, mesh, ir); }
+   if (v_weight) { v_weight->Project(vw_q, mesh, ir); }
+
+   const int NQ = nq;
+   const int VDIM = vdim;
+   const bool use_w = weight;
+   const bool use_vw = v_weight;
+   const bool finite_p = (p < infinity());
+   Vector loc_err(nq*ne);
+   auto W = ir.GetWeights().Read();
+   auto J = Reshape(detJ.Read(), nq, ne);
+   auto U = Reshape(u_q.Read(), nq, vdim, ne);
+   auto EX = Reshape(ex_q.Read(), nq, vdim, ne);
+   auto CW = Reshape(w_q.Read(), nq, ne);
+   auto VW = Reshape(vw_q.Read(), nq, vdim, ne);
+   auto ERR = Reshape(loc_err.Write(), nq, ne);
+   MFEM_FORALL(i, NQ*ne,
+   {
+      const int q = i % NQ, e = i / NQ;
+      double err = 0.0;
+      for (int c = 0; c < VDIM; c++)
+      {
+         const double diff = U(q,c,e) - EX(q,c,e);
+         err += use_vw ? diff*VW(q,c,e) : diff*diff;
+      }
+      err = use_vw ? fabs(err) : sqrt(err);
+      if (finite_p) { err = pow(err, p); }
+      if (use_w) { err *= CW(q,e); }
+      ERR(q,e) = finite_p ? W[q] * J(q,e) * err : err;
+   });
+
+   if (finite_p)
+   {
+      error = loc_err.Sum();
+      // negative quadrature weights may cause the error to be negative
+      if (error < 0.)
+      {
+         error = -pow(-error, 1./p);
+      }
+      else
+      {
+         error = pow(error, 1./p);
+      }
+   }
+   else
+   {
+      error = 0.0;
+      const double *h_err = loc_err.HostRead();
+      for (int i = 0; i < loc_err.Size(); i++)
+      {
+         error = std::max(error, h_err[i]);
+      }
+   }
+   return true;
+}
+
 double GridFunction::ComputeL2Error(
    Coefficient *exsol[], const IntegrationRule *irs[]) const
 {
    double error = 0.0, a;
+   if (ComputeLpErrorBatched(*this, 2.0, exsol, NULL, NULL, NULL, irs, error))
+   {
+      return error;
+   }
    const FiniteElement *fe;
    ElementTransformation *transf;
    Vector shape;
@@ -1957,6 +2151,12 @@ double GridFunction::ComputeL2Error(
    DenseMatrix vals, exact_vals;
    Vector loc_errs;
 
+   if (elems == NULL &&
+       ComputeLpErrorBatched(*this, 2.0, NULL, &exsol, NULL, NULL, irs, error))
+   {
+      return error;
+   }
+
    for (int i = 0; i < fes->GetNE(); i++)
    {
       if (elems != NULL && (*elems)[i] == 0) { continue; }
@@ -2312,6 +2512,14 @@ double GridFunction::ComputeLpError(const double p, Coefficient &exsol,
    ElementTransformation *T;
    Vector vals;
 
+   Coefficient *exsol_ptr = &exsol;
+   if (fes->GetVDim() == 1 &&
+       ComputeLpErrorBatched(*this, p, &exsol_ptr, NULL, weight, NULL, irs,
+                             error))
+   {
+      return error;
+   }
+
    for (int i = 0; i < fes->GetNE(); i++)
    {
       fe = fes->GetFE(i);
@@ -2442,6 +2650,12 @@ double GridFunction::ComputeLpError(const double p, VectorCoefficient &exsol,
    DenseMatrix vals, exact_vals;
    Vector loc_errs;
 
+   if (ComputeLpErrorBatched(*this, p, NULL, &exsol, weight, v_weight, irs,
+                             error))
+   {
+      return error;
+   }
+
    for (int i = 0; i < fes->GetNE(); i++)
    {
       fe = fes->GetFE(i);
@@ -345,6 +345,11 @@ public:
                                  const IntegrationRule *irs[] = NULL) const
    { return ComputeLpError(1.0, exsol, NULL, NULL, irs); }
 
+   /** On meshes with a single element type and spaces of scalar VALUE-type
+       elements (e.g. H1 and L2), this and the other ComputeL*Error methods
+       evaluate the solution with the ElementRestriction and the
+       QuadratureInterpolator, and the coefficients with their batched Project
+       methods, instead of looping over the elements. */
    virtual double ComputeLpError(const double p, Coefficient &exsol,
                                  Coefficient *weight = NULL,
                                  const IntegrationRule *irs[] = NULL) const;
@@ -648,6 +653,24 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
 double ComputeElementLpDistance(double p, int i,
                                 GridFunction& gf1, GridFunction& gf2);
 
+/** @brief Compute the Jacobian determinants of all elements of @a mesh at the
+    points of @a ir, with layout (NQ,NE). */
+/** The determinants are computed with the QuadratureInterpolator of the mesh
+    nodes, or of the vertex coordinates for meshes without nodes; unlike
+    Mesh::GetGeometricFactors(), nodes are not added to the mesh and the result
+    is not cached. All elements must have the same geometry. Returns false if
+    the nodal space is not supported by the QuadratureInterpolator. */
+bool ComputeQuadratureDeterminants(Mesh &mesh, const IntegrationRule &ir,
+                                   Vector &detJ);
+
+/** @brief Compute the physical coordinates of the points of @a ir in all
+    elements of @a mesh, with layout (NQ,DIM,NE). */
+/** Like ComputeQuadratureDeterminants(), the coordinates are computed from
+    the current mesh nodes (or vertices) and are not cached, so they are also
+    correct after the mesh moves. */
+bool ComputeQuadratureCoordinates(Mesh &mesh, const IntegrationRule &ir,
+                                  Vector &X);
+
 
 /// Class used for extruding scalar GridFunctions
 class ExtrudeCoefficient : public Coefficient
@@ -17,6 +17,7 @@
 
 #include "fem.hpp"
 #include <cmath>
+#include <algorithm>
 
 #ifdef MFEM_USE_MPFR
 #include <mpfr.h>
@@ -856,6 +857,7 @@ IntegrationRules RefinedIntRules(1, Quadrature1D::GaussLegendre);
 IntegrationRules::IntegrationRules(int Ref, int _type):
    quad_type(_type)
 {
+   for (int g = 0; g < NumRuleArrays; g++) { ir_views[g] = NULL; }
    refined = Ref;
 
    if (refined < 0) { own_rules = 0; return; }
@@ -886,69 +888,108 @@ IntegrationRules::IntegrationRules(int Ref, int _type):
    CubeIntRules = NULL;
 }
 
-const IntegrationRule &IntegrationRules::Get(int GeomType, int Order)
+Array<IntegrationRule *> *IntegrationRules::GetIntRuleArray(int GeomType)
 {
-   Array<IntegrationRule *> *ir_array;
-
    switch (GeomType)
    {
-      case Geometry::POINT:       ir_array = &PointIntRules; Order = 0; break;
-      case Geometry::SEGMENT:     ir_array = &SegmentIntRules; break;
-      case Geometry::TRIANGLE:    ir_array = &TriangleIntRules; break;
-      case Geometry::SQUARE:      ir_array = &SquareIntRules; break;
-      case Geometry::TETRAHEDRON: ir_array = &TetrahedronIntRules; break;
-      case Geometry::CUBE:        ir_array = &CubeIntRules; break;
-      case Geometry::PRISM:       ir_array = &PrismIntRules; break;
+      case Geometry::POINT:       return &PointIntRules;
+      case Geometry::SEGMENT:     return &SegmentIntRules;
+      case Geometry::TRIANGLE:    return &TriangleIntRules;
+      case Geometry::SQUARE:      return &SquareIntRules;
+      case Geometry::TETRAHEDRON: return &TetrahedronIntRules;
+      case Geometry::CUBE:        return &CubeIntRules;
+      case Geometry::PRISM:       return &PrismIntRules;
       default:
-         mfem_error("IntegrationRules::Get(...) : Unknown geometry type!");
-         ir_array = NULL;
+         mfem_error("IntegrationRules : Unknown geometry type!");
    }
+   return NULL;
+}
 
+const IntegrationRule &IntegrationRules::Get(int GeomType, int Order)
+{
+   if (GeomType == Geometry::POINT) { Order = 0; }
    if (Order < 0)
    {
       Order = 0;
    }
 
-   if (!HaveIntRule(*ir_array, Order))
+   // Lock-free search in the published rules
+   if (0 <= GeomType && GeomType < NumRuleArrays)
    {
-#ifdef MFEM_USE_LEGACY_OPENMP
-      #pragma omp critical
-#endif
+      const Array<IntegrationRule *> *view =
+         ir_views[GeomType].load(std::memory_order_acquire);
+      if (view && Order < view->Size() && (*view)[Order] != NULL)
       {
-         if (!HaveIntRule(*ir_array, Order))
-         {
-            IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
-            int RealOrder = Order;
-            while (RealOrder+1 < ir_array->Size() &&
-            /*  */ (*ir_array)[RealOrder+1] == ir)
-            {
-               RealOrder++;
-            }
-            ir->SetOrder(RealOrder);
-         }
+         return *(*view)[Order];
       }
    }
 
+   std::lock_guard<std::mutex> lock(mtx);
+   Array<IntegrationRule *> *ir_array = GetIntRuleArray(GeomType);
+   if (!HaveIntRule(*ir_array, Order))
+   {
+      GenerateIfMissing(GeomType, Order);
+      PublishIntRules();
+   }
    return *(*ir_array)[Order];
 }
 
-void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
+void IntegrationRules::Pregenerate(int GeomType, int MaxOrder)
 {
-   Array<IntegrationRule *> *ir_array;
+   std::lock_guard<std::mutex> lock(mtx);
+   const int max_order = (GeomType == Geometry::POINT) ? 0 : MaxOrder;
+   for (int order = 0; order <= max_order; order++)
+   {
+      GenerateIfMissing(GeomType, order);
+   }
+   PublishIntRules();
+}
 
-   switch (GeomType)
+void IntegrationRules::GenerateIfMissing(int GeomType, int Order)
+{
+   Array<IntegrationRule *> *ir_array = GetIntRuleArray(GeomType);
+   if (HaveIntRule(*ir_array, Order)) { return; }
+
+   IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
+   int RealOrder = Order;
+   while (RealOrder+1 < ir_array->Size() &&
+   /*  */ (*ir_array)[RealOrder+1] == ir)
    {
-      case Geometry::POINT:       ir_array = &PointIntRules; break;
-      case Geometry::SEGMENT:     ir_array = &SegmentIntRules; break;
-      case Geometry::TRIANGLE:    ir_array = &TriangleIntRules; break;
-      case Geometry::SQUARE:      ir_array = &SquareIntRules; break;
-      case Geometry::TETRAHEDRON: ir_array = &TetrahedronIntRules; break;
-      case Geometry::CUBE:        ir_array = &CubeIntRules; break;
-      case Geometry::PRISM:       ir_array = &PrismIntRules; break;
-      default:
-         mfem_error("IntegrationRules::Set(...) : Unknown geometry type!");
-         ir_array = NULL;
+      RealOrder++;
    }
+   ir->SetOrder(RealOrder);
+}
+
+void IntegrationRules::PublishIntRules()
+{
+   for (int g = 0; g < NumRuleArrays; g++)
+   {
+      const Array<IntegrationRule *> &ir_array = *GetIntRuleArray(g);
+      // Skip the arrays that did not change since the last publication; a
+      // rule may also generate rules of other geometries, e.g. prism rules
+      const Array<IntegrationRule *> *old_view =
+         ir_views[g].load(std::memory_order_relaxed);
+      if (old_view && old_view->Size() == ir_array.Size() &&
+          std::equal(ir_array.begin(), ir_array.end(), old_view->begin()))
+      {
+         continue;
+      }
+      // Create the weights before the rules are shared between threads
+      for (int i = 0; i < ir_array.Size(); i++)
+      {
+         if (ir_array[i]) { ir_array[i]->GetWeights(); }
+      }
+      const Array<IntegrationRule *> *view =
+         ir_views[g].exchange(new Array<IntegrationRule *>(ir_array),
+                              std::memory_order_acq_rel);
+      if (view) { retired_views.Append(view); }
+   }
+}
+
+void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
+{
+   std::lock_guard<std::mutex> lock(mtx);
+   Array<IntegrationRule *> *ir_array = GetIntRuleArray(GeomType);
 
    if (HaveIntRule(*ir_array, Order))
    {
@@ -958,6 +999,7 @@ void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
    AllocIntRule(*ir_array, Order);
 
    (*ir_array)[Order] = &IntRule;
+   PublishIntRules();
 }
 
 void IntegrationRules::DeleteIntRuleArray(Array<IntegrationRule *> &ir_array)
@@ -979,6 +1021,15 @@ void IntegrationRules::DeleteIntRuleArray(Array<IntegrationRule *> &ir_array)
 
 IntegrationRules::~IntegrationRules()
 {
+   for (int g = 0; g < NumRuleArrays; g++)
+   {
+      delete ir_views[g].load();
+   }
+   for (int i = 0; i < retired_views.Size(); i++)
+   {
+      delete retired_views[i];
+   }
+
    if (!own_rules) { return; }
 
    DeleteIntRuleArray(PointIntRules);
@@ -1103,7 +1154,7 @@ IntegrationRule *IntegrationRules::SegmentIntegrationRule(int Order)
       }
    }
    SegmentIntRules[RealOrder-1] = SegmentIntRules[RealOrder] = ir;
-   return ir;
+   return SegmentIntRules[Order];
 }
 
 // Integration rules for reference triangle {[0,0],[1,0],[0,1]}
@@ -1496,10 +1547,8 @@ IntegrationRule *IntegrationRules::SquareIntegrationRule(int Order)
 {
    int RealOrder = GetSegmentRealOrder(Order);
    // Order is one of {RealOrder-1,RealOrder}
-   if (!HaveIntRule(SegmentIntRules, RealOrder))
-   {
-      SegmentIntegrationRule(RealOrder);
-   }
+   // Also sets the order of the segment rule, see PrismIntegrationRule()
+   GenerateIfMissing(Geometry::SEGMENT, RealOrder);
    AllocIntRule(SquareIntRules, RealOrder); // RealOrder >= Order
    SquareIntRules[RealOrder-1] =
       SquareIntRules[RealOrder] =
@@ -1620,8 +1669,11 @@ IntegrationRule *IntegrationRules::TetrahedronIntegrationRule(int Order)
 // Integration rules for reference prism
 IntegrationRule *IntegrationRules::PrismIntegrationRule(int Order)
 {
-   const IntegrationRule & irt = Get(Geometry::TRIANGLE, Order);
-   const IntegrationRule & irs = Get(Geometry::SEGMENT, Order);
+   // Called with #mtx locked, so Get() can not be used here
+   GenerateIfMissing(Geometry::TRIANGLE, Order);
+   GenerateIfMissing(Geometry::SEGMENT, Order);
+   const IntegrationRule & irt = *TriangleIntRules[Order];
+   const IntegrationRule & irs = *SegmentIntRules[Order];
    int nt = irt.GetNPoints();
    int ns = irs.GetNPoints();
    AllocIntRule(PrismIntRules, Order);
@@ -1648,10 +1700,8 @@ IntegrationRule *IntegrationRules::PrismIntegrationRule(int Order)
 IntegrationRule *IntegrationRules::CubeIntegrationRule(int Order)
 {
    int RealOrder = GetSegmentRealOrder(Order);
-   if (!HaveIntRule(SegmentIntRules, RealOrder))
-   {
-      SegmentIntegrationRule(RealOrder);
-   }
+   // Also sets the order of the segment rule, see PrismIntegrationRule()
+   GenerateIfMissing(Geometry::SEGMENT, RealOrder);
    AllocIntRule(CubeIntRules, RealOrder);
    CubeIntRules[RealOrder-1] =
       CubeIntRules[RealOrder] =
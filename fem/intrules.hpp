@@ -14,6 +14,8 @@
 
 #include "../config/config.hpp"
 #include "../general/array.hpp"
+#include <atomic>
+#include <mutex>
 
 namespace mfem
 {
@@ -94,6 +96,8 @@ private:
    int Order;
    /** @brief The quadrature weights gathered as a contiguous array. Created
        by request with the method GetWeights(). */
+   /** The rules returned by IntegrationRules::Get() have their weights created
+       before they are shared, so GetWeights() does not modify them. */
    mutable Array<double> weights;
 
    /// Sets the indices of each quadrature point on initialization.
@@ -325,6 +329,27 @@ private:
    Array<IntegrationRule *> PrismIntRules;
    Array<IntegrationRule *> CubeIntRules;
 
+   /// Number of rule arrays, one per Geometry::Type.
+   static const int NumRuleArrays = 7;
+
+   /** @brief Read-only copies of the rule arrays, indexed by Geometry::Type,
+       that are searched by Get() without locking. */
+   /** The arrays above are modified only while holding #mtx. After each
+       modification, new copies are published with release semantics; the old
+       copies may still be read by other threads, so they are kept in
+       #retired_views until the destruction of the object. */
+   std::atomic<const Array<IntegrationRule *> *> ir_views[NumRuleArrays];
+   Array<const Array<IntegrationRule *> *> retired_views;
+   std::mutex mtx;
+
+   Array<IntegrationRule *> *GetIntRuleArray(int GeomType);
+
+   /// Generate the rule if it does not exist; #mtx must be locked.
+   void GenerateIfMissing(int GeomType, int Order);
+
+   /// Publish copies of the modified rule arrays; #mtx must be locked.
+   void PublishIntRules();
+
    void AllocIntRule(Array<IntegrationRule *> &ir_array, int Order)
    {
       if (ir_array.Size() <= Order)
@@ -362,8 +387,16 @@ public:
                              int type = Quadrature1D::GaussLegendre);
 
    /// Returns an integration rule for given GeomType and Order.
+   /** This method is thread-safe: rules that already exist are found without
+       locking, and missing rules are generated while holding a lock. */
    const IntegrationRule &Get(int GeomType, int Order);
 
+   /** @brief Generate the rules for the given GeomType and all orders up to
+       @a MaxOrder. */
+   /** Calling this method at startup, e.g. before a multithreaded assembly,
+       ensures that Get() never needs to generate rules. */
+   void Pregenerate(int GeomType, int MaxOrder);
+
    void Set(int GeomType, int Order, IntegrationRule &IntRule);
 
    void SetOwnRules(int o) { own_rules = o; }
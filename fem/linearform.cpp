@@ -24,6 +24,7 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
 
    fes = f;
    extern_lfs = 1;
+   fast_assembly = lf->fast_assembly;
 
    // Copy the pointers to the integrators
    dlfi = lf->dlfi;
@@ -76,6 +77,16 @@ void LinearForm::AddBdrFaceIntegrator(LinearFormIntegrator *lfi,
    flfi_marker.Append(&bdr_attr_marker);
 }
 
+bool LinearForm::SupportsDevice() const
+{
+   if (!fast_assembly || dlfi.Size() == 0) { return false; }
+   for (int k = 0; k < dlfi.Size(); k++)
+   {
+      if (!dlfi[k]->SupportsDevice(*fes)) { return false; }
+   }
+   return true;
+}
+
 void LinearForm::Assemble()
 {
    Array<int> vdofs;
@@ -90,7 +101,22 @@ void LinearForm::Assemble()
    // The first use of AddElementVector() below will move it back to host
    // because both 'vdofs' and 'elemvect' are on host.
 
-   if (dlfi.Size())
+   if (SupportsDevice())
+   {
+      // Sum the element vectors of all integrators in one E-vector, and add it
+      // to this object on the device.
+      const Operator *elem_restr =
+         fes->GetElementRestriction(ElementDofOrdering::NATIVE);
+      Vector elem_vect(elem_restr->Height());
+      elem_vect.UseDevice(true);
+      elem_vect = 0.0;
+      for (int k = 0; k < dlfi.Size(); k++)
+      {
+         dlfi[k]->AssembleDevice(*fes, elem_vect);
+      }
+      elem_restr->MultTranspose(elem_vect, *this);
+   }
+   else if (dlfi.Size())
    {
       for (i = 0; i < fes -> GetNE(); i++)
       {
@@ -56,6 +56,9 @@ protected:
    /// Force (re)computation of delta locations.
    void ResetDeltaLocations() { dlfi_delta_elem_id.SetSize(0); }
 
+   /// If true, use AssembleDevice() for the domain integrators, when possible.
+   bool fast_assembly;
+
 private:
    /// Copy construction is not supported; body is undefined.
    LinearForm(const LinearForm &);
@@ -64,7 +67,7 @@ public:
    /// Creates linear form associated with FE space @a *f.
    /** The pointer @a f is not owned by the newly constructed object. */
    LinearForm(FiniteElementSpace *f) : Vector(f->GetVSize())
-   { fes = f; extern_lfs = 0; UseDevice(true); }
+   { fes = f; extern_lfs = 0; fast_assembly = false; UseDevice(true); }
 
    /** @brief Create a LinearForm on the FiniteElementSpace @a f, using the
        same integrators as the LinearForm @a lf.
@@ -79,7 +82,8 @@ public:
    /** The associated FiniteElementSpace can be set later using one of the
        methods: Update(FiniteElementSpace *) or
        Update(FiniteElementSpace *, Vector &, int). */
-   LinearForm() { fes = NULL; extern_lfs = 0; UseDevice(true); }
+   LinearForm()
+   { fes = NULL; extern_lfs = 0; fast_assembly = false; UseDevice(true); }
 
    /// Construct a LinearForm using previously allocated array @a data.
    /** The LinearForm does not assume ownership of @a data which is assumed to
@@ -87,7 +91,7 @@ public:
        for externally allocated array, the pointer @a data can be NULL. The data
        array can be replaced later using the method SetData(). */
    LinearForm(FiniteElementSpace *f, double *data) : Vector(data, f->GetVSize())
-   { fes = f; extern_lfs = 0; }
+   { fes = f; extern_lfs = 0; fast_assembly = false; }
 
    /// Copy assignment. Only the data of the base class Vector is copied.
    /** It is assumed that this object and @a rhs use FiniteElementSpace%s that
@@ -152,6 +156,20 @@ public:
        corresponding pointer (to Array<int>) will be NULL. */
    Array<Array<int>*> *GetFLFI_Marker() { return &flfi_marker; }
 
+   /** @brief Enable or disable the batched (device) assembly of the domain
+       integrators, see LinearFormIntegrator::AssembleDevice(). */
+   /** When enabled, and all domain integrators support it for the space #fes,
+       the domain integrals are computed at the quadrature points of all
+       elements at once and added with the transpose of the
+       ElementRestriction, without a loop over the elements on the host.
+       Otherwise, the element-by-element assembly is used. By default, fast
+       assembly is disabled. */
+   void UseFastAssembly(bool use_fa) { fast_assembly = use_fa; }
+
+   /** @brief Return true if fast assembly is enabled and all domain
+       integrators support it, see UseFastAssembly(). */
+   bool SupportsDevice() const;
+
    /// Assembles the linear form i.e. sums over all domain/bdr integrators.
    void Assemble();
 
@@ -12,6 +12,7 @@
 
 #include <cmath>
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 namespace mfem
 {
@@ -22,6 +23,64 @@ void LinearFormIntegrator::AssembleRHSElementVect(
    mfem_error("LinearFormIntegrator::AssembleRHSElementVect(...)");
 }
 
+void LinearFormIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                          Vector &elem_vect)
+{
+   MFEM_ABORT("AssembleDevice is not implemented for this integrator");
+}
+
+// Check if the domain integrals with the rule @a ir over the elements of @a fes
+// can be computed with the QuadratureInterpolator.
+static bool DomainDeviceSupported(const FiniteElementSpace &fes,
+                                  const IntegrationRule &ir)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int dim = mesh.Dimension();
+   if (mesh.NURBSext || (dim != 2 && dim != 3) ||
+       mesh.SpaceDimension() != dim || mesh.GetNumGeometries(dim) != 1 ||
+       !dynamic_cast<const ScalarFiniteElement*>(fes.GetFE(0)) ||
+       fes.GetFE(0)->GetMapType() != FiniteElement::VALUE)
+   {
+      return false;
+   }
+   return fes.GetQuadratureInterpolator(ir)->CanEvaluate(ir);
+}
+
+// Add to the E-vector @a elem_vect the integrals of the coefficient values
+// @a q_coeff, with layout (NQ,VDIM,NE), times the basis functions of @a fes.
+// The values in @a q_coeff are overwritten.
+static void AddDomainDevice(const FiniteElementSpace &fes,
+                            const IntegrationRule &ir, Vector &q_coeff,
+                            Vector &elem_vect)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int nq = ir.GetNPoints();
+   const int ne = fes.GetNE();
+   const int vdim = fes.GetVDim();
+   MFEM_VERIFY(q_coeff.Size() == nq*vdim*ne, "invalid coefficient size");
+   Vector detJ;
+   MFEM_VERIFY(ComputeQuadratureDeterminants(mesh, ir, detJ),
+               "the mesh nodes are not supported");
+
+   const int NQ = nq;
+   const int VDIM = vdim;
+   auto W = ir.GetWeights().Read();
+   auto J = Reshape(detJ.Read(), nq, ne);
+   auto C = Reshape(q_coeff.ReadWrite(), nq, vdim, ne);
+   MFEM_FORALL(i, NQ*ne,
+   {
+      const int q = i % NQ, e = i / NQ;
+      const double w = W[q]*J(q,e);
+      for (int c = 0; c < VDIM; c++) { C(q,c,e) *= w; }
+   });
+
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   Vector e_vec(elem_vect.Size()), q_der;
+   e_vec.UseDevice(true);
+   qi->MultTranspose(QuadratureInterpolator::VALUES, q_coeff, q_der, e_vec);
+   elem_vect += e_vec;
+}
+
 
 void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
                                                 ElementTransformation &Tr,
@@ -40,6 +99,8 @@ void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
       //                    oa * el.GetOrder() + ob + Tr.OrderW());
       ir = &IntRules.Get(el.GetGeomType(), oa * el.GetOrder() + ob);
    }
+   // The shape functions at the points of the global rules are tabulated once
+   const DofToQuad *tables = IntRule ? NULL : el.GetShapeTables(*ir);
 
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
@@ -48,12 +109,36 @@ void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
       Tr.SetIntPoint (&ip);
       double val = Tr.Weight() * Q.Eval(Tr, ip);
 
-      el.CalcShape(ip, shape);
+      if (tables) { tables->GetShape(i, shape); }
+      else { el.CalcShape(ip, shape); }
 
       add(elvect, ip.weight * val, shape, elvect);
    }
 }
 
+bool DomainLFIntegrator::SupportsDevice(const FiniteElementSpace &fes) const
+{
+   if (fes.GetNE() == 0) { return false; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule &ir = IntRule ? *IntRule :
+                               IntRules.Get(el.GetGeomType(),
+                                            oa * el.GetOrder() + ob);
+   return DomainDeviceSupported(fes, ir);
+}
+
+void DomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                        Vector &elem_vect)
+{
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule &ir = IntRule ? *IntRule :
+                               IntRules.Get(el.GetGeomType(),
+                                            oa * el.GetOrder() + ob);
+   MFEM_VERIFY(fes.GetVDim() == 1, "the space must be scalar");
+   Vector q_coeff;
+   Q.Project(q_coeff, *fes.GetMesh(), ir);
+   AddDomainDevice(fes, ir, q_coeff, elem_vect);
+}
+
 void DomainLFIntegrator::AssembleDeltaElementVect(
    const FiniteElement &fe, ElementTransformation &Trans, Vector &elvect)
 {
@@ -79,6 +164,7 @@ void BoundaryLFIntegrator::AssembleRHSElementVect(
       int intorder = oa * el.GetOrder() + ob;  // <----------
       ir = &IntRules.Get(el.GetGeomType(), intorder);
    }
+   const DofToQuad *tables = IntRule ? NULL : el.GetShapeTables(*ir);
 
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
@@ -87,7 +173,8 @@ void BoundaryLFIntegrator::AssembleRHSElementVect(
       Tr.SetIntPoint (&ip);
       double val = Tr.Weight() * Q.Eval(Tr, ip);
 
-      el.CalcShape(ip, shape);
+      if (tables) { tables->GetShape(i, shape); }
+      else { el.CalcShape(ip, shape); }
 
       add(elvect, ip.weight * val, shape, elvect);
    }
@@ -207,6 +294,28 @@ void VectorDomainLFIntegrator::AssembleRHSElementVect(
    }
 }
 
+bool VectorDomainLFIntegrator::SupportsDevice(
+   const FiniteElementSpace &fes) const
+{
+   if (fes.GetNE() == 0) { return false; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule &ir = IntRule ? *IntRule :
+                               IntRules.Get(el.GetGeomType(), 2*el.GetOrder());
+   return (fes.GetVDim() == Q.GetVDim() && DomainDeviceSupported(fes, ir));
+}
+
+void VectorDomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                              Vector &elem_vect)
+{
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule &ir = IntRule ? *IntRule :
+                               IntRules.Get(el.GetGeomType(), 2*el.GetOrder());
+   MFEM_VERIFY(fes.GetVDim() == Q.GetVDim(), "incompatible vector dimensions");
+   Vector q_coeff;
+   Q.Project(q_coeff, *fes.GetMesh(), ir);
+   AddDomainDevice(fes, ir, q_coeff, elem_vect);
+}
+
 void VectorDomainLFIntegrator::AssembleDeltaElementVect(
    const FiniteElement &fe, ElementTransformation &Trans, Vector &elvect)
 {
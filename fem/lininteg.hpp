@@ -18,6 +18,8 @@
 namespace mfem
 {
 
+class FiniteElementSpace;
+
 /// Abstract base class LinearFormIntegrator
 class LinearFormIntegrator
 {
@@ -36,6 +38,20 @@ public:
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
 
+   /** @brief Return true if AssembleDevice() can be used with the space
+       @a fes. The default implementation returns false. */
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const
+   { return false; }
+
+   /** @brief Add the element vectors of all elements of @a fes to the E-vector
+       @a elem_vect, using batched (device) kernels. */
+   /** The E-vector @a elem_vect uses the layout of the ElementRestriction of
+       @a fes with native element dof ordering, i.e. (ND,VDIM,NE). This method
+       is used by LinearForm::Assemble() when fast assembly is enabled, see
+       LinearForm::UseFastAssembly(), and SupportsDevice() returns true. */
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               Vector &elem_vect);
+
    void SetIntRule(const IntegrationRule *ir) { IntRule = ir; }
    const IntegrationRule* GetIntRule() { return IntRule; }
 
@@ -116,6 +132,11 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               Vector &elem_vect);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -198,6 +219,11 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               Vector &elem_vect);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
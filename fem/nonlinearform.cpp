@@ -38,6 +38,7 @@ void NonlinearForm::SetEssentialBC(const Array<int> &bdr_attr_is_ess,
 {
    // virtual call, works in parallel too
    fes->GetEssentialTrueDofs(bdr_attr_is_ess, ess_tdof_list);
+   delete extGrad; extGrad = NULL; // refers to the old ess_tdof_list
 
    if (rhs)
    {
@@ -76,6 +77,7 @@ void NonlinearForm::SetEssentialVDofs(const Array<int> &ess_vdofs_list)
       }
       FiniteElementSpace::MarkerToList(ess_tdof_marker, ess_tdof_list);
    }
+   delete extGrad; extGrad = NULL; // refers to the old ess_tdof_list
 }
 
 double NonlinearForm::GetGridFunctionEnergy(const Vector &x) const
@@ -138,6 +140,11 @@ void NonlinearForm::Mult(const Vector &x, Vector &y) const
    if (ext)
    {
       ext->Mult(px, py);
+      if (Serial())
+      {
+         if (cP) { cP->MultTranspose(py, y); }
+         y.SetSubVector(ess_tdof_list, 0.0);
+      }
       return;
    }
 
@@ -264,7 +271,14 @@ Operator &NonlinearForm::GetGradient(const Vector &x) const
 {
    if (ext)
    {
-      MFEM_ABORT("Not yet implemented!");
+      // The gradient is updated in place, so the constrained operator is
+      // created once and reused until the essential true dofs change.
+      Operator &grad = ext->GetGradient(Prolongate(x));
+      if (!extGrad)
+      {
+         extGrad = new ConstrainedOperator(&grad, ess_tdof_list);
+      }
+      return *extGrad;
    }
 
    const int skip_zeros = 0;
@@ -431,6 +445,7 @@ void NonlinearForm::Setup()
 
 NonlinearForm::~NonlinearForm()
 {
+   delete extGrad;
    delete cGrad;
    delete Grad;
    for (int i = 0; i <  dnfi.Size(); i++) { delete  dnfi[i]; }
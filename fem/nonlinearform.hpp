@@ -46,6 +46,9 @@ protected:
 
    mutable SparseMatrix *Grad, *cGrad; // owned
 
+   /// Gradient of the extension with essential b.c. imposed.
+   mutable ConstrainedOperator *extGrad; // owned
+
    /// A list of all essential true dofs
    Array<int> ess_tdof_list;
 
@@ -69,7 +72,7 @@ public:
        number of true degrees of freedom, i.e. f->GetTrueVSize(). */
    NonlinearForm(FiniteElementSpace *f)
       : Operator(f->GetTrueVSize()), assembly(AssemblyLevel::NONE),
-        ext(NULL), fes(f), Grad(NULL), cGrad(NULL),
+        ext(NULL), fes(f), Grad(NULL), cGrad(NULL), extGrad(NULL),
         sequence(f->GetSequence()), P(f->GetProlongationMatrix()),
         cP(dynamic_cast<const SparseMatrix*>(P))
    { }
@@ -116,7 +119,10 @@ public:
 
    /// Specify essential boundary conditions.
    void SetEssentialTrueDofs(const Array<int> &ess_tdof_list)
-   { ess_tdof_list.Copy(this->ess_tdof_list); }
+   {
+      ess_tdof_list.Copy(this->ess_tdof_list);
+      delete extGrad; extGrad = NULL; // refers to the old ess_tdof_list
+   }
 
    /// Return a (read-only) list of all essential true dofs.
    const Array<int> &GetEssentialTrueDofs() const { return ess_tdof_list; }
@@ -24,7 +24,8 @@ NonlinearFormExtension::NonlinearFormExtension(NonlinearForm *form)
 }
 
 PANonlinearFormExtension::PANonlinearFormExtension(NonlinearForm *form):
-   NonlinearFormExtension(form), fes(*form->FESpace())
+   NonlinearFormExtension(form), fes(*form->FESpace()),
+   elem_restrict_lex(NULL), grad(*this)
 {
    const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
    elem_restrict_lex = fes.GetElementRestriction(ordering);
@@ -71,4 +72,111 @@ void PANonlinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void PANonlinearFormExtension::MultGrad(const Vector &x, Vector &y) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *n->GetDNFI();
+   const int iSz = integrators.Size();
+   if (elem_restrict_lex)
+   {
+      elem_restrict_lex->Mult(x, localX);
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultGradPA(localX, localY);
+      }
+      elem_restrict_lex->MultTranspose(localY, y);
+   }
+   else
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultGradPA(x, y);
+      }
+   }
+}
+
+void PANonlinearFormExtension::AssembleGradDiagonal(Vector &diag) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *n->GetDNFI();
+   const int iSz = integrators.Size();
+   if (elem_restrict_lex)
+   {
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleGradDiagonalPA(localY);
+      }
+      elem_restrict_lex->MultTranspose(localY, diag);
+   }
+   else
+   {
+      diag.UseDevice(true);
+      diag = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleGradDiagonalPA(diag);
+      }
+   }
+}
+
+Operator &PANonlinearFormExtension::GetGradient(const Vector &x) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *n->GetDNFI();
+   const int iSz = integrators.Size();
+   const Vector *ex = &x;
+   if (elem_restrict_lex)
+   {
+      elem_restrict_lex->Mult(x, localX);
+      ex = &localX;
+   }
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AssembleGradPA(*ex, fes);
+   }
+   return grad;
+}
+
+PANonlinearFormExtension::Gradient::Gradient(const PANonlinearFormExtension &e)
+   : Operator(e.fes.GetTrueVSize()), ext(e),
+     P(e.fes.GetProlongationMatrix())
+{
+   if (IsIdentityProlongation(P)) { P = NULL; }
+   if (P)
+   {
+      px.SetSize(P->Height(), Device::GetMemoryType());
+      py.SetSize(P->Height(), Device::GetMemoryType());
+   }
+}
+
+void PANonlinearFormExtension::Gradient::Mult(const Vector &x, Vector &y) const
+{
+   if (P)
+   {
+      P->Mult(x, px);
+      ext.MultGrad(px, py);
+      P->MultTranspose(py, y);
+   }
+   else
+   {
+      ext.MultGrad(x, y);
+   }
+}
+
+void PANonlinearFormExtension::Gradient::AssembleDiagonal(Vector &diag) const
+{
+   MFEM_ASSERT(diag.Size() == Height(),
+               "Vector for holding diagonal has wrong size!");
+   if (P)
+   {
+      ext.AssembleGradDiagonal(py);
+      P->MultTranspose(py, diag);
+   }
+   else
+   {
+      ext.AssembleGradDiagonal(diag);
+   }
+}
+
 }
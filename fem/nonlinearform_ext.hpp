@@ -26,19 +26,53 @@ protected:
 public:
    NonlinearFormExtension(NonlinearForm *form);
    virtual void AssemblePA() = 0;
+
+   /** @brief Return the gradient of the form, as an Operator on the true dofs,
+       at the state @a x given as an L-vector (without essential b.c.). */
+   /** The returned object is valid until the next call to this method. */
+   virtual Operator &GetGradient(const Vector &x) const = 0;
 };
 
 /// Data and methods for partially-assembled nonlinear forms
 class PANonlinearFormExtension : public NonlinearFormExtension
 {
 protected:
+   /** @brief Gradient of a partially-assembled nonlinear form, acting on the
+       true dofs through the partially assembled gradient data of the domain
+       integrators. */
+   class Gradient : public Operator
+   {
+   protected:
+      const PANonlinearFormExtension &ext;
+      const Operator *P; // Not owned, NULL for identity prolongation
+      mutable Vector px, py;
+
+   public:
+      Gradient(const PANonlinearFormExtension &e);
+      virtual void Mult(const Vector &x, Vector &y) const;
+
+      /** @brief Assemble the diagonal of the gradient into @a diag.
+
+          As in BilinearForm::AssembleDiagonal, for non-conforming meshes this
+          returns P^T d_e, where d_e is the locally assembled diagonal. */
+      virtual void AssembleDiagonal(Vector &diag) const;
+   };
+
    const FiniteElementSpace &fes; // Not owned
    mutable Vector localX, localY;
    const Operator *elem_restrict_lex; // Not owned
+   mutable Gradient grad;
+
+   /// Action of the gradient on L-vectors
+   void MultGrad(const Vector &x, Vector &y) const;
+   /// Diagonal of the gradient as an L-vector
+   void AssembleGradDiagonal(Vector &diag) const;
+
 public:
    PANonlinearFormExtension(NonlinearForm*);
    void AssemblePA();
    void Mult(const Vector &x, Vector &y) const;
+   Operator &GetGradient(const Vector &x) const;
 };
 }
 #endif // NONLINEARFORM_EXT_HPP
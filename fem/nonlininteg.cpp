@@ -34,6 +34,25 @@ void NonlinearFormIntegrator::AddMultPA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void NonlinearFormIntegrator::AssembleGradPA(const Vector &,
+                                             const FiniteElementSpace &)
+{
+   mfem_error ("NonlinearFormIntegrator::AssembleGradPA(...)\n"
+               "   is not implemented for this class.");
+}
+
+void NonlinearFormIntegrator::AddMultGradPA(const Vector &, Vector &) const
+{
+   mfem_error ("NonlinearFormIntegrator::AddMultGradPA(...)\n"
+               "   is not implemented for this class.");
+}
+
+void NonlinearFormIntegrator::AssembleGradDiagonalPA(Vector &) const
+{
+   mfem_error ("NonlinearFormIntegrator::AssembleGradDiagonalPA(...)\n"
+               "   is not implemented for this class.");
+}
+
 void NonlinearFormIntegrator::AssembleElementVector(
    const FiniteElement &el, ElementTransformation &Tr,
    const Vector &elfun, Vector &elvect)
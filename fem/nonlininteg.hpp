@@ -89,6 +89,23 @@ public:
        called. */
    virtual void AddMultPA(const Vector &x, Vector &y) const;
 
+   /// Method defining partial assembly of the gradient.
+   /** Prepare the partially assembled gradient at the state @a x, given as an
+       E-vector, for the methods AddMultGradPA() and AssembleGradDiagonalPA().
+       This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   /// Method for partially assembled gradient action.
+   /** Perform the action of the gradient assembled by AssembleGradPA() on the
+       input @a x and add the result to the output @a y. Both @a x and @a y are
+       E-vectors. */
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
+   /** @brief Add the diagonal of the gradient assembled by AssembleGradPA() to
+       the E-vector @a diag. */
+   virtual void AssembleGradDiagonalPA(Vector &diag) const;
+
    virtual ~NonlinearFormIntegrator() { }
 };
 
@@ -314,6 +331,10 @@ private:
    Vector shape;
    // PA extension
    Vector pa_data;
+   /// Data of the gradient at the state u, with layout (NQ,dim,dim+1,NE):
+   /// [q,c,j,e] = sum_k du_c/dxi_k G_kj for j < dim, and
+   /// [q,k,dim,e] = sum_j G_kj u_j, where G = w Q adj(J) is stored in pa_data
+   Vector pa_grad;
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq;
@@ -340,6 +361,12 @@ public:
    virtual void AssemblePA(const FiniteElementSpace &fes);
 
    virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradDiagonalPA(Vector &diag) const;
 };
 
 }
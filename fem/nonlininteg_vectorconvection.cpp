@@ -813,4 +813,575 @@ void VectorConvectionNLFIntegrator::AddMultPA(const Vector &x, Vector &y) const
    MFEM_ABORT("Not yet implemented!");
 }
 
+// Maximum 1D sizes in the 3D gradient kernels
+constexpr int GRAD_MAX_D1D_3D = 8;
+constexpr int GRAD_MAX_Q1D_3D = 8;
+constexpr int GRAD_MAX_NQ_2D = MAX_Q1D*MAX_Q1D;
+constexpr int GRAD_MAX_NQ_3D = GRAD_MAX_Q1D_3D*GRAD_MAX_Q1D_3D*GRAD_MAX_Q1D_3D;
+
+// Size of the quadrature point arrays in the gradient kernels: exact when Q1D
+// is known at compile time, the maximum otherwise.
+MFEM_HOST_DEVICE constexpr int GradMaxNQ(const int dim, const int t_q1d)
+{
+   return t_q1d ? (dim == 2 ? t_q1d*t_q1d : t_q1d*t_q1d*t_q1d) :
+          (dim == 2 ? GRAD_MAX_NQ_2D : GRAD_MAX_NQ_3D);
+}
+
+// Values u and reference derivatives du, with layout (Q1D^2,2), at the
+// quadrature points of the function with coefficients x (layout D1D^2).
+MFEM_HOST_DEVICE static inline
+void ConvectionNLEval2D(const int D1D, const int Q1D, const double *B,
+                        const double *G, const double *x, double *u,
+                        double *du)
+{
+   const int NQ = Q1D*Q1D;
+   double ax[MAX_D1D][MAX_Q1D], gx[MAX_D1D][MAX_Q1D];
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         double a = 0.0, g = 0.0;
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = x[dx + D1D*dy];
+            a += B[qx + Q1D*dx] * s;
+            g += G[qx + Q1D*dx] * s;
+         }
+         ax[dy][qx] = a;
+         gx[dy][qx] = g;
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         double v = 0.0, d0 = 0.0, d1 = 0.0;
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double By = B[qy + Q1D*dy];
+            v += By * ax[dy][qx];
+            d0 += By * gx[dy][qx];
+            d1 += G[qy + Q1D*dy] * ax[dy][qx];
+         }
+         const int q = qx + Q1D*qy;
+         u[q] = v;
+         du[q] = d0;
+         du[q + NQ] = d1;
+      }
+   }
+}
+
+// Add to y (layout D1D^2) the integrals of the values z (layout Q1D^2) times
+// the basis functions.
+MFEM_HOST_DEVICE static inline
+void ConvectionNLEvalT2D(const int D1D, const int Q1D, const double *B,
+                         const double *z, double *y)
+{
+   double az[MAX_Q1D][MAX_D1D];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         double a = 0.0;
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            a += B[qx + Q1D*dx] * z[qx + Q1D*qy];
+         }
+         az[qy][dx] = a;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         double a = 0.0;
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            a += B[qy + Q1D*dy] * az[qy][dx];
+         }
+         y[dx + D1D*dy] += a;
+      }
+   }
+}
+
+// Values u and reference derivatives du, with layout (Q1D^3,3), at the
+// quadrature points of the function with coefficients x (layout D1D^3).
+template<int T_D1D = 0, int T_Q1D = 0> MFEM_HOST_DEVICE static inline
+void ConvectionNLEval3D(const int D1D, const int Q1D, const double *B,
+                        const double *G, const double *x, double *u,
+                        double *du)
+{
+   constexpr int MD1 = T_D1D ? T_D1D : GRAD_MAX_D1D_3D;
+   constexpr int MQ1 = T_Q1D ? T_Q1D : GRAD_MAX_Q1D_3D;
+   const int NQ = Q1D*Q1D*Q1D;
+   double ax[MD1][MD1][MQ1], gx[MD1][MD1][MQ1];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double a = 0.0, g = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = x[dx + D1D*(dy + D1D*dz)];
+               a += B[qx + Q1D*dx] * s;
+               g += G[qx + Q1D*dx] * s;
+            }
+            ax[dz][dy][qx] = a;
+            gx[dz][dy][qx] = g;
+         }
+      }
+   }
+   double axy[MD1][MQ1][MQ1], gxy0[MD1][MQ1][MQ1], gxy1[MD1][MQ1][MQ1];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double a = 0.0, g0 = 0.0, g1 = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double By = B[qy + Q1D*dy];
+               a += By * ax[dz][dy][qx];
+               g0 += By * gx[dz][dy][qx];
+               g1 += G[qy + Q1D*dy] * ax[dz][dy][qx];
+            }
+            axy[dz][qy][qx] = a;
+            gxy0[dz][qy][qx] = g0;
+            gxy1[dz][qy][qx] = g1;
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double v = 0.0, d0 = 0.0, d1 = 0.0, d2 = 0.0;
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double Bz = B[qz + Q1D*dz];
+               v += Bz * axy[dz][qy][qx];
+               d0 += Bz * gxy0[dz][qy][qx];
+               d1 += Bz * gxy1[dz][qy][qx];
+               d2 += G[qz + Q1D*dz] * axy[dz][qy][qx];
+            }
+            const int q = qx + Q1D*(qy + Q1D*qz);
+            u[q] = v;
+            du[q] = d0;
+            du[q + NQ] = d1;
+            du[q + 2*NQ] = d2;
+         }
+      }
+   }
+}
+
+// Add to y (layout D1D^3) the integrals of the values z (layout Q1D^3) times
+// the basis functions.
+template<int T_D1D = 0, int T_Q1D = 0> MFEM_HOST_DEVICE static inline
+void ConvectionNLEvalT3D(const int D1D, const int Q1D, const double *B,
+                         const double *z, double *y)
+{
+   constexpr int MD1 = T_D1D ? T_D1D : GRAD_MAX_D1D_3D;
+   constexpr int MQ1 = T_Q1D ? T_Q1D : GRAD_MAX_Q1D_3D;
+   double az[MQ1][MQ1][MD1];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double a = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               a += B[qx + Q1D*dx] * z[qx + Q1D*(qy + Q1D*qz)];
+            }
+            az[qz][qy][dx] = a;
+         }
+      }
+   }
+   double azy[MQ1][MD1][MD1];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double a = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               a += B[qy + Q1D*dy] * az[qz][qy][dx];
+            }
+            azy[qz][dy][dx] = a;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double a = 0.0;
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               a += B[qz + Q1D*dz] * azy[qz][dy][dx];
+            }
+            y[dx + D1D*(dy + D1D*dz)] += a;
+         }
+      }
+   }
+}
+
+// PA Convection NL gradient setup kernel: compute pa_grad from the state x.
+template<int DIM, int T_D1D = 0, int T_Q1D = 0>
+static void PAConvectionNLSetupGrad(const int NE,
+                                    const Array<double> &b,
+                                    const Array<double> &g,
+                                    const Vector &q_,
+                                    const Vector &x_,
+                                    Vector &grad_,
+                                    const int d1d = 0,
+                                    const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int ND = (DIM == 2) ? D1D*D1D : D1D*D1D*D1D;
+   const int NQ = (DIM == 2) ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   auto B = b.Read();
+   auto G = g.Read();
+   auto Q = Reshape(q_.Read(), NQ, DIM, DIM, NE);
+   auto x = Reshape(x_.Read(), ND, DIM, NE);
+   auto grad = Reshape(grad_.Write(), NQ, DIM, DIM + 1, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int NQ = (DIM == 2) ? Q1D*Q1D : Q1D*Q1D*Q1D;
+      constexpr int MQ = GradMaxNQ(DIM, T_Q1D);
+      double u[MQ], du[DIM*MQ];
+      for (int q = 0; q < NQ; ++q)
+      {
+         for (int k = 0; k < DIM; ++k) { grad(q, k, DIM, e) = 0.0; }
+      }
+      for (int c = 0; c < DIM; ++c)
+      {
+         const double *xc = &x(0, c, e);
+         if (DIM == 2) { ConvectionNLEval2D(D1D, Q1D, B, G, xc, u, du); }
+         else
+         {
+            ConvectionNLEval3D<T_D1D,T_Q1D>(D1D, Q1D, B, G, xc, u, du);
+         }
+         for (int q = 0; q < NQ; ++q)
+         {
+            for (int j = 0; j < DIM; ++j)
+            {
+               double s = 0.0;
+               for (int k = 0; k < DIM; ++k)
+               {
+                  s += du[q + NQ*k] * Q(q, k, j, e);
+               }
+               grad(q, c, j, e) = s;
+            }
+            for (int k = 0; k < DIM; ++k)
+            {
+               grad(q, k, DIM, e) += Q(q, k, c, e) * u[q];
+            }
+         }
+      }
+   });
+}
+
+// PA Convection NL gradient apply kernel
+template<int DIM, int T_D1D = 0, int T_Q1D = 0>
+static void PAConvectionNLApplyGrad(const int NE,
+                                    const Array<double> &b,
+                                    const Array<double> &g,
+                                    const Vector &grad_,
+                                    const Vector &x_,
+                                    Vector &y_,
+                                    const int d1d = 0,
+                                    const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int ND = (DIM == 2) ? D1D*D1D : D1D*D1D*D1D;
+   const int NQ = (DIM == 2) ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   auto B = b.Read();
+   auto G = g.Read();
+   auto grad = Reshape(grad_.Read(), NQ, DIM, DIM + 1, NE);
+   auto x = Reshape(x_.Read(), ND, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), ND, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int NQ = (DIM == 2) ? Q1D*Q1D : Q1D*Q1D*Q1D;
+      constexpr int MQ = GradMaxNQ(DIM, T_Q1D);
+      double u[DIM][MQ], du[DIM*MQ], Z[DIM][MQ];
+      // Z_c = (u.grad) x_c + (x.grad) u_c
+      for (int c = 0; c < DIM; ++c)
+      {
+         const double *xc = &x(0, c, e);
+         if (DIM == 2) { ConvectionNLEval2D(D1D, Q1D, B, G, xc, u[c], du); }
+         else
+         {
+            ConvectionNLEval3D<T_D1D,T_Q1D>(D1D, Q1D, B, G, xc, u[c], du);
+         }
+         for (int q = 0; q < NQ; ++q)
+         {
+            double s = 0.0;
+            for (int k = 0; k < DIM; ++k)
+            {
+               s += du[q + NQ*k] * grad(q, k, DIM, e);
+            }
+            Z[c][q] = s;
+         }
+      }
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            double s = Z[c][q];
+            for (int j = 0; j < DIM; ++j) { s += u[j][q] * grad(q, c, j, e); }
+            Z[c][q] = s;
+         }
+         if (DIM == 2) { ConvectionNLEvalT2D(D1D, Q1D, B, Z[c], &y(0, c, e)); }
+         else
+         {
+            ConvectionNLEvalT3D<T_D1D,T_Q1D>(D1D, Q1D, B, Z[c], &y(0, c, e));
+         }
+      }
+   });
+}
+
+// PA Convection NL gradient diagonal 2D kernel
+static void PAConvectionNLGradDiagonal2D(const int NE,
+                                         const Array<double> &b,
+                                         const Array<double> &g,
+                                         const Vector &grad_,
+                                         Vector &diag_,
+                                         const int D1D,
+                                         const int Q1D)
+{
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto grad = Reshape(grad_.Read(), Q1D, Q1D, 2, 3, NE);
+   auto diag = Reshape(diag_.ReadWrite(), D1D, D1D, 2, NE);
+   MFEM_FORALL(e, NE,
+   {
+      // diag = sum_q phi (phi grad(c,c) + dphi/dxi_k grad(k,2))
+      for (int c = 0; c < 2; ++c)
+      {
+         double A0[MAX_Q1D][MAX_D1D], A1[MAX_Q1D][MAX_D1D];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double a0 = 0.0, a1 = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double Bx = B(qx, dx), Gx = G(qx, dx);
+                  a0 += Bx * (Bx * grad(qx, qy, c, c, e) +
+                              Gx * grad(qx, qy, 0, 2, e));
+                  a1 += Bx * Bx * grad(qx, qy, 1, 2, e);
+               }
+               A0[qy][dx] = a0;
+               A1[qy][dx] = a1;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double By = B(qy, dy);
+                  s += By * (By * A0[qy][dx] + G(qy, dy) * A1[qy][dx]);
+               }
+               diag(dx, dy, c, e) += s;
+            }
+         }
+      }
+   });
+}
+
+// PA Convection NL gradient diagonal 3D kernel
+static void PAConvectionNLGradDiagonal3D(const int NE,
+                                         const Array<double> &b,
+                                         const Array<double> &g,
+                                         const Vector &grad_,
+                                         Vector &diag_,
+                                         const int D1D,
+                                         const int Q1D)
+{
+   constexpr int MD1 = GRAD_MAX_D1D_3D;
+   constexpr int MQ1 = GRAD_MAX_Q1D_3D;
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto grad = Reshape(grad_.Read(), Q1D, Q1D, Q1D, 3, 4, NE);
+   auto diag = Reshape(diag_.ReadWrite(), D1D, D1D, D1D, 3, NE);
+   MFEM_FORALL(e, NE,
+   {
+      // diag = sum_q phi (phi grad(c,c) + dphi/dxi_k grad(k,3))
+      for (int c = 0; c < 3; ++c)
+      {
+         double A0[MQ1][MQ1][MD1], A1[MQ1][MQ1][MD1], A2[MQ1][MQ1][MD1];
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double a0 = 0.0, a1 = 0.0, a2 = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double Bx = B(qx, dx), Gx = G(qx, dx);
+                     a0 += Bx * (Bx * grad(qx, qy, qz, c, c, e) +
+                                 Gx * grad(qx, qy, qz, 0, 3, e));
+                     a1 += Bx * Bx * grad(qx, qy, qz, 1, 3, e);
+                     a2 += Bx * Bx * grad(qx, qy, qz, 2, 3, e);
+                  }
+                  A0[qz][qy][dx] = a0;
+                  A1[qz][qy][dx] = a1;
+                  A2[qz][qy][dx] = a2;
+               }
+            }
+         }
+         double C0[MQ1][MD1][MD1], C1[MQ1][MD1][MD1];
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double c0 = 0.0, c1 = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     const double By = B(qy, dy);
+                     c0 += By * (By * A0[qz][qy][dx] +
+                                 G(qy, dy) * A1[qz][qy][dx]);
+                     c1 += By * By * A2[qz][qy][dx];
+                  }
+                  C0[qz][dy][dx] = c0;
+                  C1[qz][dy][dx] = c1;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double s = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     const double Bz = B(qz, dz);
+                     s += Bz * (Bz * C0[qz][dy][dx] +
+                                G(qz, dz) * C1[qz][dy][dx]);
+                  }
+                  diag(dx, dy, dz, c, e) += s;
+               }
+            }
+         }
+      }
+   });
+}
+
+void VectorConvectionNLFIntegrator::AssembleGradPA(const Vector &x,
+                                                   const FiniteElementSpace &)
+{
+   const int NE = ne;
+   const int D1D = maps->ndof;
+   const int Q1D = maps->nqpt;
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   pa_grad.SetSize(nq * dim * (dim + 1) * ne, Device::GetMemoryType());
+   if (dim == 2)
+   {
+      MFEM_VERIFY(D1D <= MAX_D1D && Q1D <= MAX_Q1D, "Not yet implemented!");
+      return PAConvectionNLSetupGrad<2>
+             (NE, B, G, pa_data, x, pa_grad, D1D, Q1D);
+   }
+   if (dim == 3)
+   {
+      const Vector &Q = pa_data;
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23:
+            return PAConvectionNLSetupGrad<3,2,3>(NE, B, G, Q, x, pa_grad);
+         case 0x34:
+            return PAConvectionNLSetupGrad<3,3,4>(NE, B, G, Q, x, pa_grad);
+         case 0x46:
+            return PAConvectionNLSetupGrad<3,4,6>(NE, B, G, Q, x, pa_grad);
+         case 0x57:
+            return PAConvectionNLSetupGrad<3,5,7>(NE, B, G, Q, x, pa_grad);
+         default:
+         {
+            MFEM_VERIFY(D1D <= GRAD_MAX_D1D_3D && Q1D <= GRAD_MAX_Q1D_3D,
+                        "Not yet implemented!");
+            return PAConvectionNLSetupGrad<3>
+                   (NE, B, G, Q, x, pa_grad, D1D, Q1D);
+         }
+      }
+   }
+   MFEM_ABORT("Not yet implemented!");
+}
+
+void VectorConvectionNLFIntegrator::AddMultGradPA(const Vector &x,
+                                                  Vector &y) const
+{
+   const int NE = ne;
+   const int D1D = maps->ndof;
+   const int Q1D = maps->nqpt;
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   if (dim == 2)
+   {
+      return PAConvectionNLApplyGrad<2>
+             (NE, B, G, pa_grad, x, y, D1D, Q1D);
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23:
+            return PAConvectionNLApplyGrad<3,2,3>(NE, B, G, pa_grad, x, y);
+         case 0x34:
+            return PAConvectionNLApplyGrad<3,3,4>(NE, B, G, pa_grad, x, y);
+         case 0x46:
+            return PAConvectionNLApplyGrad<3,4,6>(NE, B, G, pa_grad, x, y);
+         case 0x57:
+            return PAConvectionNLApplyGrad<3,5,7>(NE, B, G, pa_grad, x, y);
+         default:
+            return PAConvectionNLApplyGrad<3>
+                   (NE, B, G, pa_grad, x, y, D1D, Q1D);
+      }
+   }
+   MFEM_ABORT("Not yet implemented!");
+}
+
+void VectorConvectionNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
+{
+   const int NE = ne;
+   const int D1D = maps->ndof;
+   const int Q1D = maps->nqpt;
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   if (dim == 2)
+   {
+      return PAConvectionNLGradDiagonal2D(NE, B, G, pa_grad, diag, D1D, Q1D);
+   }
+   if (dim == 3)
+   {
+      return PAConvectionNLGradDiagonal3D(NE, B, G, pa_grad, diag, D1D, Q1D);
+   }
+   MFEM_ABORT("Not yet implemented!");
+}
+
 } // namespace mfem
@@ -22,6 +22,7 @@
 #include <climits> // INT_MAX
 #include <limits>
 #include <list>
+#include <map>
 
 namespace mfem
 {
@@ -1998,7 +1999,7 @@ int ParFiniteElementSpace
                GetEntityDofs(entity, sf.index, slave_dofs, mf.Geom());
                if (!slave_dofs.Size()) { continue; }
 
-               sf.OrientedPointMatrix(T.GetPointMat());
+               list.OrientedPointMatrix(sf, T.GetPointMat());
                T.FinalizeTransformation();
                fe->GetLocalInterpolation(T, I);
 
@@ -2427,7 +2428,10 @@ HypreParMatrix*
 ParFiniteElementSpace::RebalanceMatrix(int old_ndofs,
                                        const Table* old_elem_dof)
 {
-   MFEM_VERIFY(Nonconforming(), "Only supported for nonconforming meshes.");
+   if (Conforming())
+   {
+      return ConformingRebalanceMatrix(old_ndofs, old_elem_dof);
+   }
    MFEM_VERIFY(old_dof_offsets.Size(), "ParFiniteElementSpace::Update needs to "
                "be called before ParFiniteElementSpace::RebalanceMatrix");
 
@@ -2525,6 +2529,187 @@ ParFiniteElementSpace::RebalanceMatrix(int old_ndofs,
 }
 
 
+HypreParMatrix*
+ParFiniteElementSpace::ConformingRebalanceMatrix(int old_ndofs,
+                                                 const Table* old_elem_dof)
+{
+   MFEM_VERIFY(old_dof_offsets.Size(), "ParFiniteElementSpace::Update needs to "
+               "be called before ParFiniteElementSpace::RebalanceMatrix");
+
+   const Array<int> &old_rank = pmesh->GetRebalanceOldRanks();
+   const Array<int> &new_rank = pmesh->GetRebalanceNewRanks();
+   MFEM_VERIFY(old_rank.Size() == pmesh->GetNE() &&
+               new_rank.Size() == old_elem_dof->Size(),
+               "Mesh::Rebalance was not called before "
+               "ParFiniteElementSpace::RebalanceMatrix");
+
+   const bool assumed = HYPRE_AssumedPartitionCheck();
+   HYPRE_Int old_offset = assumed ? old_dof_offsets[0]
+                          : old_dof_offsets[MyRank];
+
+   // Send the old global (signed) vdofs of the elements we used to own to their
+   // new owners, in the order of the old elements. Both the old and the new
+   // local elements follow the global element order, so the receiver obtains
+   // them in the order of its new elements coming from the same rank. The
+   // message sizes are known on both sides, since an element has the same
+   // number of DOFs before and after the migration.
+   std::map<int, Array<HYPRE_Int> > send_dofs, recv_dofs;
+   for (int i = 0; i < new_rank.Size(); i++)
+   {
+      const int r = new_rank[i];
+      if (r == MyRank) { continue; } // elements that stay are handled locally
+
+      const int* old_dofs = old_elem_dof->GetRow(i);
+      const int nd = old_elem_dof->RowSize(i);
+      Array<HYPRE_Int> &buf = send_dofs[r];
+      for (int vd = 0; vd < vdim; vd++)
+      {
+         for (int j = 0; j < nd; j++)
+         {
+            int col = DofToVDof(old_dofs[j], vd, old_ndofs);
+            buf.Append((col >= 0) ? old_offset + col
+                       : -1 - (old_offset + (-1 - col)));
+         }
+      }
+   }
+   Array<int> dofs;
+   for (int i = 0; i < old_rank.Size(); i++)
+   {
+      const int r = old_rank[i];
+      if (r == MyRank) { continue; }
+
+      GetElementDofs(i, dofs);
+      Array<HYPRE_Int> &buf = recv_dofs[r];
+      buf.SetSize(buf.Size() + vdim * dofs.Size());
+   }
+
+   const int tag = 275;
+   std::vector<MPI_Request> requests;
+   requests.reserve(send_dofs.size() + recv_dofs.size());
+   std::map<int, Array<HYPRE_Int> >::iterator it;
+   for (it = recv_dofs.begin(); it != recv_dofs.end(); ++it)
+   {
+      requests.push_back(MPI_REQUEST_NULL);
+      MPI_Irecv(it->second.GetData(), it->second.Size(), HYPRE_MPI_INT,
+                it->first, tag, MyComm, &requests.back());
+   }
+   for (it = send_dofs.begin(); it != send_dofs.end(); ++it)
+   {
+      requests.push_back(MPI_REQUEST_NULL);
+      MPI_Isend(it->second.GetData(), it->second.Size(), HYPRE_MPI_INT,
+                it->first, tag, MyComm, &requests.back());
+   }
+   MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+   send_dofs.clear();
+
+   // For each new vdof, find one old vdof (preferably a local one) it is
+   // copied from. The value is multiplied by the product of the old and the
+   // new element DOF signs, since the orientation of the edges and faces may
+   // change with the new local vertex numbering.
+   const int vsize = GetVSize();
+   Array<HYPRE_Int> row_col(vsize);
+   Array<int> row_type(vsize); // 0 - none, 1 - offd, 2 - diag
+   Array<double> row_sign(vsize);
+   row_type = 0;
+
+   std::map<int, int> pos; // read position in each message
+   for (int i = 0, old_elem = 0; i < pmesh->GetNE(); i++)
+   {
+      const int r = old_rank[i];
+      const int *old_dofs = NULL;
+      const HYPRE_Int *remote_dofs = NULL;
+      if (r == MyRank)
+      {
+         while (new_rank[old_elem] != MyRank) { old_elem++; }
+         old_dofs = old_elem_dof->GetRow(old_elem++);
+      }
+      else
+      {
+         remote_dofs = &recv_dofs[r][pos[r]];
+      }
+
+      GetElementDofs(i, dofs);
+      for (int vd = 0, k = 0; vd < vdim; vd++)
+      {
+         for (int j = 0; j < dofs.Size(); j++, k++)
+         {
+            int row = DofToVDof(dofs[j], vd);
+            double sign = 1.0;
+            if (row < 0) { row = -1 - row; sign = -sign; }
+
+            if (old_dofs)
+            {
+               int col = DofToVDof(old_dofs[j], vd, old_ndofs);
+               if (col < 0) { col = -1 - col; sign = -sign; }
+               row_col[row] = col;
+               row_type[row] = 2;
+               row_sign[row] = sign;
+            }
+            else if (row_type[row] == 0)
+            {
+               HYPRE_Int col = remote_dofs[k];
+               if (col < 0) { col = -1 - col; sign = -sign; }
+               row_col[row] = col;
+               row_type[row] = 1;
+               row_sign[row] = sign;
+            }
+         }
+      }
+      if (r != MyRank) { pos[r] += vdim * dofs.Size(); }
+   }
+   recv_dofs.clear();
+
+   // assemble the diagonal and the offdiagonal part of the matrix
+   int nnz_diag = 0, nnz_offd = 0;
+   for (int i = 0; i < vsize; i++)
+   {
+      if (row_type[i] == 2) { nnz_diag++; }
+      else if (row_type[i] == 1) { nnz_offd++; }
+   }
+
+   HYPRE_Int *i_diag = new HYPRE_Int[vsize+1];
+   HYPRE_Int *j_diag = new HYPRE_Int[nnz_diag];
+   double *a_diag = new double[nnz_diag];
+   HYPRE_Int *i_offd = new HYPRE_Int[vsize+1];
+   HYPRE_Int *j_offd = new HYPRE_Int[nnz_offd];
+   double *a_offd = new double[nnz_offd];
+
+   Array<Pair<HYPRE_Int, int> > cmap_offd(nnz_offd);
+   i_diag[0] = i_offd[0] = 0;
+   for (int i = 0, kd = 0, ko = 0; i < vsize; i++)
+   {
+      if (row_type[i] == 2)
+      {
+         j_diag[kd] = row_col[i];
+         a_diag[kd++] = row_sign[i];
+      }
+      else if (row_type[i] == 1)
+      {
+         cmap_offd[ko].one = row_col[i];
+         cmap_offd[ko].two = ko;
+         a_offd[ko++] = row_sign[i];
+      }
+      i_diag[i+1] = kd;
+      i_offd[i+1] = ko;
+   }
+
+   // create the offd column map (distinct rows copy distinct old vdofs)
+   SortPairs<HYPRE_Int, int>(cmap_offd, nnz_offd);
+   HYPRE_Int *cmap = new HYPRE_Int[nnz_offd];
+   for (int i = 0; i < nnz_offd; i++)
+   {
+      cmap[i] = cmap_offd[i].one;
+      j_offd[cmap_offd[i].two] = i;
+   }
+
+   const int nrk = assumed ? 2 : NRanks;
+   return new HypreParMatrix(MyComm, dof_offsets[nrk], old_dof_offsets[nrk],
+                             dof_offsets, old_dof_offsets,
+                             i_diag, j_diag, a_diag, i_offd, j_offd, a_offd,
+                             nnz_offd, cmap);
+}
+
+
 struct DerefDofMessage
 {
    std::vector<HYPRE_Int> dofs;
@@ -165,6 +165,10 @@ private:
    HypreParMatrix* RebalanceMatrix(int old_ndofs,
                                    const Table* old_elem_dof);
 
+   /// Conforming version of RebalanceMatrix().
+   HypreParMatrix* ConformingRebalanceMatrix(int old_ndofs,
+                                             const Table* old_elem_dof);
+
    /** Calculate a GridFunction restriction matrix after mesh derefinement.
        The matrix is constructed so that the new grid function interpolates
        the original function, i.e., the original function is evaluated at the
@@ -0,0 +1,362 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class PointLocator
+
+#include "pointlocator.hpp"
+#include "../general/sort_pairs.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace mfem
+{
+
+PointLocator::PointLocator(Mesh &m, double bb_t)
+   : mesh(&m), bb_tol(bb_t), sdim(m.SpaceDimension())
+{
+   MFEM_VERIFY(1 <= sdim && sdim <= 3, "invalid space dimension: " << sdim);
+   Update();
+}
+
+void PointLocator::Update()
+{
+   ComputeBoundingBoxes();
+   BuildCells();
+}
+
+void PointLocator::ComputeBoundingBoxes()
+{
+   const int ne = mesh->GetNE();
+   const GridFunction *nodes = mesh->GetNodes();
+   bb_min.SetSize(sdim*ne);
+   bb_max.SetSize(sdim*ne);
+   for (int d = 0; d < 3; d++)
+   {
+      box_min[d] = std::numeric_limits<double>::max();
+      box_max[d] = -std::numeric_limits<double>::max();
+   }
+
+   Array<int> dofs;
+   Vector loc_nodes;
+   for (int e = 0; e < ne; e++)
+   {
+      double *e_min = bb_min.GetData() + sdim*e;
+      double *e_max = bb_max.GetData() + sdim*e;
+      for (int d = 0; d < sdim; d++)
+      {
+         e_min[d] = std::numeric_limits<double>::max();
+         e_max[d] = -std::numeric_limits<double>::max();
+      }
+      if (nodes)
+      {
+         // The element dofs are ordered by components: X...Y...Z...
+         nodes->FESpace()->GetElementVDofs(e, dofs);
+         nodes->GetSubVector(dofs, loc_nodes);
+         const int nd = dofs.Size()/sdim;
+         for (int d = 0; d < sdim; d++)
+         {
+            for (int j = 0; j < nd; j++)
+            {
+               e_min[d] = std::min(e_min[d], loc_nodes(j + nd*d));
+               e_max[d] = std::max(e_max[d], loc_nodes(j + nd*d));
+            }
+         }
+      }
+      else
+      {
+         mesh->GetElementVertices(e, dofs);
+         for (int j = 0; j < dofs.Size(); j++)
+         {
+            const double *v = mesh->GetVertex(dofs[j]);
+            for (int d = 0; d < sdim; d++)
+            {
+               e_min[d] = std::min(e_min[d], v[d]);
+               e_max[d] = std::max(e_max[d], v[d]);
+            }
+         }
+      }
+      // Enlarge the box: the nodes of curved elements do not bound the
+      // element, and points on the element boundary should not be missed
+      double size = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         size = std::max(size, e_max[d] - e_min[d]);
+      }
+      for (int d = 0; d < sdim; d++)
+      {
+         e_min[d] -= bb_tol*size;
+         e_max[d] += bb_tol*size;
+         box_min[d] = std::min(box_min[d], e_min[d]);
+         box_max[d] = std::max(box_max[d], e_max[d]);
+      }
+   }
+}
+
+void PointLocator::BuildCells()
+{
+   const int ne = mesh->GetNE();
+   for (int d = 0; d < 3; d++) { ncells[d] = 1; cell_h[d] = 1.0; }
+   if (ne == 0)
+   {
+      cell_elems.Clear();
+      return;
+   }
+
+   // Choose the cell size so that the number of cells is about the number of
+   // elements, ignoring directions in which the mesh is flat.
+   double vol = 1.0, max_ext = 0.0;
+   int nz_dims = 0;
+   for (int d = 0; d < sdim; d++)
+   {
+      max_ext = std::max(max_ext, box_max[d] - box_min[d]);
+   }
+   for (int d = 0; d < sdim; d++)
+   {
+      const double ext = box_max[d] - box_min[d];
+      if (ext > 1e-12*max_ext) { vol *= ext; nz_dims++; }
+   }
+   const double h = (nz_dims > 0) ? pow(vol/ne, 1.0/nz_dims) : 1.0;
+   for (int d = 0; d < sdim; d++)
+   {
+      const double ext = box_max[d] - box_min[d];
+      if (ext > 1e-12*max_ext)
+      {
+         ncells[d] = std::max(1, std::min((int)ceil(ext/h), ne));
+         cell_h[d] = ext/ncells[d];
+      }
+      else
+      {
+         cell_h[d] = std::max(ext, 1.0);
+      }
+   }
+   const int num_cells = ncells[0]*ncells[1]*ncells[2];
+
+   // Two passes: count the elements in each cell, then fill the table.
+   int lo[3], hi[3];
+   cell_elems.MakeI(num_cells);
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int e = 0; e < ne; e++)
+      {
+         for (int d = 0; d < 3; d++)
+         {
+            lo[d] = hi[d] = 0;
+            if (d >= sdim) { continue; }
+            lo[d] = (int)floor((bb_min(sdim*e+d) - box_min[d])/cell_h[d]);
+            hi[d] = (int)floor((bb_max(sdim*e+d) - box_min[d])/cell_h[d]);
+            lo[d] = std::max(0, std::min(lo[d], ncells[d]-1));
+            hi[d] = std::max(0, std::min(hi[d], ncells[d]-1));
+         }
+         for (int k = lo[2]; k <= hi[2]; k++)
+         {
+            for (int j = lo[1]; j <= hi[1]; j++)
+            {
+               for (int i = lo[0]; i <= hi[0]; i++)
+               {
+                  const int c = i + ncells[0]*(j + ncells[1]*k);
+                  if (pass == 0) { cell_elems.AddAColumnInRow(c); }
+                  else { cell_elems.AddConnection(c, e); }
+               }
+            }
+         }
+      }
+      if (pass == 0) { cell_elems.MakeJ(); }
+   }
+   cell_elems.ShiftUpI();
+}
+
+int PointLocator::GetCell(const double *x) const
+{
+   int c = 0;
+   for (int d = sdim-1; d >= 0; d--)
+   {
+      if (x[d] < box_min[d] || x[d] > box_max[d]) { return -1; }
+      int i = (int)floor((x[d] - box_min[d])/cell_h[d]);
+      i = std::min(i, ncells[d]-1);
+      c = c*ncells[d] + i;
+   }
+   return c;
+}
+
+int PointLocator::FindPoints(const DenseMatrix &point_mat,
+                             Array<int> &elem_ids,
+                             Array<IntegrationPoint> &ips)
+{
+   const int npts = point_mat.Width();
+   elem_ids.SetSize(npts);
+   ips.SetSize(npts);
+   elem_ids = -1;
+   if (npts == 0 || mesh->GetNE() == 0) { return 0; }
+   MFEM_VERIFY(point_mat.Height() == sdim, "invalid points matrix");
+
+   // Candidate elements of each point: the elements in the cell of the point
+   // whose bounding boxes contain the point, closest box center first.
+   Table cand;
+   cand.MakeI(npts);
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int k = 0; k < npts; k++)
+      {
+         const double *x = point_mat.GetColumn(k);
+         const int c = GetCell(x);
+         if (c < 0) { continue; }
+         const int *els = cell_elems.GetRow(c);
+         for (int j = 0; j < cell_elems.RowSize(c); j++)
+         {
+            const int e = els[j];
+            bool inside = true;
+            for (int d = 0; d < sdim && inside; d++)
+            {
+               inside = (bb_min(sdim*e+d) <= x[d] && x[d] <= bb_max(sdim*e+d));
+            }
+            if (!inside) { continue; }
+            if (pass == 0) { cand.AddAColumnInRow(k); }
+            else { cand.AddConnection(k, e); }
+         }
+      }
+      if (pass == 0) { cand.MakeJ(); }
+   }
+   cand.ShiftUpI();
+
+   int max_cand = 0;
+   Array<Pair<double,int> > dist_el;
+   for (int k = 0; k < npts; k++)
+   {
+      const double *x = point_mat.GetColumn(k);
+      const int nc = cand.RowSize(k);
+      int *els = cand.GetRow(k);
+      max_cand = std::max(max_cand, nc);
+      if (nc < 2) { continue; }
+      dist_el.SetSize(nc);
+      for (int j = 0; j < nc; j++)
+      {
+         double dist = 0.0;
+         for (int d = 0; d < sdim; d++)
+         {
+            const double ctr = 0.5*(bb_min(sdim*els[j]+d) +
+                                    bb_max(sdim*els[j]+d));
+            dist += (x[d] - ctr)*(x[d] - ctr);
+         }
+         dist_el[j] = Pair<double,int>(dist, els[j]);
+      }
+      SortPairs<double,int>(dist_el, nc);
+      for (int j = 0; j < nc; j++) { els[j] = dist_el[j].two; }
+   }
+
+   // In each round, test the unresolved points against their next candidate,
+   // grouping the tests by element.
+   int pts_found = 0;
+   Vector pt;
+   Array<Pair<int,int> > el_pt;
+   for (int r = 0; r < max_cand; r++)
+   {
+      el_pt.SetSize(0);
+      for (int k = 0; k < npts; k++)
+      {
+         if (elem_ids[k] >= 0 || r >= cand.RowSize(k)) { continue; }
+         el_pt.Append(Pair<int,int>(cand.GetRow(k)[r], k));
+      }
+      if (el_pt.Size() == 0) { break; }
+      SortPairs<int,int>(el_pt, el_pt.Size());
+      int prev_e = -1;
+      for (int i = 0; i < el_pt.Size(); i++)
+      {
+         const int e = el_pt[i].one, k = el_pt[i].two;
+         if (e != prev_e)
+         {
+            inv_tr.SetTransformation(*mesh->GetElementTransformation(e));
+            prev_e = e;
+         }
+         pt.SetDataAndSize(const_cast<double*>(point_mat.GetColumn(k)), sdim);
+         if (inv_tr.Transform(pt, ips[k]) == InverseElementTransformation::Inside)
+         {
+            elem_ids[k] = e;
+            pts_found++;
+         }
+      }
+   }
+   return pts_found;
+}
+
+void PointLocator::Interpolate(const GridFunction &gf,
+                               const Array<int> &elem_ids,
+                               const Array<IntegrationPoint> &ips,
+                               DenseMatrix &vals) const
+{
+   const FiniteElementSpace *fes = gf.FESpace();
+   MFEM_VERIFY(fes->GetMesh() == mesh, "incompatible GridFunction");
+   const int npts = elem_ids.Size();
+   const int vdim = gf.VectorDim();
+   const int ne = mesh->GetNE();
+   vals.SetSize(vdim, npts);
+   vals = 0.0;
+
+   // Group the points by element
+   Table el_pts;
+   el_pts.MakeI(ne);
+   for (int k = 0; k < npts; k++)
+   {
+      if (elem_ids[k] >= 0) { el_pts.AddAColumnInRow(elem_ids[k]); }
+   }
+   el_pts.MakeJ();
+   for (int k = 0; k < npts; k++)
+   {
+      if (elem_ids[k] >= 0) { el_pts.AddConnection(elem_ids[k], k); }
+   }
+   el_pts.ShiftUpI();
+
+   Array<int> vdofs;
+   Vector loc_data, shape, val;
+   DenseMatrix vshape;
+   for (int e = 0; e < ne; e++)
+   {
+      const int np = el_pts.RowSize(e);
+      if (np == 0) { continue; }
+      const int *pts = el_pts.GetRow(e);
+      const FiniteElement *fe = fes->GetFE(e);
+      ElementTransformation *T = mesh->GetElementTransformation(e);
+      fes->GetElementVDofs(e, vdofs);
+      gf.GetSubVector(vdofs, loc_data);
+      const int nd = fe->GetDof();
+      if (fe->GetRangeType() == FiniteElement::SCALAR)
+      {
+         shape.SetSize(nd);
+         for (int j = 0; j < np; j++)
+         {
+            const int k = pts[j];
+            T->SetIntPoint(&ips[k]);
+            fe->CalcPhysShape(*T, shape);
+            for (int c = 0; c < vdim; c++)
+            {
+               double v = 0.0;
+               for (int i = 0; i < nd; i++) { v += shape(i)*loc_data(i+nd*c); }
+               vals(c,k) = v;
+            }
+         }
+      }
+      else
+      {
+         vshape.SetSize(nd, vdim);
+         for (int j = 0; j < np; j++)
+         {
+            const int k = pts[j];
+            T->SetIntPoint(&ips[k]);
+            fe->CalcVShape(*T, vshape);
+            vals.GetColumnReference(k, val);
+            vshape.MultTranspose(loc_data, val);
+         }
+      }
+   }
+}
+
+} // namespace mfem
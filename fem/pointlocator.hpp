@@ -0,0 +1,97 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_POINTLOCATOR
+#define MFEM_POINTLOCATOR
+
+#include "../config/config.hpp"
+#include "../general/table.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+/** @brief Locate many physical points in a Mesh and evaluate GridFunctions at
+    the located points. */
+/** The locator builds a uniform grid of cells covering the bounding box of the
+    mesh, and lists the elements whose (slightly enlarged) bounding boxes
+    overlap each cell. The bounding boxes are computed from the mesh nodes, or
+    from the vertices for meshes without nodes. The index is built once and
+    reused for all subsequent calls to FindPoints(); call Update() after the
+    mesh changes, e.g. when the nodes are moved.
+
+    The points are located in rounds: in each round, every point that is not
+    yet found is tested against its next candidate element (closest bounding
+    box center first), and the tests are grouped by element so that each
+    element transformation is set up only once per round. The reference
+    coordinates are computed with InverseElementTransformation.
+
+    This class does not require any external library. With a ParMesh, only the
+    local elements are searched. */
+class PointLocator
+{
+protected:
+   Mesh *mesh; ///< Not owned
+   double bb_tol;
+   int sdim;
+
+   /// Element bounding boxes, with layout (sdim,NE)
+   Vector bb_min, bb_max;
+   /// Bounding box of the mesh
+   double box_min[3], box_max[3];
+   /// Number of cells and cell size in each direction
+   int ncells[3];
+   double cell_h[3];
+   /// Elements overlapping each cell
+   Table cell_elems;
+
+   InverseElementTransformation inv_tr;
+
+   void ComputeBoundingBoxes();
+   void BuildCells();
+
+   /// Return the index of the cell containing @a x, or -1 if outside.
+   int GetCell(const double *x) const;
+
+public:
+   /** @brief Construct a locator for the elements of @a m. The element
+       bounding boxes are enlarged by @a bb_t times their size in every
+       direction, to account for curved elements. */
+   PointLocator(Mesh &m, double bb_t = 0.05);
+
+   /// Rebuild the search index, e.g. after the mesh nodes have changed.
+   void Update();
+
+   /** @brief Return the InverseElementTransformation used by FindPoints(), so
+       that its initial guess, solver and tolerances can be changed. */
+   InverseElementTransformation &GetInverseTransformation() { return inv_tr; }
+
+   /** @brief Find the elements and reference coordinates of the points given
+       by the columns of @a point_mat (of size SpaceDimension x npts). */
+   /** Same interface as Mesh::FindPoints(): @a elem_ids is set to -1 for the
+       points that were not found. Returns the number of points found. */
+   int FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                  Array<IntegrationPoint> &ips);
+
+   /** @brief Evaluate @a gf at the points given by @a elem_ids and @a ips, as
+       returned by FindPoints(). */
+   /** The values are returned in the columns of @a vals, of size
+       gf.VectorDim() x npts. The points are grouped by element, so that the
+       element dofs and transformation are extracted only once per element.
+       The values at points that were not found are set to zero. */
+   void Interpolate(const GridFunction &gf, const Array<int> &elem_ids,
+                    const Array<IntegrationPoint> &ips,
+                    DenseMatrix &vals) const;
+};
+
+} // namespace mfem
+
+#endif // MFEM_POINTLOCATOR
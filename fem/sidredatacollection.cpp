@@ -769,6 +769,12 @@ void SidreDataCollection::PrepareToSave()
    UpdateStateToDS();
 }
 
+void SidreDataCollection::SetAsyncSave(bool async, int max_in_flight)
+{
+   MFEM_VERIFY(!async, "asynchronous saving is not supported by "
+               "SidreDataCollection");
+}
+
 void SidreDataCollection::Save()
 {
    std::string filename = name;
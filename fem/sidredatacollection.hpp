@@ -321,6 +321,9 @@ public:
    /** This method calls `Save(collection_name, "sidre_hdf5")`. */
    virtual void Save();
 
+   /// Asynchronous saving is not supported, aborts when @a async is true.
+   virtual void SetAsyncSave(bool async, int max_in_flight = 2);
+
    /// Save the collection to @a filename.
    /** The collection path prefix is prepended to the @a filename and the
        current cycle is appended, if cycle >= 0. */
@@ -0,0 +1,85 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_MULTIVECTOR
+#define MFEM_MULTIVECTOR
+
+#include "../config/config.hpp"
+#include "vector.hpp"
+
+namespace mfem
+{
+
+/** @brief A set of Vectors of the same size, e.g. several right-hand sides,
+    stored one after the other in a single Vector. */
+/** The entry i of vector j is stored at index i + j*VectorSize(), so the
+    vectors are contiguous and share the Memory of the MultiVector. Use
+    GetVectorRef() to access a vector without copying. The MultiVector is
+    applied to operators with Operator::MultMulti(). */
+class MultiVector : public Vector
+{
+protected:
+   int vsize, num_vectors;
+
+public:
+   /// Create an empty MultiVector.
+   MultiVector() : vsize(0), num_vectors(0) { }
+
+   /// Create a MultiVector with @a nv vectors of size @a vs.
+   MultiVector(int vs, int nv) : Vector(vs*nv), vsize(vs), num_vectors(nv) { }
+
+   /// Create a MultiVector with the given MemoryType @a mt.
+   MultiVector(int vs, int nv, MemoryType mt)
+      : Vector(vs*nv, mt), vsize(vs), num_vectors(nv) { }
+
+   /// Copy constructor, the data is copied.
+   MultiVector(const MultiVector &v)
+      : Vector(v), vsize(v.vsize), num_vectors(v.num_vectors) { }
+
+   /// Resize to @a nv vectors of size @a vs, see Vector::SetSize().
+   void SetSize(int vs, int nv)
+   { Vector::SetSize(vs*nv); vsize = vs; num_vectors = nv; }
+
+   /// Resize with the given MemoryType @a mt, see Vector::SetSize().
+   void SetSize(int vs, int nv, MemoryType mt)
+   { Vector::SetSize(vs*nv, mt); vsize = vs; num_vectors = nv; }
+
+   /// Copy the data and the sizes of @a v.
+   MultiVector &operator=(const MultiVector &v);
+
+   /// Set all entries to @a value.
+   MultiVector &operator=(double value)
+   { Vector::operator=(value); return *this; }
+
+   /// Return the size of the vectors.
+   int VectorSize() const { return vsize; }
+
+   /// Return the number of vectors.
+   int NumVectors() const { return num_vectors; }
+
+   /// Set @a v to be a reference to the vector @a j, without copying.
+   void GetVectorRef(int j, Vector &v)
+   { v.MakeRef(*this, j*vsize, vsize); }
+
+   /// Set @a v to be a reference to the vector @a j (const version).
+   void GetVectorRef(int j, Vector &v) const
+   { v.MakeRef(const_cast<MultiVector &>(*this), j*vsize, vsize); }
+
+   /// Return the entry @a i of the vector @a j.
+   double &operator()(int i, int j) { return data[i + j*vsize]; }
+
+   /// Return the entry @a i of the vector @a j (const version).
+   const double &operator()(int i, int j) const { return data[i + j*vsize]; }
+};
+
+}
+
+#endif // MFEM_MULTIVECTOR
@@ -11,6 +11,7 @@
 
 #include "operator.hpp"
 #include "ode.hpp"
+#include "../general/forall.hpp"
 
 namespace mfem
 {
@@ -344,6 +345,421 @@ const double RK8Solver::c[] =
 };
 
 
+
+AdaptiveODESolver::AdaptiveODESolver(int q)
+{
+   err_order = q;
+   rel_tol = 1e-6;
+   abs_tol = 1e-8;
+   safety = 0.9;
+   min_factor = 0.2;
+   max_factor = 5.0;
+   dt_max = infinity();
+   max_rejections = 50;
+   err_prev = 1.0;
+   dt_last = 0.0;
+   num_accepted = num_rejected = 0;
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+AdaptiveODESolver::AdaptiveODESolver(int q, MPI_Comm _comm)
+   : AdaptiveODESolver(q)
+{
+   comm = _comm;
+}
+#endif
+
+void AdaptiveODESolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   const int n = f->Width();
+   x_new.SetSize(n, mem_type);
+   x_err.SetSize(n, mem_type);
+   w.SetSize(n, mem_type);
+   w.UseDevice(true);
+   err_prev = 1.0;
+   dt_last = 0.0;
+   num_accepted = num_rejected = 0;
+}
+
+double AdaptiveODESolver::ErrorNorm(const Vector &x, const Vector &xn,
+                                    const Vector &err)
+{
+   const double atol = abs_tol, rtol = rel_tol;
+   auto d_x = x.Read();
+   auto d_xn = xn.Read();
+   auto d_err = err.Read();
+   auto d_w = w.Write();
+   MFEM_FORALL(i, w.Size(),
+   {
+      const double scale = atol + rtol*fmax(fabs(d_x[i]), fabs(d_xn[i]));
+      d_w[i] = d_err[i]/scale;
+   });
+   double sums[2] = { w*w, (double)w.Size() };
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      double loc_sums[2] = { sums[0], sums[1] };
+      MPI_Allreduce(loc_sums, sums, 2, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   return (sums[1] > 0.0) ? sqrt(sums[0]/sums[1]) : 0.0;
+}
+
+void AdaptiveODESolver::Step(Vector &x, double &t, double &dt)
+{
+   const double k_i = 0.7/(err_order + 1), k_p = 0.4/(err_order + 1);
+   dt = std::min(dt, dt_max);
+   for (int rej = 0; true; rej++)
+   {
+      MFEM_VERIFY(rej <= max_rejections, "too many rejected steps at t = "
+                  << t << ", dt = " << dt);
+      TryStep(x, t, dt, x_new, x_err);
+      // Avoid division by zero for exact steps
+      const double err = std::max(ErrorNorm(x, x_new, x_err), 1e-10);
+      if (err <= 1.0)
+      {
+         double fac = safety*pow(err, -k_i)*pow(err_prev, k_p);
+         // Do not increase the step right after a rejection
+         fac = std::min(std::max(fac, min_factor),
+                        rej ? std::min(1.0, max_factor) : max_factor);
+         x = x_new;
+         StepAccepted(t, dt);
+         t += dt;
+         dt_last = dt;
+         err_prev = err;
+         num_accepted++;
+         dt = std::min(fac*dt, dt_max);
+         return;
+      }
+      // The comparison is false if err is NaN: the step is reduced maximally
+      double fac = safety*pow(err, -1.0/(err_order + 1));
+      fac = (fac > min_factor) ? std::min(fac, 1.0) : min_factor;
+      dt *= fac;
+      num_rejected++;
+   }
+}
+
+void AdaptiveODESolver::Run(Vector &x, double &t, double &dt, double tf)
+{
+   while (t < tf)
+   {
+      // Shorten the last step, and avoid a tiny step at the end
+      const bool last = (t + 1.01*dt >= tf);
+      if (last) { dt = tf - t; }
+      const double dt_try = dt;
+      Step(x, t, dt);
+      if (last && dt_last == dt_try) { t = tf; }
+   }
+}
+
+
+EmbeddedRKSolver::EmbeddedRKSolver(int _s, const double *_a,
+                                   const double *_b, const double *_c,
+                                   const double *_d, int q)
+   : AdaptiveODESolver(q)
+{
+   s = _s;
+   a = _a;
+   b = _b;
+   c = _c;
+   d = _d;
+   k = new Vector[s];
+   // The pair is FSAL when the last stage is evaluated at the new solution
+   fsal = (c[s-2] == 1.0 && b[s-1] == 0.0);
+   for (int j = 0; fsal && j < s-1; j++)
+   {
+      fsal = (a[(s-1)*(s-2)/2 + j] == b[j]);
+   }
+   k0_valid = false;
+   k0_time = 0.0;
+}
+
+#ifdef MFEM_USE_MPI
+EmbeddedRKSolver::EmbeddedRKSolver(int _s, const double *_a,
+                                   const double *_b, const double *_c,
+                                   const double *_d, int q, MPI_Comm _comm)
+   : EmbeddedRKSolver(_s, _a, _b, _c, _d, q)
+{
+   comm = _comm;
+}
+#endif
+
+void EmbeddedRKSolver::Init(TimeDependentOperator &_f)
+{
+   AdaptiveODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   k0_valid = false;
+}
+
+void EmbeddedRKSolver::TryStep(const Vector &x, double t, double dt,
+                               Vector &xn, Vector &err)
+{
+   if (!k0_valid || k0_time != t)
+   {
+      f->SetTime(t);
+      f->Mult(x, k[0]);
+      k0_valid = true;
+      k0_time = t;
+   }
+   for (int l = 0, i = 1; i < s; i++)
+   {
+      add(x, a[l++]*dt, k[0], y);
+      for (int j = 1; j < i; j++)
+      {
+         y.Add(a[l++]*dt, k[j]);
+      }
+
+      f->SetTime(t + c[i-1]*dt);
+      f->Mult(y, k[i]);
+   }
+   if (fsal)
+   {
+      // The last stage was evaluated at the new solution
+      xn = y;
+   }
+   else
+   {
+      add(x, b[0]*dt, k[0], xn);
+      for (int i = 1; i < s; i++)
+      {
+         xn.Add(b[i]*dt, k[i]);
+      }
+   }
+   err.Set(d[0]*dt, k[0]);
+   for (int i = 1; i < s; i++)
+   {
+      err.Add(d[i]*dt, k[i]);
+   }
+}
+
+void EmbeddedRKSolver::StepAccepted(double t, double dt)
+{
+   if (fsal)
+   {
+      k[0].Swap(k[s-1]);
+      k0_time = t + dt;
+   }
+   else
+   {
+      k0_valid = false;
+   }
+}
+
+EmbeddedRKSolver::~EmbeddedRKSolver()
+{
+   delete [] k;
+}
+
+const double DormandPrince54Solver::a[] =
+{
+   1./5,
+   3./40, 9./40,
+   44./45, -56./15, 32./9,
+   19372./6561, -25360./2187, 64448./6561, -212./729,
+   9017./3168, -355./33, 46732./5247, 49./176, -5103./18656,
+   35./384, 0., 500./1113, 125./192, -2187./6784, 11./84
+};
+const double DormandPrince54Solver::b[] =
+{
+   35./384, 0., 500./1113, 125./192, -2187./6784, 11./84, 0.
+};
+const double DormandPrince54Solver::c[] =
+{
+   1./5, 3./10, 4./5, 8./9, 1., 1.
+};
+const double DormandPrince54Solver::d[] =
+{
+   71./57600, 0., -71./16695, 71./1920, -17253./339200, 22./525, -1./40
+};
+
+const double BogackiShampine32Solver::a[] =
+{
+   1./2,
+   0., 3./4,
+   2./9, 1./3, 4./9
+};
+const double BogackiShampine32Solver::b[] =
+{
+   2./9, 1./3, 4./9, 0.
+};
+const double BogackiShampine32Solver::c[] =
+{
+   1./2, 3./4, 1.
+};
+const double BogackiShampine32Solver::d[] =
+{
+   -5./72, 1./12, 1./9, -1./8
+};
+
+
+MultirateRK2Solver::MultirateRK2Solver(const Table &group_rows,
+                                       const Array<int> &group_level,
+                                       const Table &group_nbrs)
+{
+   SetGroups(group_rows, group_level, group_nbrs,
+             (group_level.Size() > 0) ? group_level.Max() : 0);
+}
+
+#ifdef MFEM_USE_MPI
+MultirateRK2Solver::MultirateRK2Solver(MPI_Comm comm,
+                                       const Table &group_rows,
+                                       const Array<int> &group_level,
+                                       const Table &group_nbrs)
+{
+   int loc_max_level = (group_level.Size() > 0) ? group_level.Max() : 0;
+   int max_level;
+   MPI_Allreduce(&loc_max_level, &max_level, 1, MPI_INT, MPI_MAX, comm);
+   SetGroups(group_rows, group_level, group_nbrs, max_level);
+   Array<int> loc_num_rows(num_rows);
+   MPI_Allreduce(loc_num_rows.GetData(), num_rows.GetData(), num_rows.Size(),
+                 MPI_INT, MPI_SUM, comm);
+}
+#endif
+
+void MultirateRK2Solver::SetGroups(const Table &group_rows,
+                                   const Array<int> &group_level,
+                                   const Table &group_nbrs, int max_level)
+{
+   const int ng = group_rows.Size();
+   MFEM_VERIFY(group_level.Size() >= ng && group_nbrs.Size() == ng,
+               "incompatible group data");
+   MFEM_VERIFY(group_level.Size() == 0 || group_level.Min() >= 0,
+               "invalid group level");
+   num_levels = max_level + 1;
+   rows = new Array<int>[num_levels*num_levels];
+   for (int g = 0; g < ng; g++)
+   {
+      const int l = group_level[g];
+      int q = l;
+      const int *nbrs = group_nbrs.GetRow(g);
+      for (int j = 0; j < group_nbrs.RowSize(g); j++)
+      {
+         MFEM_ASSERT(nbrs[j] < group_level.Size(), "missing neighbor level");
+         q = std::max(q, group_level[nbrs[j]]);
+      }
+      const int *g_rows = group_rows.GetRow(g);
+      rows[q*num_levels + l].Append(g_rows, group_rows.RowSize(g));
+   }
+   num_rows.SetSize(num_levels*num_levels);
+   for (int i = 0; i < num_rows.Size(); i++) { num_rows[i] = rows[i].Size(); }
+}
+
+void MultirateRK2Solver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   const int n = f->Width();
+   pred.SetSize(n);
+   acc.SetSize(n);
+   ka.SetSize(n);
+   kb.SetSize(n);
+   pred = 0.0;
+   ka = 0.0;
+   kb = 0.0;
+}
+
+// Return the smallest level whose blocks of 2^(max_level-l) substeps start at
+// the substep p.
+static int MultirateFirstLevel(int p, int max_level)
+{
+   int l = max_level;
+   while (l > 0 && p % (1 << (max_level - l + 1)) == 0) { l--; }
+   return l;
+}
+
+void MultirateRK2Solver::Step(Vector &x, double &t, double &dt)
+{
+   // Level l takes 2^l Heun steps of size h_l = dt/2^l. The 2^L substeps of
+   // the finest level are processed in order; a group with maximum neighbor
+   // level q is evaluated at the first substep of each block of 2^(L-q)
+   // substeps, and its values are used for the whole block.
+   const int L = num_levels - 1;
+   const int nsub = 1 << L;
+   acc = 0.0;
+   double *d_x = x.HostReadWrite();
+   double *d_pred = pred.HostReadWrite();
+   double *d_acc = acc.HostReadWrite();
+   for (int p = 0; p < nsub; p++)
+   {
+      const int l_first = MultirateFirstLevel(p, L);
+
+      // First Heun stage at the start of the blocks of all levels
+      for (int q = l_first; q <= L; q++)
+      {
+         for (int l = 0; l <= q; l++)
+         {
+            if (num_rows[q*num_levels + l] == 0) { continue; }
+            const Array<int> &r = rows[q*num_levels + l];
+            const double h = dt/(1 << l);
+            f->SetTime(t + (p >> (L - l))*h);
+            f->MultRows(r, x, ka);
+         }
+      }
+      // Predictors for the levels that start a new block
+      const double *d_ka = ka.HostRead();
+      for (int l = l_first; l <= L; l++)
+      {
+         const double h = dt/(1 << l);
+         for (int q = l; q <= L; q++)
+         {
+            const Array<int> &r = rows[q*num_levels + l];
+            for (int i = 0; i < r.Size(); i++)
+            {
+               d_pred[r[i]] = d_x[r[i]] + h*d_ka[r[i]];
+            }
+         }
+      }
+      // Second Heun stage, and accumulation of both stages with the weight
+      // of the 2^(L-q) substeps in which the values are used
+      for (int q = l_first; q <= L; q++)
+      {
+         const double w = dt/(1 << (q + 1));
+         for (int l = 0; l <= q; l++)
+         {
+            if (num_rows[q*num_levels + l] == 0) { continue; }
+            const Array<int> &r = rows[q*num_levels + l];
+            const double h = dt/(1 << l);
+            f->SetTime(t + ((p >> (L - l)) + 1)*h);
+            f->MultRows(r, pred, kb);
+            const double *d_kb = kb.HostRead();
+            for (int i = 0; i < r.Size(); i++)
+            {
+               d_acc[r[i]] += w*(d_ka[r[i]] + d_kb[r[i]]);
+            }
+         }
+      }
+      // Update the levels whose blocks end after this substep
+      const int l_end = (p + 1 < nsub) ? MultirateFirstLevel(p + 1, L) : 0;
+      for (int l = l_end; l <= L; l++)
+      {
+         for (int q = l; q <= L; q++)
+         {
+            const Array<int> &r = rows[q*num_levels + l];
+            for (int i = 0; i < r.Size(); i++)
+            {
+               d_x[r[i]] += d_acc[r[i]];
+               d_acc[r[i]] = 0.0;
+            }
+         }
+      }
+   }
+   t += dt;
+}
+
+MultirateRK2Solver::~MultirateRK2Solver()
+{
+   delete [] rows;
+}
+
+
 AdamsBashforthSolver::AdamsBashforthSolver(int _s, const double *_a)
 {
    s = 0;
@@ -634,80 +1050,1181 @@ void SDIRK33Solver::Step(Vector &x, double &t, double &dt)
 }
 
 
-void GeneralizedAlphaSolver::Init(TimeDependentOperator &_f)
+void EmbeddedSDIRK33Solver::Init(TimeDependentOperator &_f)
 {
-   ODESolver::Init(_f);
+   AdaptiveODESolver::Init(_f);
    k.SetSize(f->Width(), mem_type);
    y.SetSize(f->Width(), mem_type);
-   xdot.SetSize(f->Width(), mem_type);
-   xdot = 0.0;
-   first = true;
 }
 
-void GeneralizedAlphaSolver::SetRhoInf(double rho_inf)
+void EmbeddedSDIRK33Solver::TryStep(const Vector &x, double t, double dt,
+                                    Vector &xn, Vector &err)
 {
-   rho_inf = (rho_inf > 1.0) ? 1.0 : rho_inf;
-   rho_inf = (rho_inf < 0.0) ? 0.0 : rho_inf;
+   //   a  |   a
+   //   c  |  c-a    a
+   //   1  |   b   1-a-b  a
+   // -----+----------------
+   //      |   b   1-a-b  a
+   //      |  1-e    e    0     embedded, 2nd order: e = (1/2-a)/(c-a)
+   const double a = 0.435866521508458999416019;
+   const double b = 1.20849664917601007033648;
+   const double c = 0.717933260754229499708010;
+   const double e = (0.5-a)/(c-a);
 
-   // According to Jansen
-   alpha_m = 0.5*(3.0 - rho_inf)/(1.0 + rho_inf);
-   alpha_f = 1.0/(1.0 + rho_inf);
-   gamma = 0.5 + alpha_m - alpha_f;
+   f->SetTime(t + a*dt);
+   f->ImplicitSolve(a*dt, x, k);
+   add(x, (c-a)*dt, k, y);
+   add(x, b*dt, k, xn);
+   err.Set((b-1.+e)*dt, k);
+
+   f->SetTime(t + c*dt);
+   f->ImplicitSolve(a*dt, y, k);
+   xn.Add((1.-a-b)*dt, k);
+   err.Add((1.-a-b-e)*dt, k);
+
+   f->SetTime(t + dt);
+   f->ImplicitSolve(a*dt, xn, k);
+   xn.Add(a*dt, k);
+   err.Add(a*dt, k);
 }
 
-void GeneralizedAlphaSolver::PrintProperties(std::ostream &out)
-{
-   out << "Generalized alpha time integrator:" << std::endl;
-   out << "alpha_m = " << alpha_m << std::endl;
-   out << "alpha_f = " << alpha_f << std::endl;
-   out << "gamma   = " << gamma   << std::endl;
 
-   if (gamma == 0.5 + alpha_m - alpha_f)
+void ImplicitSolveCache::Preconditioner::Mult(const Vector &x, Vector &y) const
+{
+   if (prec)
    {
-      out<<"Second order"<<" and ";
+      prec->Mult(x, y);
    }
    else
    {
-      out<<"First order"<<" and ";
+      y = x;
    }
+}
 
-   if ((alpha_m >= alpha_f)&&(alpha_f >= 0.5))
+ImplicitSolveCache::ImplicitSolveCache(IterativeSolver &solver_)
+   : solver(solver_), max_systems(2), refresh_factor(1.5), extrapolate(true),
+     num_prev(0), num_solves(0), num_setups(0), num_prec_setups(0),
+     num_iter(0)
+{
+   t_prev[0] = t_prev[1] = 0.0;
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+ImplicitSolveCache::ImplicitSolveCache(MPI_Comm comm_,
+                                       IterativeSolver &solver_)
+   : solver(solver_), max_systems(2), refresh_factor(1.5), extrapolate(true),
+     num_prev(0), num_solves(0), num_setups(0), num_prec_setups(0),
+     num_iter(0), comm(comm_)
+{
+   t_prev[0] = t_prev[1] = 0.0;
+}
+#endif
+
+double ImplicitSolveCache::Norm(const Vector &x) const
+{
+   double nrm2 = x*x;
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
    {
-      out<<"Stable"<<std::endl;
+      double loc_nrm2 = nrm2;
+      MPI_Allreduce(&loc_nrm2, &nrm2, 1, MPI_DOUBLE, MPI_SUM, comm);
    }
-   else
+#endif
+   return sqrt(nrm2);
+}
+
+void ImplicitSolveCache::SetMaxSystems(int max_sys)
+{
+   MFEM_VERIFY(max_sys > 0, "invalid number of systems: " << max_sys);
+   max_systems = max_sys;
+}
+
+void ImplicitSolveCache::DeleteSystem(System *sys)
+{
+   // The preconditioner first, then the operators it may reference
+   delete sys->prec;
+   if (sys->prec_A != sys->A) { delete sys->prec_A; }
+   delete sys->A;
+   delete sys;
+}
+
+void ImplicitSolveCache::SetupPreconditioner(System &sys)
+{
+   delete sys.prec;
+   if (sys.prec_A != sys.A) { delete sys.prec_A; }
+   sys.prec_A = sys.A;
+   sys.prec = NewPreconditioner(*sys.A, sys.dt);
+   sys.ref_iter = -1;
+   num_prec_setups++;
+}
+
+ImplicitSolveCache::System *ImplicitSolveCache::GetSystem(double dt)
+{
+   System *sys = NULL;
+   for (int i = 0; i < systems.Size(); i++)
    {
-      out<<"Unstable"<<std::endl;
+      if (systems[i]->dt == dt) { sys = systems[i]; break; }
+   }
+   if (!sys)
+   {
+      // Remove the least recently used systems
+      while (systems.Size() >= max_systems)
+      {
+         int j = 0;
+         for (int i = 1; i < systems.Size(); i++)
+         {
+            if (systems[i]->last_use < systems[j]->last_use) { j = i; }
+         }
+         DeleteSystem(systems[j]);
+         systems.DeleteFirst(systems[j]);
+      }
+      sys = new System;
+      sys->dt = dt;
+      sys->A = sys->prec_A = NULL;
+      sys->prec = NULL;
+      sys->ref_iter = -1;
+      sys->last_use = 0;
+      systems.Append(sys);
    }
+   if (!sys->A)
+   {
+      sys->A = NewSystem(dt);
+      num_setups++;
+      if (!sys->prec_A) { SetupPreconditioner(*sys); }
+   }
+   return sys;
 }
 
-// This routine assumes xdot is initialized.
-void GeneralizedAlphaSolver::Step(Vector &x, double &t, double &dt)
+void ImplicitSolveCache::InitialGuess(double t, Vector &k) const
 {
-   if (first)
+   k = k_prev[0];
+   if (num_prev == 2 && t_prev[0] != t_prev[1])
    {
-      f->Mult(x,xdot);
-      first = false;
+      // Linear extrapolation, only for moderate distances in time, e.g. not
+      // after a restart with a much smaller time step
+      const double theta = (t - t_prev[0])/(t_prev[0] - t_prev[1]);
+      if (fabs(theta) <= 3.0)
+      {
+         add(1.0 + theta, k_prev[0], -theta, k_prev[1], k);
+      }
    }
+}
 
-   // Set y = x + alpha_f*(1.0 - (gamma/alpha_m))*dt*xdot
-   add(x, alpha_f*(1.0 - (gamma/alpha_m))*dt, xdot, y);
+void ImplicitSolveCache::SetRelTol(const Operator &A, const Vector &b,
+                                   const Vector &k, double rel_tol)
+{
+   r.SetSize(b.Size());
+   A.Mult(k, r);
+   subtract(b, r, r);
+   const double r_norm = Norm(r), b_norm = Norm(b);
+   solver.SetRelTol((r_norm > rel_tol*b_norm) ? rel_tol*b_norm/r_norm : 1.0);
+}
 
-   // Solve k = f(y + dt_eff*k)
-   double dt_eff = (gamma*alpha_f/alpha_m)*dt;
-   f->SetTime(t + alpha_f*dt);
-   f->ImplicitSolve(dt_eff, y, k);
+void ImplicitSolveCache::Solve(double dt, double t, const Vector &b, Vector &k)
+{
+   System *sys = GetSystem(dt);
+   sys->last_use = ++num_solves;
 
-   // Update x and xdot
-   x.Add((1.0 - (gamma/alpha_m))*dt, xdot);
-   x.Add(       (gamma/alpha_m) *dt, k);
+   const bool iterative_mode = solver.iterative_mode;
+   const double rel_tol = solver.GetRelTol();
+   if (extrapolate && num_prev > 0)
+   {
+      InitialGuess(t, k);
+      solver.iterative_mode = true;
+      SetRelTol(*sys->A, b, k, rel_tol);
+   }
+   solver_prec.Set(*sys->A, sys->prec);
+   solver.SetPreconditioner(solver_prec);
+   solver.SetOperator(*sys->A);
+   solver.Mult(b, k);
+   num_iter += solver.GetNumIterations();
 
-   xdot *= (1.0-(1.0/alpha_m));
-   xdot.Add((1.0/alpha_m),k);
+   if (sys->ref_iter < 0)
+   {
+      sys->ref_iter = solver.GetNumIterations();
+   }
+   else if (sys->prec_A != sys->A &&
+            (!solver.GetConverged() || solver.GetNumIterations() >
+             refresh_factor*std::max(sys->ref_iter, 1)))
+   {
+      // The preconditioner was set up with an old operator: set it up with
+      // the current one, and if the solver failed, solve again with it
+      SetupPreconditioner(*sys);
+      if (!solver.GetConverged())
+      {
+         // Restart from the last iterate, with the tolerance scaled for it
+         solver_prec.Set(*sys->A, sys->prec);
+         solver.iterative_mode = true;
+         SetRelTol(*sys->A, b, k, rel_tol);
+         solver.Mult(b, k);
+         num_iter += solver.GetNumIterations();
+         sys->ref_iter = solver.GetNumIterations();
+      }
+   }
+   solver.iterative_mode = iterative_mode;
+   solver.SetRelTol(rel_tol);
 
+   if (extrapolate)
+   {
+      // A repeated solve at the same time replaces the last solution
+      if (num_prev > 0 && t != t_prev[0])
+      {
+         k_prev[1].Swap(k_prev[0]);
+         t_prev[1] = t_prev[0];
+         num_prev = 2;
+      }
+      num_prev = std::max(num_prev, 1);
+      k_prev[0] = k;
+      t_prev[0] = t;
+   }
+}
+
+void ImplicitSolveCache::Update()
+{
+   for (int i = 0; i < systems.Size(); i++)
+   {
+      System *sys = systems[i];
+      if (sys->A != sys->prec_A)
+      {
+         delete sys->A;
+      }
+      else if (!sys->prec)
+      {
+         delete sys->A;
+         sys->prec_A = NULL;
+      }
+      sys->A = NULL;
+   }
+}
+
+void ImplicitSolveCache::Reset()
+{
+   for (int i = 0; i < systems.Size(); i++)
+   {
+      DeleteSystem(systems[i]);
+   }
+   systems.SetSize(0);
+   num_prev = 0;
+}
+
+
+IMEXRKSolver::IMEXRKSolver(int _s, const double *_ae, const double *_ai,
+                           const double *_be, const double *_bi,
+                           const double *_c)
+{
+   s = _s;
+   ae = _ae;
+   ai = _ai;
+   be = _be;
+   bi = _bi;
+   c = _c;
+   ke = new Vector[s];
+   ki = new Vector[s];
+   // Mark the stage derivatives used by later stages or by the solution
+   need_e.SetSize(s);
+   need_i.SetSize(s);
+   for (int j = 0; j < s; j++)
+   {
+      need_e[j] = (be[j] != 0.0);
+      need_i[j] = (bi[j] != 0.0);
+      for (int i = j+1; i < s; i++)
+      {
+         need_e[j] = need_e[j] || (ae[i*(i-1)/2 + j] != 0.0);
+         need_i[j] = need_i[j] || (ai[i*(i+1)/2 + j] != 0.0);
+      }
+   }
+   last_implicit = -1;
+}
+
+void IMEXRKSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      ke[i].SetSize(n, mem_type);
+      ki[i].SetSize(n, mem_type);
+   }
+   // Zero initial guess for the first implicit solve
+   ki[0] = 0.0;
+   last_implicit = 0;
+}
+
+void IMEXRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   for (int i = 0; i < s; i++)
+   {
+      // y = x + dt sum_{j<i} (ae(i,j) ke[j] + ai(i,j) ki[j])
+      y = x;
+      for (int j = 0; j < i; j++)
+      {
+         const double a_e = ae[i*(i-1)/2 + j], a_i = ai[i*(i+1)/2 + j];
+         if (a_e != 0.0) { y.Add(a_e*dt, ke[j]); }
+         if (a_i != 0.0) { y.Add(a_i*dt, ki[j]); }
+      }
+
+      f->SetTime(t + c[i]*dt);
+      const double a_ii = ai[i*(i+1)/2 + i];
+      if (a_ii != 0.0)
+      {
+         // Solve ki[i] = f2(y + a_ii dt ki[i]), using the last implicit stage
+         // derivative as the initial guess
+         if (last_implicit != i) { ki[i] = ki[last_implicit]; }
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+         f->ImplicitSolve(a_ii*dt, y, ki[i]);
+         y.Add(a_ii*dt, ki[i]);
+         last_implicit = i;
+      }
+      else if (need_i[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+         f->Mult(y, ki[i]);
+      }
+      if (need_e[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+         f->Mult(y, ke[i]);
+      }
+   }
+   f->SetEvalMode(TimeDependentOperator::NORMAL);
+
+   for (int i = 0; i < s; i++)
+   {
+      if (be[i] != 0.0) { x.Add(be[i]*dt, ke[i]); }
+      if (bi[i] != 0.0) { x.Add(bi[i]*dt, ki[i]); }
+   }
    t += dt;
 }
 
+IMEXRKSolver::~IMEXRKSolver()
+{
+   delete [] ke;
+   delete [] ki;
+}
+
+// gamma = 1 - 1/sqrt(2), delta = 1 - 1/(2 gamma)
+const double ARS222Solver::ae[] =
+{
+   0.29289321881345247559915563789515,
+   -0.70710678118654752440084436210485, 1.70710678118654752440084436210485
+};
+const double ARS222Solver::ai[] =
+{
+   0.,
+   0., 0.29289321881345247559915563789515,
+   0., 0.70710678118654752440084436210485, 0.29289321881345247559915563789515
+};
+const double ARS222Solver::be[] =
+{
+   -0.70710678118654752440084436210485, 1.70710678118654752440084436210485, 0.
+};
+const double ARS222Solver::bi[] =
+{
+   0., 0.70710678118654752440084436210485, 0.29289321881345247559915563789515
+};
+const double ARS222Solver::c[] =
+{
+   0., 0.29289321881345247559915563789515, 1.
+};
+
+const double ARK324Solver::ae[] =
+{
+   1767732205903./2027836641118,
+   5535828885825./10492691773637, 788022342437./10882634858940,
+   6485989280629./16251701735622, -4246266847089./9704473918619,
+   10755448449292./10357097424841
+};
+const double ARK324Solver::ai[] =
+{
+   0.,
+   1767732205903./4055673282236, 1767732205903./4055673282236,
+   2746238789719./10658868560708, -640167445237./6845629431997,
+   1767732205903./4055673282236,
+   1471266399579./7840856788654, -4482444167858./7529755066697,
+   11266239266428./11593286722821, 1767732205903./4055673282236
+};
+const double ARK324Solver::be[] =
+{
+   1471266399579./7840856788654, -4482444167858./7529755066697,
+   11266239266428./11593286722821, 1767732205903./4055673282236
+};
+const double ARK324Solver::bi[] =
+{
+   1471266399579./7840856788654, -4482444167858./7529755066697,
+   11266239266428./11593286722821, 1767732205903./4055673282236
+};
+const double ARK324Solver::c[] =
+{
+   0., 1767732205903./2027836641118, 3./5, 1.
+};
+
+const double ARK436Solver::ae[] =
+{
+   1./2,
+   13861./62500, 6889./62500,
+   -116923316275./2393684061468, -2731218467317./15368042101831,
+   9408046702089./11113171139209,
+   -451086348788./2902428689909, -2682348792572./7519795681897,
+   12662868775082./11960479115383, 3355817975965./11060851509271,
+   647845179188./3216320057751, 73281519250./8382639484533,
+   552539513391./3454668386233, 3354512671639./8306763924573, 4040./17871
+};
+const double ARK436Solver::ai[] =
+{
+   0.,
+   1./4, 1./4,
+   8611./62500, -1743./31250, 1./4,
+   5012029./34652500, -654441./2922500, 174375./388108, 1./4,
+   15267082809./155376265600, -71443401./120774400, 730878875./902184768,
+   2285395./8070912, 1./4,
+   82889./524892, 0., 15625./83664, 69875./102672, -2260./8211, 1./4
+};
+const double ARK436Solver::be[] =
+{
+   82889./524892, 0., 15625./83664, 69875./102672, -2260./8211, 1./4
+};
+const double ARK436Solver::bi[] =
+{
+   82889./524892, 0., 15625./83664, 69875./102672, -2260./8211, 1./4
+};
+const double ARK436Solver::c[] =
+{
+   0., 1./2, 83./250, 31./50, 17./20, 1.
+};
+
+
+// Compute E = exp(M) with the (6,6) Pade approximation and scaling and
+// squaring, as in Expokit.
+static void DenseExp(const DenseMatrix &M, DenseMatrix &E)
+{
+   const int n = M.Height(), q = 6;
+   const double norm = M.MaxMaxNorm()*n;
+   const int s = (norm > 0.5) ? std::max(0, int(log2(norm)) + 2) : 0;
+   DenseMatrix X(M), Xk(n), T(n), N(n), D(n);
+   X *= pow(2.0, -s);
+   N = 0.0;
+   D = 0.0;
+   for (int i = 0; i < n; i++) { N(i,i) = D(i,i) = 1.0; }
+   Xk = X;
+   double c = 0.5;
+   N.Add(c, X);
+   D.Add(-c, X);
+   for (int k = 2; k <= q; k++)
+   {
+      c *= double(q - k + 1)/(k*(2*q - k + 1));
+      Mult(X, Xk, T);
+      Xk = T;
+      N.Add(c, Xk);
+      D.Add((k % 2) ? -c : c, Xk);
+   }
+   DenseMatrixInverse Dinv(D);
+   E.SetSize(n);
+   Dinv.Mult(N, E);
+   for (int k = 0; k < s; k++)
+   {
+      Mult(E, E, T);
+      E = T;
+   }
+}
+
+KrylovPhi::KrylovPhi()
+{
+   A = NULL;
+   max_dim = 0;
+   print_level = 0;
+   rel_tol = 1e-8;
+   num_mult = num_substeps = 0;
+   V = NULL;
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+   SetMaxDim(30);
+}
+
+#ifdef MFEM_USE_MPI
+KrylovPhi::KrylovPhi(MPI_Comm _comm) : KrylovPhi()
+{
+   comm = _comm;
+}
+#endif
+
+void KrylovPhi::SetMaxDim(int dim)
+{
+   MFEM_VERIFY(dim > 0, "invalid Krylov space dimension: " << dim);
+   delete [] V;
+   max_dim = dim;
+   V = new Vector[max_dim + 1];
+}
+
+double KrylovPhi::Dot(const Vector &x, const Vector &y, bool aug) const
+{
+   const int n = A->Width();
+   const double *xd = x.HostRead(), *yd = y.HostRead();
+   double dot = 0.0, aug_dot = 0.0;
+   for (int i = 0; i < n; i++) { dot += xd[i]*yd[i]; }
+   if (aug)
+   {
+      for (int i = n; i < x.Size(); i++) { aug_dot += xd[i]*yd[i]; }
+   }
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      double loc_dot = dot;
+      MPI_Allreduce(&loc_dot, &dot, 1, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   // The augmented entries are the same on all ranks
+   return dot + aug_dot;
+}
+
+void KrylovPhi::AugmentedMult(const Array<const Vector*> &b, double eta,
+                              const Vector &x, Vector &y) const
+{
+   const int n = A->Width(), p = b.Size() - 1;
+   if (p == 0) { A->Mult(x, y); return; }
+
+   Vector xn(const_cast<double*>(x.HostRead()), n);
+   Vector yn(y.HostReadWrite(), n);
+   A->Mult(xn, yn);
+   for (int j = 0; j < p; j++)
+   {
+      if (b[p-j]) { yn.Add(eta*x(n+j), *b[p-j]); }
+   }
+   for (int j = 0; j < p-1; j++) { y(n+j) = x(n+j+1); }
+   y(n+p-1) = 0.0;
+}
+
+double KrylovPhi::Approximate(double tau, double beta, int m, double h_next)
+{
+   // E = exp([tau H_m, e_1; 0, 0]) contains exp(tau H_m) e_1 in its first
+   // column and phi_1(tau H_m) e_1 in its last column.
+   M.SetSize(m + 1);
+   M = 0.0;
+   for (int k = 0; k < m; k++)
+   {
+      for (int i = 0; i <= std::min(k + 1, m - 1); i++)
+      {
+         M(i,k) = tau*H(i,k);
+      }
+   }
+   M(0,m) = 1.0;
+   DenseExp(M, E);
+
+   Av = 0.0;
+   for (int i = 0; i < m; i++) { Av.Add(beta*E(i,0), V[i]); }
+
+   // Error estimate of Saad
+   return beta*tau*h_next*fabs(E(m-1,m));
+}
+
+void KrylovPhi::Mult(double h, const Array<const Vector*> &b, Vector &w)
+{
+   MFEM_VERIFY(A != NULL, "the operator is not set");
+   MFEM_VERIFY(b.Size() > 0, "no vectors are given");
+   const int n = A->Width(), p = b.Size() - 1;
+   num_mult = num_substeps = 0;
+
+   // Scale the augmented part of the operator by eta, a power of 2, so that
+   // its entries are comparable to the vectors b_k.
+   double b_max = 0.0;
+   for (int k = 1; k <= p; k++)
+   {
+      if (b[k]) { b_max = std::max(b_max, Norm(*b[k])); }
+   }
+   const double eta = (b_max > 0.0) ? pow(2.0, -ceil(log2(b_max))) : 1.0;
+
+   Vector u(n + p);
+   u = 0.0;
+   if (b[0]) { Vector un(u.GetData(), n); un = *b[0]; }
+   if (p > 0) { u(n+p-1) = 1.0/eta; }
+   Av.SetSize(n + p);
+
+   double T = 0.0;
+   while (T < h)
+   {
+      const double beta = sqrt(Dot(u, u));
+      if (beta == 0.0) { break; }
+
+      // Arnoldi iteration, checking the error for the remaining interval
+      double tau = h - T, err = 0.0, h_next = 0.0;
+      int m = 0;
+      bool converged = false;
+      H.SetSize(max_dim + 1, max_dim);
+      H = 0.0;
+      V[0].SetSize(n + p);
+      V[0].Set(1.0/beta, u);
+      for (int j = 0; j < max_dim; j++)
+      {
+         V[j+1].SetSize(n + p);
+         AugmentedMult(b, eta, V[j], V[j+1]);
+         num_mult++;
+         const double av_norm = sqrt(Dot(V[j+1], V[j+1]));
+         for (int i = 0; i <= j; i++)
+         {
+            H(i,j) = Dot(V[i], V[j+1]);
+            V[j+1].Add(-H(i,j), V[i]);
+         }
+         h_next = sqrt(Dot(V[j+1], V[j+1]));
+         m = j + 1;
+         if (h_next <= 1e-12*av_norm)
+         {
+            // Happy breakdown: the Krylov space is invariant
+            h_next = 0.0;
+            err = Approximate(tau, beta, m, h_next);
+            converged = true;
+            break;
+         }
+         H(j+1,j) = h_next;
+         V[j+1] *= 1.0/h_next;
+         err = Approximate(tau, beta, m, h_next);
+         if (err <= rel_tol*(tau/h)*sqrt(Dot(Av, Av, false)))
+         {
+            converged = true;
+            break;
+         }
+      }
+
+      // Reduce the substep until the error estimate is small enough
+      for (int it = 0; !converged && it < 100; it++)
+      {
+         const double tol = rel_tol*(tau/h)*sqrt(Dot(Av, Av, false));
+         tau *= std::min(0.9, std::max(0.1, 0.9*pow(tol/err, 1.0/m)));
+         err = Approximate(tau, beta, m, h_next);
+         converged = (err <= rel_tol*(tau/h)*sqrt(Dot(Av, Av, false)));
+      }
+      MFEM_VERIFY(converged, "KrylovPhi: the substep size could not be "
+                  "reduced enough, tau = " << tau);
+
+      u = Av;
+      num_substeps++;
+      T = (tau == h - T) ? h : T + tau;
+
+      if (print_level > 0)
+      {
+         mfem::out << "KrylovPhi: substep " << num_substeps << ", tau = "
+                   << tau << ", dimension = " << m << ", error estimate = "
+                   << err << '\n';
+      }
+   }
+
+   Vector un(u.GetData(), n);
+   w = un;
+}
+
+KrylovPhi::~KrylovPhi()
+{
+   delete [] V;
+}
+
+
+class ExponentialODESolver::LinearPartOperator : public Operator
+{
+protected:
+   ExponentialODESolver &solver;
+   const Vector *x;
+   double t, x_norm;
+   Vector f0;
+   mutable Vector xh;
+
+public:
+   LinearPartOperator(ExponentialODESolver &s)
+      : Operator(s.f->Width()), solver(s), x(NULL), t(0.0), x_norm(0.0) { }
+
+   /// Set the linearization point (x_,t_), where f(x_,t_) = fx.
+   void Update(const Vector &x_, double t_, const Vector &fx)
+   {
+      TimeDependentOperator &f = *solver.f;
+      x = &x_;
+      t = t_;
+      switch (solver.lin_part)
+      {
+         case JACOBIAN:
+            f0 = fx;
+            x_norm = solver.phi.Norm(x_);
+            break;
+         case LINEAR:
+         case SPLIT:
+            xh.SetSize(width);
+            xh = 0.0;
+            f0.SetSize(height);
+            f.SetTime(t);
+            if (solver.lin_part == SPLIT)
+            {
+               f.SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+            }
+            f.Mult(xh, f0);
+            f.SetEvalMode(TimeDependentOperator::NORMAL);
+            break;
+      }
+   }
+
+   virtual void Mult(const Vector &v, Vector &y) const
+   {
+      TimeDependentOperator &f = *solver.f;
+      f.SetTime(t);
+      if (solver.lin_part == JACOBIAN)
+      {
+         const double v_norm = solver.phi.Norm(v);
+         if (v_norm == 0.0)
+         {
+            y = 0.0;
+            return;
+         }
+         const double e = solver.fd_eps*sqrt(1.0 + x_norm)/v_norm;
+         xh.SetSize(width);
+         add(*x, e, v, xh);
+         f.Mult(xh, y);
+         y -= f0;
+         y *= 1.0/e;
+         return;
+      }
+      if (solver.lin_part == SPLIT)
+      {
+         f.SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+      }
+      f.Mult(v, y);
+      f.SetEvalMode(TimeDependentOperator::NORMAL);
+      y -= f0;
+   }
+};
+
+ExponentialODESolver::ExponentialODESolver()
+   : lin_part(JACOBIAN), fd_eps(1.5e-8), L(NULL), tn(0.0) { }
+
+#ifdef MFEM_USE_MPI
+ExponentialODESolver::ExponentialODESolver(MPI_Comm comm)
+   : phi(comm), lin_part(JACOBIAN), fd_eps(1.5e-8), L(NULL), tn(0.0) { }
+#endif
+
+void ExponentialODESolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   const int n = f->Width();
+   fx.SetSize(n, mem_type);
+   ft.SetSize(n, mem_type);
+   a.SetSize(n, mem_type);
+   r.SetSize(n, mem_type);
+   w.SetSize(n, mem_type);
+   dz.SetSize(n, mem_type);
+   Ldz.SetSize(n, mem_type);
+   delete L;
+   L = new LinearPartOperator(*this);
+   phi.SetOperator(*L);
+}
+
+void ExponentialODESolver::Linearize(const Vector &x, double t)
+{
+   tn = t;
+   f->SetTime(t);
+   f->Mult(x, fx);
+   L->Update(x, t, fx);
+   if (lin_part == SPLIT)
+   {
+      ft = 0.0;
+      return;
+   }
+   // Finite difference approximation of df/dt
+   const double t_eps = t + fd_eps*std::max(1.0, fabs(t));
+   f->SetTime(t_eps);
+   f->Mult(x, ft);
+   ft -= fx;
+   ft *= 1.0/(t_eps - t);
+}
+
+void ExponentialODESolver::Remainder(const Vector &x, const Vector &z,
+                                     double t, Vector &rz)
+{
+   f->SetTime(t);
+   f->Mult(z, rz);
+   rz -= fx;
+   subtract(z, x, dz);
+   L->Mult(dz, Ldz);
+   rz -= Ldz;
+   rz.Add(-(t - tn), ft);
+}
+
+ExponentialODESolver::~ExponentialODESolver()
+{
+   delete L;
+}
+
+void ExponentialEulerSolver::Step(Vector &x, double &t, double &dt)
+{
+   Linearize(x, t);
+   b.SetSize(3);
+   b[0] = NULL;
+   b[1] = &fx;
+   b[2] = (lin_part == SPLIT) ? NULL : &ft;
+   phi.Mult(dt, b, w);
+   x += w;
+   t += dt;
+}
+
+void ETDRK2Solver::Step(Vector &x, double &t, double &dt)
+{
+   Linearize(x, t);
+   b.SetSize(3);
+   b[0] = NULL;
+   b[1] = &fx;
+   b[2] = (lin_part == SPLIT) ? NULL : &ft;
+   phi.Mult(dt, b, w);
+   add(x, w, a);
+
+   // x_{n+1} = a + h^2 phi_2(h L) r/h
+   Remainder(x, a, t + dt, r);
+   r *= 1.0/dt;
+   b[1] = NULL;
+   b[2] = &r;
+   phi.Mult(dt, b, w);
+   add(a, w, x);
+   t += dt;
+}
+
+void ExpRB32Solver::Step(Vector &x, double &t, double &dt)
+{
+   Linearize(x, t);
+   b.SetSize(3);
+   b[0] = NULL;
+   b[1] = &fx;
+   b[2] = (lin_part == SPLIT) ? NULL : &ft;
+   phi.Mult(dt, b, w);
+   add(x, w, a);
+
+   // x_{n+1} = a + h^3 phi_3(h J) 2 r/h^2
+   Remainder(x, a, t + dt, r);
+   r *= 2.0/(dt*dt);
+   b.SetSize(4);
+   b[1] = b[2] = NULL;
+   b[3] = &r;
+   phi.Mult(dt, b, w);
+   add(a, w, x);
+   t += dt;
+}
+
+
+void GeneralizedAlphaSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   k.SetSize(f->Width(), mem_type);
+   y.SetSize(f->Width(), mem_type);
+   xdot.SetSize(f->Width(), mem_type);
+   xdot = 0.0;
+   first = true;
+}
+
+void GeneralizedAlphaSolver::SetRhoInf(double rho_inf)
+{
+   rho_inf = (rho_inf > 1.0) ? 1.0 : rho_inf;
+   rho_inf = (rho_inf < 0.0) ? 0.0 : rho_inf;
+
+   // According to Jansen
+   alpha_m = 0.5*(3.0 - rho_inf)/(1.0 + rho_inf);
+   alpha_f = 1.0/(1.0 + rho_inf);
+   gamma = 0.5 + alpha_m - alpha_f;
+}
+
+void GeneralizedAlphaSolver::PrintProperties(std::ostream &out)
+{
+   out << "Generalized alpha time integrator:" << std::endl;
+   out << "alpha_m = " << alpha_m << std::endl;
+   out << "alpha_f = " << alpha_f << std::endl;
+   out << "gamma   = " << gamma   << std::endl;
+
+   if (gamma == 0.5 + alpha_m - alpha_f)
+   {
+      out<<"Second order"<<" and ";
+   }
+   else
+   {
+      out<<"First order"<<" and ";
+   }
+
+   if ((alpha_m >= alpha_f)&&(alpha_f >= 0.5))
+   {
+      out<<"Stable"<<std::endl;
+   }
+   else
+   {
+      out<<"Unstable"<<std::endl;
+   }
+}
+
+// This routine assumes xdot is initialized.
+void GeneralizedAlphaSolver::Step(Vector &x, double &t, double &dt)
+{
+   if (first)
+   {
+      f->Mult(x,xdot);
+      first = false;
+   }
+
+   // Set y = x + alpha_f*(1.0 - (gamma/alpha_m))*dt*xdot
+   add(x, alpha_f*(1.0 - (gamma/alpha_m))*dt, xdot, y);
+
+   // Solve k = f(y + dt_eff*k)
+   double dt_eff = (gamma*alpha_f/alpha_m)*dt;
+   f->SetTime(t + alpha_f*dt);
+   f->ImplicitSolve(dt_eff, y, k);
+
+   // Update x and xdot
+   x.Add((1.0 - (gamma/alpha_m))*dt, xdot);
+   x.Add(       (gamma/alpha_m) *dt, k);
+
+   xdot *= (1.0-(1.0/alpha_m));
+   xdot.Add((1.0/alpha_m),k);
+
+   t += dt;
+}
+
+
+PararealSolver::PararealSolver()
+{
+   fine = coarse = NULL;
+   coarse_op = NULL;
+   dt_fine = dt_coarse = 0.0;
+   num_slices = 1;
+   max_iter = -1;
+   print_level = 0;
+   rel_tol = 1e-8;
+   abs_tol = 0.0;
+   fcf = false;
+   final_iter = 0;
+   converged = false;
+   final_norm = 0.0;
+   rank = 0;
+   num_ranks = 1;
+   first_slice = last_slice = 0;
+#ifdef MFEM_USE_MPI
+   time_comm = space_comm = MPI_COMM_NULL;
+#endif
+   U = FU = GU = NULL;
+}
+
+#ifdef MFEM_USE_MPI
+PararealSolver::PararealSolver(MPI_Comm _time_comm, MPI_Comm _space_comm)
+   : PararealSolver()
+{
+   time_comm = _time_comm;
+   space_comm = _space_comm;
+   MPI_Comm_rank(time_comm, &rank);
+   MPI_Comm_size(time_comm, &num_ranks);
+   num_slices = num_ranks;
+}
+#endif
+
+void PararealSolver::DeleteVectors()
+{
+   delete [] U;
+   delete [] FU;
+   delete [] GU;
+   U = FU = GU = NULL;
+}
+
+void PararealSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   MFEM_VERIFY(num_slices >= num_ranks, "the number of slices ("
+               << num_slices << ") is smaller than the number of ranks ("
+               << num_ranks << ")");
+   first_slice = (rank*num_slices)/num_ranks;
+   last_slice = ((rank + 1)*num_slices)/num_ranks;
+   const int nloc = last_slice - first_slice, n = f->Width();
+   DeleteVectors();
+   U = new Vector[nloc + 1];
+   FU = new Vector[nloc];
+   GU = new Vector[nloc];
+   for (int i = 0; i <= nloc; i++) { U[i].SetSize(n, mem_type); }
+   for (int i = 0; i < nloc; i++)
+   {
+      FU[i].SetSize(n, mem_type);
+      GU[i].SetSize(n, mem_type);
+   }
+   g.SetSize(n, mem_type);
+}
+
+void PararealSolver::Propagate(ODESolver &solver, TimeDependentOperator &op,
+                               double h, Vector &x, double t0, double t1)
+{
+   MFEM_VERIFY(h > 0.0, "the fine and coarse time steps must be positive, "
+               "h = " << h);
+   const int m = std::max((int)ceil((t1 - t0)/h - 1e-10), 1);
+   const double dt = (t1 - t0)/m;
+   solver.Init(op);
+   double t = t0;
+   for (int i = 0; i < m; i++)
+   {
+      double dt_i = dt;
+      solver.Step(x, t, dt_i);
+   }
+}
+
+double PararealSolver::Norm(const Vector &x) const
+{
+#ifdef MFEM_USE_MPI
+   if (space_comm != MPI_COMM_NULL)
+   {
+      return sqrt(InnerProduct(space_comm, x, x));
+   }
+#endif
+   return x.Norml2();
+}
+
+void PararealSolver::SendNext(const Vector &x) const
+{
+#ifdef MFEM_USE_MPI
+   if (rank + 1 < num_ranks)
+   {
+      MPI_Send(const_cast<double*>(x.HostRead()), x.Size(), MPI_DOUBLE,
+               rank + 1, 0, time_comm);
+   }
+#endif
+}
+
+void PararealSolver::RecvPrev(Vector &x) const
+{
+#ifdef MFEM_USE_MPI
+   if (rank > 0)
+   {
+      MPI_Recv(x.HostWrite(), x.Size(), MPI_DOUBLE, rank - 1, 0, time_comm,
+               MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
+void PararealSolver::ShiftNext(const Vector &x, Vector &y) const
+{
+#ifdef MFEM_USE_MPI
+   if (num_ranks > 1)
+   {
+      const int next = (rank + 1 < num_ranks) ? rank + 1 : MPI_PROC_NULL;
+      const int prev = (rank > 0) ? rank - 1 : MPI_PROC_NULL;
+      // On the first rank, y is not changed
+      MPI_Sendrecv(const_cast<double*>(x.HostRead()), x.Size(), MPI_DOUBLE,
+                   next, 0, y.HostReadWrite(), y.Size(), MPI_DOUBLE, prev, 0,
+                   time_comm, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
+void PararealSolver::Step(Vector &x, double &t, double &dt)
+{
+   MFEM_VERIFY(fine && coarse, "the fine and coarse propagators are not set");
+   MFEM_VERIFY(U, "Init() has not been called");
+   TimeDependentOperator &cop = coarse_op ? *coarse_op : *f;
+   const int N = num_slices, n0 = first_slice, nloc = last_slice - n0;
+   const double t0 = t, dT = dt/N;
+   // Number of slices that become exact in each iteration
+   const int num_exact = fcf ? 2 : 1;
+   const int max_it = (max_iter >= 0) ? max_iter : N;
+   bool print = (print_level > 0 && rank == 0);
+#ifdef MFEM_USE_MPI
+   if (space_comm != MPI_COMM_NULL)
+   {
+      int space_rank;
+      MPI_Comm_rank(space_comm, &space_rank);
+      print = print && (space_rank == 0);
+   }
+#endif
+   // Start time of the local slice i
+   auto T = [=](int i) { return t0 + (n0 + i)*dT; };
+
+   // Sequential coarse solve
+   if (n0 == 0) { U[0] = x; }
+   else { RecvPrev(U[0]); }
+   for (int i = 0; i < nloc; i++)
+   {
+      GU[i] = U[i];
+      Propagate(*coarse, cop, dt_coarse, GU[i], T(i), T(i+1));
+      U[i+1] = GU[i];
+   }
+   SendNext(U[nloc]);
+
+   converged = false;
+   final_norm = 0.0;
+   int k;
+   for (k = 1; k <= max_it && !converged; k++)
+   {
+      // The slices before k-1 (2k-2 with FCF-relaxation) are exact, and their
+      // fine propagations from the final start values are already computed
+      const int i0 = std::max(num_exact*(k - 1) - n0, 0);
+      if (fcf)
+      {
+         // F-relaxation and C-relaxation
+         for (int i = i0; i < nloc; i++)
+         {
+            FU[i] = U[i];
+            Propagate(*fine, *f, dt_fine, FU[i], T(i), T(i+1));
+         }
+         for (int i = nloc - 1; i > i0; i--) { U[i] = FU[i-1]; }
+         U[nloc] = FU[nloc-1];
+         ShiftNext(FU[nloc-1], U[0]);
+         for (int i = i0; i < nloc; i++)
+         {
+            GU[i] = U[i];
+            Propagate(*coarse, cop, dt_coarse, GU[i], T(i), T(i+1));
+         }
+      }
+      // F-relaxation
+      for (int i = i0; i < nloc; i++)
+      {
+         FU[i] = U[i];
+         Propagate(*fine, *f, dt_fine, FU[i], T(i), T(i+1));
+      }
+      // Sequential coarse-grid correction
+      RecvPrev(U[0]);
+      double norms[2] = { 0.0, 0.0 }; // largest update and largest U_n
+      for (int i = i0; i < nloc; i++)
+      {
+         g = U[i];
+         Propagate(*coarse, cop, dt_coarse, g, T(i), T(i+1));
+         // U[i+1] <- g + FU[i] - GU[i], GU[i] <- g
+         GU[i].Neg();
+         GU[i] += FU[i];
+         GU[i] += g;
+         U[i+1] -= GU[i];
+         norms[0] = std::max(norms[0], Norm(U[i+1]));
+         U[i+1] = GU[i];
+         GU[i] = g;
+         norms[1] = std::max(norms[1], Norm(U[i+1]));
+      }
+      SendNext(U[nloc]);
+#ifdef MFEM_USE_MPI
+      if (num_ranks > 1)
+      {
+         double loc_norms[2] = { norms[0], norms[1] };
+         MPI_Allreduce(loc_norms, norms, 2, MPI_DOUBLE, MPI_MAX, time_comm);
+      }
+#endif
+      final_norm = norms[0];
+      if (print)
+      {
+         mfem::out << "   Parareal iteration : " << k
+                   << "  max |U_new - U_old| = " << final_norm << '\n';
+      }
+      converged = (final_norm <= std::max(rel_tol*norms[1], abs_tol) ||
+                   num_exact*k >= N);
+   }
+   final_iter = k - 1;
+   if (print && !converged)
+   {
+      mfem::out << "Parareal: No convergence!\n";
+   }
+
+   if (rank == num_ranks - 1) { x = U[nloc]; }
+#ifdef MFEM_USE_MPI
+   if (num_ranks > 1)
+   {
+      MPI_Bcast(x.HostReadWrite(), x.Size(), MPI_DOUBLE, num_ranks - 1,
+                time_comm);
+   }
+#endif
+   t = t0 + dt;
+}
+
 
 void
 SIASolver::Init(Operator &P, TimeDependentOperator & F)
@@ -13,7 +13,13 @@
 #define MFEM_ODE
 
 #include "../config/config.hpp"
+#include "../general/table.hpp"
 #include "operator.hpp"
+#include "densemat.hpp"
+#include "solvers.hpp"
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
 
 namespace mfem
 {
@@ -206,6 +212,254 @@ public:
 };
 
 
+/** @brief Abstract base class for ODE solvers with an embedded error estimate
+    and adaptive time step control. */
+/** Each attempted step of size dt computes a new solution x_new and an
+    estimate e of its local error, given by the difference with an embedded
+    solution of lower order q. The error is measured in the weighted RMS norm
+       |e| = sqrt( 1/N sum_i ( e_i / (abs_tol + rel_tol max(|x_i|,|x_new_i|)) )^2 )
+    where N is the global number of unknowns, and the step is accepted when
+    |e| <= 1. Rejected steps are retried with a smaller dt. The size of the next
+    step is chosen by the PI controller
+       dt_new = dt * safety * |e|^(-0.7/(q+1)) * |e_prev|^(0.4/(q+1)),
+    limited to [min_factor, max_factor] times dt and to the maximum time step.
+
+    Step() takes one accepted step, starting with the step size @a dt [in]. On
+    return, @a t [out] is the time of the accepted step, and @a dt [out] is the
+    step size proposed by the controller for the next step, which may be larger
+    than the step that was taken, see GetLastTimeStep(). Thus, a loop of the
+    form `while (t < tf) { dt = min(dt, tf - t); solver.Step(x, t, dt); }`
+    adapts the time step automatically; this is what Run() does.
+
+    When constructed with an MPI communicator, the error norm is computed
+    globally, so all ranks take the same steps. */
+class AdaptiveODESolver : public ODESolver
+{
+protected:
+   int err_order;
+   double rel_tol, abs_tol;
+   double safety, min_factor, max_factor, dt_max;
+   int max_rejections;
+
+   double err_prev, dt_last;
+   int num_accepted, num_rejected;
+   Vector x_new, x_err, w;
+
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm;
+#endif
+
+   /** @brief Compute a step of size @a dt from the solution @a x at time @a t:
+       the new solution in @a xn and the local error estimate in @a err. */
+   virtual void TryStep(const Vector &x, double t, double dt,
+                        Vector &xn, Vector &err) = 0;
+
+   /// Called after the step of size @a dt from time @a t has been accepted.
+   virtual void StepAccepted(double t, double dt) { }
+
+   /// Weighted RMS norm of @a err, see the class description.
+   double ErrorNorm(const Vector &x, const Vector &xn, const Vector &err);
+
+   /** @brief Construct a solver with error estimate of order @a q, the order
+       of the embedded method. */
+   AdaptiveODESolver(int q);
+
+#ifdef MFEM_USE_MPI
+   AdaptiveODESolver(int q, MPI_Comm _comm);
+#endif
+
+public:
+   virtual void Init(TimeDependentOperator &_f);
+
+   /// Take one accepted step, see the class description.
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   /** @brief Perform time integration from time @a t [in] to time @a tf [in],
+       with the last step shortened to end at @a tf. */
+   virtual void Run(Vector &x, double &t, double &dt, double tf);
+
+   /// Set the relative and absolute tolerances of the error norm.
+   void SetTolerances(double rtol, double atol)
+   { rel_tol = rtol; abs_tol = atol; }
+
+   /** @brief Set the safety factor (default 0.9) and the bounds for the ratio
+       of consecutive step sizes (default [0.2,5]). */
+   void SetControllerParameters(double safe, double min_fac, double max_fac)
+   { safety = safe; min_factor = min_fac; max_factor = max_fac; }
+
+   /// Set the maximum time step size, default: no limit.
+   void SetMaxTimeStep(double dtmax) { dt_max = dtmax; }
+
+   /// Set the maximum number of rejected attempts in one Step(), default 50.
+   void SetMaxRejections(int max_rej) { max_rejections = max_rej; }
+
+   /// Return the size of the last accepted step.
+   double GetLastTimeStep() const { return dt_last; }
+
+   /// Return the number of accepted steps since the last call to Init().
+   int GetNumAcceptedSteps() const { return num_accepted; }
+
+   /// Return the number of rejected steps since the last call to Init().
+   int GetNumRejectedSteps() const { return num_rejected; }
+};
+
+
+/** An explicit embedded Runge-Kutta pair, corresponding to the Butcher tableau
+    +--------+----------------------+
+    | c[0]   | a[0]                 |
+    | c[1]   | a[1] a[2]            |
+    | ...    |    ...               |
+    | c[s-2] | ...   a[s(s-1)/2-1]  |
+    +--------+----------------------+
+    |        | b[0] b[1] ... b[s-1] |
+    +--------+----------------------+
+    |        | d[0] d[1] ... d[s-1] |
+    +--------+----------------------+
+    where b are the weights of the solution and d are the differences between
+    the weights of the solution and of the embedded solution of order q. For
+    "first same as last" (FSAL) pairs, where the last stage is evaluated at the
+    new solution, the last stage is reused as the first stage of the next step.
+    The first stage is also reused when a step is rejected. Therefore, the
+    solution vector should not be changed between calls to Step(); call Init()
+    to restart the integration after changing it. */
+class EmbeddedRKSolver : public AdaptiveODESolver
+{
+private:
+   int s;
+   const double *a, *b, *c, *d;
+   bool fsal;
+   Vector y, *k;
+
+   /// If true, k[0] holds f(x,t) for t = k0_time
+   bool k0_valid;
+   double k0_time;
+
+protected:
+   virtual void TryStep(const Vector &x, double t, double dt,
+                        Vector &xn, Vector &err);
+
+   virtual void StepAccepted(double t, double dt);
+
+public:
+   EmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                    const double *_c, const double *_d, int q);
+
+#ifdef MFEM_USE_MPI
+   EmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                    const double *_c, const double *_d, int q,
+                    MPI_Comm _comm);
+#endif
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual ~EmbeddedRKSolver();
+};
+
+
+/** The 7-stage, 5th order Dormand-Prince method with an embedded 4th order
+    error estimate (FSAL, 6 function evaluations per step). */
+class DormandPrince54Solver : public EmbeddedRKSolver
+{
+private:
+   static const double a[21], b[7], c[6], d[7];
+
+public:
+   DormandPrince54Solver() : EmbeddedRKSolver(7, a, b, c, d, 4) { }
+
+#ifdef MFEM_USE_MPI
+   DormandPrince54Solver(MPI_Comm _comm)
+      : EmbeddedRKSolver(7, a, b, c, d, 4, _comm) { }
+#endif
+};
+
+
+/** The 4-stage, 3rd order Bogacki-Shampine method with an embedded 2nd order
+    error estimate (FSAL, 3 function evaluations per step). */
+class BogackiShampine32Solver : public EmbeddedRKSolver
+{
+private:
+   static const double a[6], b[4], c[3], d[4];
+
+public:
+   BogackiShampine32Solver() : EmbeddedRKSolver(4, a, b, c, d, 2) { }
+
+#ifdef MFEM_USE_MPI
+   BogackiShampine32Solver(MPI_Comm _comm)
+      : EmbeddedRKSolver(4, a, b, c, d, 2, _comm) { }
+#endif
+};
+
+
+/** @brief Second order, conservative local time stepping (multirate) method
+    based on Heun's method (SSP RK2). */
+/** The unknowns are split into groups, e.g. the dofs of the mesh elements,
+    and each group is assigned a level l >= 0 so that it is advanced with the
+    time step dt/2^l, where dt is the step size given to Step(). The levels
+    can be computed with Mesh::GetTimeStepLevels(). The right-hand side of a
+    group may depend only on the unknowns of the group and of its neighbors,
+    as for explicit DG methods.
+
+    The method is a partitioned RK method: the finest level takes 2^L Heun
+    substeps, L being the maximum level, and each level uses the weights of
+    the finest level, which ensures that the interface fluxes between levels
+    are the same on both sides, so that the method is conservative for
+    conservative DG operators. It is second order accurate, and reduces to
+    Heun's method when all groups have the same level.
+
+    The right-hand side is computed with TimeDependentOperator::MultRows():
+    the rows of a group with level l are evaluated 2*2^q times per step, where
+    q is the maximum level of the group and its neighbors, instead of 2*2^L
+    times for a global time step. Operators should re-implement MultRows() to
+    realize the savings. The stage vectors are stored on the host.
+
+    In parallel, the maximum level is global and all processors call
+    MultRows() in the same sequence, possibly with empty rows, so it may use
+    collective communication. The neighbors on other processors, e.g. the
+    face-neighbor elements of a ParMesh, are included through the levels
+    computed by ParMesh::ExchangeFaceNbrLevels(). */
+class MultirateRK2Solver : public ODESolver
+{
+protected:
+   int num_levels;
+   /// Rows of the groups with level l and maximum neighbor level q, stored
+   /// at index q*num_levels+l
+   Array<int> *rows;
+   /// Number of rows in #rows, summed over all processors in parallel
+   Array<int> num_rows;
+   Vector pred, acc, ka, kb;
+
+   void SetGroups(const Table &group_rows, const Array<int> &group_level,
+                  const Table &group_nbrs, int max_level);
+
+public:
+   /** @brief Construct the solver for the groups with unknowns given by the
+       rows of @a group_rows, levels @a group_level and neighbors given by the
+       rows of @a group_nbrs, e.g. the tables FiniteElementSpace::
+       GetElementToDofTable() and Mesh::ElementToElementTable(). */
+   /** The array @a group_level may contain, after the levels of the groups,
+       the levels of neighbors that are not groups of this solver, referenced
+       by the indices >= group_rows.Size() in @a group_nbrs. */
+   MultirateRK2Solver(const Table &group_rows, const Array<int> &group_level,
+                      const Table &group_nbrs);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Parallel version: @a group_level also contains the levels of the
+       neighbors on other processors, see ParMesh::ExchangeFaceNbrLevels(). */
+   MultirateRK2Solver(MPI_Comm comm, const Table &group_rows,
+                      const Array<int> &group_level, const Table &group_nbrs);
+#endif
+
+   /// Return the maximum level, the finest level takes 2^L steps per step.
+   int GetMaxLevel() const { return num_levels - 1; }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   virtual ~MultirateRK2Solver();
+};
+
+
 /** An explicit Adams-Bashforth method. */
 class AdamsBashforthSolver : public ODESolver
 {
@@ -431,6 +685,451 @@ public:
 };
 
 
+/** The L-stable, 3rd order SDIRK method of SDIRK33Solver with an embedded 2nd
+    order error estimate and adaptive time step control. The embedded solution
+    uses only the first two stages. */
+class EmbeddedSDIRK33Solver : public AdaptiveODESolver
+{
+protected:
+   Vector k, y;
+
+   virtual void TryStep(const Vector &x, double t, double dt,
+                        Vector &xn, Vector &err);
+
+public:
+   EmbeddedSDIRK33Solver() : AdaptiveODESolver(2) { }
+
+#ifdef MFEM_USE_MPI
+   EmbeddedSDIRK33Solver(MPI_Comm _comm) : AdaptiveODESolver(2, _comm) { }
+#endif
+
+   virtual void Init(TimeDependentOperator &_f);
+};
+
+
+/** @brief Reuse of the linear solver state across the calls to
+    TimeDependentOperator::ImplicitSolve().
+
+    This is a helper for implementations of ImplicitSolve() that solve linear
+    systems A(dt) k = b with an IterativeSolver, where A(dt) depends on the
+    time step @a dt passed to ImplicitSolve(). For DIRK methods this is the
+    product of the time step and the diagonal coefficient of the method, so it
+    takes only a few distinct values during the time integration. Derived
+    classes implement NewSystem() and NewPreconditioner(), and ImplicitSolve()
+    computes b and calls Solve(). The class then:
+    - keeps the systems A(dt) and their preconditioners for the last
+      SetMaxSystems() values of dt and reuses them when dt repeats;
+    - after Update(), which signals that the operators A(dt) changed, e.g.
+      because of a nonlinear coefficient, recreates A(dt) but keeps the old
+      preconditioners until the number of iterations of the solver grows by
+      more than the factor set with SetRefreshFactor() compared to the solve
+      right after the last setup, or until the solver fails to converge, in
+      which case the solve is repeated with a new preconditioner;
+    - uses as initial guess the linear extrapolation in time of the last two
+      solutions, see SetExtrapolation().
+
+    The iterative solvers measure the relative tolerance with respect to the
+    initial residual, so with the initial guess the relative tolerance of the
+    solver is scaled by |b|/|b - A(dt) k0|, where k0 is the initial guess and
+    |.| is the l2 norm, global when the cache is constructed with an MPI
+    communicator. The preconditioner set in the solver is replaced by an
+    internal one, so SetOperator() is not called for the cached
+    preconditioners when switching between systems. */
+class ImplicitSolveCache
+{
+protected:
+   /// Forwards to the preconditioner of the current system.
+   class Preconditioner : public Solver
+   {
+   public:
+      const Solver *prec;
+      Preconditioner() : prec(NULL) { }
+      /// Use @a p (may be NULL) with the operator @a A of the current system.
+      void Set(const Operator &A, const Solver *p)
+      { height = A.Height(); width = A.Width(); prec = p; }
+      virtual void Mult(const Vector &x, Vector &y) const;
+      /// The cached preconditioners are set up in NewPreconditioner().
+      virtual void SetOperator(const Operator &op) { }
+   };
+
+   /// A cached system A(dt) and its preconditioner.
+   struct System
+   {
+      double dt;
+      Operator *A;      ///< NULL after Update(), recreated on demand
+      Operator *prec_A; ///< the operator used to set up prec
+      Solver *prec;
+      int ref_iter;     ///< iterations of the first solve after the setup
+      long last_use;
+   };
+
+   IterativeSolver &solver;
+   Preconditioner solver_prec;
+   Array<System*> systems;
+   int max_systems;
+   double refresh_factor;
+   bool extrapolate;
+
+   /// Last two solutions and their times, used for the initial guess.
+   Vector k_prev[2];
+   double t_prev[2];
+   int num_prev;
+
+   long num_solves;
+   int num_setups, num_prec_setups, num_iter;
+
+   Vector r;
+
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm;
+#endif
+
+   /** @brief Return a new operator A(@a dt), the cache takes ownership of
+       it. */
+   virtual Operator *NewSystem(double dt) = 0;
+
+   /** @brief Return a new preconditioner, set up with the operator @a A
+       returned by NewSystem(@a dt), or NULL for no preconditioner. The cache
+       takes ownership of it. */
+   virtual Solver *NewPreconditioner(const Operator &A, double dt)
+   { return NULL; }
+
+   /// Find or create the system for @a dt.
+   System *GetSystem(double dt);
+   /// Delete the preconditioner of @a sys and set up a new one with sys->A.
+   void SetupPreconditioner(System &sys);
+   void DeleteSystem(System *sys);
+   void InitialGuess(double t, Vector &k) const;
+   double Norm(const Vector &x) const;
+   /** @brief Set the relative tolerance of the solver for the initial guess
+       @a k, keeping the accuracy @a rel_tol of a solve with zero initial
+       guess, see the class description. */
+   void SetRelTol(const Operator &A, const Vector &b, const Vector &k,
+                  double rel_tol);
+
+public:
+   /// Use @a solver_ (not owned) for the solution of the systems.
+   ImplicitSolveCache(IterativeSolver &solver_);
+
+#ifdef MFEM_USE_MPI
+   ImplicitSolveCache(MPI_Comm comm_, IterativeSolver &solver_);
+#endif
+
+   /// Set the number of cached systems, default: 2.
+   void SetMaxSystems(int max_sys);
+
+   /** @brief Set the growth factor of the number of iterations that triggers
+       a new setup of the preconditioner, default: 1.5. */
+   void SetRefreshFactor(double factor) { refresh_factor = factor; }
+
+   /** @brief Enable or disable the extrapolation of the previous solutions as
+       initial guess, default: enabled. */
+   /** When disabled, the solver starts from the input value of @a k in
+       Solve() if its IterativeSolver::iterative_mode is set, and from zero
+       otherwise. */
+   void SetExtrapolation(bool extrap) { extrapolate = extrap; }
+
+   /** @brief Solve A(@a dt) @a k = @a b, where @a t is the time of the
+       solution, typically TimeDependentOperator::GetTime(). */
+   void Solve(double dt, double t, const Vector &b, Vector &k);
+
+   /** @brief Notify the cache that the operators A(dt) changed. They are
+       recreated on demand, while the preconditioners are reused as described
+       in the class description. */
+   void Update();
+
+   /// Delete all cached systems and forget the previous solutions.
+   void Reset();
+
+   /// Number of calls to NewSystem().
+   int GetNumSetups() const { return num_setups; }
+   /// Number of calls to NewPreconditioner().
+   int GetNumPreconditionerSetups() const { return num_prec_setups; }
+   /// Total number of iterations of the solver in Solve().
+   int GetNumIterations() const { return num_iter; }
+
+   virtual ~ImplicitSolveCache() { Reset(); }
+};
+
+
+/** An implicit-explicit (IMEX) additive Runge-Kutta method for the additive
+    split f(x,t) = f1(x,t) + f2(x,t), where the non-stiff term f1 is treated
+    explicitly and the stiff term f2 implicitly with a diagonally implicit RK
+    method. The pair of Butcher tableaus is
+    +--------+---------------------------+  +-----------------------------+
+    | c[0]   |                           |  | ai[0]                       |
+    | c[1]   | ae[0]                     |  | ai[1] ai[2]                 |
+    | ...    |    ...                    |  |    ...                      |
+    | c[s-1] | ...  ae[s(s-1)/2-1]       |  | ...         ai[s(s+1)/2-1]  |
+    +--------+---------------------------+  +-----------------------------+
+    |        | be[0] be[1] ... be[s-1]   |  | bi[0] bi[1] ... bi[s-1]     |
+    +--------+---------------------------+  +-----------------------------+
+    with c[0] = 0. The two terms are evaluated with the evaluation modes
+    TimeDependentOperator::ADDITIVE_TERM_1 (f1, using Mult()) and
+    TimeDependentOperator::ADDITIVE_TERM_2 (f2, using Mult() and
+    ImplicitSolve()) of the associated operator, which is set back to
+    TimeDependentOperator::NORMAL at the end of each step.
+
+    Stages with a zero diagonal entry in the implicit tableau are explicit in
+    both terms. For the other stages, the vector @a k passed to ImplicitSolve()
+    contains the implicit stage derivative of the previous implicit stage (of
+    the same step or of the previous step), which operators using iterative
+    solvers can use as an initial guess. Stage derivatives that are not needed
+    are not computed. */
+class IMEXRKSolver : public ODESolver
+{
+private:
+   int s;
+   const double *ae, *ai, *be, *bi, *c;
+   Array<bool> need_e, need_i;
+   Vector y, *ke, *ki;
+   int last_implicit;
+
+public:
+   IMEXRKSolver(int _s, const double *_ae, const double *_ai,
+                const double *_be, const double *_bi, const double *_c);
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   virtual ~IMEXRKSolver();
+};
+
+
+/** The 3-stage, 2nd order IMEX method ARS(2,2,2) of Ascher, Ruuth and Spiteri,
+    with an L-stable implicit part. */
+class ARS222Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[3], ai[6], be[3], bi[3], c[3];
+
+public:
+   ARS222Solver() : IMEXRKSolver(3, ae, ai, be, bi, c) { }
+};
+
+
+/** The 4-stage, 3rd order IMEX method ARK3(2)4L[2]SA of Kennedy and Carpenter,
+    with an L-stable, stiffly accurate ESDIRK implicit part. */
+class ARK324Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[6], ai[10], be[4], bi[4], c[4];
+
+public:
+   ARK324Solver() : IMEXRKSolver(4, ae, ai, be, bi, c) { }
+};
+
+
+/** The 6-stage, 4th order IMEX method ARK4(3)6L[2]SA of Kennedy and Carpenter,
+    with an L-stable, stiffly accurate ESDIRK implicit part. */
+class ARK436Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[15], ai[21], be[6], bi[6], c[6];
+
+public:
+   ARK436Solver() : IMEXRKSolver(6, ae, ai, be, bi, c) { }
+};
+
+
+/** @brief Action of the phi-functions of an Operator A, computed with an
+    adaptive Krylov (Arnoldi) method that only uses A.Mult(). */
+/** Mult() computes the linear combination
+       w = phi_0(h A) b_0 + h phi_1(h A) b_1 + ... + h^p phi_p(h A) b_p,
+    where phi_0(z) = exp(z) and phi_{k+1}(z) = (phi_k(z) - 1/k!)/z. Following
+    Al-Mohy and Higham (SIAM J. Sci. Comput. 33, 2011), w is the first block of
+    exp(h Ab) [b_0; e_p], where Ab = [A, B; 0, J] is the augmented operator of
+    size n+p, with B = [b_p, ..., b_1] and the p x p shift matrix J. Thus, all
+    phi-functions are computed with one Krylov space, using the exponential of
+    the small Hessenberg matrix.
+
+    The Arnoldi iteration stops when the error estimate of Saad is below
+    rel_tol |w|. If this does not happen within max_dim iterations (default
+    30), the interval h is split into substeps, as in Expokit, and the Krylov
+    space is rebuilt for each substep. Thus, the work adapts to the stiffness
+    of h A, and large values of h are always stable.
+
+    When constructed with an MPI communicator, the inner products are computed
+    globally. */
+class KrylovPhi
+{
+protected:
+   const Operator *A;
+   int max_dim, print_level;
+   double rel_tol;
+   int num_mult, num_substeps;
+   Vector *V, Av;
+   DenseMatrix H, M, E;
+
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm;
+#endif
+
+   /** @brief Inner product of augmented vectors, where the first n entries
+       are global. With @a aug = false, only the first n entries are used. */
+   double Dot(const Vector &x, const Vector &y, bool aug = true) const;
+
+   /// Action of the augmented operator, see the class description.
+   void AugmentedMult(const Array<const Vector*> &b, double eta,
+                      const Vector &x, Vector &y) const;
+
+   /** @brief Compute the approximation Av = beta V_m exp(tau H_m) e_1 and
+       return its error estimate, using the first m+1 Arnoldi vectors. */
+   double Approximate(double tau, double beta, int m, double h_next);
+
+public:
+   KrylovPhi();
+
+#ifdef MFEM_USE_MPI
+   KrylovPhi(MPI_Comm _comm);
+#endif
+
+   /// Set the Operator A; its action is computed with A.Mult().
+   void SetOperator(const Operator &op) { A = &op; }
+
+   /// Set the relative tolerance of the result, default 1e-8.
+   void SetRelTol(double rtol) { rel_tol = rtol; }
+
+   /// Set the maximum dimension of the Krylov space, default 30.
+   void SetMaxDim(int dim);
+
+   void SetPrintLevel(int print_lvl) { print_level = print_lvl; }
+
+   /// Global l2 norm of a Vector of the size of A.
+   double Norm(const Vector &x) const { return sqrt(Dot(x, x, false)); }
+
+   /** @brief Compute w = sum_k h^k phi_k(h A) b[k], k = 0,...,b.Size()-1,
+       where NULL entries of @a b are zero. */
+   void Mult(double h, const Array<const Vector*> &b, Vector &w);
+
+   /// Return the number of applications of A in the last call to Mult().
+   int GetNumMult() const { return num_mult; }
+
+   /// Return the number of substeps in the last call to Mult().
+   int GetNumSubsteps() const { return num_substeps; }
+
+   ~KrylovPhi();
+};
+
+
+/** @brief Abstract base class for exponential integrators of dx/dt = f(x,t),
+    which treat a linear operator L exactly through phi-functions of h L. */
+/** In each step, f is written as f(x,t) = f_n + L (x - x_n) + N(x,t), where
+    f_n = f(x_n,t_n), and the phi-functions of L are evaluated with KrylovPhi,
+    so that only the action of f (and of L) is needed, and no preconditioner
+    or linear solver is set up. The operator L is chosen with SetLinearPart():
+    - JACOBIAN: the Jacobian of f at (x_n,t_n), approximated by the finite
+      differences (f(x_n + e v,t_n) - f_n)/e, e = fd_eps sqrt(1 + |x_n|)/|v|,
+      giving the exponential Rosenbrock methods (default).
+    - LINEAR: f is affine in x, and L v = f(v,t_n) - f(0,t_n) exactly.
+    - SPLIT: f = f1 + f2, where f2, evaluated in the mode
+      TimeDependentOperator::ADDITIVE_TERM_2, is affine in x and
+      L v = f2(v,t_n) - f2(0,t_n), giving the exponential time differencing
+      (ETD) methods, in which f1 is explicit.
+    In the JACOBIAN and LINEAR modes, the time derivative of f is computed by
+    finite differences and integrated with phi_2, which keeps the order of the
+    methods for non-autonomous problems. */
+class ExponentialODESolver : public ODESolver
+{
+public:
+   /// Choice of the linear operator L, see the class description.
+   enum LinearPart { JACOBIAN, LINEAR, SPLIT };
+
+protected:
+   class LinearPartOperator;
+
+   KrylovPhi phi;
+   LinearPart lin_part;
+   double fd_eps;
+   LinearPartOperator *L;
+   double tn;
+   Vector fx, ft, a, r, w, dz, Ldz;
+   Array<const Vector*> b;
+
+   /** @brief Set up L at (@a x, @a t), compute fx = f(x,t) and, in the
+       JACOBIAN and LINEAR modes, ft = df/dt(x,t) (otherwise ft = 0). */
+   void Linearize(const Vector &x, double t);
+
+   /** @brief Compute rz = f(z,t) - fx - L (z - x) - (t - tn) ft, the nonlinear
+       remainder at the stage (z,t) relative to the linearization point x. */
+   void Remainder(const Vector &x, const Vector &z, double t, Vector &rz);
+
+   ExponentialODESolver();
+
+#ifdef MFEM_USE_MPI
+   ExponentialODESolver(MPI_Comm comm);
+#endif
+
+public:
+   virtual void Init(TimeDependentOperator &_f);
+
+   /// Set the linear operator L, see the class description.
+   void SetLinearPart(LinearPart lp) { lin_part = lp; }
+
+   /// Set the finite difference parameter, default 1.5e-8.
+   void SetFDEps(double eps) { fd_eps = eps; }
+
+   /// Return the Krylov phi-function evaluator, e.g. to set its tolerance.
+   KrylovPhi &GetKrylovPhi() { return phi; }
+
+   virtual ~ExponentialODESolver();
+};
+
+
+/** The exponential Euler method x_{n+1} = x_n + h phi_1(h L) f_n. It is second
+    order with the JACOBIAN and LINEAR modes (the exponential Rosenbrock-Euler
+    method), exact for affine autonomous f, and first order in the SPLIT mode
+    (ETD1). */
+class ExponentialEulerSolver : public ExponentialODESolver
+{
+public:
+   ExponentialEulerSolver() { }
+
+#ifdef MFEM_USE_MPI
+   ExponentialEulerSolver(MPI_Comm comm) : ExponentialODESolver(comm) { }
+#endif
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
+/** The second order exponential time differencing method ETD2RK of Cox and
+    Matthews, intended for the SPLIT mode:
+       a = x_n + h phi_1(h L) f_n,
+       x_{n+1} = a + h phi_2(h L) (N(a,t_n+h) - N(x_n,t_n)). */
+class ETDRK2Solver : public ExponentialODESolver
+{
+public:
+   ETDRK2Solver() { SetLinearPart(SPLIT); }
+
+#ifdef MFEM_USE_MPI
+   ETDRK2Solver(MPI_Comm comm) : ExponentialODESolver(comm)
+   { SetLinearPart(SPLIT); }
+#endif
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
+/** The third order exponential Rosenbrock method exprb32 of Hochbruck,
+    Ostermann and Schweitzer (SIAM J. Numer. Anal. 47, 2009), a two-stage
+    method of EPIRK type, for the JACOBIAN and LINEAR modes:
+       a = x_n + h phi_1(h J) f_n + h^2 phi_2(h J) ft_n,
+       x_{n+1} = a + 2 h phi_3(h J) N(a,t_n+h). */
+class ExpRB32Solver : public ExponentialODESolver
+{
+public:
+   ExpRB32Solver() { }
+
+#ifdef MFEM_USE_MPI
+   ExpRB32Solver(MPI_Comm comm) : ExponentialODESolver(comm) { }
+#endif
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier–Stokes equations with a stabilized finite element
 /// method" by K.E. Jansen, C.H. Whiting and G.M. Hulbert.
@@ -453,6 +1152,131 @@ public:
 };
 
 
+/** @brief Parallel-in-time integration with the Parareal method, or with the
+    two-level MGRIT method with FCF-relaxation. */
+/** Step() advances the solution over a time window of size dt, which is split
+    into N time slices [T_n,T_{n+1}]. The slices are integrated with a fine
+    propagator F, given by an ODESolver with a small time step, and a coarse
+    propagator G, given by an ODESolver with a larger time step and optionally
+    a cheaper operator, see SetCoarseOperator(). The slice start values U_n are
+    initialized with a sequential coarse solve, and every iteration computes
+       U_{n+1} = G(U_n^new) + F(U_n^old) - G(U_n^old),
+    where the fine propagations of all slices are independent. After k
+    iterations, the first k slices are equal to the sequential fine solution,
+    so at most N iterations are needed, and these slices are skipped in the
+    next iterations. The iteration stops when the largest norm of the updates
+    of the U_n is below max(rel_tol*|U|, abs_tol), |U| being the largest norm
+    of the U_n.
+
+    With FCF-relaxation, the U_n are replaced by the fine propagations from the
+    previous slices before each iteration (MGRIT). This needs two fine
+    propagations per slice and iteration, but fewer iterations: the first 2k
+    slices are exact after k iterations.
+
+    The propagators take a fixed number of steps per slice: the slice is
+    divided into the smallest number of equal steps not larger than the given
+    time step, and the ODESolver is re-initialized for each slice.
+
+    When constructed with an MPI communicator, the slices are distributed in
+    contiguous blocks over the ranks of @a time_comm, which compute the fine
+    propagations concurrently, while the coarse solve is pipelined through the
+    ranks. All ranks of @a time_comm hold the same spatial unknowns, e.g. the
+    ranks with the same spatial partition in a space-time decomposition, and
+    the norms are summed over @a space_comm, if given. On return from Step(),
+    all ranks hold the solution at the end of the window. */
+class PararealSolver : public ODESolver
+{
+protected:
+   ODESolver *fine, *coarse;
+   TimeDependentOperator *coarse_op;
+   double dt_fine, dt_coarse;
+   int num_slices, max_iter, print_level;
+   double rel_tol, abs_tol;
+   bool fcf;
+
+   int final_iter;
+   bool converged;
+   double final_norm;
+
+   /// Rank in the time communicator, and first and last+1 local slices
+   int rank, num_ranks, first_slice, last_slice;
+#ifdef MFEM_USE_MPI
+   MPI_Comm time_comm, space_comm;
+#endif
+
+   /// Local slice start values and the end value of the last local slice,
+   /// and the fine and coarse propagations of the local slices
+   Vector *U, *FU, *GU;
+   Vector g;
+
+   /// Propagate @a x from time @a t0 to @a t1 with time steps <= @a h.
+   void Propagate(ODESolver &solver, TimeDependentOperator &op, double h,
+                  Vector &x, double t0, double t1);
+
+   double Norm(const Vector &x) const;
+
+   /// Send @a x to the rank holding the next slice.
+   void SendNext(const Vector &x) const;
+
+   /// Receive @a x from the rank holding the previous slice.
+   void RecvPrev(Vector &x) const;
+
+   /// Combination of SendNext() and RecvPrev() without serialization.
+   void ShiftNext(const Vector &x, Vector &y) const;
+
+   void DeleteVectors();
+
+public:
+   PararealSolver();
+
+#ifdef MFEM_USE_MPI
+   PararealSolver(MPI_Comm _time_comm, MPI_Comm _space_comm = MPI_COMM_NULL);
+#endif
+
+   /// Set the fine propagator and its time step (not owned).
+   void SetFinePropagator(ODESolver &solver, double dt)
+   { fine = &solver; dt_fine = dt; }
+
+   /// Set the coarse propagator and its time step (not owned).
+   void SetCoarsePropagator(ODESolver &solver, double dt)
+   { coarse = &solver; dt_coarse = dt; }
+
+   /** @brief Set the operator used by the coarse propagator (not owned), by
+       default the operator given to Init(). */
+   void SetCoarseOperator(TimeDependentOperator &op) { coarse_op = &op; }
+
+   /** @brief Set the number of time slices in each Step(), by default the
+       number of ranks. Must be called before Init(). */
+   void SetNumSlices(int n) { num_slices = n; }
+
+   /// Use FCF-relaxation (two-level MGRIT), default: false (Parareal).
+   void SetFCFRelaxation(bool use_fcf = true) { fcf = use_fcf; }
+
+   void SetRelTol(double rtol) { rel_tol = rtol; }
+   void SetAbsTol(double atol) { abs_tol = atol; }
+
+   /// Set the maximum number of iterations, by default the number of slices.
+   void SetMaxIter(int max_it) { max_iter = max_it; }
+
+   /// Print the norm of the updates in each iteration if @a print_lvl > 0.
+   void SetPrintLevel(int print_lvl) { print_level = print_lvl; }
+
+   int GetNumSlices() const { return num_slices; }
+
+   /// Return the number of iterations of the last Step().
+   int GetNumIterations() const { return final_iter; }
+   bool GetConverged() const { return converged; }
+   double GetFinalNorm() const { return final_norm; }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   /// Advance @a x from time @a t to @a t + @a dt, see the class description.
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   virtual ~PararealSolver() { DeleteVectors(); }
+};
+
+
 /// The SIASolver class is based on the Symplectic Integration Algorithm
 /// described in "A Symplectic Integration Algorithm for Separable Hamiltonian
 /// Functions" by J. Candy and W. Rozmus, Journal of Computational Physics,
@@ -20,6 +20,19 @@
 namespace mfem
 {
 
+void Operator::MultMulti(const MultiVector &X, MultiVector &Y) const
+{
+   MFEM_ASSERT(X.VectorSize() == width && Y.VectorSize() == height &&
+               X.NumVectors() == Y.NumVectors(), "incompatible MultiVectors");
+   Vector x, y;
+   for (int j = 0; j < X.NumVectors(); j++)
+   {
+      X.GetVectorRef(j, x);
+      Y.GetVectorRef(j, y);
+      Mult(x, y);
+   }
+}
+
 void Operator::InitTVectors(const Operator *Po, const Operator *Ri,
                             Vector &x, Vector &b,
                             Vector &X, Vector &B) const
@@ -232,6 +245,19 @@ void TimeDependentOperator::ImplicitSolve(const double, const Vector &,
    mfem_error("TimeDependentOperator::ImplicitSolve() is not overridden!");
 }
 
+void TimeDependentOperator::MultRows(const Array<int> &rows, const Vector &x,
+                                     Vector &y) const
+{
+   Vector z(height);
+   Mult(x, z);
+   const double *d_z = z.HostRead();
+   double *d_y = y.HostReadWrite();
+   for (int i = 0; i < rows.Size(); i++)
+   {
+      d_y[rows[i]] = d_z[rows[i]];
+   }
+}
+
 Operator &TimeDependentOperator::GetImplicitGradient(
    const Vector &, const Vector &, double) const
 {
@@ -339,6 +365,22 @@ RAPOperator::RAPOperator(const Operator &Rt_, const Operator &A_,
    APx.SetSize(A.Height(), mem_type);
 }
 
+void RAPOperator::MultMulti(const MultiVector &X, MultiVector &Y) const
+{
+   const int nv = X.NumVectors();
+   PX.SetSize(P.Height(), nv, Px.GetMemory().GetMemoryType());
+   APX.SetSize(A.Height(), nv, APx.GetMemory().GetMemoryType());
+   P.MultMulti(X, PX);
+   A.MultMulti(PX, APX);
+   Vector apx, y;
+   for (int j = 0; j < nv; j++)
+   {
+      APX.GetVectorRef(j, apx);
+      Y.GetVectorRef(j, y);
+      Rt.MultTranspose(apx, y);
+   }
+}
+
 
 TripleProductOperator::TripleProductOperator(
    const Operator *A, const Operator *B, const Operator *C,
@@ -453,6 +495,45 @@ void ConstrainedOperator::Mult(const Vector &x, Vector &y) const
    });
 }
 
+void ConstrainedOperator::MultMulti(const MultiVector &X,
+                                    MultiVector &Y) const
+{
+   const int csz = constraint_list.Size();
+   if (csz == 0)
+   {
+      A->MultMulti(X, Y);
+      return;
+   }
+
+   const int n = X.VectorSize(), nv = X.NumVectors();
+   Z.SetSize(n, nv, z.GetMemory().GetMemoryType());
+   Z = X;
+
+   auto idx = constraint_list.Read();
+   auto d_Z = Z.ReadWrite();
+   MFEM_FORALL(k, csz*nv, d_Z[idx[k % csz] + (k / csz)*n] = 0.0;);
+
+   A->MultMulti(Z, Y);
+
+   auto d_X = X.Read();
+   auto d_Y = Y.ReadWrite();
+   MFEM_FORALL(k, csz*nv,
+   {
+      const int id = idx[k % csz] + (k / csz)*n;
+      d_Y[id] = d_X[id];
+   });
+}
+
+void ConstrainedOperator::AssembleDiagonal(Vector &diag) const
+{
+   A->AssembleDiagonal(diag);
+
+   const int csz = constraint_list.Size();
+   auto idx = constraint_list.Read();
+   auto d_diag = diag.ReadWrite();
+   MFEM_FORALL(i, csz, d_diag[idx[i]] = 1.0;);
+}
+
 RectangularConstrainedOperator::RectangularConstrainedOperator(
    Operator *A,
    const Array<int> &trial_list,
@@ -13,6 +13,7 @@
 #define MFEM_OPERATOR
 
 #include "vector.hpp"
+#include "multivector.hpp"
 
 namespace mfem
 {
@@ -79,11 +80,25 @@ public:
    /// Operator application: `y=A(x)`.
    virtual void Mult(const Vector &x, Vector &y) const = 0;
 
+   /** @brief Operator application to several vectors: `Y_j=A(X_j)` for all
+       vectors j of @a X. */
+   /** The MultiVector @a Y must have the same number of vectors as @a X, with
+       size Height(). The default implementation calls Mult() for each vector;
+       derived classes can override it to read the operator data only once for
+       all vectors. */
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const;
+
    /** @brief Action of the transpose operator: `y=A^t(x)`. The default behavior
        in class Operator is to generate an error. */
    virtual void MultTranspose(const Vector &x, Vector &y) const
    { mfem_error("Operator::MultTranspose() is not overloaded!"); }
 
+   /** @brief Compute the diagonal of the operator, e.g. for a Jacobi
+       preconditioner. The default behavior in class Operator is to generate an
+       error. */
+   virtual void AssembleDiagonal(Vector &diag) const
+   { mfem_error("Operator::AssembleDiagonal() is not overloaded!"); }
+
    /** @brief Evaluate the gradient operator at the point @a x. The default
        behavior in class Operator is to generate an error. */
    virtual Operator &GetGradient(const Vector &x) const
@@ -363,6 +378,18 @@ public:
        If not re-implemented, this method simply generates an error. */
    virtual void ImplicitSolve(const double dt, const Vector &x, Vector &k);
 
+   /** @brief Perform the action of the operator for the unknowns with indices
+       in @a rows: @a y(i) = f(@a x, t)(i) for all i in @a rows. */
+   /** The other entries of @a y are not referenced. This method is used by
+       local time stepping methods, see MultirateRK2Solver. Operators whose
+       action is computed element by element, e.g. explicit DG operators with
+       block diagonal mass matrices, can compute only the needed elements.
+
+       If not re-implemented, this method computes the full action with Mult()
+       and copies the requested entries. */
+   virtual void MultRows(const Array<int> &rows, const Vector &x,
+                         Vector &y) const;
+
    /** @brief Return an Operator representing (dF/dk @a shift + dF/dx) at the
        given @a x, @a k, and the currently set time.
 
@@ -559,6 +586,7 @@ private:
    const Operator & P;
    mutable Vector Px;
    mutable Vector APx;
+   mutable MultiVector PX, APX;
    MemoryClass mem_class;
 
 public:
@@ -574,6 +602,9 @@ public:
    /// Application of the transpose.
    virtual void MultTranspose(const Vector & x, Vector & y) const
    { Rt.Mult(x, APx); A.MultTranspose(APx, Px); P.MultTranspose(Px, y); }
+
+   /// Operator application to several vectors.
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const;
 };
 
 
@@ -616,6 +647,7 @@ protected:
    Operator *A;                 ///< The unconstrained Operator.
    bool own_A;                  ///< Ownership flag for A.
    mutable Vector z, w;         ///< Auxiliary vectors.
+   mutable MultiVector Z;       ///< Auxiliary MultiVector.
    MemoryClass mem_class;
 
 public:
@@ -652,6 +684,13 @@ public:
        the vectors, and "_i" -- the rest of the entries. */
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /// Constrained operator action on several vectors, see Mult().
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const;
+
+   /** @brief Diagonal of the unconstrained operator, with entries equal to one
+       at the constrained indices/dofs. */
+   virtual void AssembleDiagonal(Vector &diag) const;
+
    /// Destructor: destroys the unconstrained Operator, if owned.
    virtual ~ConstrainedOperator() { if (own_A) { delete A; } }
 };
@@ -113,8 +113,9 @@ OperatorJacobiSmoother::OperatorJacobiSmoother(const BilinearForm &a,
    N(height),
    dinv(N),
    damping(dmpng),
-   ess_tdof_list(ess_tdofs),
-   residual(N)
+   ess_tdof_list(&ess_tdofs),
+   residual(N),
+   use_oper_diag(false)
 {
    Vector diag(N);
    a.AssembleDiagonal(diag);
@@ -130,21 +131,50 @@ OperatorJacobiSmoother::OperatorJacobiSmoother(const Vector &d,
    N(d.Size()),
    dinv(N),
    damping(dmpng),
-   ess_tdof_list(ess_tdofs),
-   residual(N)
+   ess_tdof_list(&ess_tdofs),
+   residual(N),
+   oper(NULL),
+   use_oper_diag(false)
 {
    Setup(d);
 }
 
+OperatorJacobiSmoother::OperatorJacobiSmoother(const double dmpng)
+   :
+   Solver(0),
+   N(0),
+   damping(dmpng),
+   ess_tdof_list(NULL),
+   oper(NULL),
+   use_oper_diag(true)
+{ }
+
+void OperatorJacobiSmoother::SetOperator(const Operator &op)
+{
+   oper = &op;
+   if (use_oper_diag)
+   {
+      Vector diag(op.Height());
+      op.AssembleDiagonal(diag);
+      Setup(diag);
+   }
+}
+
 void OperatorJacobiSmoother::Setup(const Vector &diag)
 {
+   N = height = width = diag.Size();
+   dinv.SetSize(N);
+   residual.SetSize(N);
    residual.UseDevice(true);
    const double delta = damping;
    auto D = diag.Read();
    auto DI = dinv.Write();
    MFEM_FORALL(i, N, DI[i] = delta / D[i]; );
-   auto I = ess_tdof_list.Read();
-   MFEM_FORALL(i, ess_tdof_list.Size(), DI[I[i]] = delta; );
+   if (ess_tdof_list)
+   {
+      auto I = ess_tdof_list->Read();
+      MFEM_FORALL(i, ess_tdof_list->Size(), DI[I[i]] = delta; );
+   }
 }
 
 void OperatorJacobiSmoother::Mult(const Vector &x, Vector &y) const
@@ -539,6 +569,157 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
    pcg.Mult(b, x);
 }
 
+void BlockCGSolver::UpdateVectors(int nv) const
+{
+   const MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+   R.SetSize(width, nv, mt);
+   D.SetSize(width, nv, mt);
+   AD.SetSize(width, nv, mt);
+   if (prec) { Z.SetSize(width, nv, mt); }
+   nom.SetSize(nv);
+   goal.SetSize(nv);
+   active.SetSize(nv);
+}
+
+void BlockCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   MultiVector B(b.Size(), 1), X(x.Size(), 1);
+   Vector b_0, x_0;
+   B.GetVectorRef(0, b_0);
+   X.GetVectorRef(0, x_0);
+   b_0 = b;
+   if (iterative_mode) { x_0 = x; }
+   MultMulti(B, X);
+   x = x_0;
+}
+
+void BlockCGSolver::MultMulti(const MultiVector &B, MultiVector &X) const
+{
+   const int nv = B.NumVectors();
+   MFEM_VERIFY(X.NumVectors() == nv, "incompatible MultiVectors");
+   UpdateVectors(nv);
+
+   if (iterative_mode)
+   {
+      oper->MultMulti(X, R);
+      subtract(B, R, R); // R = B - A X
+   }
+   else
+   {
+      R = B;
+      X = 0.0;
+   }
+
+   // Z = M R, or a reference to R without preconditioner
+   MultiVector &MR = prec ? Z : R;
+   if (prec) { prec->MultMulti(R, Z); }
+   D = MR;
+
+   Vector x_j, r_j, d_j, z_j, ad_j;
+   int num_active = 0;
+   double max_nom = 0.0;
+   for (int j = 0; j < nv; j++)
+   {
+      R.GetVectorRef(j, r_j);
+      MR.GetVectorRef(j, z_j);
+      nom(j) = Dot(z_j, r_j);
+      MFEM_ASSERT(IsFinite(nom(j)), "nom = " << nom(j));
+      goal(j) = std::max(nom(j)*rel_tol*rel_tol, abs_tol*abs_tol);
+      active[j] = (nom(j) > goal(j));
+      num_active += active[j];
+      max_nom = std::max(max_nom, nom(j));
+   }
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  max (B r, r) = "
+                << max_nom << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   int i;
+   converged = 1;
+   for (i = 1; num_active > 0; i++)
+   {
+      if (i > max_iter)
+      {
+         converged = 0;
+         break;
+      }
+
+      oper->MultMulti(D, AD); // AD = A D
+      for (int j = 0; j < nv; j++)
+      {
+         if (!active[j]) { continue; }
+         D.GetVectorRef(j, d_j);
+         AD.GetVectorRef(j, ad_j);
+         const double den = Dot(ad_j, d_j);
+         MFEM_ASSERT(IsFinite(den), "den = " << den);
+         if (den <= 0.0)
+         {
+            if (print_level >= 0)
+            {
+               mfem::out << "BlockCG: The operator is not positive definite. "
+                         << "(Ad, d) = " << den << " for vector " << j << '\n';
+            }
+            active[j] = 0;
+            num_active--;
+            converged = 0;
+            continue;
+         }
+         const double alpha = nom(j)/den;
+         X.GetVectorRef(j, x_j);
+         R.GetVectorRef(j, r_j);
+         x_j.Add(alpha, d_j);   //  x = x + alpha d
+         r_j.Add(-alpha, ad_j); //  r = r - alpha A d
+      }
+
+      if (prec) { prec->MultMulti(R, Z); } //  Z = M R
+
+      max_nom = 0.0;
+      for (int j = 0; j < nv; j++)
+      {
+         if (!active[j]) { continue; }
+         R.GetVectorRef(j, r_j);
+         MR.GetVectorRef(j, z_j);
+         const double betanom = Dot(z_j, r_j);
+         MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
+         max_nom = std::max(max_nom, betanom);
+         if (betanom < goal(j))
+         {
+            active[j] = 0;
+            num_active--;
+            nom(j) = betanom;
+            continue;
+         }
+         const double beta = betanom/nom(j);
+         D.GetVectorRef(j, d_j);
+         add(z_j, beta, d_j, d_j); //  d = z + beta d
+         nom(j) = betanom;
+      }
+
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  max (B r, r) = "
+                   << max_nom << ", active vectors: " << num_active << '\n';
+      }
+   }
+   final_iter = i - 1;
+   final_norm = sqrt(nom.Max());
+
+   if (print_level == 2)
+   {
+      mfem::out << "Number of BlockCG iterations: " << final_iter << '\n';
+   }
+   else if (print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter
+                << "  max (B r, r) = " << final_norm*final_norm << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "BlockCG: No convergence!\n";
+   }
+}
+
 
 inline void GeneratePlaneRotation(double &dx, double &dy,
                                   double &cs, double &sn)
@@ -1303,6 +1484,78 @@ void MINRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
+// Finite difference approximation of the Jacobian of the Newton operator
+class NewtonSolver::FDJacobian : public Operator
+{
+protected:
+   const NewtonSolver &newton;
+   const Vector *x;
+   Vector fx;
+   mutable Vector xh, fh;
+   double eps, x_norm;
+
+public:
+   FDJacobian(const NewtonSolver &n, double fd_eps)
+      : Operator(n.Height()), newton(n), x(NULL), eps(fd_eps), x_norm(0.0) { }
+
+   double GetEps() const { return eps; }
+
+   /// Set the linearization point @a x_, where F(x_) - b = @a r.
+   void Update(const Vector &x_, const Vector &r, const Vector *b)
+   {
+      x = &x_;
+      fx = r;
+      if (b) { fx += *b; }
+      x_norm = newton.Norm(x_);
+   }
+
+   virtual void Mult(const Vector &v, Vector &y) const
+   {
+      const double v_norm = newton.Norm(v);
+      if (v_norm == 0.0)
+      {
+         y = 0.0;
+         return;
+      }
+      const double h = eps*sqrt(1.0 + x_norm)/v_norm;
+      xh.SetSize(width);
+      fh.SetSize(height);
+      add(*x, h, v, xh);
+      newton.oper->Mult(xh, fh);
+      subtract(1.0/h, fh, fx, y);
+   }
+};
+
+// Preconditioner wrapper that ignores SetOperator(), so that the linear
+// solver does not set up the preconditioner with the finite difference Jacobian
+class NewtonSolver::FrozenPreconditioner : public Solver
+{
+protected:
+   Solver &pc;
+
+public:
+   FrozenPreconditioner(Solver &pc_, int n) : Solver(n), pc(pc_) { }
+
+   virtual void SetOperator(const Operator &op) { }
+
+   virtual void Mult(const Vector &x, Vector &y) const { pc.Mult(x, y); }
+};
+
+void NewtonSolver::InitNewton()
+{
+   fd_grad = NULL;
+   frozen_prec = NULL;
+   grad_prec = NULL;
+   grad_prec_freq = 1;
+   lin_rtol_type = 0;
+   lin_rtol0 = lin_rtol_max = lin_rtol_alpha = lin_rtol_gamma = 0.0;
+   lin_rtol_last = fnorm_last = lnorm_last = 0.0;
+   grad_max_rate = 0.0;
+   grad_max_age = 0;
+   grad_age = -1;
+   last_grad = NULL;
+}
+
 void NewtonSolver::SetOperator(const Operator &op)
 {
    oper = &op;
@@ -1312,6 +1565,90 @@ void NewtonSolver::SetOperator(const Operator &op)
 
    r.SetSize(width);
    c.SetSize(width);
+   grad_age = -1;
+
+   if (fd_grad)
+   {
+      SetJacobianFree(grad_prec, grad_prec_freq, fd_grad->GetEps());
+   }
+}
+
+void NewtonSolver::SetJacobianFree(Solver *pc, int pc_update_freq,
+                                   double fd_eps)
+{
+   MFEM_VERIFY(pc_update_freq >= 0, "invalid preconditioner update frequency");
+   delete fd_grad;
+   delete frozen_prec;
+   fd_grad = new FDJacobian(*this, fd_eps);
+   frozen_prec = NULL;
+   grad_prec = pc;
+   grad_prec_freq = pc_update_freq;
+   if (pc) { frozen_prec = new FrozenPreconditioner(*pc, height); }
+}
+
+void NewtonSolver::SetAdaptiveLinRtol(int type, double rtol0, double rtol_max,
+                                      double alpha, double gamma)
+{
+   MFEM_VERIFY(type >= 0 && type <= 2, "invalid forcing term type " << type);
+   lin_rtol_type = type;
+   lin_rtol0 = rtol0;
+   lin_rtol_max = rtol_max;
+   lin_rtol_alpha = alpha;
+   lin_rtol_gamma = gamma;
+}
+
+void NewtonSolver::SetJacobianReuse(double max_rate, int max_age)
+{
+   MFEM_VERIFY(max_rate >= 0.0 && max_age >= 0, "invalid parameters");
+   grad_max_rate = max_rate;
+   grad_max_age = max_age;
+   grad_age = -1;
+}
+
+void NewtonSolver::AdaptiveLinRtolPreSolve(int it, double fnorm) const
+{
+   if (lin_rtol_type == 0) { return; }
+
+   IterativeSolver *lin_solver = dynamic_cast<IterativeSolver *>(prec);
+   MFEM_VERIFY(lin_solver, "the linear solver must be an IterativeSolver");
+
+   double rtol = lin_rtol0;
+   if (it > 0)
+   {
+      double sg;
+      if (lin_rtol_type == 1)
+      {
+         rtol = std::abs(fnorm - lnorm_last)/fnorm_last;
+         sg = pow(lin_rtol_last, lin_rtol_alpha);
+      }
+      else
+      {
+         rtol = lin_rtol_gamma*pow(fnorm/fnorm_last, lin_rtol_alpha);
+         sg = lin_rtol_gamma*pow(lin_rtol_last, lin_rtol_alpha);
+      }
+      // Safeguard against tolerances decreasing too quickly
+      if (sg > 0.1) { rtol = std::max(rtol, sg); }
+   }
+   rtol = std::min(rtol, lin_rtol_max);
+   lin_solver->SetRelTol(rtol);
+   lin_rtol_last = rtol;
+   fnorm_last = fnorm;
+   if (print_level >= 0)
+   {
+      mfem::out << "Newton iteration " << setw(2) << it
+                << " : linear solver relative tolerance = " << rtol << '\n';
+   }
+}
+
+void NewtonSolver::AdaptiveLinRtolPostSolve(const Operator &grad) const
+{
+   if (lin_rtol_type != 1) { return; }
+
+   // lnorm_last = |r - J c|
+   z.SetSize(width);
+   grad.Mult(c, z);
+   subtract(r, z, z);
+   lnorm_last = Norm(z);
 }
 
 void NewtonSolver::Mult(const Vector &b, Vector &x) const
@@ -1323,6 +1660,15 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
    double norm0, norm, norm_goal;
    const bool have_b = (b.Size() == Height());
 
+   IterativeSolver *lin_solver = NULL;
+   if (fd_grad)
+   {
+      lin_solver = dynamic_cast<IterativeSolver *>(prec);
+      MFEM_VERIFY(lin_solver, "the JFNK mode requires an IterativeSolver");
+      if (frozen_prec) { lin_solver->SetPreconditioner(*frozen_prec); }
+      lin_solver->SetOperator(*fd_grad);
+   }
+
    if (!iterative_mode)
    {
       x = 0.0;
@@ -1366,10 +1712,36 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
          break;
       }
 
-      prec->SetOperator(oper->GetGradient(x));
+      const Operator *grad;
+      if (fd_grad)
+      {
+         fd_grad->Update(x, r, have_b ? &b : NULL);
+         if (grad_prec && grad_prec_freq > 0 && it % grad_prec_freq == 0)
+         {
+            grad_prec->SetOperator(oper->GetGradient(x));
+         }
+         grad = fd_grad;
+      }
+      else if (grad_max_rate > 0.0 && grad_age >= 0 &&
+               (grad_max_age == 0 || grad_age < grad_max_age))
+      {
+         // Reuse the gradient and the linear solver setup
+         grad = last_grad;
+         grad_age++;
+      }
+      else
+      {
+         grad = last_grad = &oper->GetGradient(x);
+         prec->SetOperator(*grad);
+         grad_age = 1;
+      }
+
+      AdaptiveLinRtolPreSolve(it, norm);
 
       prec->Mult(r, c);  // c = [DF(x_i)]^{-1} [F(x_i)-b]
 
+      AdaptiveLinRtolPostSolve(*grad);
+
       const double c_scale = ComputeScalingFactor(x, b);
       if (c_scale == 0.0)
       {
@@ -1385,7 +1757,143 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
       {
          r -= b;
       }
+      const double norm_prev = norm;
       norm = Norm(r);
+      if (norm > grad_max_rate*norm_prev) { grad_age = -1; }
+   }
+
+   final_iter = it;
+   final_norm = norm;
+}
+
+NewtonSolver::~NewtonSolver()
+{
+   delete frozen_prec;
+   delete fd_grad;
+}
+
+
+void AndersonSolver::UpdateVectors()
+{
+   MFEM_VERIFY(m >= 0, "invalid depth " << m);
+   g.SetSize(width);
+   f.SetSize(width);
+   x_prev.SetSize(width);
+   f_prev.SetSize(width);
+   gamma.SetSize(m);
+   dX.SetSize(width, m);
+   dF.SetSize(width, m);
+   Q.SetSize(width, m);
+   R.SetSize(m);
+}
+
+void AndersonSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
+
+   const bool have_b = (b.Size() == Height());
+   if (!iterative_mode)
+   {
+      x = 0.0;
+   }
+
+   // f = G(x) + b - x
+   oper->Mult(x, g);
+   if (have_b) { g += b; }
+   subtract(g, x, f);
+
+   const double norm0 = Norm(f);
+   const double norm_goal = std::max(rel_tol*norm0, abs_tol);
+   double norm = norm0;
+
+   Vector dx_j, df_j, q_j, q_i;
+   Array<int> cols;
+   int it;
+   for (it = 0; true; it++)
+   {
+      MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
+      if (print_level >= 0)
+      {
+         mfem::out << "Anderson iteration " << setw(2) << it
+                   << " : ||r|| = " << norm;
+         if (it > 0)
+         {
+            mfem::out << ", ||r||/||r_0|| = " << norm/norm0;
+         }
+         mfem::out << '\n';
+      }
+      if (norm <= norm_goal)
+      {
+         converged = 1;
+         break;
+      }
+      if (it >= max_iter)
+      {
+         converged = 0;
+         break;
+      }
+
+      // Store the differences in the circular history
+      if (it > 0 && m > 0)
+      {
+         const int j = (it - 1) % m;
+         dX.GetColumnReference(j, dx_j);
+         dF.GetColumnReference(j, df_j);
+         subtract(x, x_prev, dx_j);
+         subtract(f, f_prev, df_j);
+      }
+      x_prev = x;
+      f_prev = f;
+
+      // Modified Gram-Schmidt QR of dF, from the oldest to the newest column,
+      // dropping the columns that are nearly dependent on the previous ones
+      const int mk = std::min(it, m);
+      cols.SetSize(0);
+      for (int k = 0; k < mk; k++)
+      {
+         const int j = (it - mk + k) % m;
+         dF.GetColumnReference(j, df_j);
+         const int n = cols.Size();
+         Q.GetColumnReference(n, q_j);
+         q_j = df_j;
+         for (int i = 0; i < n; i++)
+         {
+            Q.GetColumnReference(i, q_i);
+            R(i,n) = Dot(q_i, q_j);
+            q_j.Add(-R(i,n), q_i);
+         }
+         const double r_nn = Norm(q_j);
+         if (r_nn <= 1e-10*Norm(df_j)) { continue; }
+         R(n,n) = r_nn;
+         q_j /= r_nn;
+         cols.Append(j);
+      }
+
+      // gamma = R^{-1} Q^T f, x = x + beta f - (dX + beta dF) gamma
+      const int n = cols.Size();
+      for (int i = 0; i < n; i++)
+      {
+         Q.GetColumnReference(i, q_i);
+         gamma(i) = Dot(q_i, f);
+      }
+      for (int i = n - 1; i >= 0; i--)
+      {
+         for (int k = i + 1; k < n; k++) { gamma(i) -= R(i,k)*gamma(k); }
+         gamma(i) /= R(i,i);
+      }
+      x.Add(beta, f);
+      for (int i = 0; i < n; i++)
+      {
+         dX.GetColumnReference(cols[i], dx_j);
+         dF.GetColumnReference(cols[i], df_j);
+         x.Add(-gamma(i), dx_j);
+         x.Add(-beta*gamma(i), df_j);
+      }
+
+      oper->Mult(x, g);
+      if (have_b) { g += b; }
+      subtract(g, x, f);
+      norm = Norm(f);
    }
 
    final_iter = it;
@@ -14,6 +14,7 @@
 
 #include "../config/config.hpp"
 #include "operator.hpp"
+#include "densemat.hpp"
 
 #ifdef MFEM_USE_MPI
 #include <mpi.h>
@@ -65,6 +66,9 @@ public:
    void SetMaxIter(int max_it) { max_iter = max_it; }
    void SetPrintLevel(int print_lvl);
 
+   double GetRelTol() const { return rel_tol; }
+   double GetAbsTol() const { return abs_tol; }
+
    int GetNumIterations() const { return final_iter; }
    int GetConverged() const { return converged; }
    double GetFinalNorm() const { return final_norm; }
@@ -99,20 +103,29 @@ public:
    OperatorJacobiSmoother(const Vector &d,
                           const Array<int> &ess_tdof_list,
                           const double damping=1.0);
+
+   /** Setup a Jacobi smoother with the diagonal of the operator given to
+       SetOperator(), obtained by calling Operator::AssembleDiagonal(). The
+       diagonal is recomputed in every call to SetOperator(), e.g. for each
+       gradient in NewtonSolver. The operator is assumed to provide the
+       diagonal entries of the essential dofs, e.g. ones for ConstrainedOperator
+       and for the (assembled) DIAG_ONE policy. */
+   explicit OperatorJacobiSmoother(const double damping=1.0);
    ~OperatorJacobiSmoother() {}
 
    void Mult(const Vector &x, Vector &y) const;
-   void SetOperator(const Operator &op) { oper = &op; }
+   void SetOperator(const Operator &op);
    void Setup(const Vector &diag);
 
 private:
-   const int N;
+   int N;
    Vector dinv;
    const double damping;
-   const Array<int> &ess_tdof_list;
+   const Array<int> *ess_tdof_list; // not owned, may be NULL
    mutable Vector residual;
 
    const Operator *oper;
+   bool use_oper_diag;
 };
 
 
@@ -169,6 +182,41 @@ public:
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
+/// Conjugate gradient method for several right-hand sides
+/** Solves A X_j = B_j for all vectors j of the MultiVectors given to
+    MultMulti(), iterating on all right-hand sides together: each iteration
+    applies the operator and the preconditioner once to the block of vectors
+    with Operator::MultMulti(), so that, e.g., a SparseMatrix or a partially
+    assembled BilinearForm reads its data once for all right-hand sides.
+
+    Each vector has its own CG coefficients, as with CGSolver, so the method
+    does not break down when some vectors converge before the others; the
+    converged vectors are no longer updated. The tolerances are applied to each
+    vector; GetNumIterations() returns the maximum number of iterations and
+    GetFinalNorm() the maximum final norm. */
+class BlockCGSolver : public IterativeSolver
+{
+protected:
+   mutable MultiVector R, D, Z, AD;
+   mutable Vector nom, goal;
+   mutable Array<int> active;
+
+   void UpdateVectors(int nv) const;
+
+public:
+   BlockCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   BlockCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   /// Solve for a single right-hand side.
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// Solve for all the right-hand sides in @a B.
+   virtual void MultMulti(const MultiVector &B, MultiVector &X) const;
+};
+
 /// Conjugate gradient method. (tolerances are squared)
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter = 0, int max_num_iter = 1000,
@@ -300,13 +348,40 @@ void MINRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
 class NewtonSolver : public IterativeSolver
 {
 protected:
-   mutable Vector r, c;
+   mutable Vector r, c, z;
+
+   // Jacobian-free Newton-Krylov mode, see SetJacobianFree()
+   class FDJacobian;
+   class FrozenPreconditioner;
+   FDJacobian *fd_grad;
+   FrozenPreconditioner *frozen_prec;
+   Solver *grad_prec;
+   int grad_prec_freq;
+
+   // Adaptive linear solver tolerance, see SetAdaptiveLinRtol()
+   int lin_rtol_type;
+   double lin_rtol0, lin_rtol_max, lin_rtol_alpha, lin_rtol_gamma;
+   mutable double lin_rtol_last, fnorm_last, lnorm_last;
+
+   // Reuse of the gradient, see SetJacobianReuse()
+   double grad_max_rate;
+   int grad_max_age;
+   mutable int grad_age;
+   mutable const Operator *last_grad;
+
+   void InitNewton();
+
+   /// Set the relative tolerance of the linear solver for iteration @a it.
+   void AdaptiveLinRtolPreSolve(int it, double fnorm) const;
+
+   /// Store the norm of the linear residual, used by the type 1 forcing term.
+   void AdaptiveLinRtolPostSolve(const Operator &grad) const;
 
 public:
-   NewtonSolver() { }
+   NewtonSolver() { InitNewton(); }
 
 #ifdef MFEM_USE_MPI
-   NewtonSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+   NewtonSolver(MPI_Comm _comm) : IterativeSolver(_comm) { InitNewton(); }
 #endif
    virtual void SetOperator(const Operator &op);
 
@@ -314,6 +389,54 @@ public:
    /** This method is equivalent to calling SetPreconditioner(). */
    virtual void SetSolver(Solver &solver) { prec = &solver; }
 
+   /** @brief Use the Jacobian-free Newton-Krylov (JFNK) method: the action of
+       the Jacobian is approximated by a finite difference of Mult(). */
+   /** The Jacobian-vector product is computed as
+       J(x) v ~ (F(x + h v) - F(x))/h, h = fd_eps sqrt(1 + |x|)/|v|,
+       so GetGradient() is not needed by the linear solver. The linear solver
+       set with SetSolver() must be an IterativeSolver, e.g. GMRESSolver,
+       without a preconditioner of its own. The optional preconditioner
+       @a pc is set up with the gradient, pc->SetOperator(GetGradient(x)),
+       every @a pc_update_freq Newton iterations starting with the first one;
+       with @a pc_update_freq = 0 it is never updated by the Newton solver.
+
+       For operators that set the residual to zero on essential dofs, like
+       NonlinearForm, the finite difference Jacobian has zero rows on these
+       dofs; the Newton updates remain zero there with Krylov solvers started
+       from a zero initial guess. */
+   void SetJacobianFree(Solver *pc = NULL, int pc_update_freq = 1,
+                        double fd_eps = 1.5e-8);
+
+   /** @brief Adapt the relative tolerance of the linear solver in each
+       iteration, using the forcing terms of Eisenstat and Walker. */
+   /** The linear solver set with SetSolver() must be an IterativeSolver. With
+       F_k = F(x_k) - b, the relative tolerance at iteration k > 0 is
+        - type 1: | |F_k| - |F_{k-1} + J_{k-1} s_{k-1}| | / |F_{k-1}|,
+        - type 2: gamma (|F_k|/|F_{k-1}|)^alpha,
+       with the safeguards of Eisenstat and Walker, and it is @a rtol0 at the
+       first iteration. The tolerance is bounded by @a rtol_max. Use type 0 to
+       disable the adaptivity. */
+   void SetAdaptiveLinRtol(int type = 2, double rtol0 = 0.5,
+                           double rtol_max = 0.9,
+                           double alpha = 0.5*(1.0 + sqrt(5.0)),
+                           double gamma = 1.0);
+
+   /** @brief Reuse the gradient and the setup of the linear solver across
+       iterations and calls to Mult(), until the convergence degrades. */
+   /** The gradient is computed, and the linear solver set up with it, only
+       when the last Newton step reduced the residual norm by a factor larger
+       than @a max_rate, or when the gradient was computed @a max_age Newton
+       iterations ago (no limit if @a max_age = 0). This avoids, e.g., the setup
+       of an AMG preconditioner in most Newton iterations and time steps. The
+       gradient is also recomputed after SetOperator() and ResetJacobian().
+       Use @a max_rate = 0 to compute the gradient in every iteration (the
+       default). This option does not apply to the JFNK mode, where the
+       preconditioner is updated as set by SetJacobianFree(). */
+   void SetJacobianReuse(double max_rate = 0.5, int max_age = 0);
+
+   /// Recompute the gradient in the next Newton iteration.
+   void ResetJacobian() { grad_age = -1; }
+
    /// Solve the nonlinear system with right-hand side @a b.
    /** If `b.Size() != Height()`, then @a b is assumed to be zero. */
    virtual void Mult(const Vector &b, Vector &x) const;
@@ -328,6 +451,53 @@ public:
    /** @brief This method can be overloaded in derived classes to perform
        computations that need knowledge of the newest Newton state. */
    virtual void ProcessNewState(const Vector &x) const { }
+
+   virtual ~NewtonSolver();
+};
+
+/// Anderson accelerated fixed-point iteration
+/** Solves the fixed-point problem x = G(x) + b, where G is the Operator given
+    by SetOperator(), and b is the right-hand side given to Mult() (assumed to
+    be zero if `b.Size() != Height()`). For example, G(x) can be a Picard
+    linearization, G(x) = A(x)^{-1} c, and b = 0.
+
+    With the residual f_k = G(x_k) + b - x_k, the iteration is
+    x_{k+1} = x_k + beta f_k - (dX + beta dF) gamma, where the columns of dX and
+    dF are the last m differences of the iterates and residuals, and gamma
+    minimizes |f_k - dF gamma|. The least-squares problem is solved with a QR
+    factorization of dF, dropping the nearly linearly dependent columns. With
+    m = 0 the method is the damped fixed-point iteration
+    x_{k+1} = x_k + beta f_k. The iteration stops when |f_k| is below the
+    relative or absolute tolerance. */
+class AndersonSolver : public IterativeSolver
+{
+protected:
+   int m;
+   double beta;
+   mutable Vector g, f, x_prev, f_prev, gamma;
+   /// The last m differences of the iterates and residuals, and the Q factor
+   mutable DenseMatrix dX, dF, Q;
+   mutable DenseMatrix R;
+
+   void UpdateVectors();
+
+public:
+   AndersonSolver() : m(5), beta(1.0) { }
+
+#ifdef MFEM_USE_MPI
+   AndersonSolver(MPI_Comm _comm) : IterativeSolver(_comm), m(5), beta(1.0) { }
+#endif
+
+   /// Set the number of previous iterates @a m_ used in the acceleration.
+   void SetDepth(int m_) { m = m_; UpdateVectors(); }
+
+   /// Set the damping (mixing) parameter beta, default 1.
+   void SetDamping(double beta_) { beta = beta_; }
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
 };
 
 /** Adaptive restarted GMRES.
@@ -613,6 +613,58 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
 #endif
 }
 
+void SparseMatrix::MultMulti(const MultiVector &X, MultiVector &Y) const
+{
+   if (Finalized()) { Y.UseDevice(true); }
+   Y = 0.0;
+   AddMultMulti(X, Y);
+}
+
+void SparseMatrix::AddMultMulti(const MultiVector &X, MultiVector &Y,
+                                const double a) const
+{
+   MFEM_ASSERT(X.VectorSize() == width && Y.VectorSize() == height &&
+               X.NumVectors() == Y.NumVectors(), "incompatible MultiVectors");
+
+   if (!Finalized())
+   {
+      Vector x, y;
+      for (int v = 0; v < X.NumVectors(); v++)
+      {
+         X.GetVectorRef(v, x);
+         Y.GetVectorRef(v, y);
+         AddMult(x, y, a);
+      }
+      return;
+   }
+
+   // Each row of the matrix is read once from memory and reused for all
+   // vectors
+   const int height = this->height;
+   const int width = this->width;
+   const int nv = X.NumVectors();
+   const int nnz = J.Capacity();
+   auto d_I = Read(I, height+1);
+   auto d_J = Read(J, nnz);
+   auto d_A = Read(A, nnz);
+   auto d_x = X.Read();
+   auto d_y = Y.ReadWrite();
+   MFEM_FORALL(i, height,
+   {
+      const int begin = d_I[i], end = d_I[i+1];
+      for (int v = 0; v < nv; v++)
+      {
+         const double *d_xv = d_x + v*width;
+         double d = 0.0;
+         for (int j = begin; j < end; j++)
+         {
+            d += d_A[j] * d_xv[d_J[j]];
+         }
+         d_y[i + v*height] += a * d;
+      }
+   });
+}
+
 void SparseMatrix::MultTranspose(const Vector &x, Vector &y) const
 {
    if (Finalized()) { y.UseDevice(true); }
@@ -252,6 +252,9 @@ public:
    /// Returns the Diagonal of A
    void GetDiag(Vector & d) const;
 
+   /// Same as GetDiag(), see Operator::AssembleDiagonal().
+   virtual void AssembleDiagonal(Vector &diag) const { GetDiag(diag); }
+
    /// Produces a DenseMatrix from a SparseMatrix
    DenseMatrix *ToDenseMatrix() const;
 
@@ -267,6 +270,14 @@ public:
    /// y += A * x (default)  or  y += a * A * x
    void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
 
+   /** @brief Matrix multiplication of several vectors, Y_j = A X_j. The matrix
+       is read only once for all vectors. */
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const;
+
+   /// Y_j += a * A * X_j for all vectors j of @a X, see MultMulti().
+   void AddMultMulti(const MultiVector &X, MultiVector &Y,
+                     const double a = 1.0) const;
+
    /// Multiply a vector with the transposed matrix. y = At * x
    void MultTranspose(const Vector &x, Vector &y) const;
 
@@ -25,6 +25,7 @@
 #include <cstring>
 #include <ctime>
 #include <functional>
+#include <cstdint>
 
 // Include the METIS header, if using version 5. If using METIS 4, the needed
 // declarations are inlined below, i.e. no header is needed.
@@ -114,6 +115,46 @@ double Mesh::GetElementVolume(int i)
    return volume;
 }
 
+void Mesh::GetTimeStepSizes(Vector &h, bool use_depth)
+{
+   h.SetSize(NumOfElements);
+   if (use_depth)
+   {
+      MFEM_VERIFY(ncmesh, "the element depth requires a nonconforming mesh");
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         h(i) = ldexp(1.0, -ncmesh->GetElementDepth(i));
+      }
+      return;
+   }
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      h(i) = GetElementSize(i, 1);
+   }
+}
+
+void Mesh::SizesToTimeStepLevels(const Vector &h, double h_max,
+                                 int max_level, Array<int> &levels)
+{
+   levels.SetSize(h.Size());
+   for (int i = 0; i < h.Size(); i++)
+   {
+      // The tolerance keeps sizes that differ by exact powers of 2 (up to
+      // round-off) on the coarser level
+      const double l = log2(h_max/h(i)) - 1e-8;
+      levels[i] = std::min(std::max(int(ceil(l)), 0), max_level);
+   }
+}
+
+void Mesh::GetTimeStepLevels(Array<int> &levels, int max_level,
+                             bool use_depth)
+{
+   Vector h;
+   GetTimeStepSizes(h, use_depth);
+   SizesToTimeStepLevels(h, (h.Size() > 0) ? h.Max() : 0.0, max_level,
+                         levels);
+}
+
 // Similar to VisualizationSceneSolution3d::FindNewBox in GLVis
 void Mesh::GetBoundingBox(Vector &min, Vector &max, int ref)
 {
@@ -1563,6 +1604,130 @@ void Mesh::GetHilbertElementOrdering(Array<int> &ordering)
    }
 }
 
+void Mesh::GetMortonElementOrdering(Array<int> &ordering)
+{
+   MFEM_VERIFY(spaceDim <= 3, "");
+
+   const int ne = GetNE();
+   const int bits = 63 / spaceDim; // bits per coordinate in a 64-bit key
+
+   // calculate element centers (from the vertices, as only the order matters)
+   Array<double> points(3*ne);
+   double min[3] = { infinity(), infinity(), infinity() };
+   double max[3] = { -infinity(), -infinity(), -infinity() };
+   for (int i = 0; i < ne; i++)
+   {
+      const int *v = elements[i]->GetVertices();
+      const int nv = elements[i]->GetNVertices();
+      for (int d = 0; d < spaceDim; d++)
+      {
+         double c = 0.0;
+         for (int j = 0; j < nv; j++) { c += vertices[v[j]](d); }
+         c /= nv;
+         points[3*i + d] = c;
+         min[d] = std::min(min[d], c);
+         max[d] = std::max(max[d], c);
+      }
+   }
+
+   Array<Pair<std::uint64_t, int> > keys;
+   SortSFCKeys(points, spaceDim, min, max, bits, false, keys);
+
+   // return ordering in the format required by ReorderElements
+   ordering.SetSize(ne);
+   for (int i = 0; i < ne; i++)
+   {
+      ordering[keys[i].two] = i;
+   }
+}
+
+// Position of the point 'x', quantized to 'bits' bits per coordinate, along
+// the Hilbert curve. The coordinates are overwritten. This is the "transpose"
+// algorithm of J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707
+// (2004), followed by interleaving the bits of the transposed coordinates.
+static std::uint64_t HilbertKey(std::uint64_t x[], int dim, int bits)
+{
+   if (dim == 1) { return x[0]; }
+
+   const std::uint64_t m = std::uint64_t(1) << (bits-1);
+   for (std::uint64_t q = m; q > 1; q >>= 1)
+   {
+      const std::uint64_t p = q - 1;
+      for (int i = 0; i < dim; i++)
+      {
+         if (x[i] & q)
+         {
+            x[0] ^= p; // invert
+         }
+         else
+         {
+            const std::uint64_t t = (x[0] ^ x[i]) & p; // exchange
+            x[0] ^= t;
+            x[i] ^= t;
+         }
+      }
+   }
+
+   // Gray encode
+   for (int i = 1; i < dim; i++) { x[i] ^= x[i-1]; }
+   std::uint64_t t = 0;
+   for (std::uint64_t q = m; q > 1; q >>= 1)
+   {
+      if (x[dim-1] & q) { t ^= q - 1; }
+   }
+   for (int i = 0; i < dim; i++) { x[i] ^= t; }
+
+   std::uint64_t key = 0;
+   for (int b = bits-1; b >= 0; b--)
+   {
+      for (int i = 0; i < dim; i++)
+      {
+         key = (key << 1) | ((x[i] >> b) & 1);
+      }
+   }
+   return key;
+}
+
+void Mesh::SortSFCKeys(const Array<double> &points, int sdim,
+                       const double *min, const double *max, int bits,
+                       bool hilbert, Array<Pair<std::uint64_t, int> > &keys)
+{
+   const int np = points.Size() / 3;
+   const std::uint64_t qmax = (std::uint64_t(1) << bits) - 1;
+   keys.SetSize(np);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < np; i++)
+   {
+      std::uint64_t q[3], key = 0;
+      for (int d = 0; d < sdim; d++)
+      {
+         const double len = max[d] - min[d];
+         const double t = (len > 0.0) ? (points[3*i + d] - min[d]) / len : 0.0;
+         q[d] = std::min(std::uint64_t(t * qmax + 0.5), qmax);
+      }
+      if (hilbert)
+      {
+         key = HilbertKey(q, sdim, bits);
+      }
+      else
+      {
+         // interleave the bits of the quantized coordinates
+         for (int b = bits-1; b >= 0; b--)
+         {
+            for (int d = 0; d < sdim; d++)
+            {
+               key = (key << 1) | ((q[d] >> b) & 1);
+            }
+         }
+      }
+      keys[i].one = key;
+      keys[i].two = i;
+   }
+   SortPairs<std::uint64_t, int>(keys, np);
+}
+
 
 void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
 {
@@ -4997,7 +5162,8 @@ void Mesh::GenerateNCFaceInfo()
       NCFaceInfo &master_nc = nc_faces_info[master_fi.NCFace];
 
       slave_fi.NCFace = nc_faces_info.Size();
-      nc_faces_info.Append(NCFaceInfo(true, slave.master, &slave.point_matrix));
+      nc_faces_info.Append(NCFaceInfo(true, slave.master,
+                                      &list.GetPointMatrix(slave)));
 
       slave_fi.Elem2No = master_fi.Elem1No;
       slave_fi.Elem2Inf = 64 * master_nc.MasterFace; // get lf no. stored above
@@ -5268,8 +5434,55 @@ int *Mesh::CartesianPartitioning(int nxyz[])
    return partitioning;
 }
 
-int *Mesh::GeneratePartitioning(int nparts, int part_method)
+void Mesh::SplitWeightedSequence(int ne, const int *sequence,
+                                 const Vector *weights, double offset,
+                                 double total, int nparts, int *part)
+{
+   for (int k = 0; k < ne; k++)
+   {
+      const int i = sequence ? sequence[k] : k;
+      const double w = weights ? (*weights)(i) : 1.0;
+      MFEM_ASSERT(w >= 0.0, "negative element weight");
+
+      // assign the element to the piece containing its midpoint in the
+      // cumulative weight sequence
+      const double mid = offset + 0.5*w;
+      const int p = (total > 0.0) ? int(mid / total * nparts) : 0;
+      part[i] = std::max(0, std::min(p, nparts-1));
+      offset += w;
+   }
+}
+
+int *Mesh::GeneratePartitioning(int nparts, int part_method,
+                                const Vector *elem_weights)
 {
+   if (part_method == 6 || part_method == 7)
+   {
+      Array<int> ordering;
+      if (part_method == 6)
+      {
+         GetHilbertElementOrdering(ordering);
+      }
+      else
+      {
+         GetMortonElementOrdering(ordering);
+      }
+      // split the sequence into pieces of approximately equal total weight
+      const int ne = GetNE();
+      MFEM_VERIFY(!elem_weights || elem_weights->Size() == ne,
+                  "invalid number of element weights");
+      Array<int> sequence(ne);
+      for (int i = 0; i < ne; i++) { sequence[ordering[i]] = i; }
+      const double total = elem_weights ? elem_weights->Sum() : double(ne);
+      int *partitioning = new int[ne];
+      SplitWeightedSequence(ne, sequence, elem_weights, 0.0, total, nparts,
+                            partitioning);
+      return partitioning;
+   }
+
+   MFEM_VERIFY(elem_weights == NULL, "element weights are only supported by "
+               "the space-filling curve methods (part_method = 6, 7)");
+
 #ifdef MFEM_USE_METIS
 
    int print_messages = 1;
@@ -10038,7 +10251,8 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    const int NQ   = ir.GetNPoints();
 
    Vector Enodes(vdim*ND*NE);
-   // For now, we are not using tensor product evaluation
+   // Native ordering; the tensor product evaluation in the
+   // QuadratureInterpolator applies the lexicographic dof map itself
    const Operator *elem_restr = fespace->GetElementRestriction(
                                    ElementDofOrdering::NATIVE);
    elem_restr->Mult(*nodes, Enodes);
@@ -10061,8 +10275,6 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    }
 
    const QuadratureInterpolator *qi = fespace->GetQuadratureInterpolator(ir);
-   // For now, we are not using tensor product evaluation (not implemented)
-   qi->DisableTensorProducts();
    qi->Mult(Enodes, eval_flags, X, J, detJ);
 }
 
@@ -22,7 +22,9 @@
 #include "../fem/eltrans.hpp"
 #include "../fem/coefficient.hpp"
 #include "../general/gzstream.hpp"
+#include "../general/sort_pairs.hpp"
 #include <iostream>
+#include <cstdint>
 
 namespace mfem
 {
@@ -443,6 +445,32 @@ protected:
    void GetElementData(const Array<Element*> &elem_array, int geom,
                        Array<int> &elem_vtx, Array<int> &attr) const;
 
+   // used in GetTimeStepLevels(): the element sizes h_i, where h_i = 2^{-d_i}
+   // for the refinement depth d_i with use_depth = true
+   void GetTimeStepSizes(Vector &h, bool use_depth);
+   static void SizesToTimeStepLevels(const Vector &h, double h_max,
+                                     int max_level, Array<int> &levels);
+
+   /** Sort the points (the first @a sdim of every 3 entries of @a points)
+       along the Morton curve or, if @a hilbert is true, the Hilbert curve. The
+       coordinates are quantized to @a bits bits in the box [@a min, @a max];
+       @a keys returns the sorted curve keys with the point indices. Used by
+       GetMortonElementOrdering() and ParMesh::HilbertPartition(). */
+   static void SortSFCKeys(const Array<double> &points, int sdim,
+                           const double *min, const double *max, int bits,
+                           bool hilbert,
+                           Array<Pair<std::uint64_t, int> > &keys);
+
+   /** Split the @a ne elements, taken in the order @a sequence (or in their
+       local order, if NULL), into @a nparts contiguous pieces of approximately
+       equal total weight, returned in @a part. The cumulative weight starts
+       at @a offset, e.g. the weight on the previous ranks, and reaches
+       @a total; each element goes to the piece containing its midpoint. Unit
+       weights are used if @a weights is NULL. */
+   static void SplitWeightedSequence(int ne, const int *sequence,
+                                     const Vector *weights, double offset,
+                                     double total, int nparts, int *part);
+
 public:
 
    Mesh() { SetEmpty(); }
@@ -579,6 +607,14 @@ public:
        ReorderElements. This is a cheap alternative to GetGeckoElementOrdering.*/
    void GetHilbertElementOrdering(Array<int> &ordering);
 
+   /** Return an ordering of the elements along the Morton (Z-order) curve. The
+       centers of the elements (averages of their vertices) are mapped to
+       integer keys by interleaving the bits of their quantized coordinates,
+       and the keys are sorted. The result can be passed to ReorderElements.
+       This is cheaper than GetHilbertElementOrdering, with somewhat less
+       compact pieces of the sequence. */
+   void GetMortonElementOrdering(Array<int> &ordering);
+
    /** Rebuilds the mesh with a different order of elements. For each element i,
        the array ordering[i] contains its desired new index. Note that the method
        reorders vertices, edges and faces along with the elements. */
@@ -1004,7 +1040,25 @@ public:
    virtual void ReorientTetMesh();
 
    int *CartesianPartitioning(int nxyz[]);
-   int *GeneratePartitioning(int nparts, int part_method = 1);
+
+   /** @brief Partition the mesh into @a nparts parts, returning a new array
+       with the part of each element.
+
+       The @a part_method is one of:
+       - 0, 1, 2: METIS_PartGraphRecursive, METIS_PartGraphKway and
+         METIS_PartGraphVKway, with sorted neighbor lists;
+       - 3, 4, 5: the same METIS methods without sorting the neighbor lists;
+       - 6, 7: split the Hilbert (6) or Morton (7) curve sequence of the
+         elements, see GetHilbertElementOrdering() and
+         GetMortonElementOrdering(), into contiguous pieces. These methods do
+         not require METIS and run in O(N log N) time.
+
+       The optional @a elem_weights, of size GetNE(), give the nonnegative
+       cost of each element (e.g. its number of DOFs or quadrature points);
+       the pieces then have approximately equal total weight. Weights are
+       only supported by the space-filling curve methods. */
+   int *GeneratePartitioning(int nparts, int part_method = 1,
+                             const Vector *elem_weights = NULL);
    void CheckPartitioning(int *partitioning);
 
    void CheckDisplacements(const Vector &displacements, double &tmax);
@@ -1216,6 +1270,19 @@ public:
 
    double GetElementVolume(int i);
 
+   /** @brief Compute the local time stepping level of each element, such that
+       elements of level l can be advanced with the step dt/2^l, where dt is
+       stable for the largest elements, see MultirateRK2Solver. */
+   /** With @a use_depth = false, the level of element i is the smallest l such
+       that h_i >= h_max/2^l, where h_i = GetElementSize(i, 1) is the minimal
+       element size. With @a use_depth = true, the level is the refinement
+       depth NCMesh::GetElementDepth() of the element minus the minimal depth;
+       this option requires a nonconforming mesh. The levels are limited to
+       @a max_level, so the time step must be stable for the elements of that
+       level. In parallel, h_max and the minimal depth are global. */
+   virtual void GetTimeStepLevels(Array<int> &levels, int max_level,
+                                  bool use_depth = false);
+
    /// Returns the minimum and maximum corners of the mesh bounding box.
    /** For high-order meshes, the geometry is first refined @a ref times. */
    void GetBoundingBox(Vector &min, Vector &max, int ref = 2);
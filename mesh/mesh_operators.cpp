@@ -161,7 +161,7 @@ int Rebalancer::ApplyImpl(Mesh &mesh)
 {
 #ifdef MFEM_USE_MPI
    ParMesh *pmesh = dynamic_cast<ParMesh*>(&mesh);
-   if (pmesh && pmesh->Nonconforming())
+   if (pmesh && !pmesh->NURBSext)
    {
       pmesh->Rebalance();
       return CONTINUE + REBALANCED;
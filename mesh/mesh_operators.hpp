@@ -315,8 +315,7 @@ public:
 class Rebalancer : public MeshOperator
 {
 protected:
-   /** @brief Rebalance a parallel mesh (only non-conforming parallel meshes are
-       supported).
+   /** @brief Rebalance a parallel mesh (NURBS meshes are not supported).
        @return CONTINUE + REBALANCE on success, NONE otherwise. */
    virtual int ApplyImpl(Mesh &mesh);
 
@@ -1491,14 +1491,33 @@ void NCMesh::RefineElement(int elem, char ref_type)
 
 void NCMesh::Refine(const Array<Refinement>& refinements)
 {
+   // upper bounds on the number of new nodes and faces created by one
+   // (isotropic) refinement, indexed by Geometry::Type
+   static const int refine_new_nodes[Geometry::NUM_GEOMETRIES] =
+   { 0, 1, 3, 5, 6, 19, 12 };
+   static const int refine_new_faces[Geometry::NUM_GEOMETRIES] =
+   { 0, 0, 9, 12, 24, 36, 30 };
+
    // push all refinements on the stack in reverse order
+   int new_nodes = 0, new_faces = 0;
    ref_stack.Reserve(refinements.Size());
    for (int i = refinements.Size()-1; i >= 0; i--)
    {
       const Refinement& ref = refinements[i];
-      ref_stack.Append(Refinement(leaf_elements[ref.index], ref.ref_type));
+      const int elem = leaf_elements[ref.index];
+      ref_stack.Append(Refinement(elem, ref.ref_type));
+
+      const int geom = elements[elem].Geom();
+      new_nodes += refine_new_nodes[geom];
+      new_faces += refine_new_faces[geom];
    }
 
+   // presize the hash tables for the whole batch, so that they are not
+   // rehashed (i.e., all items reinserted) several times during refinement;
+   // forced refinements are not included in the estimate
+   nodes.Reserve(nodes.Size() + new_nodes);
+   faces.Reserve(faces.Size() + new_faces);
+
    // keep refining as long as the stack contains something
    int nforced = 0;
    while (ref_stack.Size())
@@ -2353,12 +2372,13 @@ void NCMesh::TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
          face_list.slaves.push_back(
             Slave(fa->index, elem, -1, Geometry::SQUARE));
 
-         DenseMatrix &mat = face_list.slaves.back().point_matrix;
+         DenseMatrix mat;
          pm.GetMatrix(mat);
 
          // reorder the point matrix according to slave face orientation
          int local = ReorderFacePointMat(vn0, vn1, vn2, vn3, elem, mat);
          face_list.slaves.back().local = local;
+         AddSlaveMatrix(face_list, mat);
 
          eface[0] = eface[2] = fa;
          eface[1] = eface[3] = fa;
@@ -2428,7 +2448,7 @@ void NCMesh::TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
                Slave(-1 - enode.edge_index,
                      eid[0].element, eid[0].local, eid[0].geom));
 
-            DenseMatrix &mat = face_list.slaves.back().point_matrix;
+            DenseMatrix mat;
             if (split == 1)
             {
                Point mid0(pm(0), pm(1)), mid2(pm(2), pm(3));
@@ -2445,6 +2465,7 @@ void NCMesh::TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
                ((v1 < v2) ? PointMatrix(mid1, mid3, mid3, mid1) :
                 /*       */ PointMatrix(mid3, mid1, mid1, mid3)).GetMatrix(mat);
             }
+            AddSlaveMatrix(face_list, mat);
          }
       }
    }
@@ -2469,12 +2490,12 @@ void NCMesh::TraverseTetEdge(int vn0, int vn1, const Point &p0, const Point &p1)
          face_list.slaves.push_back(
             Slave(-1 - eid.index, eid.element, eid.local, eid.geom));
 
-         DenseMatrix &mat = face_list.slaves.back().point_matrix;
-
+         DenseMatrix mat;
          int v0index = nodes[vn0].vert_index;
          int v1index = nodes[vn1].vert_index;
          ((v0index < v1index) ? PointMatrix(p0, p1, p0)
           /*               */ : PointMatrix(p1, p0, p1)).GetMatrix(mat);
+         AddSlaveMatrix(face_list, mat);
 
          return; // no need to continue deeper
       }
@@ -2500,12 +2521,13 @@ bool NCMesh::TraverseTriFace(int vn0, int vn1, int vn2,
          face_list.slaves.push_back(
             Slave(fa->index, elem, -1, Geometry::TRIANGLE));
 
-         DenseMatrix &mat = face_list.slaves.back().point_matrix;
+         DenseMatrix mat;
          pm.GetMatrix(mat);
 
          // reorder the point matrix according to slave face orientation
          int local = ReorderFacePointMat(vn0, vn1, vn2, -1, elem, mat);
          face_list.slaves.back().local = local;
+         AddSlaveMatrix(face_list, mat);
 
          return true;
       }
@@ -2541,6 +2563,40 @@ bool NCMesh::TraverseTriFace(int vn0, int vn1, int vn2,
    return false;
 }
 
+bool NCMesh::PointMatrixLess::operator()(const DenseMatrix *a,
+                                         const DenseMatrix *b) const
+{
+   if (a->Height() != b->Height()) { return a->Height() < b->Height(); }
+   if (a->Width() != b->Width()) { return a->Width() < b->Width(); }
+
+   const double *ad = a->Data(), *bd = b->Data();
+   for (int i = 0; i < a->Height()*a->Width(); i++)
+   {
+      if (ad[i] != bd[i]) { return ad[i] < bd[i]; }
+   }
+   return false;
+}
+
+void NCMesh::AddSlaveMatrix(NCList &list, const DenseMatrix &mat)
+{
+   // slaves at the same position within their masters (there are only a few
+   // such positions per refinement level) share the same point matrix
+   int index;
+   PointMatrixMap::const_iterator it = pm_map.find(&mat);
+   if (it == pm_map.end())
+   {
+      index = list.point_matrices.Size();
+      MFEM_VERIFY(index < (1 << 24), "too many point matrices");
+      list.point_matrices.Append(new DenseMatrix(mat));
+      pm_map[list.point_matrices.Last()] = index;
+   }
+   else
+   {
+      index = it->second;
+   }
+   list.slaves.back().matrix = index;
+}
+
 void NCMesh::BuildFaceList()
 {
    face_list.Clear();
@@ -2549,6 +2605,7 @@ void NCMesh::BuildFaceList()
    if (HaveTets()) { GetEdgeList(); } // needed by TraverseTetEdge()
 
    boundary_faces.SetSize(0);
+   pm_map.clear();
 
    Array<char> processed_faces(faces.NumIds());
    processed_faces = 0;
@@ -2623,6 +2680,7 @@ void NCMesh::BuildFaceList()
          if (fa.Boundary()) { boundary_faces.Append(face); }
       }
    }
+   pm_map.clear();
 }
 
 void NCMesh::TraverseEdge(int vn0, int vn1, double t0, double t1, int flags,
@@ -2638,9 +2696,10 @@ void NCMesh::TraverseEdge(int vn0, int vn1, double t0, double t1, int flags,
       edge_list.slaves.push_back(Slave(nd.edge_index, -1, -1, Geometry::SEGMENT));
       Slave &sl = edge_list.slaves.back();
 
-      sl.point_matrix.SetSize(1, 2);
-      sl.point_matrix(0,0) = t0;
-      sl.point_matrix(0,1) = t1;
+      DenseMatrix mat(1, 2);
+      mat(0,0) = t0;
+      mat(0,1) = t1;
+      AddSlaveMatrix(edge_list, mat);
 
       // handle slave edge orientation
       sl.edge_flags = flags;
@@ -2665,6 +2724,7 @@ void NCMesh::BuildEdgeList()
 
    Array<char> processed_edges(nodes.NumIds());
    processed_edges = 0;
+   pm_map.clear();
 
    Array<int> edge_element(nodes.NumIds());
    Array<signed char> edge_local(nodes.NumIds());
@@ -2754,6 +2814,7 @@ void NCMesh::BuildEdgeList()
          sl.element = edge_element[sl.index];
       }
    }
+   pm_map.clear();
 }
 
 void NCMesh::BuildVertexList()
@@ -2791,21 +2852,22 @@ void NCMesh::BuildVertexList()
    }
 }
 
-void NCMesh::Slave::OrientedPointMatrix(DenseMatrix &oriented_matrix) const
+void NCMesh::NCList::OrientedPointMatrix(const Slave &slave,
+                                         DenseMatrix &oriented_matrix) const
 {
-   oriented_matrix = point_matrix;
+   oriented_matrix = GetPointMatrix(slave);
 
-   if (edge_flags)
+   if (slave.edge_flags)
    {
       MFEM_ASSERT(oriented_matrix.Height() == 1 &&
                   oriented_matrix.Width() == 2, "not an edge point matrix");
 
-      if (edge_flags & 1) // master inverted
+      if (slave.edge_flags & 1) // master inverted
       {
          oriented_matrix(0,0) = 1.0 - oriented_matrix(0,0);
          oriented_matrix(0,1) = 1.0 - oriented_matrix(0,1);
       }
-      if (edge_flags & 2) // slave inverted
+      if (slave.edge_flags & 2) // slave inverted
       {
          std::swap(oriented_matrix(0,0), oriented_matrix(0,1));
       }
@@ -2822,14 +2884,28 @@ void NCMesh::NCList::Clear(bool hard)
    }
    else
    {
-      NCList empty;
-      conforming.swap(empty.conforming);
-      masters.swap(empty.masters);
-      slaves.swap(empty.slaves);
+      std::vector<MeshId>().swap(conforming);
+      std::vector<Master>().swap(masters);
+      std::vector<Slave>().swap(slaves);
    }
+   for (int i = 0; i < point_matrices.Size(); i++)
+   {
+      delete point_matrices[i];
+   }
+   point_matrices.DeleteAll();
    inv_index.DeleteAll();
 }
 
+void NCMesh::NCList::CopyPointMatrices(const NCList &other)
+{
+   MFEM_ASSERT(!point_matrices.Size(), "");
+   point_matrices.SetSize(other.point_matrices.Size());
+   for (int i = 0; i < point_matrices.Size(); i++)
+   {
+      point_matrices[i] = new DenseMatrix(*other.point_matrices[i]);
+   }
+}
+
 long NCMesh::NCList::TotalSize() const
 {
    return conforming.size() + masters.size() + slaves.size();
@@ -5087,20 +5163,27 @@ void NCMesh::Trim()
    element_vertex.Clear();
 
    ClearTransforms();
+
+   // refinement/derefinement temporaries
+   ref_stack.DeleteAll();
+   reparents.DeleteAll();
+   shadow.DeleteAll();
+   derefinements.Clear();
 }
 
 long NCMesh::NCList::MemoryUsage() const
 {
-   int pmsize = 0;
-   if (slaves.size())
+   long pmsize = point_matrices.MemoryUsage();
+   for (int i = 0; i < point_matrices.Size(); i++)
    {
-      pmsize = slaves[0].point_matrix.MemoryUsage();
+      pmsize += sizeof(DenseMatrix) + point_matrices[i]->MemoryUsage();
    }
 
    return conforming.capacity() * sizeof(MeshId) +
           masters.capacity() * sizeof(Master) +
           slaves.capacity() * sizeof(Slave) +
-          slaves.size() * pmsize;
+          inv_index.MemoryUsage() +
+          pmsize;
 }
 
 long CoarseFineTransformations::MemoryUsage() const
@@ -176,15 +176,12 @@ public:
    struct Slave : public MeshId
    {
       int master; ///< master number (in Mesh numbering)
-      int edge_flags; ///< edge orientation flags
-      DenseMatrix point_matrix; ///< position within the master edge/face
+      unsigned matrix : 24; ///< index into NCList::point_matrices
+      unsigned edge_flags : 8; ///< edge orientation flags
 
       Slave(int index, int element, char local, char geom)
          : MeshId(index, element, local, geom)
-         , master(-1), edge_flags(0) {}
-
-      /// Return the point matrix oriented according to the master and slave edges
-      void OrientedPointMatrix(DenseMatrix &oriented_matrix) const;
+         , master(-1), matrix(0), edge_flags(0) {}
    };
 
    /// Lists all edges/faces in the nonconforming mesh.
@@ -194,7 +191,13 @@ public:
       std::vector<Master> masters;
       std::vector<Slave> slaves;
       // TODO: switch to Arrays when fixed for non-POD types
-      // TODO: make a list of unique slave matrices to save memory (+ time later)
+
+      /** List of unique point matrices (positions of the slaves within their
+          masters), shared by all slaves with the same Slave::matrix. */
+      Array<DenseMatrix*> point_matrices;
+
+      NCList() {}
+      ~NCList() { Clear(true); }
 
       void Clear(bool hard = false);
       bool Empty() const { return !conforming.size() && !masters.size(); }
@@ -202,8 +205,24 @@ public:
       long MemoryUsage() const;
 
       const MeshId& LookUp(int index, int *type = NULL) const;
+
+      /// Return the point matrix of @a slave, see Slave::matrix.
+      const DenseMatrix &GetPointMatrix(const Slave &slave) const
+      { return *point_matrices[slave.matrix]; }
+
+      /** Return the point matrix of @a slave oriented according to the master
+          and slave edges. */
+      void OrientedPointMatrix(const Slave &slave,
+                               DenseMatrix &oriented_matrix) const;
+
+      /// Copy the point matrices of @a other, used together with its slaves.
+      void CopyPointMatrices(const NCList &other);
+
    private:
       mutable Array<int> inv_index;
+
+      NCList(const NCList&); // the point matrices are owned: prevent copy
+      NCList& operator=(const NCList&);
    };
 
    /// Return the current list of conforming and nonconforming faces.
@@ -350,7 +369,9 @@ public:
    /// I/O: Set positions of all vertices (used by mesh loader).
    void SetVertexPositions(const Array<mfem::Vertex> &vertices);
 
-   /// Save memory by releasing all non-essential and cached data.
+   /** @brief Save memory by releasing all non-essential and cached data.
+       This includes the NC lists (rebuilt on demand), the coarse/fine
+       transforms, the derefinement table and the refinement temporaries. */
    virtual void Trim();
 
    /// Return total number of bytes allocated.
@@ -635,6 +656,20 @@ protected: // implementation
    void TraverseEdge(int vn0, int vn1, double t0, double t1, int flags,
                      int level);
 
+   /// Lexicographic ordering of DenseMatrix contents, see AddSlaveMatrix().
+   struct PointMatrixLess
+   {
+      bool operator()(const DenseMatrix *a, const DenseMatrix *b) const;
+   };
+   typedef std::map<const DenseMatrix*, int, PointMatrixLess> PointMatrixMap;
+
+   /// Unique point matrices of the NCList being built (temporary).
+   PointMatrixMap pm_map;
+
+   /** Set the Slave::matrix of the last slave in @a list to the index of @a mat
+       in NCList::point_matrices, adding a copy of @a mat if not yet there. */
+   void AddSlaveMatrix(NCList &list, const DenseMatrix &mat);
+
    virtual void BuildFaceList();
    virtual void BuildEdgeList();
    virtual void BuildVertexList();
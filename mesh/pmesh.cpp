@@ -19,9 +19,13 @@
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
 #include "../general/globals.hpp"
+#include "../general/binaryio.hpp"
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>
 
 using namespace std;
 
@@ -3239,13 +3243,31 @@ void ParMesh::Rebalance(const Array<int> &partition)
    RebalanceImpl(&partition);
 }
 
-void ParMesh::RebalanceImpl(const Array<int> *partition)
+void ParMesh::Rebalance(const Vector &elem_weights)
 {
-   if (Conforming())
-   {
-      MFEM_ABORT("Load balancing is currently not supported for conforming"
-                 " meshes.");
-   }
+   RebalanceImpl(NULL, &elem_weights);
+}
+
+void ParMesh::WeightedPartition(const Vector &weights,
+                                Array<int> &partition) const
+{
+   MFEM_VERIFY(weights.Size() == GetNE(), "invalid number of element weights");
+
+   double loc_sum = weights.Sum(), glob_sum, offset;
+   MPI_Scan(&loc_sum, &offset, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   MPI_Allreduce(&loc_sum, &glob_sum, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   offset -= loc_sum;
+
+   partition.SetSize(GetNE());
+   SplitWeightedSequence(GetNE(), NULL, &weights, offset, glob_sum, NRanks,
+                         partition.GetData());
+}
+
+void ParMesh::RebalanceImpl(const Array<int> *partition,
+                            const Vector *weights)
+{
+   MFEM_VERIFY(NURBSext == NULL,
+               "Load balancing is not supported for NURBS meshes.");
 
    // Make sure the Nodes use a ParFiniteElementSpace
    if (Nodes && dynamic_cast<ParFiniteElementSpace*>(Nodes->FESpace()) == NULL)
@@ -3266,20 +3288,34 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    DeleteFaceNbrData();
 
-   pncmesh->Rebalance(partition);
+   if (Conforming())
+   {
+      RebalanceConforming(partition, weights);
+   }
+   else
+   {
+      Array<int> weighted_partition;
+      if (weights)
+      {
+         // split the SFC sequence of the leaf elements by weight
+         WeightedPartition(*weights, weighted_partition);
+         partition = &weighted_partition;
+      }
+      pncmesh->Rebalance(partition);
 
-   ParMesh* pmesh2 = new ParMesh(*pncmesh);
-   pncmesh->OnMeshUpdated(pmesh2);
+      ParMesh* pmesh2 = new ParMesh(*pncmesh);
+      pncmesh->OnMeshUpdated(pmesh2);
 
-   attributes.Copy(pmesh2->attributes);
-   bdr_attributes.Copy(pmesh2->bdr_attributes);
+      attributes.Copy(pmesh2->attributes);
+      bdr_attributes.Copy(pmesh2->bdr_attributes);
 
-   Swap(*pmesh2, false);
-   delete pmesh2;
+      Swap(*pmesh2, false);
+      delete pmesh2;
 
-   pncmesh->GetConformingSharedStructures(*this);
+      pncmesh->GetConformingSharedStructures(*this);
 
-   GenerateNCFaceInfo();
+      GenerateNCFaceInfo();
+   }
 
    last_operation = Mesh::REBALANCE;
    sequence++;
@@ -3287,6 +3323,807 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
    UpdateNodes();
 }
 
+void ParMesh::HilbertPartition(const Vector *weights, Array<int> &partition)
+{
+   MFEM_VERIFY(spaceDim <= 3, "");
+
+   const int ne = GetNE();
+   const int bits = std::min(63 / spaceDim, 31); // bits per coordinate
+   const int key_bits = bits * spaceDim;
+
+   // global bounding box of the element centers
+   Vector center;
+   Array<double> points(3*ne);
+   double bbox[6] = { infinity(), infinity(), infinity(),
+                      infinity(), infinity(), infinity()
+                    };
+   for (int i = 0; i < ne; i++)
+   {
+      GetElementCenter(i, center);
+      for (int d = 0; d < spaceDim; d++)
+      {
+         points[3*i + d] = center(d);
+         bbox[d] = std::min(bbox[d], center(d));
+         bbox[3+d] = std::min(bbox[3+d], -center(d));
+      }
+   }
+   MPI_Allreduce(MPI_IN_PLACE, bbox, 6, MPI_DOUBLE, MPI_MIN, MyComm);
+
+   // sorted Hilbert keys of the local elements
+   double bmin[3], bmax[3];
+   for (int d = 0; d < spaceDim; d++)
+   {
+      bmin[d] = bbox[d];
+      bmax[d] = -bbox[3+d];
+   }
+   Array<Pair<std::uint64_t, int> > keys;
+   SortSFCKeys(points, spaceDim, bmin, bmax, bits, true, keys);
+
+   // local weight of the elements before each position in 'keys'
+   Array<double> cum_weight(ne+1);
+   cum_weight[0] = 0.0;
+   for (int k = 0; k < ne; k++)
+   {
+      const double w = weights ? (*weights)(keys[k].two) : 1.0;
+      MFEM_ASSERT(w >= 0.0, "negative element weight");
+      cum_weight[k+1] = cum_weight[k] + w;
+   }
+   double total;
+   MPI_Allreduce(&cum_weight[ne], &total, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+
+   partition.SetSize(ne);
+   partition = 0;
+   if (NRanks == 1 || total <= 0.0) { return; }
+
+   // Rank 'r' gets the keys in [split[r-1], split[r]), where split[r-1] is the
+   // smallest key such that the global weight of the smaller keys reaches
+   // r/NRanks of the total. The splitters are found by bisection, each step
+   // requiring one reduction of NRanks-1 partial weights.
+   const int nsplit = NRanks-1;
+   Array<std::uint64_t> lo(nsplit), hi(nsplit), mid(nsplit);
+   Vector loc_w(nsplit), glob_w(nsplit);
+   for (int r = 0; r < nsplit; r++)
+   {
+      lo[r] = 0;
+      hi[r] = std::uint64_t(1) << key_bits;
+   }
+   for (int it = 0; it < key_bits; it++)
+   {
+      for (int r = 0; r < nsplit; r++)
+      {
+         mid[r] = lo[r] + (hi[r] - lo[r]) / 2;
+         const Pair<std::uint64_t, int> *pos =
+            std::lower_bound(keys.begin(), keys.end(), mid[r],
+                             [](const Pair<std::uint64_t, int> &a,
+                                std::uint64_t key) { return a.one < key; });
+         loc_w(r) = cum_weight[int(pos - keys.begin())];
+      }
+      MPI_Allreduce(loc_w.GetData(), glob_w.GetData(), nsplit, MPI_DOUBLE,
+                    MPI_SUM, MyComm);
+      for (int r = 0; r < nsplit; r++)
+      {
+         if (glob_w(r) >= total * (r+1) / NRanks) { hi[r] = mid[r]; }
+         else { lo[r] = mid[r]; }
+      }
+   }
+
+   for (int k = 0, r = 0; k < ne; k++)
+   {
+      while (r < nsplit && hi[r] <= keys[k].one) { r++; }
+      partition[keys[k].two] = r;
+   }
+}
+
+// Send the messages in 'send' and receive all messages with the same tag that
+// are sent to this rank, whose number and sources are not known in advance.
+// As in ParNCMesh::RedistributeElements, this uses synchronous sends and a
+// non-blocking barrier (the "non-blocking consensus" algorithm). A message to
+// this rank is moved to 'recv' directly.
+template<int Tag>
+static void ExchangeMessages(std::map<int, VarMessage<Tag> > &send,
+                             std::map<int, VarMessage<Tag> > &recv,
+                             MPI_Comm comm)
+{
+   int my_rank;
+   MPI_Comm_rank(comm, &my_rank);
+
+   typename std::map<int, VarMessage<Tag> >::iterator it = send.find(my_rank);
+   if (it != send.end())
+   {
+      recv[my_rank].data.swap(it->second.data);
+      send.erase(it);
+   }
+   for (it = send.begin(); it != send.end(); ++it)
+   {
+      it->second.Issend(it->first, comm);
+   }
+
+   MPI_Request barrier = MPI_REQUEST_NULL;
+   int done = 0;
+   while (!done)
+   {
+      int rank, size;
+      while (VarMessage<Tag>::IProbe(rank, size, comm))
+      {
+         recv[rank].Recv(rank, size, comm);
+      }
+
+      if (barrier != MPI_REQUEST_NULL)
+      {
+         MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+      }
+      else if (VarMessage<Tag>::TestAllSent(send))
+      {
+         int err = MPI_Ibarrier(comm, &barrier);
+         MFEM_VERIFY(err == MPI_SUCCESS, "");
+      }
+   }
+}
+
+// A vertex, edge or face identified by its sorted global vertex numbers.
+struct RebalanceEntity
+{
+   int key[4], len; // global vertex numbers, number of vertices
+   int group, index;
+
+   bool KeyLess(const RebalanceEntity &other) const
+   {
+      if (len != other.len) { return len < other.len; }
+      return std::lexicographical_compare(key, key + len,
+                                          other.key, other.key + len);
+   }
+   bool SameKey(const RebalanceEntity &other) const
+   {
+      return len == other.len && std::equal(key, key + len, other.key);
+   }
+   bool operator<(const RebalanceEntity &other) const
+   {
+      return (group != other.group) ? group < other.group : KeyLess(other);
+   }
+};
+
+void ParMesh::RebalanceConforming(const Array<int> *partition,
+                                  const Vector *weights)
+{
+   using namespace bin_io;
+
+   MFEM_VERIFY(!partition || partition->Size() == GetNE(),
+               "invalid partition size");
+   MFEM_VERIFY(!weights || weights->Size() == GetNE(),
+               "invalid number of element weights");
+
+   // 1. Global vertex numbering: each vertex is owned by the master of its
+   //    group; the owners number their vertices consecutively (preserving the
+   //    local order) and broadcast the numbers to the rest of the group.
+   Array<int> vert_group(GetNV());
+   vert_group = 0;
+   for (int gr = 1; gr < GetNGroups(); gr++)
+   {
+      for (int i = 0; i < GroupNVertices(gr); i++)
+      {
+         vert_group[GroupVertex(gr, i)] = gr;
+      }
+   }
+
+   Array<int> vert_global(GetNV());
+   int num_owned = 0, vert_offset;
+   for (int i = 0; i < GetNV(); i++)
+   {
+      vert_global[i] = gtopo.IAmMaster(vert_group[i]) ? num_owned++ : -1;
+   }
+   MPI_Scan(&num_owned, &vert_offset, 1, MPI_INT, MPI_SUM, MyComm);
+   vert_offset -= num_owned;
+   for (int i = 0; i < GetNV(); i++)
+   {
+      if (vert_global[i] >= 0) { vert_global[i] += vert_offset; }
+   }
+   {
+      // the shared vertices are ordered consistently in group_svert
+      GroupCommunicator svert_comm(gtopo);
+      Table &gr_svert = svert_comm.GroupLDofTable();
+      gr_svert.SetDims(GetNGroups(), svert_lvert.Size());
+      gr_svert.GetI()[0] = 0;
+      for (int gr = 1; gr <= GetNGroups(); gr++)
+      {
+         gr_svert.GetI()[gr] = group_svert.GetI()[gr-1];
+      }
+      for (int k = 0; k < svert_lvert.Size(); k++)
+      {
+         gr_svert.GetJ()[k] = group_svert.GetJ()[k];
+      }
+      svert_comm.Finalize();
+
+      Array<int> svert_global(svert_lvert.Size());
+      for (int k = 0; k < svert_lvert.Size(); k++)
+      {
+         svert_global[k] = vert_global[svert_lvert[k]];
+      }
+      svert_comm.Bcast(svert_global);
+      for (int k = 0; k < svert_lvert.Size(); k++)
+      {
+         vert_global[svert_lvert[k]] = svert_global[k];
+      }
+   }
+
+   // 2. New owners of the elements: the given partition, or a split of the
+   //    Hilbert curve through the element centers into pieces of equal weight
+   Array<int> new_rank;
+   if (partition)
+   {
+      partition->Copy(new_rank);
+   }
+   else
+   {
+      HilbertPartition(weights, new_rank);
+   }
+
+   // 3. New owners of the boundary elements. As in the constructor from a
+   //    serial mesh, a boundary element on an interior face goes (in 3D) with
+   //    the element whose face has the same orientation. On a shared face this
+   //    may be the element of the neighbor rank, so the new owners of the
+   //    elements on both sides of the shared faces are exchanged first.
+   Array<int> sface_nbr_rank;
+   if (Dim == 3)
+   {
+      GroupCommunicator sface_comm(gtopo);
+      Table &gr_sface = sface_comm.GroupLDofTable();
+      const int nst = shared_trias.Size();
+      gr_sface.MakeI(GetNGroups());
+      for (int gr = 1; gr < GetNGroups(); gr++)
+      {
+         gr_sface.AddColumnsInRow(gr, GroupNTriangles(gr) +
+                                  GroupNQuadrilaterals(gr));
+      }
+      gr_sface.MakeJ();
+      for (int gr = 1; gr < GetNGroups(); gr++)
+      {
+         gr_sface.AddConnections(gr, group_stria.GetRow(gr-1),
+                                 group_stria.RowSize(gr-1));
+         for (int i = 0; i < group_squad.RowSize(gr-1); i++)
+         {
+            gr_sface.AddConnection(gr, nst + group_squad.GetRow(gr-1)[i]);
+         }
+      }
+      gr_sface.ShiftUpI();
+      sface_comm.Finalize();
+
+      const int nsf = sface_lface.Size();
+      Array<int> my_rank(nsf);
+      for (int sf = 0; sf < nsf; sf++)
+      {
+         my_rank[sf] = new_rank[faces_info[sface_lface[sf]].Elem1No];
+      }
+      // the masters send their values to the other rank of the face group ...
+      my_rank.Copy(sface_nbr_rank);
+      sface_comm.Bcast(sface_nbr_rank);
+      // ... and receive the values of the other rank
+      for (int gr = 1; gr < GetNGroups(); gr++)
+      {
+         if (!gtopo.IAmMaster(gr)) { continue; }
+         for (int i = 0; i < gr_sface.RowSize(gr); i++)
+         {
+            my_rank[gr_sface.GetRow(gr)[i]] = 0;
+         }
+      }
+      sface_comm.Reduce<int>(my_rank, GroupCommunicator::Sum);
+      for (int gr = 1; gr < GetNGroups(); gr++)
+      {
+         if (!gtopo.IAmMaster(gr)) { continue; }
+         for (int i = 0; i < gr_sface.RowSize(gr); i++)
+         {
+            const int sf = gr_sface.GetRow(gr)[i];
+            sface_nbr_rank[sf] = my_rank[sf];
+         }
+      }
+   }
+
+   Array<int> bdr_new_rank(GetNBE());
+   {
+      Array<int> face_sface;
+      if (Dim == 3)
+      {
+         face_sface.SetSize(GetNumFaces());
+         face_sface = -1;
+         for (int sf = 0; sf < sface_lface.Size(); sf++)
+         {
+            face_sface[sface_lface[sf]] = sf;
+         }
+      }
+      for (int i = 0; i < GetNBE(); i++)
+      {
+         int f, o = 0;
+         if (Dim == 3)
+         {
+            GetBdrElementFace(i, &f, &o);
+         }
+         else
+         {
+            f = GetBdrElementEdgeIndex(i);
+         }
+         const FaceInfo &fi = faces_info[f];
+         if (o % 2 == 0)
+         {
+            bdr_new_rank[i] = new_rank[fi.Elem1No];
+         }
+         else if (fi.Elem2No >= 0)
+         {
+            bdr_new_rank[i] = new_rank[fi.Elem2No];
+         }
+         else if (face_sface[f] >= 0)
+         {
+            bdr_new_rank[i] = sface_nbr_rank[face_sface[f]];
+         }
+         else // boundary face
+         {
+            bdr_new_rank[i] = new_rank[fi.Elem1No];
+         }
+      }
+   }
+
+   // 4. Send the elements and the boundary elements, together with the global
+   //    numbers and coordinates of their vertices, to their new owners. The
+   //    elements keep their vertex order (and tetrahedra their refinement
+   //    flags), so that subsequent conforming refinements remain consistent.
+   typedef VarMessage<161> ElementMessage;
+   std::map<int, ElementMessage> send_elems, recv_elems;
+   {
+      std::map<int, Array<int> > rank_elems, rank_bdr;
+      for (int i = 0; i < GetNE(); i++)
+      {
+         MFEM_VERIFY(new_rank[i] >= 0 && new_rank[i] < NRanks,
+                     "invalid rank " << new_rank[i] << " for element " << i);
+         rank_elems[new_rank[i]].Append(i);
+      }
+      for (int i = 0; i < GetNBE(); i++)
+      {
+         rank_bdr[bdr_new_rank[i]].Append(i);
+      }
+      std::map<int, Array<int> >::iterator it;
+      for (it = rank_bdr.begin(); it != rank_bdr.end(); ++it)
+      {
+         rank_elems[it->first]; // the message may contain only bdr elements
+      }
+
+      Array<int> vert_marker(GetNV()), verts;
+      vert_marker = -1;
+      for (it = rank_elems.begin(); it != rank_elems.end(); ++it)
+      {
+         const int rank = it->first;
+         const Array<Element*> *lists[2] = { &elements, &boundary };
+         const Array<int> *indices[2] = { &it->second, &rank_bdr[rank] };
+
+         std::ostringstream stream;
+         verts.SetSize(0);
+         for (int l = 0; l < 2; l++)
+         {
+            write<int>(stream, indices[l]->Size());
+            for (int k = 0; k < indices[l]->Size(); k++)
+            {
+               Element *el = (*lists[l])[(*indices[l])[k]];
+               write<int>(stream, el->GetGeometryType());
+               write<int>(stream, el->GetAttribute());
+               write<int>(stream, (el->GetType() == Element::TETRAHEDRON) ?
+                          ((Tetrahedron*) el)->GetRefinementFlag() : 0);
+               const int *v = el->GetVertices();
+               for (int j = 0; j < el->GetNVertices(); j++)
+               {
+                  write<int>(stream, vert_global[v[j]]);
+                  if (vert_marker[v[j]] != rank)
+                  {
+                     vert_marker[v[j]] = rank;
+                     verts.Append(v[j]);
+                  }
+               }
+            }
+         }
+         write<int>(stream, verts.Size());
+         for (int k = 0; k < verts.Size(); k++)
+         {
+            write<int>(stream, vert_global[verts[k]]);
+            stream.write((const char*) GetVertex(verts[k]),
+                         spaceDim*sizeof(double));
+         }
+         stream.str().swap(send_elems[rank].data);
+      }
+   }
+   vert_global.DeleteAll();
+
+   ExchangeMessages(send_elems, recv_elems, MyComm);
+   send_elems.clear();
+
+   // 5. Build the new local mesh. The messages are processed in the order of
+   //    the sending ranks, so the new elements follow the global order of the
+   //    previous elements. The local vertices are ordered by global number.
+   mfem::Swap(rebalance_new_rank, new_rank);
+   rebalance_old_rank.SetSize(0);
+
+   Array<int> vert_gnum;
+   int new_ne = 0, new_nbe = 0;
+   {
+      std::map<int, ElementMessage>::iterator it;
+      for (it = recv_elems.begin(); it != recv_elems.end(); ++it)
+      {
+         std::istringstream stream(it->second.data);
+         for (int l = 0; l < 2; l++)
+         {
+            const int n = read<int>(stream);
+            for (int k = 0; k < n; k++)
+            {
+               const int geom = read<int>(stream);
+               stream.seekg((2 + Geometry::NumVerts[geom])*sizeof(int),
+                            std::ios::cur);
+            }
+            (l ? new_nbe : new_ne) += n;
+         }
+         const int nv = read<int>(stream);
+         for (int k = 0; k < nv; k++)
+         {
+            vert_gnum.Append(read<int>(stream));
+            stream.seekg(spaceDim*sizeof(double), std::ios::cur);
+         }
+      }
+      vert_gnum.Sort();
+      vert_gnum.Unique();
+   }
+
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      FreeElement(elements[i]);
+   }
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      FreeElement(boundary[i]);
+   }
+   elements.SetSize(0);
+   boundary.SetSize(0);
+   NumOfElements = NumOfBdrElements = 0;
+
+   {
+      Mesh mesh(Dim, vert_gnum.Size(), new_ne, new_nbe, spaceDim);
+      Array<double> coords(vert_gnum.Size()*spaceDim);
+
+      std::map<int, ElementMessage>::iterator it;
+      for (it = recv_elems.begin(); it != recv_elems.end(); ++it)
+      {
+         std::istringstream stream(it->second.data);
+         for (int l = 0; l < 2; l++)
+         {
+            const int n = read<int>(stream);
+            for (int k = 0; k < n; k++)
+            {
+               // note: the elements are allocated by this mesh, see the
+               // MFEM_USE_MEMALLOC option
+               Element *el = NewElement(read<int>(stream));
+               el->SetAttribute(read<int>(stream));
+               const int flag = read<int>(stream);
+               if (flag) { ((Tetrahedron*) el)->SetRefinementFlag(flag); }
+               int *v = el->GetVertices();
+               for (int j = 0; j < el->GetNVertices(); j++)
+               {
+                  v[j] = vert_gnum.FindSorted(read<int>(stream));
+               }
+               if (l == 0)
+               {
+                  mesh.AddElement(el);
+                  rebalance_old_rank.Append(it->first);
+               }
+               else
+               {
+                  mesh.AddBdrElement(el);
+               }
+            }
+         }
+         const int nv = read<int>(stream);
+         for (int k = 0; k < nv; k++)
+         {
+            const int lv = vert_gnum.FindSorted(read<int>(stream));
+            stream.read((char*) &coords[lv*spaceDim], spaceDim*sizeof(double));
+         }
+         it->second.data.clear();
+      }
+      recv_elems.clear();
+
+      for (int i = 0; i < vert_gnum.Size(); i++)
+      {
+         mesh.AddVertex(&coords[i*spaceDim]);
+      }
+      mesh.FinalizeTopology(false);
+
+      const int global_meshgen = meshgen;
+      Swap(mesh, false);
+      meshgen = global_meshgen;
+
+      // the attribute lists are global
+      mesh.attributes.Copy(attributes);
+      mesh.bdr_attributes.Copy(bdr_attributes);
+   }
+
+   // 6. Find the shared vertices, edges and faces. Only the entities on the
+   //    boundary of the local part can be shared. Each of them is registered
+   //    with a "directory" rank determined by its smallest global vertex
+   //    number, which collects the ranks containing the entity and sends the
+   //    list back. The entities are identified by their sorted global vertex
+   //    numbers, so they can be ordered consistently on all ranks.
+   Array<RebalanceEntity> ents;
+   {
+      Array<int> vert_marker(GetNV()), edge_marker(GetNEdges());
+      vert_marker = 0;
+      edge_marker = 0;
+      DSTable v_to_v(Dim == 3 ? GetNV() : 0);
+      if (Dim == 3) { GetVertexToVertexTable(v_to_v); }
+
+      RebalanceEntity ent;
+      ent.group = 0;
+      Array<int> fv;
+      for (int f = 0; f < GetNumFaces(); f++)
+      {
+         if (faces_info[f].Elem2No >= 0) { continue; }
+
+         GetFaceVertices(f, fv);
+         if (Dim == 3)
+         {
+            ent.len = fv.Size();
+            ent.index = f;
+            ents.Append(ent);
+         }
+         if (Dim == 2 && !edge_marker[f]++)
+         {
+            ent.len = 2;
+            ent.index = f;
+            ents.Append(ent);
+         }
+         for (int j = 0; j < fv.Size(); j++)
+         {
+            if (!vert_marker[fv[j]]++)
+            {
+               ent.len = 1;
+               ent.index = fv[j];
+               ents.Append(ent);
+            }
+            if (Dim == 3)
+            {
+               const int e = v_to_v(fv[j], fv[(j+1) % fv.Size()]);
+               if (!edge_marker[e]++)
+               {
+                  ent.len = 2;
+                  ent.index = e;
+                  ents.Append(ent);
+               }
+            }
+         }
+      }
+
+      Array<int> ev;
+      for (int k = 0; k < ents.Size(); k++)
+      {
+         RebalanceEntity &ent = ents[k];
+         switch (ent.len)
+         {
+            case 1: ev.SetSize(1); ev[0] = ent.index; break;
+            case 2: GetEdgeVertices(ent.index, ev); break;
+            default: GetFaceVertices(ent.index, ev); break;
+         }
+         for (int j = 0; j < ent.len; j++) { ent.key[j] = vert_gnum[ev[j]]; }
+         std::sort(ent.key, ent.key + ent.len);
+      }
+   }
+
+   typedef VarMessage<162> EntityMessage;
+   std::map<int, EntityMessage> send_ents, recv_ents;
+   std::map<int, Array<int> > dir_ents; // entities sent to each directory
+   {
+      for (int k = 0; k < ents.Size(); k++)
+      {
+         dir_ents[ents[k].key[0] % NRanks].Append(k);
+      }
+      std::map<int, Array<int> >::iterator it;
+      for (it = dir_ents.begin(); it != dir_ents.end(); ++it)
+      {
+         std::ostringstream stream;
+         write<int>(stream, it->second.Size());
+         for (int i = 0; i < it->second.Size(); i++)
+         {
+            const RebalanceEntity &ent = ents[it->second[i]];
+            write<int>(stream, ent.len);
+            stream.write((const char*) ent.key, ent.len*sizeof(int));
+         }
+         stream.str().swap(send_ents[it->first].data);
+      }
+   }
+   ExchangeMessages(send_ents, recv_ents, MyComm);
+   send_ents.clear();
+
+   // directory: reply with the ranks containing each entity that is shared
+   typedef VarMessage<163> EntityRanksMessage;
+   std::map<int, EntityRanksMessage> send_ranks, recv_ranks;
+   {
+      Array<RebalanceEntity> dir; // 'group' is the rank, 'index' the position
+      std::map<int, EntityMessage>::iterator it;
+      for (it = recv_ents.begin(); it != recv_ents.end(); ++it)
+      {
+         std::istringstream stream(it->second.data);
+         const int n = read<int>(stream);
+         for (int i = 0; i < n; i++)
+         {
+            RebalanceEntity ent;
+            ent.len = read<int>(stream);
+            stream.read((char*) ent.key, ent.len*sizeof(int));
+            ent.group = it->first;
+            ent.index = i;
+            dir.Append(ent);
+         }
+      }
+      recv_ents.clear();
+
+      dir.Sort([](const RebalanceEntity &a, const RebalanceEntity &b)
+      {
+         return a.SameKey(b) ? a.group < b.group : a.KeyLess(b);
+      });
+
+      std::map<int, std::ostringstream> streams;
+      Array<int> ranks;
+      for (int begin = 0, end = 0; begin < dir.Size(); begin = end)
+      {
+         ranks.SetSize(0);
+         while (end < dir.Size() && dir[end].SameKey(dir[begin]))
+         {
+            ranks.Append(dir[end++].group);
+         }
+         if (ranks.Size() < 2) { continue; }
+
+         for (int i = begin; i < end; i++)
+         {
+            std::ostringstream &stream = streams[dir[i].group];
+            write<int>(stream, dir[i].index);
+            write<int>(stream, ranks.Size());
+            stream.write((const char*) ranks.GetData(),
+                         ranks.Size()*sizeof(int));
+         }
+      }
+      std::map<int, std::ostringstream>::iterator st;
+      for (st = streams.begin(); st != streams.end(); ++st)
+      {
+         st->second.str().swap(send_ranks[st->first].data);
+      }
+   }
+   ExchangeMessages(send_ranks, recv_ranks, MyComm);
+   send_ranks.clear();
+
+   ListOfIntegerSets groups;
+   {
+      // the first group is the local one
+      IntegerSet group;
+      group.Recreate(1, &MyRank);
+      groups.Insert(group);
+
+      Array<int> ranks;
+      std::map<int, EntityRanksMessage>::iterator it;
+      for (it = recv_ranks.begin(); it != recv_ranks.end(); ++it)
+      {
+         const Array<int> &sent = dir_ents[it->first];
+         std::istringstream stream(it->second.data);
+         while (stream.peek() != EOF)
+         {
+            const int pos = read<int>(stream);
+            ranks.SetSize(read<int>(stream));
+            stream.read((char*) ranks.GetData(), ranks.Size()*sizeof(int));
+            group.Recreate(ranks.Size(), ranks.GetData());
+            ents[sent[pos]].group = groups.Insert(group);
+         }
+      }
+      recv_ranks.clear();
+   }
+
+   // 7. Build the group topology and the shared entities. Within each group,
+   //    the entities are ordered by their global vertex numbers.
+   {
+      GroupTopology new_gtopo(MyComm);
+      new_gtopo.Create(groups, 822);
+      new_gtopo.Copy(gtopo);
+   }
+   const int ngroups = groups.Size()-1;
+
+   for (int i = 0; i < shared_edges.Size(); i++)
+   {
+      FreeElement(shared_edges[i]);
+   }
+   shared_edges.SetSize(0);
+   shared_trias.SetSize(0);
+   shared_quads.SetSize(0);
+   svert_lvert.SetSize(0);
+
+   ents.Sort();
+   group_svert.MakeI(ngroups);
+   group_sedge.MakeI(ngroups);
+   group_stria.MakeI(ngroups);
+   group_squad.MakeI(ngroups);
+   Table *group_tables[5] =
+   { NULL, &group_svert, &group_sedge, &group_stria, &group_squad };
+   for (int k = 0; k < ents.Size(); k++)
+   {
+      const RebalanceEntity &ent = ents[k];
+      if (ent.group) { group_tables[ent.len]->AddAColumnInRow(ent.group-1); }
+   }
+   for (int t = 1; t <= 4; t++) { group_tables[t]->MakeJ(); }
+
+   Array<int> stria_group;
+   for (int k = 0; k < ents.Size(); k++)
+   {
+      const RebalanceEntity &ent = ents[k];
+      if (!ent.group) { continue; }
+
+      int idx = 0;
+      switch (ent.len)
+      {
+         case 1:
+            idx = svert_lvert.Append(ent.index)-1;
+            break;
+
+         case 2:
+         {
+            // the local vertices are ordered like the global ones
+            Array<int> ev;
+            GetEdgeVertices(ent.index, ev);
+            idx = shared_edges.Append(
+                     new Segment(std::min(ev[0], ev[1]),
+                                 std::max(ev[0], ev[1]), 1))-1;
+            break;
+         }
+
+         case 3:
+         {
+            shared_trias.SetSize(shared_trias.Size()+1);
+            int *v = shared_trias.Last().v;
+            for (int j = 0; j < 3; j++)
+            {
+               v[j] = vert_gnum.FindSorted(ent.key[j]);
+            }
+            stria_group.Append(ent.group);
+            idx = shared_trias.Size()-1;
+            break;
+         }
+
+         case 4:
+         {
+            // start from the smallest vertex and continue towards its smaller
+            // neighbor, independent of the orientation of the local face
+            const int *fv = faces[ent.index]->GetVertices();
+            const int m = std::min_element(fv, fv + 4) - fv;
+            const int dir = (fv[(m+1) % 4] < fv[(m+3) % 4]) ? 1 : 3;
+            shared_quads.SetSize(shared_quads.Size()+1);
+            int *v = shared_quads.Last().v;
+            for (int j = 0; j < 4; j++) { v[j] = fv[(m + j*dir) % 4]; }
+            idx = shared_quads.Size()-1;
+            break;
+         }
+      }
+      group_tables[ent.len]->AddConnection(ent.group-1, idx);
+   }
+   for (int t = 1; t <= 4; t++) { group_tables[t]->ShiftUpI(); }
+
+   FinalizeParTopo();
+
+   if (meshgen == 1) // Tet-only mesh
+   {
+      // mark the shared faces for refinement according to the refinement flag
+      // of the local tetrahedron, flipping them on one of the two ranks
+      for (int st = 0; st < shared_trias.Size(); st++)
+      {
+         const FaceInfo &fi = faces_info[sface_lface[st]];
+         Tetrahedron *tet = dynamic_cast<Tetrahedron *>(elements[fi.Elem1No]);
+         if (tet->GetRefinementFlag())
+         {
+            int *v = shared_trias[st].v;
+            tet->GetMarkedFace(fi.Elem1Inf/64, v);
+            if (!gtopo.IAmMaster(stria_group[st]))
+            {
+               std::swap(v[0], v[1]);
+            }
+         }
+      }
+   }
+}
+
 void ParMesh::RefineGroups(const DSTable &v_to_v, int *middle)
 {
    // Refine groups after LocalRefinement in 2D (triangle meshes)
@@ -5135,6 +5972,60 @@ long ParMesh::ReduceInt(int value) const
    return global;
 }
 
+void ParMesh::GetTimeStepLevels(Array<int> &levels, int max_level,
+                                bool use_depth)
+{
+   Vector h;
+   GetTimeStepSizes(h, use_depth);
+   double loc_h_max = (h.Size() > 0) ? h.Max() : 0.0, h_max;
+   MPI_Allreduce(&loc_h_max, &h_max, 1, MPI_DOUBLE, MPI_MAX, MyComm);
+   SizesToTimeStepLevels(h, h_max, max_level, levels);
+}
+
+void ParMesh::ExchangeFaceNbrLevels(Array<int> &levels)
+{
+   MFEM_VERIFY(levels.Size() == NumOfElements, "invalid levels");
+   ExchangeFaceNbrData();
+
+   const int num_face_nbrs = GetNFaceNeighbors();
+   if (num_face_nbrs == 0) { return; }
+   levels.SetSize(NumOfElements + face_nbr_elements.Size());
+
+   Array<int> send_levels(send_face_nbr_elements.Size_of_connections());
+   const int *send_offset = send_face_nbr_elements.GetI();
+   const int *send_el = send_face_nbr_elements.GetJ();
+   for (int i = 0; i < send_levels.Size(); i++)
+   {
+      send_levels[i] = levels[send_el[i]];
+   }
+
+   MPI_Request *requests = new MPI_Request[2*num_face_nbrs];
+   MPI_Request *send_requests = requests;
+   MPI_Request *recv_requests = requests + num_face_nbrs;
+   MPI_Status  *statuses = new MPI_Status[num_face_nbrs];
+
+   int *recv_levels = levels.GetData() + NumOfElements;
+   for (int fn = 0; fn < num_face_nbrs; fn++)
+   {
+      int nbr_rank = GetFaceNbrRank(fn);
+      int tag = 0;
+
+      MPI_Isend(&send_levels[send_offset[fn]],
+                send_offset[fn+1] - send_offset[fn],
+                MPI_INT, nbr_rank, tag, MyComm, &send_requests[fn]);
+
+      MPI_Irecv(&recv_levels[face_nbr_elements_offset[fn]],
+                face_nbr_elements_offset[fn+1] - face_nbr_elements_offset[fn],
+                MPI_INT, nbr_rank, tag, MyComm, &recv_requests[fn]);
+   }
+
+   MPI_Waitall(num_face_nbrs, send_requests, statuses);
+   MPI_Waitall(num_face_nbrs, recv_requests, statuses);
+
+   delete [] statuses;
+   delete [] requests;
+}
+
 void ParMesh::ParPrint(ostream &out) const
 {
    if (NURBSext || pncmesh)
@@ -78,6 +78,12 @@ protected:
    // sface ids: all triangles first, then all quads
    Array<int> sface_lface;
 
+   /** After Rebalance() of a conforming mesh: the rank that owned each current
+       element before the call, and the rank each of the previous elements was
+       sent to. Used by ParFiniteElementSpace to migrate the element DOFs. */
+   Array<int> rebalance_old_rank;
+   Array<int> rebalance_new_rank;
+
    /// Create from a nonconforming mesh.
    ParMesh(const ParNCMesh &pncmesh);
 
@@ -142,7 +148,25 @@ protected:
                                           double threshold, int nc_limit = 0,
                                           int op = 1);
 
-   void RebalanceImpl(const Array<int> *partition);
+   void RebalanceImpl(const Array<int> *partition,
+                      const Vector *weights = NULL);
+
+   /** Rebalance a conforming mesh using @a partition, or, if NULL, the
+       partition computed by HilbertPartition(). The elements are sent point to
+       point to their new owners, together with a global numbering of their
+       vertices, and the shared groups are rebuilt from the ranks containing
+       each vertex, edge and face on the boundary of the new local parts. */
+   void RebalanceConforming(const Array<int> *partition,
+                            const Vector *weights);
+
+   /** Split the Hilbert curve through the element centers into NRanks pieces
+       of equal total weight (or number of elements, if @a weights is NULL),
+       using a distributed bisection search for the splitting keys. */
+   void HilbertPartition(const Vector *weights, Array<int> &partition);
+
+   /// Compute a partition that splits the global element sequence in NRanks
+   /// contiguous pieces of (approximately) equal total weight.
+   void WeightedPartition(const Vector &weights, Array<int> &partition) const;
 
    void DeleteFaceNbrData();
 
@@ -289,15 +313,45 @@ public:
    /// Utility function: sum integers from all processors (Allreduce).
    virtual long ReduceInt(int value) const;
 
+   /** @brief Compute the local time stepping levels of the local elements, see
+       Mesh::GetTimeStepLevels(); h_max and the minimal depth are global. */
+   virtual void GetTimeStepLevels(Array<int> &levels, int max_level,
+                                  bool use_depth = false);
+
+   /** @brief Append the levels of the face-neighbor elements to the element
+       @a levels, e.g. computed with GetTimeStepLevels(). */
+   /** The face-neighbor elements are numbered after the local elements, as in
+       ElementToElementTable() when it is first called after
+       ExchangeFaceNbrData(), which is called by this method. The two are the
+       input of the parallel MultirateRK2Solver. */
+   void ExchangeFaceNbrLevels(Array<int> &levels);
+
    /** Load balance the mesh by equipartitioning the global space-filling
-       sequence of elements. Works for nonconforming meshes only. */
+       sequence of elements. For conforming meshes, the elements are ordered
+       along the Hilbert curve through their centers. */
    void Rebalance();
 
-   /** Load balance a nonconforming mesh using a user-defined partition.
-       Each local element 'i' is migrated to processor rank 'partition[i]',
-       for 0 <= i < GetNE(). */
+   /** Load balance the mesh using a user-defined partition. Each local element
+       'i' is migrated to processor rank 'partition[i]', for 0 <= i < GetNE().
+       */
    void Rebalance(const Array<int> &partition);
 
+   /** Load balance the mesh by splitting the global space-filling sequence of
+       elements (see Rebalance()) into pieces of equal total weight. The
+       nonnegative @a elem_weights, of size GetNE(), can be e.g. the estimated
+       work per element or the error estimates used to drive the refinement. */
+   void Rebalance(const Vector &elem_weights);
+
+   /** Return the previous owner of each element after a Rebalance() of a
+       conforming mesh (the array is empty for nonconforming meshes). */
+   const Array<int>& GetRebalanceOldRanks() const
+   { return rebalance_old_rank; }
+
+   /** Return the destination rank of each previous element after a
+       Rebalance() of a conforming mesh (empty for nonconforming meshes). */
+   const Array<int>& GetRebalanceNewRanks() const
+   { return rebalance_new_rank; }
+
    /** Print the part of the mesh in the calling processor adding the interface
        as boundary (for visualization purposes) using the mfem v1.0 format. */
    virtual void Print(std::ostream &out = mfem::out) const;
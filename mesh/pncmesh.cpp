@@ -505,6 +505,7 @@ void ParNCMesh::MakeSharedList(const NCList &list, NCList &shared)
          shared.slaves.push_back(list.slaves[i]);
       }
    }
+   shared.CopyPointMatrices(list);
 }
 
 bool operator<(const ParNCMesh::CommGroup &lhs, const ParNCMesh::CommGroup &rhs)
@@ -1260,7 +1261,7 @@ void ParNCMesh::GetFaceNeighbors(ParMesh &pmesh)
             MFEM_ASSERT(fi.Elem2No >= NElements, "");
             fi.Elem2No = -1 - fnbr_index[fi.Elem2No - NElements];
 
-            const DenseMatrix* pm = &sf.point_matrix;
+            const DenseMatrix* pm = &full_list.GetPointMatrix(sf);
             if (!sloc && Dim == 3)
             {
                // ghost slave in 3D needs flipping orientation
@@ -1272,7 +1273,7 @@ void ParNCMesh::GetFaceNeighbors(ParMesh &pmesh)
                fi.Elem2Inf ^= 1;
                pm = pm2;
 
-               // The problem is that sf.point_matrix is designed for P matrix
+               // The problem is that the slave point matrix is designed for P matrix
                // construction and always has orientation relative to the slave
                // face. In ParMesh::GetSharedFaceTransformations the result
                // would therefore be the same on both processors, which is not
@@ -621,6 +621,8 @@ int main (int argc, char *argv[])
                  "3) METIS_PartGraphRecursive\n"
                  "4) METIS_PartGraphKway\n"
                  "5) METIS_PartGraphVKway\n"
+                 "6) Hilbert curve split (no METIS)\n"
+                 "7) Morton curve split (no METIS)\n"
                  "--> " << flush;
             char pk;
             cin >> pk;
@@ -655,7 +657,7 @@ int main (int argc, char *argv[])
             else
             {
                int part_method = pk - '0';
-               if (part_method < 0 || part_method > 5)
+               if (part_method < 0 || part_method > 7)
                {
                   continue;
                }
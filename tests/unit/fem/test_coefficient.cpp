@@ -0,0 +1,154 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace coefficient
+{
+
+double func(const Vector &x)
+{
+   double val = 1.0 + x(0)*x(0);
+   for (int d = 1; d < x.Size(); d++) { val += x(d)*(d + x(0)); }
+   return val;
+}
+
+void vfunc(const Vector &x, Vector &v)
+{
+   v.SetSize(x.Size());
+   for (int d = 0; d < x.Size(); d++) { v(d) = func(x) + d*x(d); }
+}
+
+// Reference point-wise evaluation of the coefficient
+void ProjectPointwise(Coefficient &coeff, Mesh &mesh,
+                      const IntegrationRule &ir, Vector &qcoeff)
+{
+   const int nq = ir.GetNPoints();
+   qcoeff.SetSize(nq*mesh.GetNE());
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         T.SetIntPoint(&ir.IntPoint(q));
+         qcoeff(q + nq*e) = coeff.Eval(T, ir.IntPoint(q));
+      }
+   }
+}
+
+void CheckProject(Coefficient &coeff, Mesh &mesh, const IntegrationRule &ir)
+{
+   Vector qc, qc_ref;
+   coeff.Project(qc, mesh, ir);
+   ProjectPointwise(coeff, mesh, ir, qc_ref);
+   REQUIRE(qc.Size() == qc_ref.Size());
+   qc_ref -= qc;
+   REQUIRE(qc_ref.Normlinf() < 1e-12);
+}
+
+TEST_CASE("Batched coefficient evaluation", "[Coefficient]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 4, Element::QUADRILATERAL, true, 1.0, 2.0) :
+                   new Mesh(2, 3, 2, Element::HEXAHEDRON, true, 1.0, 2.0, 0.5);
+      mesh->EnsureNodes();
+      const int order = 2;
+      const IntegrationRule &ir =
+         IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 1);
+
+      SECTION("ConstantCoefficient, dim = " + std::to_string(dim))
+      {
+         ConstantCoefficient cc(2.5);
+         CheckProject(cc, *mesh, ir);
+      }
+
+      SECTION("FunctionCoefficient, dim = " + std::to_string(dim))
+      {
+         FunctionCoefficient fc(func);
+         CheckProject(fc, *mesh, ir);
+      }
+
+      SECTION("GridFunctionCoefficient, dim = " + std::to_string(dim))
+      {
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace sfes(mesh, &fec);
+         FiniteElementSpace vfes(mesh, &fec, dim);
+         GridFunction sgf(&sfes), vgf(&vfes);
+         FunctionCoefficient fc(func);
+         VectorFunctionCoefficient vfc(dim, vfunc);
+         sgf.ProjectCoefficient(fc);
+         vgf.ProjectCoefficient(vfc);
+
+         GridFunctionCoefficient sgc(&sgf);
+         CheckProject(sgc, *mesh, ir);
+         for (int c = 1; c <= dim; c++)
+         {
+            GridFunctionCoefficient vgc(&vgf, c);
+            CheckProject(vgc, *mesh, ir);
+         }
+      }
+
+      SECTION("QuadratureFunction, dim = " + std::to_string(dim))
+      {
+         QuadratureSpace qspace(mesh, 3);
+         QuadratureFunction qf(&qspace);
+         FunctionCoefficient fc(func);
+         fc.Project(qf);
+
+         Vector qc_ref;
+         ProjectPointwise(fc, *mesh, qspace.GetElementIntRule(0), qc_ref);
+         qc_ref -= qf;
+         REQUIRE(qc_ref.Normlinf() < 1e-12);
+      }
+
+      delete mesh;
+   }
+}
+
+TEST_CASE("Batched coefficient evaluation on a mixed mesh", "[Coefficient]")
+{
+   // Two triangles and a quadrilateral covering [0,2]x[0,1]
+   Mesh mesh(2, 6, 3, 0, 2);
+   const double vert[6][2] = { {0,0}, {1,0}, {2,0}, {0,1}, {1,1}, {2,1} };
+   for (int i = 0; i < 6; i++) { mesh.AddVertex(vert[i]); }
+   const int quad[4] = { 1, 2, 5, 4 };
+   const int tri1[3] = { 0, 1, 4 };
+   const int tri2[3] = { 0, 4, 3 };
+   mesh.AddTriangle(tri1);
+   mesh.AddTriangle(tri2);
+   mesh.AddQuad(quad);
+   mesh.FinalizeMesh();
+
+   QuadratureSpace qspace(&mesh, 2);
+   QuadratureFunction qf(&qspace);
+   FunctionCoefficient fc(func);
+   fc.Project(qf);
+
+   int offset = 0;
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      const IntegrationRule &ir = qspace.GetElementIntRule(e);
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         T.SetIntPoint(&ir.IntPoint(q));
+         REQUIRE(qf(offset++) == Approx(fc.Eval(T, ir.IntPoint(q))));
+      }
+   }
+   REQUIRE(offset == qf.Size());
+}
+
+} // namespace coefficient
@@ -103,6 +103,54 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
          REQUIRE(rmdir("base_00005") == 0);
       }
 
+#ifdef MFEM_USE_THREADS
+      SECTION("Asynchronous save")
+      {
+         VisItDataCollection dc("base", mesh);
+         dc.RegisterField("u", u);
+         dc.RegisterField("v", v);
+         dc.SetCycle(5);
+         dc.SetTime(8.0);
+         dc.SetPadDigits(5);
+         dc.SetAsyncSave(true, 1);
+         REQUIRE(dc.GetAsyncSave());
+
+         //Save a snapshot, then modify the fields while it is being written
+         Vector u_old(*u), v_old(*v);
+         dc.Save();
+         *u = 0.0;
+         *v = 0.0;
+         dc.WaitSave();
+         REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+         VisItDataCollection dc_new("base");
+         dc_new.SetPadDigits(5);
+         dc_new.Load(dc.GetCycle());
+         Mesh* mesh_new = dc_new.GetMesh();
+         GridFunction *u_new = dc_new.GetField("u");
+         GridFunction *v_new = dc_new.GetField("v");
+         REQUIRE(mesh_new);
+         REQUIRE(u_new);
+         REQUIRE(v_new);
+         REQUIRE(dc.GetTime() == dc_new.GetTime());
+         REQUIRE(mesh->GetNE() == mesh_new->GetNE());
+
+         //The saved fields should match the snapshot, not the modified data
+         Vector u_diff(*u_new), v_diff(*v_new);
+         u_diff -= u_old;
+         v_diff -= v_old;
+         REQUIRE(u_diff.Normlinf() < 1e-10);
+         REQUIRE(v_diff.Normlinf() < 1e-10);
+
+         //Cleanup all the files
+         REQUIRE(remove("base_00005.mfem_root") == 0);
+         REQUIRE(remove("base_00005/mesh.00000") == 0);
+         REQUIRE(remove("base_00005/u.00000") == 0);
+         REQUIRE(remove("base_00005/v.00000") == 0);
+         REQUIRE(rmdir("base_00005") == 0);
+      }
+#endif
+
 #ifdef MFEM_USE_GZSTREAM
       SECTION("Compressed MFEM format")
       {
@@ -111,3 +111,64 @@ TEST_CASE("L2 Hexahedron Finite Element",
       REQUIRE( fe.GetDerivMapType()   == (int) FiniteElement::H_CURL );
    }
 }
+
+TEST_CASE("Tabulated shape functions",
+          "[DofToQuad]"
+          "[ScalarFiniteElement]"
+          "[FiniteElement]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(2, 2, Element::TRIANGLE, true, 1.0, 1.5) :
+                   new Mesh(2, 2, 2, Element::TETRAHEDRON, true, 1.0, 1.5, 2.0);
+      for (int b = 0; b < 2; b++)
+      {
+         const int btype = (b == 0) ? BasisType::GaussLobatto :
+                           BasisType::Positive;
+         H1_FECollection fec(3, dim, btype);
+         FiniteElementSpace fes(mesh, &fec);
+         const FiniteElement &fe = *fes.GetFE(0);
+         const IntegrationRule &ir = IntRules.Get(fe.GetGeomType(), 6);
+         const int nd = fe.GetDof();
+
+         const DofToQuad *tables = fe.GetShapeTables(ir);
+         REQUIRE(tables != NULL);
+         REQUIRE(tables == fe.GetShapeTables(ir));
+         Vector shape(nd), tshape(nd);
+         DenseMatrix dshape(nd, dim), tdshape(nd, dim);
+         for (int i = 0; i < ir.GetNPoints(); i++)
+         {
+            fe.CalcShape(ir.IntPoint(i), shape);
+            tables->GetShape(i, tshape);
+            tshape -= shape;
+            REQUIRE(tshape.Normlinf() == 0.0);
+            fe.CalcDShape(ir.IntPoint(i), dshape);
+            tables->GetDShape(i, tdshape);
+            tdshape -= dshape;
+            REQUIRE(tdshape.MaxMaxNorm() == 0.0);
+         }
+
+         // The integrators use the tables only for the global rules, so a
+         // copy of the rule gives the reference element matrices.
+         IntegrationRule ir_copy(ir);
+         MassIntegrator mass, mass_ref(&ir_copy);
+         DiffusionIntegrator diff, diff_ref;
+         diff_ref.SetIntRule(&ir_copy);
+         DenseMatrix elmat, elmat_ref;
+         for (int e = 0; e < mesh->GetNE(); e++)
+         {
+            ElementTransformation *T = mesh->GetElementTransformation(e);
+            mass.AssembleElementMatrix(fe, *T, elmat);
+            mass_ref.AssembleElementMatrix(fe, *T, elmat_ref);
+            elmat -= elmat_ref;
+            REQUIRE(elmat.MaxMaxNorm() < 1e-14*elmat_ref.MaxMaxNorm());
+            diff.AssembleElementMatrix(fe, *T, elmat);
+            diff_ref.AssembleElementMatrix(fe, *T, elmat_ref);
+            elmat -= elmat_ref;
+            REQUIRE(elmat.MaxMaxNorm() < 1e-14*elmat_ref.MaxMaxNorm());
+         }
+      }
+      delete mesh;
+   }
+}
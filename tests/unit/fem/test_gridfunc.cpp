@@ -0,0 +1,170 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace gridfunc
+{
+
+static double func(const Vector &x)
+{
+   double r = 1.0;
+   for (int d = 0; d < x.Size(); d++) { r *= sin(1.0 + (d + 1)*x(d)); }
+   return r;
+}
+
+static void vfunc(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = cos(x(d)) + x.Size(); }
+}
+
+template <int D>
+static double vfunc_comp(const Vector &x)
+{
+   Vector v(x.Size());
+   vfunc(x, v);
+   return v(D);
+}
+
+static double weight_func(const Vector &x) { return 1.0 + x(0)*x(0); }
+
+static void vweight_func(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = 0.5 + d - x(d); }
+}
+
+// Combine the (element-by-element) errors from ComputeElementLpErrors
+static double GlobalError(double p, const GridFunction &elem_errors)
+{
+   double error = 0.0;
+   for (int i = 0; i < elem_errors.Size(); i++)
+   {
+      if (p < infinity()) { error += pow(elem_errors(i), p); }
+      else { error = std::max(error, elem_errors(i)); }
+   }
+   return (p < infinity()) ? pow(error, 1.0/p) : error;
+}
+
+TEST_CASE("GridFunction batched Lp errors", "[GridFunction]")
+{
+   const double ps[3] = { 1.0, 2.0, infinity() };
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int t = 0; t < 3; t++)
+      {
+         Element::Type type = (t == 0) ?
+                              (dim == 2 ? Element::QUADRILATERAL :
+                               Element::HEXAHEDRON) :
+                              (dim == 2 ? Element::TRIANGLE :
+                               Element::TETRAHEDRON);
+         Mesh *mesh_ptr = (dim == 2) ?
+                          new Mesh(3, 2, type, true, 1.0, 1.5) :
+                          new Mesh(2, 2, 3, type, true, 1.0, 1.5, 2.0);
+         Mesh &mesh = *mesh_ptr;
+         // t == 2: curved mesh, otherwise a mesh without nodes
+         if (t == 2)
+         {
+            mesh.SetCurvature(2);
+            GridFunction &nodes = *mesh.GetNodes();
+            for (int i = 0; i < nodes.Size(); i++)
+            {
+               nodes(i) += 0.02*sin(5.0*i);
+            }
+         }
+         L2_FECollection err_fec(0, dim);
+         FiniteElementSpace err_fes(&mesh, &err_fec);
+         GridFunction elem_errors(&err_fes);
+
+         FunctionCoefficient exsol(func);
+         FunctionCoefficient weight(weight_func);
+         VectorFunctionCoefficient vexsol(dim, vfunc);
+         VectorFunctionCoefficient vweight(dim, vweight_func);
+
+         for (int order = 1; order <= 3; order++)
+         {
+            H1_FECollection fec(order, dim);
+            FiniteElementSpace fes(&mesh, &fec);
+            FiniteElementSpace vfes(&mesh, &fec, dim);
+            GridFunction u(&fes), v(&vfes);
+            u.Randomize(1);
+            v.Randomize(2);
+
+            for (int i = 0; i < 3; i++)
+            {
+               const double p = ps[i];
+               u.ComputeElementLpErrors(p, exsol, elem_errors, &weight);
+               const double ref = GlobalError(p, elem_errors);
+               const double err = u.ComputeLpError(p, exsol, &weight);
+               REQUIRE(std::abs(err - ref) < 1e-12*ref);
+
+               v.ComputeElementLpErrors(p, vexsol, elem_errors);
+               const double vref = GlobalError(p, elem_errors);
+               const double verr = v.ComputeLpError(p, vexsol);
+               REQUIRE(std::abs(verr - vref) < 1e-12*vref);
+
+               v.ComputeElementLpErrors(p, vexsol, elem_errors, NULL,
+                                        &vweight);
+               const double vwref = GlobalError(p, elem_errors);
+               const double vwerr = v.ComputeLpError(p, vexsol, NULL,
+                                                     &vweight);
+               REQUIRE(std::abs(vwerr - vwref) < 1e-12*vwref);
+            }
+
+            // Component-wise exact solution
+            v.ComputeElementLpErrors(2.0, vexsol, elem_errors);
+            const double ref = GlobalError(2.0, elem_errors);
+            FunctionCoefficient c0(vfunc_comp<0>), c1(vfunc_comp<1>),
+                                c2(vfunc_comp<2>);
+            Coefficient *coeffs[3] = { &c0, &c1, &c2 };
+            REQUIRE(std::abs(v.ComputeL2Error(coeffs) - ref) < 1e-12*ref);
+            REQUIRE(std::abs(v.ComputeL2Error(vexsol) - ref) < 1e-12*ref);
+         }
+         // The error computation should not add nodes to the mesh
+         REQUIRE((t == 2 || mesh.GetNodes() == NULL));
+         delete mesh_ptr;
+      }
+   }
+}
+
+static double moved_func(const Vector &x) { return x(0)*x(0) + x(1); }
+
+TEST_CASE("GridFunction Lp errors on a moved mesh", "[GridFunction]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+   mesh.SetCurvature(1);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   GridFunction u(&fes);
+   u = 0.0;
+   FunctionCoefficient exsol(moved_func);
+
+   // Compute the error once, so the quadrature data is set up on the mesh
+   // before it moves
+   u.ComputeL2Error(exsol);
+
+   Vector displacement(mesh.GetNodes()->Size());
+   displacement = 0.5;
+   mesh.MoveNodes(displacement);
+
+   L2_FECollection err_fec(0, 2);
+   FiniteElementSpace err_fes(&mesh, &err_fec);
+   GridFunction elem_errors(&err_fes);
+   u.ComputeElementLpErrors(2.0, exsol, elem_errors);
+   const double ref = GlobalError(2.0, elem_errors);
+   const double err = u.ComputeL2Error(exsol);
+   REQUIRE(std::abs(err - ref) < 1e-12*ref);
+   REQUIRE(std::abs(err - 2.18232) < 1e-5);
+}
+
+} // namespace gridfunc
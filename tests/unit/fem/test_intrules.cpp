@@ -14,6 +14,11 @@ using namespace mfem;
 
 #include "catch.hpp"
 
+#ifdef MFEM_USE_THREADS
+#include <thread>
+#include <vector>
+#endif
+
 //You typically want to start by testing things one object at a time.
 TEST_CASE("Integration rule container with no refinement", "[IntegrationRules]")
 {
@@ -94,6 +99,42 @@ TEST_CASE("Integration rule container with no refinement", "[IntegrationRules]")
       }
       REQUIRE(true);
    }
+
+   SECTION("pregenerated int rules are complete")
+   {
+      my_intrules.Pregenerate(Geometry::SQUARE, 12);
+      for (int order = 0; order <= 12; order++)
+      {
+         ir = &my_intrules.Get(Geometry::SQUARE, order);
+         REQUIRE(ir->GetOrder() >= order);
+         // The weights are created before the rule is shared
+         REQUIRE(ir->GetWeights().Size() == ir->GetNPoints());
+         REQUIRE(ir == &my_intrules.Get(Geometry::SQUARE, order));
+      }
+   }
+
+   SECTION("prism int rules generate their triangle and segment rules")
+   {
+      // The prism rules are built from triangle and segment rules, which are
+      // generated while the container is locked
+      ir = &my_intrules.Get(Geometry::PRISM, 5);
+      REQUIRE(ir->GetNPoints() ==
+              my_intrules.Get(Geometry::TRIANGLE, 5).GetNPoints()*
+              my_intrules.Get(Geometry::SEGMENT, 5).GetNPoints());
+      double vol = 0.0;
+      for (int i = 0; i < ir->GetNPoints(); i++)
+      {
+         vol += ir->IntPoint(i).weight;
+      }
+      REQUIRE(std::abs(vol - 0.5) < 1e-14);
+
+      my_intrules.Pregenerate(Geometry::PRISM, 8);
+      for (int order = 0; order <= 8; order++)
+      {
+         ir = &my_intrules.Get(Geometry::PRISM, order);
+         REQUIRE(ir->GetWeights().Size() == ir->GetNPoints());
+      }
+   }
 }
 
 
@@ -199,3 +240,102 @@ TEST_CASE("Simplex integration rules", "[SimplexRules]")
       }
    }
 }
+
+#ifdef MFEM_USE_THREADS
+TEST_CASE("Concurrent integration rules and shape functions",
+          "[IntegrationRules][Threads]")
+{
+   // Several threads request the same rules, DofToQuad maps and Bernstein
+   // shape functions (which fill the binomial table) at the same time
+   const int num_threads = 8, max_order = 16;
+   const int geoms[] = { Geometry::SEGMENT, Geometry::TRIANGLE,
+                         Geometry::SQUARE, Geometry::TETRAHEDRON,
+                         Geometry::CUBE, Geometry::PRISM
+                       };
+   IntegrationRules my_intrules(0, Quadrature1D::GaussLegendre);
+   H1_HexahedronElement hex(3);
+   H1Pos_TetrahedronElement tet(3);
+
+   std::vector<const IntegrationRule *> irs(num_threads*6*(max_order+1));
+   std::vector<const DofToQuad *> maps(2*num_threads*(max_order+1));
+   std::vector<double> sums(num_threads*(Poly_1D::MaxBinomOrder+1));
+
+   auto work = [&](int t)
+   {
+      for (int order = 0; order <= max_order; order++)
+      {
+         // Start at a different geometry in each thread
+         for (int g = 0; g < 6; g++)
+         {
+            const int geom = geoms[(g + t) % 6];
+            irs[(t*6 + (g + t) % 6)*(max_order+1) + order] =
+               &my_intrules.Get(geom, order);
+            IntRules.Get(geom, order);
+         }
+         const IntegrationRule &hex_ir = my_intrules.Get(Geometry::CUBE, order);
+         const IntegrationRule &tet_ir =
+            my_intrules.Get(Geometry::TETRAHEDRON, order);
+         maps[2*(t*(max_order+1) + order)] =
+            &hex.GetDofToQuad(hex_ir, DofToQuad::TENSOR);
+         maps[2*(t*(max_order+1) + order) + 1] =
+            &tet.GetDofToQuad(tet_ir, DofToQuad::FULL);
+      }
+      // The Bernstein basis is a partition of unity
+      Vector shape;
+      for (int p = Poly_1D::MaxBinomOrder; p >= 0; p--)
+      {
+         shape.SetSize((p + 1)*(p + 2)/2);
+         H1Pos_TriangleElement::CalcShape(p, 0.2, 0.3, shape.GetData());
+         sums[t*(Poly_1D::MaxBinomOrder+1) + p] = shape.Sum();
+      }
+   };
+
+   std::vector<std::thread> threads;
+   for (int t = 0; t < num_threads; t++)
+   {
+      threads.push_back(std::thread(work, t));
+   }
+   for (int t = 0; t < num_threads; t++) { threads[t].join(); }
+
+   // All threads got the same objects, and the same ones as in serial
+   for (int t = 0; t < num_threads; t++)
+   {
+      for (int g = 0; g < 6; g++)
+      {
+         for (int order = 0; order <= max_order; order++)
+         {
+            const IntegrationRule *ir = irs[(t*6 + g)*(max_order+1) + order];
+            REQUIRE(ir == &my_intrules.Get(geoms[g], order));
+            REQUIRE(ir->GetOrder() >= order);
+         }
+      }
+      for (int order = 0; order <= max_order; order++)
+      {
+         const IntegrationRule &hex_ir = my_intrules.Get(Geometry::CUBE, order);
+         const IntegrationRule &tet_ir =
+            my_intrules.Get(Geometry::TETRAHEDRON, order);
+         const DofToQuad *hex_map = maps[2*(t*(max_order+1) + order)];
+         const DofToQuad *tet_map = maps[2*(t*(max_order+1) + order) + 1];
+         REQUIRE(hex_map == &hex.GetDofToQuad(hex_ir, DofToQuad::TENSOR));
+         REQUIRE(tet_map == &tet.GetDofToQuad(tet_ir, DofToQuad::FULL));
+         REQUIRE(tet_map->B.Size() == tet.GetDof()*tet_ir.GetNPoints());
+      }
+      for (int p = 0; p <= Poly_1D::MaxBinomOrder; p++)
+      {
+         REQUIRE(std::abs(sums[t*(Poly_1D::MaxBinomOrder+1) + p] - 1.0) <
+                 1e-12);
+      }
+   }
+
+   // The maps computed concurrently have the right values
+   H1Pos_TetrahedronElement tet2(3);
+   const IntegrationRule &tet_ir =
+      my_intrules.Get(Geometry::TETRAHEDRON, max_order);
+   const DofToQuad &map = tet.GetDofToQuad(tet_ir, DofToQuad::FULL);
+   const DofToQuad &map2 = tet2.GetDofToQuad(tet_ir, DofToQuad::FULL);
+   for (int i = 0; i < map.B.Size(); i++)
+   {
+      REQUIRE(map.B[i] == map2.B[i]);
+   }
+}
+#endif // MFEM_USE_THREADS
@@ -0,0 +1,127 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace linearform
+{
+
+static double func(const Vector &x)
+{
+   double r = 1.0;
+   for (int d = 0; d < x.Size(); d++) { r *= sin(1.0 + (d + 1)*x(d)); }
+   return r;
+}
+
+static void vfunc(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = cos(x(d)) + d; }
+}
+
+// Assemble @a lf with and without fast assembly and return the difference
+static double FastAssemblyError(LinearForm &lf)
+{
+   lf.UseFastAssembly(false);
+   lf.Assemble();
+   Vector ref(lf);
+   lf.UseFastAssembly(true);
+   REQUIRE(lf.SupportsDevice());
+   lf.Assemble();
+   ref -= lf;
+   return ref.Normlinf();
+}
+
+TEST_CASE("LinearForm fast assembly", "[LinearForm]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int t = 0; t < 3; t++)
+      {
+         Element::Type type = (t == 1) ?
+                              (dim == 2 ? Element::TRIANGLE :
+                               Element::TETRAHEDRON) :
+                              (dim == 2 ? Element::QUADRILATERAL :
+                               Element::HEXAHEDRON);
+         Mesh *mesh = (dim == 2) ?
+                      new Mesh(3, 2, type, true, 1.0, 1.5) :
+                      new Mesh(2, 2, 3, type, true, 1.0, 1.5, 2.0);
+         // t == 2: curved mesh, otherwise a mesh without nodes
+         if (t == 2)
+         {
+            mesh->SetCurvature(2);
+            GridFunction &nodes = *mesh->GetNodes();
+            for (int i = 0; i < nodes.Size(); i++)
+            {
+               nodes(i) += 0.02*sin(5.0*i);
+            }
+         }
+         FunctionCoefficient coeff(func);
+         VectorFunctionCoefficient vcoeff(dim, vfunc);
+
+         for (int order = 1; order <= 3; order++)
+         {
+            H1_FECollection h1_fec(order, dim);
+            L2_FECollection l2_fec(order, dim);
+            FiniteElementCollection *fecs[2] = { &h1_fec, &l2_fec };
+            for (int f = 0; f < 2; f++)
+            {
+               FiniteElementSpace fes(mesh, fecs[f]);
+               LinearForm b(&fes);
+               b.AddDomainIntegrator(new DomainLFIntegrator(coeff));
+               // A GridFunction coefficient, and a second integrator
+               GridFunction u(&fes);
+               u.ProjectCoefficient(coeff);
+               GridFunctionCoefficient u_coeff(&u);
+               b.AddDomainIntegrator(new DomainLFIntegrator(u_coeff, 1, 1));
+               REQUIRE(FastAssemblyError(b) < 1e-13);
+
+               for (int ordering = 0; ordering < 2; ordering++)
+               {
+                  FiniteElementSpace vfes(mesh, fecs[f], dim, ordering);
+                  LinearForm vb(&vfes);
+                  vb.AddDomainIntegrator(new VectorDomainLFIntegrator(vcoeff));
+                  REQUIRE(FastAssemblyError(vb) < 1e-13);
+               }
+            }
+         }
+         // Fast assembly should not add nodes to the mesh
+         REQUIRE((t == 2 || mesh->GetNodes() == NULL));
+         delete mesh;
+      }
+   }
+}
+
+TEST_CASE("LinearForm fast assembly on a moved mesh", "[LinearForm]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+   mesh.SetCurvature(2);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient coeff(func);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(coeff));
+   b.UseFastAssembly(true);
+   b.Assemble();
+
+   // Assemble again after moving the nodes, compare with legacy assembly
+   Vector displacement(mesh.GetNodes()->Size());
+   for (int i = 0; i < displacement.Size(); i++)
+   {
+      displacement(i) = 0.5 + 0.02*sin(5.0*i);
+   }
+   mesh.MoveNodes(displacement);
+   REQUIRE(FastAssemblyError(b) < 1e-13);
+}
+
+} // namespace linearform
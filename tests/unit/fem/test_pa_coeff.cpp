@@ -144,4 +144,103 @@ TEST_CASE("pa_coeff")
    }
 }
 
+void matrixCoeffFunction(const Vector& x, DenseMatrix& K)
+{
+   // symmetric positive definite, spatially varying permeability tensor
+   K.SetSize(dimension);
+   for (int i = 0; i < dimension; i++)
+   {
+      for (int j = 0; j < dimension; j++)
+      {
+         K(i,j) = (i == j) ? 2.0 + x[i]*x[i] : 0.25*sin(M_PI*(x[i] + x[j]));
+      }
+   }
+}
+
+void nonsymMatrixCoeffFunction(const Vector& x, DenseMatrix& K)
+{
+   matrixCoeffFunction(x, K);
+   K(0,1) += 0.5*x[0];
+}
+
+void vectorCoeffFunction(const Vector& x, Vector& v)
+{
+   v.SetSize(dimension);
+   for (int i = 0; i < dimension; i++) { v[i] = coeffFunction(x) + i; }
+}
+
+// Compare partial and full assembly for the given integrators
+static double pa_error(FiniteElementSpace &fes, BilinearFormIntegrator *pa_integ,
+                       BilinearFormIntegrator *fa_integ)
+{
+   BilinearForm paform(&fes);
+   paform.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   paform.AddDomainIntegrator(pa_integ);
+   paform.Assemble();
+
+   BilinearForm faform(&fes);
+   faform.AddDomainIntegrator(fa_integ);
+   faform.Assemble();
+   faform.Finalize();
+
+   Vector xin(fes.GetVSize()), y_pa(fes.GetVSize()), y_fa(fes.GetVSize());
+   xin.Randomize(1);
+   paform.Mult(xin, y_pa);
+   faform.Mult(xin, y_fa);
+   y_pa -= y_fa;
+   return y_pa.Norml2() / y_fa.Norml2();
+}
+
+TEST_CASE("pa_matrix_coeff")
+{
+   for (dimension = 2; dimension < 4; ++dimension)
+   {
+      const int ne = 2;
+      for (int order = 1; order < 4; ++order)
+      {
+         Mesh* mesh;
+         if (dimension == 2)
+         {
+            mesh = new Mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+         }
+         else
+         {
+            mesh = new Mesh(ne, ne, ne, Element::HEXAHEDRON, 1, 1.0, 1.0,
+                            1.0);
+         }
+         // Use a curved mesh, so that the Jacobians are not diagonal
+         mesh->SetCurvature(2);
+         GridFunction &nodes = *mesh->GetNodes();
+         for (int i = 0; i < nodes.Size(); i++)
+         {
+            nodes(i) += 0.03*sin(7.0*i);
+         }
+
+         H1_FECollection fec(order, dimension);
+         FiniteElementSpace fes(mesh, &fec);
+         FiniteElementSpace vfes(mesh, &fec, dimension);
+
+         MatrixFunctionCoefficient mcoeff(dimension, &matrixCoeffFunction);
+         VectorFunctionCoefficient vcoeff(dimension, &vectorCoeffFunction);
+         FunctionCoefficient coeff(&coeffFunction);
+
+         REQUIRE(pa_error(fes, new DiffusionIntegrator(mcoeff),
+                          new DiffusionIntegrator(mcoeff)) < 1.e-12);
+         REQUIRE(pa_error(vfes, new VectorMassIntegrator(coeff),
+                          new VectorMassIntegrator(coeff)) < 1.e-12);
+         REQUIRE(pa_error(vfes, new VectorMassIntegrator(vcoeff),
+                          new VectorMassIntegrator(vcoeff)) < 1.e-12);
+         REQUIRE(pa_error(vfes, new VectorMassIntegrator(mcoeff),
+                          new VectorMassIntegrator(mcoeff)) < 1.e-12);
+
+         // The vector mass kernels also support non-symmetric matrices
+         MatrixFunctionCoefficient nscoeff(dimension, &nonsymMatrixCoeffFunction);
+         REQUIRE(pa_error(vfes, new VectorMassIntegrator(nscoeff),
+                          new VectorMassIntegrator(nscoeff)) < 1.e-12);
+
+         delete mesh;
+      }
+   }
+}
+
 } // namespace pa_coeff
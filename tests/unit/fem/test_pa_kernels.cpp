@@ -288,6 +288,143 @@ TEST_CASE("Nonlinear Convection", "[PartialAssembly], [NonlinearPA]")
    }
 }
 
+// Compare the partially assembled gradient of the nonlinear convection form,
+// its diagonal and the Jacobi smoother built from it, with the assembled ones.
+// A non-default integration rule order 'ir_order' selects the generic kernels.
+void test_nl_convection_grad_nd(int dim, int order, int ir_order,
+                                double &grad_diff, double &diag_diff,
+                                double &jacobi_diff)
+{
+   Mesh *mesh;
+
+   if (dim == 2)
+   {
+      mesh = new Mesh(2, 2, Element::QUADRILATERAL, 0, 1.0, 1.0);
+   }
+   if (dim == 3)
+   {
+      mesh = new Mesh(2, 2, 2, Element::HEXAHEDRON, 0, 1.0, 1.0, 1.0);
+   }
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim);
+
+   Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   GridFunction x(&fes), d(&fes), y_fa(&fes), y_pa(&fes);
+   x.Randomize(3);
+   d.Randomize(5);
+
+   const IntegrationRule *ir = NULL;
+   if (ir_order >= 0)
+   {
+      ir = &IntRules.Get(fes.GetFE(0)->GetGeomType(), ir_order);
+   }
+
+   NonlinearForm nlf_fa(&fes);
+   nlf_fa.AddDomainIntegrator(new VectorConvectionNLFIntegrator);
+   if (ir) { (*nlf_fa.GetDNFI())[0]->SetIntRule(ir); }
+   nlf_fa.SetEssentialTrueDofs(ess_tdof_list);
+   SparseMatrix &grad_fa = dynamic_cast<SparseMatrix &>(nlf_fa.GetGradient(x));
+   grad_fa.Mult(d, y_fa);
+
+   NonlinearForm nlf_pa(&fes);
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf_pa.AddDomainIntegrator(new VectorConvectionNLFIntegrator);
+   if (ir) { (*nlf_pa.GetDNFI())[0]->SetIntRule(ir); }
+   nlf_pa.SetEssentialTrueDofs(ess_tdof_list);
+   nlf_pa.Setup();
+   Operator &grad_pa = nlf_pa.GetGradient(x);
+   grad_pa.Mult(d, y_pa);
+
+   y_fa -= y_pa;
+   grad_diff = y_fa.Norml2();
+
+   Vector diag_fa, diag_pa(fes.GetTrueVSize());
+   grad_fa.GetDiag(diag_fa);
+   grad_pa.AssembleDiagonal(diag_pa);
+   diag_fa -= diag_pa;
+   diag_diff = diag_fa.Norml2();
+
+   OperatorJacobiSmoother jacobi_fa, jacobi_pa;
+   jacobi_fa.SetOperator(grad_fa);
+   jacobi_pa.SetOperator(grad_pa);
+   jacobi_fa.Mult(d, y_fa);
+   jacobi_pa.Mult(d, y_pa);
+   // Relative, since the random state may give small diagonal entries
+   y_fa -= y_pa;
+   jacobi_diff = y_fa.Norml2() / y_pa.Norml2();
+
+   delete mesh;
+}
+
+TEST_CASE("Nonlinear Convection Gradient", "[PartialAssembly], [NonlinearPA]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      // The default rules use the specialized 3D kernels for orders 1 to 4,
+      // the rules with Q1D = D1D + 3 use the generic ones
+      for (int order = 1; order <= 4; order++)
+      {
+         for (int generic = 0; generic <= 1; generic++)
+         {
+            const int ir_order = generic ? 2*order + 7 : -1;
+            double grad_diff, diag_diff, jacobi_diff;
+            test_nl_convection_grad_nd(dim, order, ir_order,
+                                       grad_diff, diag_diff, jacobi_diff);
+            REQUIRE(grad_diff == Approx(0.0));
+            REQUIRE(diag_diff == Approx(0.0));
+            REQUIRE(jacobi_diff == Approx(0.0));
+         }
+      }
+   }
+}
+
+TEST_CASE("Nonlinear PA Gradient Reuse", "[PartialAssembly], [NonlinearPA]")
+{
+   Mesh mesh(2, 2, 2, Element::HEXAHEDRON, 0, 1.0, 1.0, 1.0);
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fes(&mesh, &fec, 3);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   GridFunction x(&fes), d(&fes), y_fa(&fes), y_pa(&fes);
+   x.Randomize(3);
+   d.Randomize(5);
+
+   NonlinearForm nlf_fa(&fes), nlf_pa(&fes);
+   nlf_fa.AddDomainIntegrator(new VectorConvectionNLFIntegrator);
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf_pa.AddDomainIntegrator(new VectorConvectionNLFIntegrator);
+   nlf_pa.Setup();
+
+   // Without essential b.c., then with them, then for a new state
+   Operator *grad_pa = &nlf_pa.GetGradient(x);
+   for (int i = 0; i < 3; i++)
+   {
+      if (i == 1)
+      {
+         nlf_fa.SetEssentialTrueDofs(ess_tdof_list);
+         nlf_pa.SetEssentialTrueDofs(ess_tdof_list);
+      }
+      if (i == 2) { x.Randomize(7); }
+
+      // The gradient is updated in place until the essential dofs change
+      Operator &grad = nlf_pa.GetGradient(x);
+      if (i != 1) { REQUIRE(&grad == grad_pa); }
+      grad_pa = &grad;
+
+      nlf_fa.GetGradient(x).Mult(d, y_fa);
+      grad_pa->Mult(d, y_pa);
+      y_fa -= y_pa;
+      REQUIRE(y_fa.Norml2() == Approx(0.0));
+   }
+}
+
 template <typename INTEGRATOR>
 double test_vector_pa_integrator(int dim)
 {
@@ -353,4 +490,56 @@ TEST_CASE("PA Vector Diffusion", "[PartialAssembly], [VectorPA]")
    }
 }
 
+TEST_CASE("PA Simplex Mass and Diffusion", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 2, Element::TRIANGLE, true, 1.0, 1.5) :
+                   new Mesh(2, 2, 1, Element::TETRAHEDRON, true, 1.0, 1.5, 0.5);
+      for (int b = 0; b < 2; b++)
+      {
+         const int btype = (b == 0) ? BasisType::GaussLobatto :
+                           BasisType::Positive;
+         for (int order = 1; order <= 6; order++)
+         {
+            H1_FECollection fec(order, dim, btype);
+            FiniteElementSpace fes(mesh, &fec);
+            GridFunction x(&fes), y_fa(&fes), y_pa(&fes);
+            Vector diag_pa(fes.GetVSize()), diag_fa;
+            x.Randomize(1);
+            ConstantCoefficient coeff(2.5);
+            for (int i = 0; i < 2; i++)
+            {
+               BilinearForm blf_fa(&fes), blf_pa(&fes);
+               blf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+               if (i == 0)
+               {
+                  blf_fa.AddDomainIntegrator(new MassIntegrator(coeff));
+                  blf_pa.AddDomainIntegrator(new MassIntegrator(coeff));
+               }
+               else
+               {
+                  blf_fa.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+                  blf_pa.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+               }
+               blf_fa.Assemble();
+               blf_fa.Finalize();
+               blf_pa.Assemble();
+               blf_fa.Mult(x, y_fa);
+               blf_pa.Mult(x, y_pa);
+               y_pa -= y_fa;
+               REQUIRE(y_pa.Normlinf() < 1e-12*y_fa.Normlinf());
+
+               blf_fa.SpMat().GetDiag(diag_fa);
+               blf_pa.AssembleDiagonal(diag_pa);
+               diag_pa -= diag_fa;
+               REQUIRE(diag_pa.Normlinf() < 1e-12*diag_fa.Normlinf());
+            }
+         }
+      }
+      delete mesh;
+   }
+}
+
 }// namespace pa_kernels
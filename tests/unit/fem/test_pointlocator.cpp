@@ -0,0 +1,170 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pointlocator
+{
+
+static double func(const Vector &x)
+{
+   double r = 1.0;
+   for (int d = 0; d < x.Size(); d++) { r *= cos(1.0 + (d + 1)*x(d)); }
+   return r;
+}
+
+static void vfunc(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = sin(x(d)) + d; }
+}
+
+TEST_CASE("PointLocator", "[PointLocator]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int t = 0; t < 3; t++)
+      {
+         Element::Type type = (t == 1) ?
+                              (dim == 2 ? Element::TRIANGLE :
+                               Element::TETRAHEDRON) :
+                              (dim == 2 ? Element::QUADRILATERAL :
+                               Element::HEXAHEDRON);
+         Mesh *mesh = (dim == 2) ?
+                      new Mesh(4, 3, type, true, 1.0, 1.5) :
+                      new Mesh(3, 2, 3, type, true, 1.0, 1.5, 2.0);
+         // t == 2: curved mesh, otherwise a mesh without nodes
+         if (t == 2)
+         {
+            mesh->SetCurvature(3);
+            GridFunction &nodes = *mesh->GetNodes();
+            for (int i = 0; i < nodes.Size(); i++)
+            {
+               nodes(i) += 0.02*sin(5.0*i);
+            }
+         }
+         const int ne = mesh->GetNE();
+
+         // Map random reference points to physical points, and add a few
+         // points outside of the mesh.
+         const int npts_in = 5*ne, npts = npts_in + 3;
+         DenseMatrix point_mat(dim, npts);
+         Vector x;
+         srand(1234);
+         for (int k = 0; k < npts_in; k++)
+         {
+            const int e = k % ne;
+            IntegrationPoint ip;
+            double xi[3];
+            for (int d = 0; d < 3; d++) { xi[d] = rand()/(double)RAND_MAX; }
+            if (type == Element::TRIANGLE || type == Element::TETRAHEDRON)
+            {
+               // Fold the point into the reference simplex
+               double s = 0.0;
+               for (int d = 0; d < dim; d++) { s += xi[d]; }
+               for (int d = 0; s > 1.0 && d < dim; d++) { xi[d] *= 0.99/s; }
+            }
+            ip.Set(xi, dim);
+            ElementTransformation *T = mesh->GetElementTransformation(e);
+            point_mat.GetColumnReference(k, x);
+            T->Transform(ip, x);
+         }
+         for (int k = npts_in; k < npts; k++)
+         {
+            for (int d = 0; d < dim; d++)
+            {
+               point_mat(d,k) = (d == (k - npts_in) % dim) ?
+                                (k % 2 ? 5.0 : -5.0) : 0.5;
+            }
+         }
+
+         PointLocator locator(*mesh);
+         Array<int> elem_ids;
+         Array<IntegrationPoint> ips;
+         REQUIRE(locator.FindPoints(point_mat, elem_ids, ips) == npts_in);
+         Vector y(dim);
+         for (int k = 0; k < npts; k++)
+         {
+            if (k >= npts_in)
+            {
+               REQUIRE(elem_ids[k] == -1);
+               continue;
+            }
+            REQUIRE(elem_ids[k] >= 0);
+            // The found point is mapped to the physical point
+            ElementTransformation *T =
+               mesh->GetElementTransformation(elem_ids[k]);
+            T->Transform(ips[k], y);
+            point_mat.GetColumnReference(k, x);
+            y -= x;
+            REQUIRE(y.Normlinf() < 1e-10);
+         }
+
+         // Compare the batched evaluation with GridFunction::GetVectorValue
+         H1_FECollection h1_fec(2, dim);
+         RT_FECollection rt_fec(1, dim);
+         FiniteElementSpace h1_fes(mesh, &h1_fec, dim);
+         FiniteElementSpace rt_fes(mesh, &rt_fec);
+         GridFunction u(&h1_fes), w(&rt_fes);
+         VectorFunctionCoefficient vcoeff(dim, vfunc);
+         u.ProjectCoefficient(vcoeff);
+         w.ProjectCoefficient(vcoeff);
+         GridFunction *gfs[2] = { &u, &w };
+         DenseMatrix vals;
+         Vector val;
+         for (int g = 0; g < 2; g++)
+         {
+            locator.Interpolate(*gfs[g], elem_ids, ips, vals);
+            REQUIRE(vals.Height() == dim);
+            REQUIRE(vals.Width() == npts);
+            for (int k = 0; k < npts; k++)
+            {
+               if (elem_ids[k] < 0)
+               {
+                  for (int d = 0; d < dim; d++) { REQUIRE(vals(d,k) == 0.0); }
+                  continue;
+               }
+               gfs[g]->GetVectorValue(elem_ids[k], ips[k], val);
+               for (int d = 0; d < dim; d++)
+               {
+                  REQUIRE(std::abs(vals(d,k) - val(d)) < 1e-12);
+               }
+            }
+         }
+
+         // Scalar function, after moving the mesh
+         if (t == 2)
+         {
+            GridFunction &nodes = *mesh->GetNodes();
+            nodes *= 2.0;
+            point_mat *= 2.0;
+            locator.Update();
+            REQUIRE(locator.FindPoints(point_mat, elem_ids, ips) == npts_in);
+         }
+         H1_FECollection fec(3, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         GridFunction s(&fes);
+         FunctionCoefficient coeff(func);
+         s.ProjectCoefficient(coeff);
+         locator.Interpolate(s, elem_ids, ips, vals);
+         for (int k = 0; k < npts_in; k++)
+         {
+            REQUIRE(std::abs(vals(0,k) - s.GetValue(elem_ids[k], ips[k]))
+                    < 1e-12);
+         }
+         delete mesh;
+      }
+   }
+}
+
+} // namespace pointlocator
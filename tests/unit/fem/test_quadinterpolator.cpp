@@ -0,0 +1,214 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace quadinterpolator
+{
+
+static Mesh *MakeMesh(int dim, Element::Type type)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 2, type, true, 1.0, 1.5) :
+                new Mesh(2, 2, 3, type, true, 1.0, 1.5, 2.0);
+   // Use a curved mesh, so that the derivatives are not trivial
+   mesh->SetCurvature(2);
+   GridFunction &nodes = *mesh->GetNodes();
+   for (int i = 0; i < nodes.Size(); i++) { nodes(i) += 0.02*sin(5.0*i); }
+   return mesh;
+}
+
+// Check the adjoint identity (Q x, y) = (x, Q^T y) for the given flags
+static double AdjointError(const QuadratureInterpolator &qi, int ne, int nd,
+                           int nq, int vdim, int dim, unsigned flags)
+{
+   Vector x(nd*vdim*ne), x_t(nd*vdim*ne);
+   Vector q_val(nq*vdim*ne), q_der(nq*vdim*dim*ne), q_det;
+   Vector y_val(q_val.Size()), y_der(q_der.Size());
+   x.Randomize(1);
+   y_val.Randomize(2);
+   y_der.Randomize(3);
+   q_val = 0.0;
+   q_der = 0.0;
+
+   qi.Mult(x, flags, q_val, q_der, q_det);
+   qi.MultTranspose(flags, y_val, y_der, x_t);
+
+   double lhs = 0.0;
+   if (flags & QuadratureInterpolator::VALUES) { lhs += q_val * y_val; }
+   if (flags & QuadratureInterpolator::DERIVATIVES) { lhs += q_der * y_der; }
+   const double rhs = x * x_t;
+   return std::abs(lhs - rhs) / std::abs(rhs);
+}
+
+TEST_CASE("QuadratureInterpolator MultTranspose",
+          "[QuadratureInterpolator]")
+{
+   const unsigned VALUES = QuadratureInterpolator::VALUES;
+   const unsigned DERIVATIVES = QuadratureInterpolator::DERIVATIVES;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Element::Type types[2] =
+      {
+         (dim == 2) ? Element::QUADRILATERAL : Element::HEXAHEDRON,
+         (dim == 2) ? Element::TRIANGLE : Element::TETRAHEDRON
+      };
+      for (int t = 0; t < 2; t++)
+      {
+         Mesh *mesh = MakeMesh(dim, types[t]);
+         for (int order = 1; order <= 3; order++)
+         {
+            H1_FECollection fec(order, dim);
+            for (int vdim = 1; vdim <= dim; vdim += dim-1)
+            {
+               FiniteElementSpace fes(mesh, &fec, vdim);
+               const FiniteElement &fe = *fes.GetFE(0);
+               const IntegrationRule &ir =
+                  IntRules.Get(fe.GetGeomType(), 2*order + 1);
+               const QuadratureInterpolator &qi =
+                  *fes.GetQuadratureInterpolator(ir);
+               const int ne = mesh->GetNE();
+               const int nd = fe.GetDof();
+               const int nq = ir.GetNPoints();
+               for (int tensor = 0; tensor < 2; tensor++)
+               {
+                  qi.DisableTensorProducts(tensor == 0);
+                  REQUIRE(AdjointError(qi, ne, nd, nq, vdim, dim, VALUES)
+                          < 1e-12);
+                  REQUIRE(AdjointError(qi, ne, nd, nq, vdim, dim, DERIVATIVES)
+                          < 1e-12);
+                  REQUIRE(AdjointError(qi, ne, nd, nq, vdim, dim,
+                                       VALUES | DERIVATIVES) < 1e-12);
+               }
+               qi.DisableTensorProducts(false);
+            }
+         }
+         delete mesh;
+      }
+   }
+}
+
+TEST_CASE("QuadratureInterpolator tensor Mult",
+          "[QuadratureInterpolator]")
+{
+   // Compare the sum-factorized evaluation with the full evaluation
+   const unsigned flags = QuadratureInterpolator::VALUES |
+                          QuadratureInterpolator::DERIVATIVES |
+                          QuadratureInterpolator::DETERMINANTS;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = MakeMesh(dim, (dim == 2) ? Element::QUADRILATERAL :
+                            Element::HEXAHEDRON);
+      for (int order = 1; order <= 4; order++)
+      {
+         H1_FECollection h1_fec(order, dim);
+         L2_FECollection l2_fec(order, dim);
+         FiniteElementCollection *fecs[2] = { &h1_fec, &l2_fec };
+         for (int f = 0; f < 2; f++)
+         {
+            FiniteElementSpace fes(mesh, fecs[f], dim);
+            const FiniteElement &fe = *fes.GetFE(0);
+            for (int q_order = 2*order - 1; q_order <= 2*order + 1;
+                 q_order += 2)
+            {
+               const IntegrationRule &ir =
+                  IntRules.Get(fe.GetGeomType(), q_order);
+               const QuadratureInterpolator &qi =
+                  *fes.GetQuadratureInterpolator(ir);
+               const int ne = mesh->GetNE();
+               const int nd = fe.GetDof();
+               const int nq = ir.GetNPoints();
+
+               Vector x(nd*dim*ne);
+               x.Randomize(1);
+               Vector val[2], der[2], det[2];
+               for (int tensor = 0; tensor < 2; tensor++)
+               {
+                  val[tensor].SetSize(nq*dim*ne);
+                  der[tensor].SetSize(nq*dim*dim*ne);
+                  det[tensor].SetSize(nq*ne);
+                  qi.DisableTensorProducts(tensor == 0);
+                  qi.Mult(x, flags, val[tensor], der[tensor], det[tensor]);
+               }
+               qi.DisableTensorProducts(false);
+
+               val[1] -= val[0];
+               der[1] -= der[0];
+               det[1] -= det[0];
+               REQUIRE(val[1].Normlinf() < 1e-12*val[0].Normlinf());
+               REQUIRE(der[1].Normlinf() < 1e-12*der[0].Normlinf());
+               REQUIRE(det[1].Normlinf() < 1e-12*det[0].Normlinf());
+
+               // Determinants without derivatives use a temporary vector
+               Vector q_val, q_der;
+               qi.Mult(x, QuadratureInterpolator::DETERMINANTS,
+                       q_val, q_der, det[1]);
+               det[1] -= det[0];
+               REQUIRE(det[1].Normlinf() < 1e-12*det[0].Normlinf());
+            }
+         }
+      }
+      delete mesh;
+   }
+}
+
+TEST_CASE("QuadratureInterpolator matrix-free mass",
+          "[QuadratureInterpolator]")
+{
+   // Apply the mass operator as R^T B^T D B R and compare to MassIntegrator
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = MakeMesh(dim, (dim == 2) ? Element::QUADRILATERAL :
+                            Element::HEXAHEDRON);
+      const int order = 3;
+      H1_FECollection fec(order, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      const IntegrationRule &ir =
+         IntRules.Get(fes.GetFE(0)->GetGeomType(), 2*order + 3);
+      const int ne = mesh->GetNE();
+      const int nq = ir.GetNPoints();
+
+      const Operator *R = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+      const QuadratureInterpolator &qi = *fes.GetQuadratureInterpolator(ir);
+      const GeometricFactors *geom =
+         mesh->GetGeometricFactors(ir, GeometricFactors::DETERMINANTS);
+
+      Vector x(fes.GetVSize()), y(fes.GetVSize()), y_ref(fes.GetVSize());
+      Vector x_e(R->Height()), q_val(nq*ne), q_der, q_det;
+      x.Randomize(1);
+      R->Mult(x, x_e);
+      qi.Mult(x_e, QuadratureInterpolator::VALUES, q_val, q_der, q_det);
+      for (int e = 0; e < ne; e++)
+      {
+         for (int q = 0; q < nq; q++)
+         {
+            q_val(q + nq*e) *= ir.IntPoint(q).weight * geom->detJ(q + nq*e);
+         }
+      }
+      qi.MultTranspose(QuadratureInterpolator::VALUES, q_val, q_der, x_e);
+      R->MultTranspose(x_e, y);
+
+      BilinearForm mass(&fes);
+      mass.AddDomainIntegrator(new MassIntegrator(&ir));
+      mass.Assemble();
+      mass.Finalize();
+      mass.Mult(x, y_ref);
+
+      y -= y_ref;
+      REQUIRE(y.Normlinf() < 1e-12*y_ref.Normlinf());
+      delete mesh;
+   }
+}
+
+} // namespace quadinterpolator
@@ -0,0 +1,203 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "general/hash.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace hash_test
+{
+
+struct Item2 : public Hashed2 { int value; };
+struct Item4 : public Hashed4 { int value; };
+
+// HashTable with access to the size of the hash table, which changes only
+// when the items are rehashed
+template <typename T>
+class TestHashTable : public HashTable<T>
+{
+public:
+   TestHashTable(int init_hash_size)
+      : HashTable<T>(1024, init_hash_size) { }
+
+   int TableSize() const { return this->mask + 1; }
+};
+
+// The item i has the parents (i, i+1) or (i, i+1, i+2, i+3), which are given
+// in different orders, as the order is not relevant
+Item2 *GetItem(HashTable<Item2> &table, int i) { return table.Get(i+1, i); }
+Item4 *GetItem(HashTable<Item4> &table, int i)
+{ return table.Get(i+3, i+1, i, i+2); }
+
+const Item2 *FindItem(const HashTable<Item2> &table, int i)
+{ return table.Find(i, i+1); }
+const Item4 *FindItem(const HashTable<Item4> &table, int i)
+{ return table.Find(i, i+1, i+2, i+3); }
+
+int FindItemId(const HashTable<Item2> &table, int i)
+{ return table.FindId(i+1, i); }
+int FindItemId(const HashTable<Item4> &table, int i)
+{ return table.FindId(i+2, i, i+3, i+1); }
+
+// Insert the items i in [begin, end), and return the number of times the
+// table was rehashed
+template <typename T>
+int InsertItems(TestHashTable<T> &table, int begin, int end)
+{
+   int num_rehash = 0, size = table.TableSize();
+   for (int i = begin; i < end; i++)
+   {
+      GetItem(table, i)->value = i;
+      if (table.TableSize() != size)
+      {
+         num_rehash++;
+         size = table.TableSize();
+      }
+   }
+   return num_rehash;
+}
+
+// Check that the items i in [0, n) are in the table, and no other items
+template <typename T>
+void CheckLookups(const TestHashTable<T> &table, int n)
+{
+   REQUIRE(table.Size() == n);
+   bool all_found = true;
+   for (int i = 0; i < n; i++)
+   {
+      const T *item = FindItem(table, i);
+      all_found &= (item != NULL && item->value == i &&
+                    &table.At(FindItemId(table, i)) == item);
+   }
+   REQUIRE(all_found);
+   REQUIRE(FindItem(table, n) == NULL);
+   REQUIRE(FindItemId(table, -1) == -1);
+}
+
+template <typename T>
+void TestReserve()
+{
+   const int n = 10000, init_size = 16;
+
+   // Without Reserve(), the table grows by rehashing several times
+   TestHashTable<T> table(init_size);
+   REQUIRE(InsertItems(table, 0, n) > 1);
+   CheckLookups(table, n);
+   const int grown_size = table.TableSize();
+
+   // With Reserve(), the batch is inserted without rehashing
+   TestHashTable<T> reserved(init_size);
+   reserved.Reserve(n);
+   REQUIRE(reserved.TableSize() == grown_size);
+   REQUIRE(InsertItems(reserved, 0, n) == 0);
+   CheckLookups(reserved, n);
+
+   // Reserve() never shrinks the table
+   reserved.Reserve(n/2);
+   REQUIRE(reserved.TableSize() == grown_size);
+   CheckLookups(reserved, n);
+
+   // Reserve() for a second batch rehashes the existing items once
+   reserved.Reserve(4*n);
+   REQUIRE(reserved.TableSize() > grown_size);
+   CheckLookups(reserved, n);
+   REQUIRE(InsertItems(reserved, n, 4*n) == 0);
+   CheckLookups(reserved, 4*n);
+}
+
+TEST_CASE("HashTable Reserve", "[HashTable]")
+{
+   SECTION("Pairs") { TestReserve<Item2>(); }
+   SECTION("Quadruples") { TestReserve<Item4>(); }
+}
+
+// NCMesh with access to its hash tables
+class TestNCMesh : public NCMesh
+{
+public:
+   TestNCMesh(const Mesh *mesh) : NCMesh(mesh) { }
+
+   int NumLeaves() const { return leaf_elements.Size(); }
+   int NumNodes() const { return nodes.Size(); }
+   int NumFaces() const { return faces.Size(); }
+
+   // Return the index of the first leaf that is a root element, or -1
+   int FirstRootLeaf() const
+   {
+      for (int i = 0; i < leaf_elements.Size(); i++)
+      {
+         if (elements[leaf_elements[i]].parent == -1) { return i; }
+      }
+      return -1;
+   }
+
+   // Return true if the edges and faces of all leaf elements can be found
+   bool CheckLookups() const
+   {
+      bool all_found = true;
+      for (int i = 0; i < leaf_elements.Size(); i++)
+      {
+         const Element &el = elements[leaf_elements[i]];
+         const GeomInfo &gi = GI[el.Geom()];
+         for (int j = 0; j < gi.ne; j++)
+         {
+            const int *ev = gi.edges[j];
+            const Node *node = nodes.Find(el.node[ev[0]], el.node[ev[1]]);
+            all_found &= (node != NULL && node->HasEdge());
+         }
+         for (int j = 0; j < gi.nf; j++)
+         {
+            const int *fv = gi.faces[j];
+            const int n3 = (gi.nfv[j] == 4) ? el.node[fv[3]] : -1;
+            all_found &= (faces.Find(el.node[fv[0]], el.node[fv[1]],
+                                     el.node[fv[2]], n3) != NULL);
+         }
+      }
+      return all_found;
+   }
+};
+
+TEST_CASE("NCMesh batched refinement", "[HashTable][NCMesh]")
+{
+   for (int t = 0; t < 2; t++)
+   {
+      Mesh mesh(4, 4, 4, t ? Element::WEDGE : Element::HEXAHEDRON);
+
+      // Refine all elements in one batch, which presizes the hash tables
+      TestNCMesh batch(&mesh);
+      Array<Refinement> refs;
+      for (int i = 0; i < batch.NumLeaves(); i++)
+      {
+         refs.Append(Refinement(i));
+      }
+      batch.Refine(refs);
+      REQUIRE(batch.NumLeaves() == 8*mesh.GetNE());
+      REQUIRE(batch.FirstRootLeaf() == -1);
+      REQUIRE(batch.CheckLookups());
+
+      // Refine the same elements one at a time
+      TestNCMesh single(&mesh);
+      for (int i; (i = single.FirstRootLeaf()) >= 0; )
+      {
+         Array<Refinement> ref;
+         ref.Append(Refinement(i));
+         single.Refine(ref);
+      }
+      REQUIRE(single.NumLeaves() == batch.NumLeaves());
+      REQUIRE(single.NumNodes() == batch.NumNodes());
+      REQUIRE(single.NumFaces() == batch.NumFaces());
+      REQUIRE(single.CheckLookups());
+   }
+}
+
+} // namespace hash_test
@@ -0,0 +1,218 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace multivector
+{
+
+static double coeff_func(const Vector &x) { return 1.0 + x(0)*x(0); }
+
+// Compare A.MultMulti() with A.Mult() applied to each vector
+static double MultMultiError(const Operator &A, int nv)
+{
+   MultiVector X(A.Width(), nv), Y(A.Height(), nv);
+   X.Randomize(1);
+   A.MultMulti(X, Y);
+   Vector x, y, y_ref(A.Height());
+   double err = 0.0, norm = 0.0;
+   for (int j = 0; j < nv; j++)
+   {
+      X.GetVectorRef(j, x);
+      Y.GetVectorRef(j, y);
+      A.Mult(x, y_ref);
+      norm = std::max(norm, y_ref.Normlinf());
+      y_ref -= y;
+      err = std::max(err, y_ref.Normlinf());
+   }
+   return err/norm;
+}
+
+TEST_CASE("MultiVector", "[MultiVector]")
+{
+   MultiVector X(5, 3);
+   REQUIRE(X.Size() == 15);
+   REQUIRE(X.VectorSize() == 5);
+   REQUIRE(X.NumVectors() == 3);
+   X = 0.0;
+   Vector x;
+   X.GetVectorRef(1, x);
+   REQUIRE(x.Size() == 5);
+   x = 2.0;
+   REQUIRE(X(0,1) == 2.0);
+   REQUIRE(X(4,1) == 2.0);
+   REQUIRE(X(0,2) == 0.0);
+   REQUIRE(X.Sum() == 10.0);
+
+   MultiVector Y;
+   Y = X;
+   REQUIRE(Y.NumVectors() == 3);
+   REQUIRE(Y(3,1) == 2.0);
+}
+
+TEST_CASE("Operator MultMulti", "[MultiVector]")
+{
+   const int nv = 4;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(4, 3, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                   new Mesh(3, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      Array<int> ess_bdr(mesh->bdr_attributes.Max());
+      ess_bdr = 1;
+      for (int order = 1; order <= 3; order++)
+      {
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         FunctionCoefficient coeff(coeff_func);
+         Array<int> ess_tdof_list;
+         fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+         for (int pa = 0; pa <= 1; pa++)
+         {
+            BilinearForm a(&fes);
+            if (pa) { a.SetAssemblyLevel(AssemblyLevel::PARTIAL); }
+            a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+            a.AddDomainIntegrator(new MassIntegrator);
+            a.Assemble();
+            if (!pa) { a.Finalize(); }
+            REQUIRE(MultMultiError(a, nv) < 1e-14);
+
+            OperatorPtr A;
+            a.FormSystemMatrix(ess_tdof_list, A);
+            REQUIRE(MultMultiError(*A, nv) < 1e-14);
+         }
+      }
+      delete mesh;
+   }
+}
+
+TEST_CASE("PA MultMulti specialized kernels", "[MultiVector][PartialAssembly]")
+{
+   // Use the quadrature rules for which AddMultPA dispatches to the templated
+   // (shared memory) kernels, Q1D = D1D in 2D and Q1D = D1D+1 in 3D, and check
+   // that the multi-vector path matches the per-vector one.
+   const int nv = 5;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 4, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                   new Mesh(2, 3, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+      for (int order = 2; order <= 3; order++)
+      {
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         const int q1d = (dim == 2) ? order + 1 : order + 2;
+         const IntegrationRule &ir = IntRules.Get(geom, 2*q1d - 1);
+         FunctionCoefficient coeff(coeff_func);
+
+         for (int integ = 0; integ < 2; integ++)
+         {
+            BilinearForm a(&fes);
+            a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            BilinearFormIntegrator *bfi;
+            if (integ == 0) { bfi = new DiffusionIntegrator(coeff); }
+            else { bfi = new MassIntegrator(coeff); }
+            bfi->SetIntRule(&ir);
+            a.AddDomainIntegrator(bfi);
+            a.Assemble();
+            REQUIRE(MultMultiError(a, nv) < 1e-14);
+         }
+      }
+      delete mesh;
+   }
+}
+
+TEST_CASE("Block CG", "[MultiVector]")
+{
+   const int nv = 6;
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true, 1.0, 1.0);
+   H1_FECollection fec(3, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+   FunctionCoefficient coeff(coeff_func);
+
+   for (int pa = 0; pa <= 1; pa++)
+   {
+      BilinearForm a(&fes);
+      if (pa) { a.SetAssemblyLevel(AssemblyLevel::PARTIAL); }
+      a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      a.Assemble();
+      OperatorPtr A;
+      a.FormSystemMatrix(ess_tdof_list, A);
+      const int n = A->Height();
+      Vector diag(n);
+      if (pa) { a.AssembleDiagonal(diag); }
+      else { A.As<SparseMatrix>()->GetDiag(diag); }
+      OperatorJacobiSmoother jacobi(diag, ess_tdof_list);
+
+      MultiVector B(n, nv), X(n, nv);
+      B.Randomize(2);
+      for (int j = 0; j < nv; j++)
+      {
+         for (int i = 0; i < ess_tdof_list.Size(); i++)
+         {
+            B(ess_tdof_list[i], j) = 0.0;
+         }
+      }
+      for (int p = 0; p <= 1; p++)
+      {
+         BlockCGSolver bcg;
+         bcg.SetOperator(*A);
+         if (p) { bcg.SetPreconditioner(jacobi); }
+         bcg.SetRelTol(1e-12);
+         bcg.SetMaxIter(500);
+         bcg.SetPrintLevel(-1);
+         X = 0.0; // the solvers use iterative_mode by default
+         bcg.MultMulti(B, X);
+         REQUIRE(bcg.GetConverged());
+
+         // Compare with CG for each right-hand side
+         CGSolver cg;
+         cg.SetOperator(*A);
+         if (p) { cg.SetPreconditioner(jacobi); }
+         cg.SetRelTol(1e-12);
+         cg.SetMaxIter(500);
+         cg.SetPrintLevel(-1);
+         int max_iter = 0;
+         Vector b, x, x_cg(n);
+         for (int j = 0; j < nv; j++)
+         {
+            B.GetVectorRef(j, b);
+            X.GetVectorRef(j, x);
+            x_cg = 0.0;
+            cg.Mult(b, x_cg);
+            REQUIRE(cg.GetConverged());
+            max_iter = std::max(max_iter, cg.GetNumIterations());
+            x_cg -= x;
+            REQUIRE(x_cg.Normlinf() < 1e-8*x.Normlinf());
+         }
+         // The iteration counts may differ slightly due to round-off
+         REQUIRE(std::abs(bcg.GetNumIterations() - max_iter) <= max_iter/10);
+
+         // Single right-hand side
+         B.GetVectorRef(0, b);
+         x_cg = 0.0;
+         bcg.Mult(b, x_cg);
+         X.GetVectorRef(0, x);
+         x_cg -= x;
+         REQUIRE(x_cg.Normlinf() < 1e-8*x.Normlinf());
+      }
+   }
+}
+
+} // namespace multivector
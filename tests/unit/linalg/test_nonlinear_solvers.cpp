@@ -0,0 +1,284 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace nonlinear_solvers
+{
+
+// The 1D finite difference discretization of -u'' + u^3 = f with homogeneous
+// Dirichlet boundary conditions, F(x) = A x + x^3
+class CubicDiffusion : public Operator
+{
+   SparseMatrix A;
+   mutable SparseMatrix *grad;
+public:
+   mutable int num_mult, num_grad;
+
+   CubicDiffusion(int n)
+      : Operator(n), A(n), grad(NULL), num_mult(0), num_grad(0)
+   {
+      const double h2 = (n + 1.0)*(n + 1.0);
+      for (int i = 0; i < n; i++)
+      {
+         A.Add(i, i, 2.0*h2);
+         if (i > 0) { A.Add(i, i-1, -h2); }
+         if (i < n-1) { A.Add(i, i+1, -h2); }
+      }
+      A.Finalize();
+   }
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   {
+      num_mult++;
+      A.Mult(x, y);
+      for (int i = 0; i < height; i++) { y(i) += x(i)*x(i)*x(i); }
+   }
+
+   virtual Operator &GetGradient(const Vector &x) const
+   {
+      num_grad++;
+      delete grad;
+      grad = new SparseMatrix(A);
+      for (int i = 0; i < height; i++) { grad->Add(i, i, 3.0*x(i)*x(i)); }
+      return *grad;
+   }
+
+   virtual ~CubicDiffusion() { delete grad; }
+};
+
+// The Picard linearization of F(x) = b: G(x) = (A + diag(x^2))^{-1} b
+class CubicDiffusionPicard : public Operator
+{
+   const CubicDiffusion &F;
+   const Vector &b;
+public:
+   CubicDiffusionPicard(const CubicDiffusion &F_, const Vector &b_)
+      : Operator(F_.Height()), F(F_), b(b_) { }
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   {
+      // A + diag(x^2) is the gradient at x/sqrt(3)
+      Vector xs(x);
+      xs /= sqrt(3.0);
+      CGSolver cg;
+      cg.SetOperator(F.GetGradient(xs));
+      cg.SetRelTol(1e-14);
+      cg.SetMaxIter(1000);
+      cg.SetPrintLevel(-1);
+      y = 0.0;
+      cg.Mult(b, y);
+   }
+};
+
+TEST_CASE("Jacobian-free Newton-Krylov", "[NewtonSolver]")
+{
+   const int n = 100;
+   CubicDiffusion F(n);
+   Vector b(n);
+   for (int i = 0; i < n; i++)
+   {
+      const double x = (i + 1.0)/(n + 1.0);
+      b(i) = 1e3*sin(M_PI*x) + 1e4*x*x;
+   }
+
+   // Reference solution with the assembled Jacobian
+   Vector x_ref(n);
+   x_ref = 0.0;
+   {
+      GMRESSolver gmres;
+      DSmoother jacobi;
+      gmres.SetPreconditioner(jacobi);
+      gmres.SetRelTol(1e-12);
+      gmres.SetMaxIter(500);
+      gmres.SetKDim(100);
+      gmres.SetPrintLevel(-1);
+      NewtonSolver newton;
+      newton.SetSolver(gmres);
+      newton.SetOperator(F);
+      newton.SetRelTol(1e-12);
+      newton.SetMaxIter(20);
+      newton.SetPrintLevel(-1);
+      newton.Mult(b, x_ref);
+      REQUIRE(newton.GetConverged());
+   }
+   const double ref_norm = x_ref.Normlinf();
+
+   for (int pc_freq = 0; pc_freq <= 3; pc_freq++)
+   {
+      for (int ew = 0; ew <= 2; ew++)
+      {
+         GMRESSolver gmres;
+         gmres.SetRelTol(1e-10);
+         gmres.SetAbsTol(0.0);
+         gmres.SetMaxIter(500);
+         gmres.SetKDim(100);
+         gmres.SetPrintLevel(-1);
+         DSmoother jacobi;
+         NewtonSolver newton;
+         newton.SetSolver(gmres);
+         newton.SetOperator(F);
+         // pc_freq = 0: no preconditioner
+         newton.SetJacobianFree(pc_freq ? &jacobi : NULL, pc_freq);
+         newton.SetAdaptiveLinRtol(ew);
+         newton.SetRelTol(1e-10);
+         newton.SetMaxIter(50);
+         newton.SetPrintLevel(-1);
+
+         Vector x(n);
+         x = 0.0;
+         F.num_grad = 0;
+         newton.Mult(b, x);
+         REQUIRE(newton.GetConverged());
+
+         // The Jacobian is assembled only for the preconditioner
+         const int iter = newton.GetNumIterations();
+         REQUIRE(F.num_grad == (pc_freq ? (iter + pc_freq - 1)/pc_freq : 0));
+
+         x -= x_ref;
+         REQUIRE(x.Normlinf() < 1e-8*ref_norm);
+      }
+   }
+}
+
+TEST_CASE("Newton adaptive linear tolerance", "[NewtonSolver]")
+{
+   const int n = 100;
+   CubicDiffusion F(n);
+   Vector b(n);
+   b = 1e4;
+
+   // In the JFNK mode without preconditioner, each Krylov iteration costs one
+   // evaluation of F
+   int num_mult[3];
+   for (int ew = 0; ew <= 2; ew++)
+   {
+      GMRESSolver gmres;
+      gmres.SetRelTol(1e-10);
+      gmres.SetAbsTol(0.0);
+      gmres.SetMaxIter(500);
+      gmres.SetKDim(100);
+      gmres.SetPrintLevel(-1);
+      NewtonSolver newton;
+      newton.SetSolver(gmres);
+      newton.SetOperator(F);
+      newton.SetJacobianFree();
+      newton.SetAdaptiveLinRtol(ew);
+      newton.SetRelTol(1e-10);
+      newton.SetMaxIter(50);
+      newton.SetPrintLevel(-1);
+      Vector x(n);
+      x = 0.0;
+      F.num_mult = 0;
+      newton.Mult(b, x);
+      REQUIRE(newton.GetConverged());
+      REQUIRE(F.num_grad == 0);
+      num_mult[ew] = F.num_mult;
+   }
+   // The forcing terms avoid oversolving the linear systems
+   REQUIRE(num_mult[1] < num_mult[0]);
+   REQUIRE(num_mult[2] < num_mult[0]);
+}
+
+static void NewtonReference(const CubicDiffusion &F, const Vector &b,
+                            Vector &x)
+{
+   CGSolver cg;
+   cg.SetRelTol(1e-14);
+   cg.SetMaxIter(1000);
+   cg.SetPrintLevel(-1);
+   NewtonSolver newton;
+   newton.SetSolver(cg);
+   newton.SetOperator(F);
+   newton.SetRelTol(1e-12);
+   newton.SetMaxIter(20);
+   newton.SetPrintLevel(-1);
+   x = 0.0;
+   newton.Mult(b, x);
+   REQUIRE(newton.GetConverged());
+}
+
+TEST_CASE("Anderson acceleration", "[AndersonSolver]")
+{
+   const int n = 100;
+   CubicDiffusion F(n);
+   Vector b(n);
+   b = 30.0;
+   Vector x_ref(n);
+   NewtonReference(F, b, x_ref);
+
+   CubicDiffusionPicard G(F, b);
+   int iter[2];
+   for (int k = 0; k < 2; k++)
+   {
+      AndersonSolver anderson;
+      anderson.SetOperator(G);
+      anderson.SetDepth(k ? 5 : 0);
+      anderson.SetRelTol(1e-10);
+      anderson.SetMaxIter(200);
+      anderson.SetPrintLevel(-1);
+      Vector x(n);
+      x = 0.0;
+      anderson.Mult(Vector(), x);
+      REQUIRE(anderson.GetConverged());
+      iter[k] = anderson.GetNumIterations();
+
+      x -= x_ref;
+      REQUIRE(x.Normlinf() < 1e-8*x_ref.Normlinf());
+   }
+   // Anderson acceleration versus the Picard iteration
+   REQUIRE(3*iter[1] < iter[0]);
+}
+
+TEST_CASE("Newton Jacobian reuse", "[NewtonSolver]")
+{
+   const int n = 100;
+   CubicDiffusion F(n), F_ref(n);
+   Vector b0(n), b(n), x(n), x_ref(n);
+   b0 = 1e4;
+   x = 0.0;
+
+   CGSolver cg;
+   cg.SetRelTol(1e-12);
+   cg.SetMaxIter(1000);
+   cg.SetPrintLevel(-1);
+   NewtonSolver newton;
+   newton.SetSolver(cg);
+   newton.SetOperator(F);
+   newton.SetJacobianReuse(0.5);
+   newton.SetRelTol(1e-10);
+   newton.SetAbsTol(0.0);
+   newton.SetMaxIter(100);
+   newton.SetPrintLevel(-1);
+   newton.iterative_mode = true;
+
+   // A sequence of slowly changing problems, as in time stepping
+   int total_iter = 0;
+   F.num_grad = 0;
+   for (int step = 0; step < 10; step++)
+   {
+      b = b0;
+      b *= 1.0 + 0.05*step;
+      newton.Mult(b, x);
+      REQUIRE(newton.GetConverged());
+      total_iter += newton.GetNumIterations();
+
+      NewtonReference(F_ref, b, x_ref);
+      x_ref -= x;
+      REQUIRE(x_ref.Normlinf() < 1e-8*x.Normlinf());
+   }
+   REQUIRE(F.num_grad < total_iter/2);
+}
+
+} // namespace nonlinear_solvers
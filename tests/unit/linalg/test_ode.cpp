@@ -281,3 +281,939 @@ TEST_CASE("First order ODE methods",
    }
 }
 
+
+TEST_CASE("Adaptive ODE methods",
+          "[ODE1]")
+{
+   // The ODE du/dt + A u = 0 with exact solution u(pi) = -u(0)
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      DenseMatrix A, T;
+      Vector r;
+   public:
+      ODE() : TimeDependentOperator(2, 0.0), A(2), T(2), r(2)
+      {
+         A(0,0) = 0.0;  A(0,1) = 1.0;
+         A(1,0) = -1.0; A(1,1) = 0.0;
+      }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         A.Mult(u, dudt);
+         dudt.Neg();
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u,
+                                 Vector &dudt)
+      {
+         A.Mult(u, r);
+         r.Neg();
+         T = A;
+         T *= dt;
+         T(0,0) += 1.0;
+         T(1,1) += 1.0;
+         T.Invert();
+         T.Mult(r, dudt);
+      }
+   };
+   ODE oper;
+   Vector u0(2);
+   u0 = 1.0;
+
+   // Error at t = pi, using the given tolerance and initial time step
+   class Solve
+   {
+   public:
+      static double Error(AdaptiveODESolver &solver, ODE &oper,
+                          const Vector &u0, double tol, double dt)
+      {
+         Vector u(u0);
+         double t = 0.0;
+         solver.SetTolerances(tol, tol);
+         solver.Init(oper);
+         solver.Run(u, t, dt, M_PI);
+         REQUIRE(t == M_PI);
+         u += u0;
+         return u.Norml2();
+      }
+   };
+
+   AdaptiveODESolver *solvers[3] =
+   {
+      new DormandPrince54Solver, new BogackiShampine32Solver,
+      new EmbeddedSDIRK33Solver
+   };
+   const int orders[3] = { 5, 3, 3 };
+   for (int i = 0; i < 3; i++)
+   {
+      AdaptiveODESolver &solver = *solvers[i];
+
+      // Order of the solution with fixed steps: all steps are accepted and the
+      // step size is not changed.
+      solver.SetControllerParameters(1.0, 1.0, 1.0);
+      const double err1 = Solve::Error(solver, oper, u0, 1e10, M_PI/16);
+      const double err2 = Solve::Error(solver, oper, u0, 1e10, M_PI/32);
+      REQUIRE(solver.GetNumAcceptedSteps() == 32);
+      REQUIRE(log(err1/err2)/log(2.0) > orders[i] - 0.1);
+
+      // Adaptive steps: the error decreases with the tolerance, and too large
+      // initial steps are rejected.
+      solver.SetControllerParameters(0.9, 0.2, 5.0);
+      const double err_coarse = Solve::Error(solver, oper, u0, 1e-5, M_PI);
+      REQUIRE(solver.GetNumRejectedSteps() > 0);
+      const int steps_coarse = solver.GetNumAcceptedSteps();
+      const double err_fine = Solve::Error(solver, oper, u0, 1e-8, M_PI);
+      REQUIRE(err_coarse < 1e-3);
+      REQUIRE(err_fine < 1e-6);
+      REQUIRE(err_fine < err_coarse/10);
+      REQUIRE(solver.GetNumAcceptedSteps() > steps_coarse);
+      delete solvers[i];
+   }
+}
+
+TEST_CASE("IMEX ODE methods",
+          "[ODE1]")
+{
+   // The ODE du/dt = -(A1 + A2) u, where the terms -A1 u and -A2 u are
+   // evaluated with ADDITIVE_TERM_1 and ADDITIVE_TERM_2, respectively. The
+   // matrices do not commute, so that the coupling conditions are tested.
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      DenseMatrix A1, A2, A, T;
+      Vector r;
+   public:
+      int num_solves;
+
+      ODE() : TimeDependentOperator(2, 0.0), A1(2), A2(2), A(2), T(2), r(2)
+      {
+         A1(0,0) = 0.0;  A1(0,1) = 1.0;
+         A1(1,0) = -1.0; A1(1,1) = 0.0;
+         A2(0,0) = 0.5;  A2(0,1) = 0.2;
+         A2(1,0) = 0.1;  A2(1,1) = 2.0;
+         num_solves = 0;
+      }
+
+      const DenseMatrix &Matrix() const
+      {
+         return (eval_mode == ADDITIVE_TERM_1) ? A1 : A2;
+      }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         REQUIRE(eval_mode != NORMAL);
+         Matrix().Mult(u, dudt);
+         dudt.Neg();
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u,
+                                 Vector &dudt)
+      {
+         REQUIRE(eval_mode == ADDITIVE_TERM_2);
+         num_solves++;
+         A2.Mult(u, r);
+         r.Neg();
+         T = A2;
+         T *= dt;
+         T(0,0) += 1.0;
+         T(1,1) += 1.0;
+         T.Invert();
+         T.Mult(r, dudt);
+      }
+   };
+
+   // Reference solution at t = 1: exp(-(A1 + A2)) u0, using many RK4 steps
+   ODE oper;
+   Vector u0(2), u_ex(2), k(2), tmp(2);
+   u0(0) = 1.0; u0(1) = -0.5;
+   {
+      class Full : public TimeDependentOperator
+      {
+         ODE &ode;
+         mutable Vector v;
+      public:
+         Full(ODE &o) : TimeDependentOperator(2, 0.0), ode(o), v(2) { }
+         virtual void Mult(const Vector &u, Vector &dudt) const
+         {
+            ode.SetEvalMode(ADDITIVE_TERM_1);
+            ode.Mult(u, dudt);
+            ode.SetEvalMode(ADDITIVE_TERM_2);
+            ode.Mult(u, v);
+            dudt += v;
+         }
+      } full(oper);
+      RK4Solver rk4;
+      rk4.Init(full);
+      u_ex = u0;
+      double t = 0.0, dt = 1.0/4096;
+      for (int i = 0; i < 4096; i++) { rk4.Step(u_ex, t, dt); }
+      oper.SetEvalMode(TimeDependentOperator::NORMAL);
+   }
+
+   ODESolver *solvers[3] =
+   {
+      new ARS222Solver, new ARK324Solver, new ARK436Solver
+   };
+   const int orders[3] = { 2, 3, 4 };
+   // Number of implicit stages (the first stage is explicit)
+   const int solves[3] = { 2, 3, 5 };
+   for (int i = 0; i < 3; i++)
+   {
+      double err[2];
+      for (int l = 0; l < 2; l++)
+      {
+         const int steps = 16 << l;
+         Vector u(u0);
+         double t = 0.0, dt = 1.0/steps;
+         solvers[i]->Init(oper);
+         oper.num_solves = 0;
+         for (int n = 0; n < steps; n++) { solvers[i]->Step(u, t, dt); }
+         REQUIRE(oper.GetEvalMode() == TimeDependentOperator::NORMAL);
+         REQUIRE(oper.num_solves == solves[i]*steps);
+         u -= u_ex;
+         err[l] = u.Norml2();
+      }
+      REQUIRE(log(err[0]/err[1])/log(2.0) > orders[i] - 0.15);
+      delete solvers[i];
+   }
+}
+
+namespace ode_multirate
+{
+
+// Polynomial divergence-free velocity field, tangential to the boundary of
+// [0,1]^2, with stream function 4 x (1-x) y (1-y)
+static void velocity(const Vector &x, Vector &v)
+{
+   v(0) = 4.0*x(0)*(1.0 - x(0))*(1.0 - 2.0*x(1));
+   v(1) = -4.0*x(1)*(1.0 - x(1))*(1.0 - 2.0*x(0));
+}
+
+static double bump(const Vector &x)
+{
+   const double r = hypot(x(0) - 0.3, x(1) - 0.6);
+   return (r < 0.2) ? pow(cos(M_PI*r/0.4), 2) : 0.0;
+}
+
+// Grade the mesh in the x-direction, with element sizes varying by a factor 8
+static void grade(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) = (exp(log(8.0)*x(0)) - 1.0)/7.0;
+}
+
+// Compute y(r) = (A x)(r) for the rows r in rows
+static void MultRows(const SparseMatrix &A, const Array<int> &rows,
+                     const Vector &x, Vector &y)
+{
+   const int *I = A.GetI(), *J = A.GetJ();
+   const double *V = A.GetData();
+   for (int i = 0; i < rows.Size(); i++)
+   {
+      const int r = rows[i];
+      double val = 0.0;
+      for (int k = I[r]; k < I[r+1]; k++) { val += V[k]*x(J[k]); }
+      y(r) = val;
+   }
+}
+
+// The DG advection operator du/dt = M^{-1} K u, which can be evaluated element
+// by element
+class DGAdvection : public TimeDependentOperator
+{
+   SparseMatrix &K, &Minv;
+   mutable Vector z;
+public:
+   mutable long num_rows;
+
+   DGAdvection(SparseMatrix &K_, SparseMatrix &Minv_)
+      : TimeDependentOperator(K_.Height()), K(K_), Minv(Minv_), z(height),
+        num_rows(0) { }
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   {
+      num_rows += height;
+      K.Mult(x, z);
+      Minv.Mult(z, y);
+   }
+
+   // The rows contain whole elements, and M^{-1} is block diagonal
+   virtual void MultRows(const Array<int> &rows, const Vector &x,
+                         Vector &y) const
+   {
+      num_rows += rows.Size();
+      ode_multirate::MultRows(K, rows, x, z);
+      ode_multirate::MultRows(Minv, rows, z, y);
+   }
+};
+
+TEST_CASE("Multirate ODE methods",
+          "[ODE1]")
+{
+   Mesh mesh(16, 8, Element::QUADRILATERAL, true, 1.0, 1.0);
+   mesh.Transform(grade);
+   Array<int> levels;
+   mesh.GetTimeStepLevels(levels, 10);
+   REQUIRE(levels.Max() == 3);
+   REQUIRE(levels.Min() == 0);
+
+   DG_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   VectorFunctionCoefficient vel(2, velocity);
+   // Exact quadrature, so that the discrete operator is conservative
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 6);
+   const IntegrationRule &face_ir = IntRules.Get(Geometry::SEGMENT, 6);
+   BilinearForm k(&fes), minv(&fes), m(&fes);
+   BilinearFormIntegrator *conv = new ConvectionIntegrator(vel, -1.0);
+   conv->SetIntRule(&ir);
+   k.AddDomainIntegrator(conv);
+   for (int f = 0; f < 2; f++)
+   {
+      BilinearFormIntegrator *trace = new DGTraceIntegrator(vel, 1.0, -0.5);
+      trace->SetIntRule(&face_ir);
+      if (f == 0)
+      {
+         k.AddInteriorFaceIntegrator(new TransposeIntegrator(trace));
+      }
+      else
+      {
+         k.AddBdrFaceIntegrator(new TransposeIntegrator(trace));
+      }
+   }
+   minv.AddDomainIntegrator(new InverseIntegrator(new MassIntegrator));
+   m.AddDomainIntegrator(new MassIntegrator);
+   k.Assemble();
+   k.Finalize();
+   minv.Assemble();
+   minv.Finalize();
+   m.Assemble();
+   m.Finalize();
+   DGAdvection adv(k.SpMat(), minv.SpMat());
+
+   GridFunction u0(&fes);
+   FunctionCoefficient u0_coeff(bump);
+   u0.ProjectCoefficient(u0_coeff);
+   Vector ones(fes.GetVSize()), Mu(fes.GetVSize());
+   ones = 1.0;
+   m.Mult(u0, Mu);
+   const double mass0 = ones*Mu;
+
+   const double dt = 0.02, t_final = 0.4;
+   const int nsteps = int(t_final/dt + 0.5);
+   const Table &elem_dofs = fes.GetElementToDofTable();
+   const Table &elem_nbrs = mesh.ElementToElementTable();
+
+   // Reference solution: RK4 with a small global step
+   Vector u_ref(u0);
+   {
+      RK4Solver rk4;
+      rk4.Init(adv);
+      double t = 0.0, h = dt/32;
+      for (int i = 0; i < 32*nsteps; i++) { rk4.Step(u_ref, t, h); }
+   }
+
+   // With a single level, the method is Heun's method
+   {
+      Array<int> zero_levels(mesh.GetNE());
+      zero_levels = 0;
+      MultirateRK2Solver lts(elem_dofs, zero_levels, elem_nbrs);
+      RK2Solver heun(1.0);
+      Vector u1(u0), u2(u0);
+      double t1 = 0.0, t2 = 0.0, h1 = dt/8, h2 = dt/8;
+      lts.Init(adv);
+      heun.Init(adv);
+      for (int i = 0; i < 8; i++)
+      {
+         lts.Step(u1, t1, h1);
+         heun.Step(u2, t2, h2);
+      }
+      u1 -= u2;
+      REQUIRE(u1.Normlinf() < 1e-14);
+   }
+
+   // Cost of Heun's method with the time step of the smallest elements
+   adv.num_rows = 0;
+   {
+      Vector u(u0);
+      RK2Solver heun(1.0);
+      heun.Init(adv);
+      double t = 0.0, h = dt/8;
+      for (int i = 0; i < 8*nsteps; i++) { heun.Step(u, t, h); }
+   }
+   const long glob_rows = adv.num_rows;
+
+   // Local time stepping: exact conservation, and second order convergence
+   MultirateRK2Solver lts(elem_dofs, levels, elem_nbrs);
+   REQUIRE(lts.GetMaxLevel() == 3);
+   lts.Init(adv);
+   double err[2];
+   for (int r = 0; r < 2; r++)
+   {
+      Vector u(u0);
+      adv.num_rows = 0;
+      double t = 0.0, h = dt/(1 << r);
+      for (int i = 0; i < (nsteps << r); i++) { lts.Step(u, t, h); }
+      REQUIRE(std::abs(t - t_final) < 1e-12);
+      REQUIRE(adv.num_rows < 0.6*(glob_rows << r));
+
+      m.Mult(u, Mu);
+      REQUIRE(std::abs(ones*Mu - mass0) < 1e-13*std::abs(mass0));
+      u -= u_ref;
+      err[r] = u.Normlinf();
+   }
+   REQUIRE(err[0] < 1e-3*u_ref.Normlinf());
+   REQUIRE(err[0]/err[1] > 3.5);
+
+   // A neighbor that is not a group of the solver, e.g. a face-neighbor
+   // element in parallel, sets the rate of its neighbors and the maximum level
+   {
+      const int nd = elem_dofs.RowSize(0);
+      Table group_rows(1, nd), group_nbrs(1, 1);
+      for (int j = 0; j < nd; j++)
+      {
+         group_rows.GetRow(0)[j] = elem_dofs.GetRow(0)[j];
+      }
+      group_nbrs.GetRow(0)[0] = 1;
+      Array<int> group_level(2);
+      group_level[0] = 0;
+      group_level[1] = 2;
+      MultirateRK2Solver nbr_lts(group_rows, group_level, group_nbrs);
+      REQUIRE(nbr_lts.GetMaxLevel() == 2);
+      nbr_lts.Init(adv);
+      Vector u(u0);
+      double t = 0.0, h = dt;
+      adv.num_rows = 0;
+      nbr_lts.Step(u, t, h);
+      REQUIRE(adv.num_rows == 2*4*nd);
+   }
+
+   // Levels from the refinement depth of a nonconforming mesh
+   Mesh nc_mesh(4, 4, Element::QUADRILATERAL, true, 1.0, 1.0);
+   nc_mesh.EnsureNCMesh();
+   Array<int> refs(1);
+   refs[0] = 0;
+   nc_mesh.GeneralRefinement(refs);
+   nc_mesh.GeneralRefinement(refs);
+   nc_mesh.GetTimeStepLevels(levels, 10, true);
+   Array<int> size_levels;
+   nc_mesh.GetTimeStepLevels(size_levels, 10);
+   REQUIRE(levels.Max() == 2);
+   for (int i = 0; i < levels.Size(); i++)
+   {
+      REQUIRE(levels[i] == size_levels[i]);
+   }
+}
+
+} // namespace ode_multirate
+
+namespace ode_parareal
+{
+
+// The linear ODE du/dt = J u
+class LinearODE : public TimeDependentOperator
+{
+protected:
+   DenseMatrix J, T;
+   Vector r;
+public:
+   LinearODE(const DenseMatrix &_J)
+      : TimeDependentOperator(_J.Height(), 0.0), J(_J), r(_J.Height()) { }
+
+   virtual void Mult(const Vector &u, Vector &dudt) const
+   {
+      J.Mult(u, dudt);
+   }
+
+   virtual void ImplicitSolve(const double dt, const Vector &u, Vector &dudt)
+   {
+      J.Mult(u, r);
+      T = J;
+      T *= -dt;
+      for (int i = 0; i < T.Height(); i++) { T(i,i) += 1.0; }
+      T.Invert();
+      T.Mult(r, dudt);
+   }
+};
+
+// Heat equation (p = 0) and wave equation (p = 1), discretized with finite
+// differences on n interior points of (0,1), with the initial value u0 and
+// the final time tf
+static void MakeProblem(int p, int n, DenseMatrix &J, Vector &u0, double &tf)
+{
+   const double h2 = 1.0/((n + 1)*(n + 1));
+   const int m = (p == 0) ? n : 2*n;
+   J.SetSize(m);
+   J = 0.0;
+   for (int i = 0; i < n; i++)
+   {
+      const int r = (p == 0) ? i : n + i;
+      J(r,i) = -2.0/h2;
+      if (i > 0) { J(r,i-1) = 1.0/h2; }
+      if (i < n-1) { J(r,i+1) = 1.0/h2; }
+      if (p == 1) { J(i,n+i) = 1.0; }
+   }
+   u0.SetSize(m);
+   u0 = 0.0;
+   for (int i = 0; i < n; i++)
+   {
+      const double x = (i + 1.0)/(n + 1);
+      u0(i) = x*(1.0 - x)*(1.0 + x);
+   }
+   tf = (p == 0) ? 0.5 : 1.0;
+}
+
+// Sequential fine solution with num_steps steps of size dt
+static void FineSolve(ODESolver &fine, TimeDependentOperator &oper,
+                      double dt, int num_steps, Vector &u)
+{
+   double t = 0.0;
+   fine.Init(oper);
+   for (int i = 0; i < num_steps; i++)
+   {
+      double dt_i = dt;
+      fine.Step(u, t, dt_i);
+   }
+}
+
+TEST_CASE("Parareal ODE methods",
+          "[ODE1]")
+{
+   const int n = 15, num_slices = 16;
+   for (int p = 0; p < 2; p++)
+   {
+      DenseMatrix J;
+      Vector u0;
+      double tf;
+      MakeProblem(p, n, J, u0, tf);
+      LinearODE oper(J);
+      const double dt_fine = tf/num_slices/16, dt_coarse = tf/num_slices;
+
+      SDIRK33Solver fine;
+      Vector u_ref(u0);
+      FineSolve(fine, oper, dt_fine, 16*num_slices, u_ref);
+
+      BackwardEulerSolver coarse;
+      PararealSolver parareal;
+      parareal.SetFinePropagator(fine, dt_fine);
+      parareal.SetCoarsePropagator(coarse, dt_coarse);
+      parareal.SetNumSlices(num_slices);
+      parareal.Init(oper);
+
+      // All slices are exact after num_slices iterations
+      Vector u(u0);
+      parareal.SetRelTol(0.0);
+      double t = 0.0, dt = tf;
+      parareal.Step(u, t, dt);
+      REQUIRE(t == tf);
+      REQUIRE(parareal.GetConverged());
+      REQUIRE(parareal.GetNumIterations() == num_slices);
+      u -= u_ref;
+      REQUIRE(u.Normlinf() < 1e-12*u_ref.Normlinf());
+
+      // Convergence to the given tolerance, with and without FCF-relaxation
+      int iters[2];
+      for (int fcf = 0; fcf < 2; fcf++)
+      {
+         parareal.SetFCFRelaxation(fcf);
+         parareal.SetRelTol(1e-8);
+         u = u0;
+         t = 0.0;
+         parareal.Step(u, t, dt);
+         REQUIRE(parareal.GetConverged());
+         iters[fcf] = parareal.GetNumIterations();
+         u -= u_ref;
+         REQUIRE(u.Normlinf() < 1e-6*u_ref.Normlinf());
+      }
+      REQUIRE(iters[1] < iters[0]);
+      REQUIRE(iters[1] <= num_slices/2);
+
+      // A window of two steps, which is exact with num_slices iterations. With
+      // fewer iterations, the error decreases with each iteration.
+      parareal.SetFCFRelaxation(false);
+      parareal.SetRelTol(0.0);
+      double err[4];
+      for (int it = 0; it < 4; it++)
+      {
+         parareal.SetMaxIter((it < 3) ? it : num_slices);
+         u = u0;
+         t = 0.0;
+         dt = tf/2;
+         parareal.Run(u, t, dt, tf);
+         REQUIRE(std::abs(t - tf) < 1e-14);
+         u -= u_ref;
+         err[it] = u.Normlinf()/u_ref.Normlinf();
+      }
+      REQUIRE(err[3] < 1e-12);
+      REQUIRE(err[2] < err[1]);
+      REQUIRE(err[1] < err[0]);
+      REQUIRE(err[2] < 0.2);
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel Parareal ODE methods",
+          "[ODE1][Parallel]")
+{
+   // The slices are distributed over the ranks of MPI_COMM_WORLD, and the
+   // results are compared with the serial Parareal iterations
+   int num_ranks;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+   const int n = 15, num_slices = std::max(16, num_ranks);
+   for (int p = 0; p < 2; p++)
+   {
+      DenseMatrix J;
+      Vector u0;
+      double tf;
+      MakeProblem(p, n, J, u0, tf);
+      LinearODE oper(J);
+      const double dt_fine = tf/num_slices/16, dt_coarse = tf/num_slices;
+
+      SDIRK33Solver fine;
+      Vector u_ref(u0);
+      FineSolve(fine, oper, dt_fine, 16*num_slices, u_ref);
+
+      BackwardEulerSolver coarse;
+      PararealSolver serial, parallel(MPI_COMM_WORLD);
+      PararealSolver *solvers[2] = { &serial, &parallel };
+      for (int s = 0; s < 2; s++)
+      {
+         solvers[s]->SetFinePropagator(fine, dt_fine);
+         solvers[s]->SetCoarsePropagator(coarse, dt_coarse);
+         solvers[s]->SetNumSlices(num_slices);
+         solvers[s]->Init(oper);
+      }
+
+      // All slices are exact after num_slices iterations
+      Vector u(u0);
+      parallel.SetRelTol(0.0);
+      double t = 0.0, dt = tf;
+      parallel.Step(u, t, dt);
+      REQUIRE(t == tf);
+      REQUIRE(parallel.GetConverged());
+      REQUIRE(parallel.GetNumIterations() == num_slices);
+      u -= u_ref;
+      REQUIRE(u.Normlinf() < 1e-12*u_ref.Normlinf());
+
+      // Convergence to the given tolerance, with and without FCF-relaxation,
+      // and a window of two steps with two iterations
+      for (int c = 0; c < 3; c++)
+      {
+         Vector us[2];
+         int iters[2];
+         for (int s = 0; s < 2; s++)
+         {
+            PararealSolver &parareal = *solvers[s];
+            parareal.SetFCFRelaxation(c == 1);
+            parareal.SetRelTol((c < 2) ? 1e-8 : 0.0);
+            parareal.SetMaxIter((c < 2) ? num_slices : 2);
+            us[s] = u0;
+            t = 0.0;
+            dt = (c < 2) ? tf : tf/2;
+            parareal.Run(us[s], t, dt, tf);
+            REQUIRE(std::abs(t - tf) < 1e-14);
+            iters[s] = parareal.GetNumIterations();
+         }
+         REQUIRE(iters[1] == iters[0]);
+         us[1] -= us[0];
+         REQUIRE(us[1].Normlinf() < 1e-12*us[0].Normlinf());
+         if (c < 2)
+         {
+            us[0] -= u_ref;
+            REQUIRE(us[0].Normlinf() < 1e-6*u_ref.Normlinf());
+         }
+      }
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace ode_parareal
+
+TEST_CASE("Exponential ODE methods",
+          "[ODE1]")
+{
+   // The stiff ODE du/dt = A u + N(u,t), where A is the finite difference
+   // Laplacian and N(u,t) = alpha sin(u) + cos(t) c. The terms A u and N(u,t)
+   // are evaluated with ADDITIVE_TERM_2 and ADDITIVE_TERM_1, respectively.
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      DenseMatrix A;
+      Vector c;
+      double alpha;
+   public:
+      ODE(int n, double _alpha)
+         : TimeDependentOperator(n, 0.0), A(n), c(n), alpha(_alpha)
+      {
+         const double s = (n + 1)*(n + 1);
+         A = 0.0;
+         for (int i = 0; i < n; i++)
+         {
+            A(i,i) = -2.0*s;
+            if (i > 0) { A(i,i-1) = s; }
+            if (i < n-1) { A(i,i+1) = s; }
+            c(i) = 1.0 + i%3;
+         }
+      }
+
+      const DenseMatrix &Matrix() const { return A; }
+      const Vector &Source() const { return c; }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         dudt = 0.0;
+         if (eval_mode != ADDITIVE_TERM_1) { A.Mult(u, dudt); }
+         if (eval_mode != ADDITIVE_TERM_2)
+         {
+            for (int i = 0; i < u.Size(); i++)
+            {
+               dudt(i) += alpha*sin(u(i)) + cos(t)*c(i);
+            }
+         }
+      }
+   };
+
+   SECTION("Linear problem")
+   {
+      // For the autonomous ODE du/dt = A u + c, the solution is, with the
+      // eigendecomposition A = Q D Q^T,
+      // u(h) = Q (exp(h D) Q^T u0 + (exp(h D) - 1)/D Q^T c), and a single
+      // exponential Euler step is exact.
+      const int n = 50;
+      ODE oper(n, 0.0);
+      class Autonomous : public TimeDependentOperator
+      {
+         ODE &ode;
+         Vector c;
+      public:
+         Autonomous(ODE &o) : TimeDependentOperator(o.Width(), 0.0), ode(o),
+            c(o.Source()) { }
+         virtual void Mult(const Vector &u, Vector &dudt) const
+         {
+            ode.Matrix().Mult(u, dudt);
+            dudt += c;
+         }
+      } aut(oper);
+
+      Vector u0(n), u_ex(n), d(n), qu(n), qc(n);
+      for (int i = 0; i < n; i++) { u0(i) = sin(M_PI*(i + 1)/(n + 1)); }
+      const double h = 0.5;
+      DenseMatrix Q(n);
+      for (int k = 0; k < n; k++)
+      {
+         const double s = sin(M_PI*(k + 1)/(2*(n + 1)));
+         d(k) = -4.0*(n + 1)*(n + 1)*s*s;
+         for (int i = 0; i < n; i++)
+         {
+            Q(i,k) = sqrt(2.0/(n + 1))*sin(M_PI*(i + 1)*(k + 1)/(n + 1));
+         }
+      }
+      Q.MultTranspose(u0, qu);
+      Q.MultTranspose(oper.Source(), qc);
+      for (int i = 0; i < n; i++)
+      {
+         const double e = exp(h*d(i));
+         qu(i) = e*qu(i) + (e - 1.0)/d(i)*qc(i);
+      }
+      Q.Mult(qu, u_ex);
+
+      for (int max_dim = 10; max_dim <= 50; max_dim += 40)
+      {
+         ExponentialEulerSolver solver;
+         solver.SetLinearPart(ExponentialODESolver::LINEAR);
+         solver.GetKrylovPhi().SetRelTol(1e-12);
+         solver.GetKrylovPhi().SetMaxDim(max_dim);
+         solver.Init(aut);
+         Vector u(u0);
+         double t = 0.0, dt = h;
+         solver.Step(u, t, dt);
+         REQUIRE(t == h);
+         // A small Krylov space needs substeps for the stiff operator
+         if (max_dim == 10)
+         {
+            REQUIRE(solver.GetKrylovPhi().GetNumSubsteps() > 1);
+         }
+         u -= u_ex;
+         REQUIRE(u.Normlinf() < 1e-9*u_ex.Normlinf());
+      }
+   }
+
+   SECTION("Convergence")
+   {
+      // Reference solution at t = 1, using many RK4 steps
+      const int n = 10;
+      ODE oper(n, 0.5);
+      Vector u0(n), u_ex(n);
+      for (int i = 0; i < n; i++) { u0(i) = sin(M_PI*(i + 1)/(n + 1)); }
+      {
+         RK4Solver rk4;
+         rk4.Init(oper);
+         u_ex = u0;
+         double t = 0.0, dt = 1.0/16384;
+         for (int i = 0; i < 16384; i++) { rk4.Step(u_ex, t, dt); }
+      }
+
+      ExponentialODESolver *solvers[4] =
+      {
+         new ExponentialEulerSolver, new ExponentialEulerSolver,
+         new ETDRK2Solver, new ExpRB32Solver
+      };
+      solvers[1]->SetLinearPart(ExponentialODESolver::SPLIT);
+      const int orders[4] = { 2, 1, 2, 3 };
+      for (int i = 0; i < 4; i++)
+      {
+         solvers[i]->GetKrylovPhi().SetRelTol(1e-12);
+         double err[2];
+         for (int l = 0; l < 2; l++)
+         {
+            const int steps = 32 << (2*l);
+            Vector u(u0);
+            double t = 0.0, dt = 1.0/steps;
+            solvers[i]->Init(oper);
+            for (int k = 0; k < steps; k++) { solvers[i]->Step(u, t, dt); }
+            REQUIRE(oper.GetEvalMode() == TimeDependentOperator::NORMAL);
+            u -= u_ex;
+            err[l] = u.Norml2();
+         }
+         REQUIRE(log(err[0]/err[1])/log(4.0) > orders[i] - 0.15);
+         delete solvers[i];
+      }
+   }
+}
+
+TEST_CASE("Implicit solve cache",
+          "[ODE1]")
+{
+   // The heat equation du/dt = -kappa(t) K u with the finite difference
+   // Laplacian K. The systems (I + dt kappa K) k = -kappa K u are solved in
+   // ImplicitSolve() with CG, preconditioned with symmetric Gauss-Seidel.
+   class Systems : public ImplicitSolveCache
+   {
+      const SparseMatrix &I, &K;
+      const double &kappa;
+   protected:
+      virtual Operator *NewSystem(double dt)
+      { return Add(1.0, I, dt*kappa, K); }
+      virtual Solver *NewPreconditioner(const Operator &A, double dt)
+      { return new GSSmoother(static_cast<const SparseMatrix &>(A)); }
+   public:
+      Systems(IterativeSolver &s, const SparseMatrix &I_,
+              const SparseMatrix &K_, const double &kappa_)
+         : ImplicitSolveCache(s), I(I_), K(K_), kappa(kappa_) { }
+   };
+
+   class Heat : public TimeDependentOperator
+   {
+      SparseMatrix I, K;
+      double beta, kappa;
+      CGSolver cg;
+      mutable Vector z;
+   public:
+      Systems systems;
+
+      Heat(int n, double beta_)
+         : TimeDependentOperator(n, 0.0), I(n), K(n), beta(beta_), kappa(1.0),
+           z(n), systems(cg, I, K, kappa)
+      {
+         const double s = (n + 1)*(n + 1);
+         for (int i = 0; i < n; i++)
+         {
+            I.Add(i, i, 1.0);
+            K.Add(i, i, 2.0*s);
+            if (i > 0) { K.Add(i, i-1, -s); }
+            if (i < n-1) { K.Add(i, i+1, -s); }
+         }
+         I.Finalize();
+         K.Finalize();
+         cg.SetRelTol(1e-10);
+         cg.SetAbsTol(0.0);
+         cg.SetMaxIter(500);
+         cg.SetPrintLevel(-1);
+      }
+
+      virtual void SetTime(const double _t)
+      {
+         t = _t;
+         if (beta != 0.0)
+         {
+            kappa = 1.0 + beta*sin(10.0*t);
+            systems.Update();
+         }
+      }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         K.Mult(u, dudt);
+         dudt *= -kappa;
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &k)
+      {
+         K.Mult(u, z);
+         z *= -kappa;
+         systems.Solve(dt, t, z, k);
+      }
+   };
+
+   const int n = 100, steps = 20;
+   Vector u0(n);
+   for (int i = 0; i < n; i++)
+   {
+      const double x = (i + 1.0)/(n + 1);
+      u0(i) = x*(1.0 - x)*(1.0 + x);
+   }
+
+   for (int beta = 0; beta <= 1; beta++)
+   {
+      Vector u[2];
+      int num_iter[2];
+      for (int extrap = 0; extrap <= 1; extrap++)
+      {
+         Heat heat(n, 0.5*beta);
+         heat.systems.SetExtrapolation(extrap);
+         SDIRK33Solver sdirk;
+         sdirk.Init(heat);
+         u[extrap] = u0;
+         double t = 0.0, dt = 0.01;
+         for (int i = 0; i < steps; i++) { sdirk.Step(u[extrap], t, dt); }
+         num_iter[extrap] = heat.systems.GetNumIterations();
+
+         if (beta == 0)
+         {
+            // All stages use the same dt
+            REQUIRE(heat.systems.GetNumSetups() == 1);
+            REQUIRE(heat.systems.GetNumPreconditionerSetups() == 1);
+         }
+         else
+         {
+            // A new system in each stage, but fewer preconditioner setups
+            REQUIRE(heat.systems.GetNumSetups() == 3*steps);
+            REQUIRE(heat.systems.GetNumPreconditionerSetups() < 3*steps);
+         }
+      }
+      // The extrapolated initial guess saves iterations
+      REQUIRE(num_iter[1] < num_iter[0]);
+      u[1] -= u[0];
+      REQUIRE(u[1].Normlinf() < 1e-8*u[0].Normlinf());
+   }
+
+   // Alternating time steps, with one or two cached systems
+   for (int max_sys = 1; max_sys <= 2; max_sys++)
+   {
+      Heat heat(n, 0.0);
+      heat.systems.SetMaxSystems(max_sys);
+      BackwardEulerSolver be;
+      be.Init(heat);
+      Vector u(u0);
+      double t = 0.0;
+      for (int i = 0; i < steps; i++)
+      {
+         double dt = (i%2 == 0) ? 0.01 : 0.02;
+         be.Step(u, t, dt);
+      }
+      REQUIRE(std::abs(t - 0.3) < 1e-14);
+      REQUIRE(heat.systems.GetNumSetups() == ((max_sys == 1) ? steps : 2));
+   }
+}
@@ -95,3 +95,73 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
 }
 
 #endif
+
+TEST_CASE("Space-filling curve partitioning", "[Mesh]")
+{
+   const int nparts = 7;
+
+   for (int part_method = 6; part_method <= 7; part_method++)
+   {
+      SECTION("Equal parts, method " + std::to_string(part_method))
+      {
+         Mesh mesh(5, 4, 3, Element::TETRAHEDRON);
+         int *partitioning = mesh.GeneratePartitioning(nparts, part_method);
+
+         Array<int> part_size(nparts);
+         part_size = 0;
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            REQUIRE(partitioning[i] >= 0);
+            REQUIRE(partitioning[i] < nparts);
+            part_size[partitioning[i]]++;
+         }
+         REQUIRE(part_size.Min() >= mesh.GetNE() / nparts);
+         REQUIRE(part_size.Max() <= mesh.GetNE() / nparts + 1);
+
+         delete [] partitioning;
+      }
+
+      SECTION("Weighted parts, method " + std::to_string(part_method))
+      {
+         Mesh mesh(8, 8, Element::QUADRILATERAL);
+         Vector weights(mesh.GetNE());
+         double max_weight = 0.0;
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            weights(i) = 1 + (i % 5);
+            max_weight = std::max(max_weight, weights(i));
+         }
+         int *partitioning =
+            mesh.GeneratePartitioning(nparts, part_method, &weights);
+
+         Vector part_weight(nparts);
+         part_weight = 0.0;
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            part_weight(partitioning[i]) += weights(i);
+         }
+         const double avg = weights.Sum() / nparts;
+         for (int p = 0; p < nparts; p++)
+         {
+            REQUIRE(std::abs(part_weight(p) - avg) <= max_weight);
+         }
+
+         delete [] partitioning;
+      }
+   }
+
+   SECTION("Morton ordering is a permutation")
+   {
+      Mesh mesh(3, 4, 5, Element::HEXAHEDRON);
+      Array<int> ordering;
+      mesh.GetMortonElementOrdering(ordering);
+      REQUIRE(ordering.Size() == mesh.GetNE());
+
+      Array<int> sorted(ordering);
+      sorted.Sort();
+      for (int i = 0; i < sorted.Size(); i++)
+      {
+         REQUIRE(sorted[i] == i);
+      }
+   }
+}
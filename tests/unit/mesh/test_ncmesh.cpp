@@ -0,0 +1,143 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+
+namespace ncmesh
+{
+
+// Non-conforming mesh of the unit square/cube refined three times around the
+// origin, so that the master edges/faces have slaves on several levels
+Mesh *MakeRefinedMesh(int dim)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(2, 2, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   mesh->EnsureNCMesh();
+   for (int level = 0; level < 3; level++)
+   {
+      Array<int> refs;
+      Vector center;
+      for (int i = 0; i < mesh->GetNE(); i++)
+      {
+         mesh->GetElementTransformation(i)->Transform(
+            Geometries.GetCenter(mesh->GetElementBaseGeometry(i)), center);
+         if (center.Normlinf() < 0.5) { refs.Append(i); }
+      }
+      mesh->GeneralRefinement(refs, 1);
+   }
+   return mesh;
+}
+
+// Check that the point matrices of the list are unique and valid
+void CheckPointMatrices(const NCMesh::NCList &list)
+{
+   const int npm = list.point_matrices.Size();
+   REQUIRE(list.slaves.size() > 0);
+   REQUIRE(npm > 0);
+   REQUIRE(npm < (int) list.slaves.size());
+   for (unsigned i = 0; i < list.slaves.size(); i++)
+   {
+      REQUIRE((int) list.slaves[i].matrix < npm);
+   }
+   for (int i = 0; i < npm; i++)
+   {
+      const DenseMatrix &pm_i = *list.point_matrices[i];
+      for (int j = 0; j < i; j++)
+      {
+         const DenseMatrix &pm_j = *list.point_matrices[j];
+         bool same = (pm_i.Height() == pm_j.Height() &&
+                      pm_i.Width() == pm_j.Width());
+         for (int k = 0; same && k < pm_i.Height()*pm_i.Width(); k++)
+         {
+            same = (pm_i.Data()[k] == pm_j.Data()[k]);
+         }
+         REQUIRE(!same);
+      }
+   }
+}
+
+// Check that the lists are the same, comparing the point matrices of the
+// slaves by value
+void CompareLists(const NCMesh::NCList &a, const NCMesh::NCList &b)
+{
+   REQUIRE(a.conforming.size() == b.conforming.size());
+   REQUIRE(a.masters.size() == b.masters.size());
+   REQUIRE(a.slaves.size() == b.slaves.size());
+   REQUIRE(a.point_matrices.Size() == b.point_matrices.Size());
+   for (unsigned i = 0; i < a.conforming.size(); i++)
+   {
+      REQUIRE(a.conforming[i].index == b.conforming[i].index);
+      REQUIRE(a.conforming[i].element == b.conforming[i].element);
+      REQUIRE(a.conforming[i].local == b.conforming[i].local);
+   }
+   for (unsigned i = 0; i < a.masters.size(); i++)
+   {
+      REQUIRE(a.masters[i].index == b.masters[i].index);
+      REQUIRE(a.masters[i].slaves_begin == b.masters[i].slaves_begin);
+      REQUIRE(a.masters[i].slaves_end == b.masters[i].slaves_end);
+   }
+   for (unsigned i = 0; i < a.slaves.size(); i++)
+   {
+      const NCMesh::Slave &sa = a.slaves[i], &sb = b.slaves[i];
+      REQUIRE(sa.index == sb.index);
+      REQUIRE(sa.master == sb.master);
+      REQUIRE(sa.edge_flags == sb.edge_flags);
+      DenseMatrix diff(a.GetPointMatrix(sa));
+      diff -= b.GetPointMatrix(sb);
+      REQUIRE(diff.MaxMaxNorm() == 0.0);
+   }
+}
+
+TEST_CASE("NCMesh point matrices and Trim", "[NCMesh]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = MakeRefinedMesh(dim);
+      Mesh *trimmed = MakeRefinedMesh(dim);
+      REQUIRE(mesh->GetNE() == trimmed->GetNE());
+
+      NCMesh &ncmesh = *mesh->ncmesh;
+      // In 2D the faces are the edges, and the face list is empty
+      CheckPointMatrices(ncmesh.GetEdgeList());
+      if (dim == 3) { CheckPointMatrices(ncmesh.GetFaceList()); }
+
+      // Trim() releases the lists, which are rebuilt on demand
+      const long mem = trimmed->ncmesh->MemoryUsage();
+      trimmed->ncmesh->Trim();
+      REQUIRE(trimmed->ncmesh->MemoryUsage() < mem);
+      CompareLists(ncmesh.GetFaceList(), trimmed->ncmesh->GetFaceList());
+      CompareLists(ncmesh.GetEdgeList(), trimmed->ncmesh->GetEdgeList());
+      CompareLists(ncmesh.GetVertexList(), trimmed->ncmesh->GetVertexList());
+
+      // The spaces on the trimmed mesh have the same constraints
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec), fes_trimmed(trimmed, &fec);
+      REQUIRE(fes.GetVSize() == fes_trimmed.GetVSize());
+      REQUIRE(fes.GetTrueVSize() == fes_trimmed.GetTrueVSize());
+      REQUIRE(fes.GetTrueVSize() < fes.GetVSize());
+
+      Vector x(fes.GetTrueVSize()), y(fes.GetVSize()), y_trimmed(y.Size());
+      x.Randomize(1);
+      fes.GetProlongationMatrix()->Mult(x, y);
+      fes_trimmed.GetProlongationMatrix()->Mult(x, y_trimmed);
+      y_trimmed -= y;
+      REQUIRE(y_trimmed.Normlinf() == 0.0);
+
+      delete trimmed;
+      delete mesh;
+   }
+}
+
+} // namespace ncmesh
@@ -0,0 +1,339 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+
+#ifdef MFEM_USE_MPI
+
+namespace pmesh
+{
+
+// Functions that are reproduced exactly by the spaces used below, also after
+// uniform refinement.
+double scalar_func(const Vector &x)
+{
+   double s = 1.0;
+   for (int d = 0; d < x.Size(); d++) { s += (d + 1)*x(d)*(1.0 - 0.5*x(d)); }
+   return s;
+}
+
+// Constant plus rotation, in the lowest order Nedelec space
+void nd_func(const Vector &x, Vector &v)
+{
+   if (x.Size() == 2)
+   {
+      v(0) = 1.0 - x(1);
+      v(1) = 2.0 + x(0);
+   }
+   else
+   {
+      v(0) = 1.0 + x(1) - 2.0*x(2);
+      v(1) = 2.0 - x(0) + 3.0*x(2);
+      v(2) = 3.0 + 2.0*x(0) - 3.0*x(1);
+   }
+}
+
+// Constant plus dilation, in the lowest order Raviart-Thomas space
+void rt_func(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < x.Size(); d++) { v(d) = (d + 1) + 0.5*x(d); }
+}
+
+// Max norm of the difference between 'x' and the projection of the exact
+// function in the current (rebalanced) space
+double ProjectionError(ParGridFunction &x, Coefficient *c,
+                       VectorCoefficient *vc)
+{
+   ParGridFunction y(x.ParFESpace());
+   if (c) { y.ProjectCoefficient(*c); }
+   else { y.ProjectCoefficient(*vc); }
+   y -= x;
+
+   double loc_err = y.Normlinf(), glob_err;
+   MPI_Allreduce(&loc_err, &glob_err, 1, MPI_DOUBLE, MPI_MAX,
+                 x.ParFESpace()->GetComm());
+   return glob_err;
+}
+
+void CheckBalance(ParMesh &pmesh, HYPRE_Int global_ne)
+{
+   REQUIRE(pmesh.ReduceInt(pmesh.GetNE()) == global_ne);
+
+   int ne_min, ne_max, ne = pmesh.GetNE();
+   MPI_Allreduce(&ne, &ne_min, 1, MPI_INT, MPI_MIN, pmesh.GetComm());
+   MPI_Allreduce(&ne, &ne_max, 1, MPI_INT, MPI_MAX, pmesh.GetComm());
+   REQUIRE(ne_max - ne_min <= 1);
+}
+
+// The center of the element 'i'
+void ElementCenter(ParMesh &pmesh, int i, Vector &center)
+{
+   const int geom = pmesh.GetElementBaseGeometry(i);
+   pmesh.GetElementTransformation(i)->Transform(Geometries.GetCenter(geom),
+                                                center);
+}
+
+double CenterX(ParMesh &pmesh, int i)
+{
+   Vector center;
+   ElementCenter(pmesh, i, center);
+   return center(0);
+}
+
+// Grid functions in H1, ND, RT, L2 and vector H1 spaces on 'pmesh', which are
+// updated after the mesh changes and compared with the exact functions
+struct TestFields
+{
+   const int dim;
+   H1_FECollection h1_fec;
+   ND_FECollection nd_fec;
+   RT_FECollection rt_fec;
+   L2_FECollection l2_fec;
+   ParFiniteElementSpace h1_fes, nd_fes, rt_fes, l2_fes, vh1_fes;
+   FunctionCoefficient scalar_coeff;
+   VectorFunctionCoefficient nd_coeff, rt_coeff;
+   ParGridFunction h1_x, nd_x, rt_x, l2_x, vh1_x;
+
+   TestFields(ParMesh &pmesh)
+      : dim(pmesh.Dimension()),
+        h1_fec(2, dim), nd_fec(1, dim), rt_fec(0, dim), l2_fec(2, dim),
+        h1_fes(&pmesh, &h1_fec), nd_fes(&pmesh, &nd_fec),
+        rt_fes(&pmesh, &rt_fec), l2_fes(&pmesh, &l2_fec),
+        vh1_fes(&pmesh, &h1_fec, dim, Ordering::byVDIM),
+        scalar_coeff(scalar_func), nd_coeff(dim, nd_func),
+        rt_coeff(dim, rt_func),
+        h1_x(&h1_fes), nd_x(&nd_fes), rt_x(&rt_fes), l2_x(&l2_fes),
+        vh1_x(&vh1_fes)
+   {
+      h1_x.ProjectCoefficient(scalar_coeff);
+      nd_x.ProjectCoefficient(nd_coeff);
+      rt_x.ProjectCoefficient(rt_coeff);
+      l2_x.ProjectCoefficient(scalar_coeff);
+      vh1_x.ProjectCoefficient(rt_coeff);
+   }
+
+   // Update the spaces and the functions after the mesh was refined or
+   // rebalanced
+   void Update()
+   {
+      ParFiniteElementSpace *fes[] = { &h1_fes, &nd_fes, &rt_fes, &l2_fes,
+                                        &vh1_fes
+                                      };
+      ParGridFunction *x[] = { &h1_x, &nd_x, &rt_x, &l2_x, &vh1_x };
+      for (int i = 0; i < 5; i++) { fes[i]->Update(); x[i]->Update(); }
+   }
+
+   // The functions are still the exact ones
+   void Check()
+   {
+      REQUIRE(ProjectionError(h1_x, &scalar_coeff, NULL) < 1e-12);
+      REQUIRE(ProjectionError(nd_x, NULL, &nd_coeff) < 1e-12);
+      REQUIRE(ProjectionError(rt_x, NULL, &rt_coeff) < 1e-12);
+      REQUIRE(ProjectionError(l2_x, &scalar_coeff, NULL) < 1e-12);
+      REQUIRE(ProjectionError(vh1_x, NULL, &rt_coeff) < 1e-12);
+   }
+};
+
+// A parallel mesh with the first half of the elements on rank 0 and the rest
+// scattered over all ranks
+ParMesh *MakeUnbalancedMesh(Mesh &mesh)
+{
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   const int ne = mesh.GetNE();
+   int *partitioning = new int[ne];
+   for (int i = 0; i < ne; i++)
+   {
+      partitioning[i] = (i < ne/2) ? 0 : (7*i) % num_procs;
+   }
+   ParMesh *pmesh = new ParMesh(MPI_COMM_WORLD, mesh, partitioning);
+   delete [] partitioning;
+   return pmesh;
+}
+
+} // namespace pmesh
+
+TEST_CASE("ParMesh conforming rebalance", "[ParMesh][Parallel]")
+{
+   using namespace pmesh;
+
+   const Element::Type types[] = { Element::TRIANGLE, Element::QUADRILATERAL,
+                                   Element::TETRAHEDRON, Element::HEXAHEDRON
+                                 };
+   for (int t = 0; t < 4; t++)
+   {
+      Mesh *mesh = (t < 2) ? new Mesh(6, 6, types[t], true)
+                   : new Mesh(3, 3, 3, types[t], true);
+      const int dim = mesh->Dimension();
+      HYPRE_Int global_ne = mesh->GetNE();
+      ParMesh *pmesh = MakeUnbalancedMesh(*mesh);
+      delete mesh;
+      TestFields fields(*pmesh);
+
+      for (int it = 0; it < 2; it++)
+      {
+         if (it > 0)
+         {
+            pmesh->UniformRefinement();
+            fields.Update();
+            global_ne <<= dim;
+         }
+
+         pmesh->Rebalance();
+         fields.Update();
+
+         CheckBalance(*pmesh, global_ne);
+         fields.Check();
+      }
+      delete pmesh;
+   }
+}
+
+TEST_CASE("ParMesh conforming weighted rebalance", "[ParMesh][Parallel]")
+{
+   using namespace pmesh;
+
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+   const Element::Type types[] = { Element::QUADRILATERAL,
+                                   Element::TETRAHEDRON
+                                 };
+   for (int t = 0; t < 2; t++)
+   {
+      Mesh *mesh = (t == 0) ? new Mesh(8, 8, types[t], true)
+                   : new Mesh(3, 3, 3, types[t], true);
+      const HYPRE_Int global_ne = mesh->GetNE();
+      ParMesh *pmesh = MakeUnbalancedMesh(*mesh);
+      delete mesh;
+      TestFields fields(*pmesh);
+
+      // The elements with x < 1/2 are four times as expensive
+      Vector weights(pmesh->GetNE());
+      for (int i = 0; i < pmesh->GetNE(); i++)
+      {
+         weights(i) = (CenterX(*pmesh, i) < 0.5) ? 4.0 : 1.0;
+      }
+      const double max_weight = 4.0;
+      const double total_weight = weights.Sum();
+      double global_weight;
+      MPI_Allreduce(&total_weight, &global_weight, 1, MPI_DOUBLE, MPI_SUM,
+                    pmesh->GetComm());
+
+      pmesh->Rebalance(weights);
+      fields.Update();
+
+      REQUIRE(pmesh->ReduceInt(pmesh->GetNE()) == global_ne);
+      fields.Check();
+
+      // Each rank has about the same total weight
+      double weight = 0.0, w_min, w_max;
+      for (int i = 0; i < pmesh->GetNE(); i++)
+      {
+         weight += (CenterX(*pmesh, i) < 0.5) ? 4.0 : 1.0;
+      }
+      MPI_Allreduce(&weight, &w_min, 1, MPI_DOUBLE, MPI_MIN, pmesh->GetComm());
+      MPI_Allreduce(&weight, &w_max, 1, MPI_DOUBLE, MPI_MAX, pmesh->GetComm());
+      REQUIRE(w_max - w_min <= 2*max_weight);
+      REQUIRE(std::abs(w_max - global_weight/num_procs) <= max_weight);
+      delete pmesh;
+   }
+}
+
+TEST_CASE("ParMesh conforming rebalance with a partition",
+          "[ParMesh][Parallel]")
+{
+   using namespace pmesh;
+
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+   const Element::Type types[] = { Element::TRIANGLE, Element::HEXAHEDRON };
+   for (int t = 0; t < 2; t++)
+   {
+      Mesh *mesh = (t == 0) ? new Mesh(6, 6, types[t], true)
+                   : new Mesh(3, 3, 3, types[t], true);
+      ParMesh *pmesh = MakeUnbalancedMesh(*mesh);
+      delete mesh;
+      TestFields fields(*pmesh);
+
+      // Cut the domain in slabs in the x-direction, one per rank
+      Array<int> partition(pmesh->GetNE());
+      Array<int> count(num_procs), global_count(num_procs);
+      count = 0;
+      for (int i = 0; i < pmesh->GetNE(); i++)
+      {
+         const int rank = int(CenterX(*pmesh, i)*num_procs);
+         partition[i] = std::min(rank, num_procs - 1);
+         count[partition[i]]++;
+      }
+      MPI_Allreduce(count.GetData(), global_count.GetData(), num_procs,
+                    MPI_INT, MPI_SUM, pmesh->GetComm());
+
+      pmesh->Rebalance(partition);
+      fields.Update();
+
+      // Every rank has exactly the elements of its slab
+      REQUIRE(pmesh->GetNE() == global_count[pmesh->GetMyRank()]);
+      for (int i = 0; i < pmesh->GetNE(); i++)
+      {
+         const int rank = int(CenterX(*pmesh, i)*num_procs);
+         REQUIRE(std::min(rank, num_procs - 1) == pmesh->GetMyRank());
+      }
+      fields.Check();
+      delete pmesh;
+   }
+}
+
+TEST_CASE("ParMesh conforming rebalance of a locally refined tet mesh",
+          "[ParMesh][Parallel]")
+{
+   using namespace pmesh;
+
+   Mesh mesh(3, 3, 3, Element::TETRAHEDRON, true);
+   ParMesh *pmesh = MakeUnbalancedMesh(mesh);
+   TestFields fields(*pmesh);
+
+   // Refine near a corner, rebalance, then refine the rebalanced mesh, which
+   // must still have consistent refinement data
+   for (int it = 0; it < 3; it++)
+   {
+      Array<int> marked;
+      for (int i = 0; i < pmesh->GetNE(); i++)
+      {
+         Vector center;
+         ElementCenter(*pmesh, i, center);
+         if (center.Normlinf() < 0.6 - 0.15*it) { marked.Append(i); }
+      }
+      const HYPRE_Int global_marked = pmesh->ReduceInt(marked.Size());
+      REQUIRE(global_marked > 0);
+      const HYPRE_Int global_ne = pmesh->ReduceInt(pmesh->GetNE());
+      pmesh->GeneralRefinement(marked);
+      fields.Update();
+
+      const HYPRE_Int new_global_ne = pmesh->ReduceInt(pmesh->GetNE());
+      REQUIRE(new_global_ne >= global_ne + global_marked);
+      REQUIRE(pmesh->Conforming());
+      fields.Check();
+
+      pmesh->Rebalance();
+      fields.Update();
+
+      CheckBalance(*pmesh, new_global_ne);
+      fields.Check();
+   }
+   delete pmesh;
+}
+
+#endif // MFEM_USE_MPI